@@ -0,0 +1,1017 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegExp>
+#include <QUrl>
+#include <QXmlStreamWriter>
+
+#include "knbenchmarkgenerator.h"
+
+#include <QDebug>
+
+//Change the version when the generated library is changed, so the libraries
+//generated by the old version will be generated again.
+#define GeneratorVersion 1
+#define GeneratorMarker "Generator.json"
+//The MP3 frames are 128kbps at 44.1kHz, 38 frames are about 1 second.
+#define MpegFrameCount 38
+#define MpegFrameSize 417
+//The FLAC frames have 4096 samples at 44.1kHz, 11 frames are about 1 second.
+#define FlacFrameCount 11
+#define FlacBlockSize 4096
+#define FlacSampleRate 44100
+//The size of the playlists, and how many files make a playlist of each format.
+#define PlaylistSize 100
+#define FilesPerPlaylist 1000
+//The ID3v2 taggers leave some padding for editing the tag later.
+#define ID3v2Padding 1024
+
+static const char *syllables[]={"ka", "ri", "so", "ne", "mu", "ta", "lo", "vi",
+                                "da", "en", "or", "al", "mi", "sa", "ku", "re",
+                                "no", "fe", "zu", "an", "ly", "ha", "ti", "be",
+                                "go", "ur", "es", "py", "wa", "ch", "th", "is"};
+#define SyllableCount 32
+
+static inline void appendBigEndian(QByteArray &data,
+                                   const quint64 &value,
+                                   const int &bytes)
+{
+    for(int i=bytes-1; i>-1; --i)
+    {
+        data.append((char)((value>>(i<<3)) & 0xFF));
+    }
+}
+
+static inline void appendLittleEndian(QByteArray &data, const quint32 &value)
+{
+    for(int i=0; i<4; ++i)
+    {
+        data.append((char)((value>>(i<<3)) & 0xFF));
+    }
+}
+
+static inline bool isAscii(const QString &text)
+{
+    for(QString::const_iterator i=text.constBegin(); i!=text.constEnd(); ++i)
+    {
+        if((*i).unicode()>0x7F)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//The ID3v2 text starts with the encoding. The ASCII text is saved in
+//ISO-8859-1, the others are saved in UTF-16 with BOM like most taggers do.
+static inline QByteArray id3v2Text(const QString &text)
+{
+    QByteArray content;
+    if(isAscii(text))
+    {
+        content.append('\0');
+        content.append(text.toLatin1());
+        return content;
+    }
+    content.append('\1');
+    content.append("\xFF\xFE", 2);
+    for(QString::const_iterator i=text.constBegin(); i!=text.constEnd(); ++i)
+    {
+        content.append((char)((*i).unicode() & 0xFF));
+        content.append((char)((*i).unicode()>>8));
+    }
+    return content;
+}
+
+static inline void appendID3v2Frame(QByteArray &tag,
+                                    const char *frameID,
+                                    const QByteArray &content)
+{
+    //ID3v2.3 frame header: frame ID, 4 bytes size and 2 bytes flags.
+    tag.append(frameID, 4);
+    appendBigEndian(tag, content.size(), 4);
+    tag.append(2, '\0');
+    tag.append(content);
+}
+
+static inline void appendAPEv2Item(QByteArray &items,
+                                   const QString &key,
+                                   const QByteArray &value,
+                                   const quint32 &flags=0)
+{
+    //APEv2 item: 4 bytes value size, 4 bytes flags, the key with a '\0' and
+    //the value.
+    appendLittleEndian(items, value.size());
+    appendLittleEndian(items, flags);
+    items.append(key.toLatin1());
+    items.append('\0');
+    items.append(value);
+}
+
+static inline QByteArray apev2Header(const quint32 &tagSize,
+                                     const quint32 &itemCount,
+                                     const quint32 &flags)
+{
+    QByteArray header("APETAGEX");
+    appendLittleEndian(header, 2000);
+    appendLittleEndian(header, tagSize);
+    appendLittleEndian(header, itemCount);
+    appendLittleEndian(header, flags);
+    header.append(8, '\0');
+    return header;
+}
+
+static inline void appendVorbisComment(QByteArray &comments,
+                                       int &commentCount,
+                                       const char *fieldName,
+                                       const QString &value)
+{
+    //The empty field is not saved.
+    if(value.isEmpty())
+    {
+        return;
+    }
+    QByteArray comment=QByteArray(fieldName)+"="+value.toUtf8();
+    appendLittleEndian(comments, comment.size());
+    comments.append(comment);
+    ++commentCount;
+}
+
+static inline void appendFlacBlock(QByteArray &data,
+                                   const int &blockType,
+                                   const QByteArray &content,
+                                   const bool &lastBlock)
+{
+    //The first bit of the header is the last metadata block flag.
+    data.append((char)(lastBlock?(blockType | 0x80):blockType));
+    appendBigEndian(data, content.size(), 3);
+    data.append(content);
+}
+
+static inline quint8 flacCrc8(const QByteArray &data)
+{
+    //Polynomial x^8+x^2+x^1+x^0, initialized with 0.
+    quint8 crc=0;
+    for(int i=0; i<data.size(); ++i)
+    {
+        crc^=(quint8)data.at(i);
+        for(int j=0; j<8; ++j)
+        {
+            crc=(crc & 0x80)?((crc<<1)^0x07):(crc<<1);
+        }
+    }
+    return crc;
+}
+
+static inline quint16 flacCrc16(const QByteArray &data)
+{
+    //Polynomial x^16+x^15+x^2+x^0, initialized with 0.
+    quint16 crc=0;
+    for(int i=0; i<data.size(); ++i)
+    {
+        crc^=((quint16)(quint8)data.at(i))<<8;
+        for(int j=0; j<8; ++j)
+        {
+            crc=(crc & 0x8000)?((crc<<1)^0x8005):(crc<<1);
+        }
+    }
+    return crc;
+}
+
+static inline QByteArray m4aBox(const char *name, const QByteArray &content)
+{
+    //The size of the box contains the 8 bytes of the size and the name.
+    QByteArray box;
+    appendBigEndian(box, content.size()+8, 4);
+    box.append(name, 4);
+    box.append(content);
+    return box;
+}
+
+static inline QByteArray m4aDataBox(const quint32 &dataType,
+                                    const QByteArray &value)
+{
+    //The data box has 4 bytes type and 4 bytes locale before the value.
+    QByteArray content;
+    appendBigEndian(content, dataType, 4);
+    appendBigEndian(content, 0, 4);
+    content.append(value);
+    return m4aBox("data", content);
+}
+
+static inline void appendM4AText(QByteArray &items,
+                                 const char *name,
+                                 const QString &value)
+{
+    if(!value.isEmpty())
+    {
+        //Type 1 is the UTF-8 text.
+        items.append(m4aBox(name, m4aDataBox(1, value.toUtf8())));
+    }
+}
+
+static inline int blendChannel(const quint32 &startColor,
+                               const quint32 &endColor,
+                               const int &shift,
+                               const int &position,
+                               const int &noise)
+{
+    //Blend a channel of the colors, the position is 0-255.
+    int start=(startColor>>shift) & 0xFF, end=(endColor>>shift) & 0xFF;
+    return qBound(0, ((start*(256-position)+end*position)>>8)+noise, 255);
+}
+
+static inline QString fileName(const QString &name)
+{
+    //Replace the characters which couldn't be used in the file name.
+    QString result=name;
+    result.replace(QRegExp("[\\\\/:*?\"<>|]"), "_");
+    return result;
+}
+
+static inline QString cueText(const QString &text)
+{
+    //The double quotes couldn't be used in the CUE sheet.
+    return "\""+QString(text).replace('\"', '\'')+"\"";
+}
+
+KNBenchmarkGenerator::KNBenchmarkGenerator(const quint32 &seed) :
+    m_seed(seed),
+    m_state(seed)
+{
+    m_genres<<"Rock"<<"Pop"<<"Jazz"<<"Classical"<<"Electronic"<<"Hip-Hop"
+            <<"Metal"<<"Folk"<<"Soundtrack"<<"Blues"<<"Country"<<"Ambient"
+            <<"R&B"<<"Reggae"<<"J-Pop"<<"Anime";
+}
+
+bool KNBenchmarkGenerator::generate(const QString &folderPath,
+                                    const int &fileCount)
+{
+    //Check the marker of the folder, skip the library which has been generated.
+    QDir folder(folderPath);
+    QFile markerFile(folder.filePath(GeneratorMarker));
+    if(markerFile.open(QIODevice::ReadOnly))
+    {
+        QJsonObject marker=QJsonDocument::fromJson(markerFile.readAll()).object();
+        markerFile.close();
+        if(marker.value("version").toInt()==GeneratorVersion &&
+                marker.value("seed").toDouble()==m_seed &&
+                marker.value("files").toInt()==fileCount)
+        {
+            return true;
+        }
+        //Remove the library which is generated in another way.
+        folder.removeRecursively();
+    }
+    else if(folder.exists() &&
+            !folder.entryList(QDir::AllEntries | QDir::NoDotAndDotDot).isEmpty())
+    {
+        //Never touch the folder which is not generated by us.
+        qWarning()<<folderPath<<"is not empty, and it's not a generated library.";
+        return false;
+    }
+    if(!folder.mkpath(folder.absolutePath()))
+    {
+        return false;
+    }
+    //The libraries in different size are generated from different states.
+    m_state=m_seed^((quint32)fileCount*2654435761U);
+    if(m_state==0)
+    {
+        m_state=1;
+    }
+    //Generate the artists, the count of the artists grows with the library.
+    QStringList artists, usedArtists;
+    int artistCount=qMax(8, fileCount/50);
+    for(int i=0; i<artistCount; ++i)
+    {
+        artists.append(uniqueName(randomName(1, 3), usedArtists));
+    }
+    //Generate the albums until there're enough files.
+    QList<KNBenchmarkTrack> libraryTracks;
+    QStringList usedAlbumFolders;
+    int generatedCount=0;
+    while(generatedCount<fileCount)
+    {
+        //Some artists have much more albums than the others.
+        QString albumArtist=artists.at(random(random(artistCount)+1));
+        //One of ten albums is a compilation.
+        bool compilation=(random(10)==0);
+        if(compilation)
+        {
+            albumArtist="Various Artists";
+        }
+        KNBenchmarkTrack albumTrack;
+        albumTrack.album=randomName(1, 4);
+        albumTrack.albumArtist=albumArtist;
+        albumTrack.genre=m_genres.at(random(m_genres.size()));
+        albumTrack.year=QString::number(1960+random(56));
+        albumTrack.trackCount=8+random(9);
+        //Half of the albums are MP3 with ID3v2, the others are FLAC, M4A, MP3
+        //with APEv2 and FLAC images with CUE sheets.
+        int formatIndex=random(20), albumFormat;
+        if(formatIndex<10)
+        {
+            albumFormat=FormatID3v2;
+        }
+        else if(formatIndex<14)
+        {
+            albumFormat=FormatFLAC;
+        }
+        else if(formatIndex<17)
+        {
+            albumFormat=FormatM4A;
+        }
+        else if(formatIndex<19)
+        {
+            albumFormat=FormatAPEv2;
+        }
+        else
+        {
+            albumFormat=FormatCue;
+        }
+        //The image of the CUE sheet is only one file.
+        if(albumFormat!=FormatCue)
+        {
+            albumTrack.trackCount=qMin(albumTrack.trackCount,
+                                       fileCount-generatedCount);
+        }
+        //Prepare the album folder.
+        QString albumFolderPath=
+                folder.absolutePath()+"/"+fileName(albumArtist)+"/"+
+                uniqueName(fileName(albumTrack.year+" - "+albumTrack.album),
+                           usedAlbumFolders);
+        if(!folder.mkpath(albumFolderPath))
+        {
+            return false;
+        }
+        //All the tracks in the album share the same album art.
+        QByteArray mimeType, art=albumArt(mimeType);
+        //Generate the tracks.
+        QList<KNBenchmarkTrack> albumTracks;
+        for(int i=1; i<=albumTrack.trackCount; ++i)
+        {
+            KNBenchmarkTrack track=albumTrack;
+            track.title=randomName(1, 5);
+            track.artist=compilation?artists.at(random(artistCount)):
+                                     albumArtist;
+            track.trackNumber=i;
+            if(random(2)==0)
+            {
+                track.composer=artists.at(random(artistCount));
+            }
+            if(random(3)==0)
+            {
+                track.comment=randomName(3, 8);
+            }
+            albumTracks.append(track);
+        }
+        //Write the files.
+        if(albumFormat==FormatCue)
+        {
+            QString imageFileName=fileName(albumTrack.album)+".flac";
+            for(QList<KNBenchmarkTrack>::iterator i=albumTracks.begin();
+                i!=albumTracks.end();
+                ++i)
+            {
+                (*i).filePath=albumFolderPath+"/"+imageFileName;
+            }
+            if(!writeFile(albumFolderPath+"/"+imageFileName,
+                          flacFile(albumTrack,
+                                   art,
+                                   mimeType,
+                                   FlacFrameCount*albumTrack.trackCount)) ||
+                    !writeFile(albumFolderPath+"/"+
+                               fileName(albumTrack.album)+".cue",
+                               cueSheet(albumTracks, imageFileName)))
+            {
+                return false;
+            }
+            ++generatedCount;
+        }
+        else
+        {
+            static const char *suffixes[]={".mp3", ".flac", ".m4a", ".mp3"};
+            for(QList<KNBenchmarkTrack>::iterator i=albumTracks.begin();
+                i!=albumTracks.end();
+                ++i)
+            {
+                (*i).filePath=albumFolderPath+"/"+
+                        QString::number((*i).trackNumber).rightJustified(2, '0')+
+                        " "+fileName((*i).title)+suffixes[albumFormat];
+                QByteArray fileData;
+                switch(albumFormat)
+                {
+                case FormatID3v2:
+                    fileData=id3v2Tag(*i, art, mimeType)+
+                            mpegFrames(MpegFrameCount);
+                    break;
+                case FormatFLAC:
+                    fileData=flacFile(*i, art, mimeType, FlacFrameCount);
+                    break;
+                case FormatM4A:
+                    fileData=m4aFile(*i, art, mimeType);
+                    break;
+                case FormatAPEv2:
+                    fileData=mpegFrames(MpegFrameCount)+apev2Tag(*i, art);
+                    break;
+                }
+                if(!writeFile((*i).filePath, fileData))
+                {
+                    return false;
+                }
+            }
+            generatedCount+=albumTracks.size();
+        }
+        libraryTracks.append(albumTracks);
+    }
+    //Write the playlists of the tracks.
+    if(!writePlaylists(folder.absolutePath()+"/Playlists", libraryTracks))
+    {
+        return false;
+    }
+    //Write the marker at last, the library which is not completed will be
+    //generated again.
+    QJsonObject marker;
+    marker.insert("version", GeneratorVersion);
+    marker.insert("seed", (double)m_seed);
+    marker.insert("files", fileCount);
+    return writeFile(folder.filePath(GeneratorMarker),
+                     QJsonDocument(marker).toJson());
+}
+
+inline quint32 KNBenchmarkGenerator::random()
+{
+    //Xorshift, it generates the same numbers on all the platforms.
+    m_state^=m_state<<13;
+    m_state^=m_state>>17;
+    m_state^=m_state<<5;
+    return m_state;
+}
+
+inline int KNBenchmarkGenerator::random(const int &bound)
+{
+    return bound<2?0:(int)(random()%(quint32)bound);
+}
+
+inline QString KNBenchmarkGenerator::randomName(const int &minimumWords,
+                                                const int &maximumWords)
+{
+    //One of eight names is in CJK.
+    if(random(8)==0)
+    {
+        static const QString characters=
+                QString::fromUtf8("星空夜光雨风花海月心梦歌雪樱春秋青蓝白色恋物语"
+                                  "桜の君へ道東京少女世界");
+        QString name;
+        int length=2+random(5);
+        for(int i=0; i<length; ++i)
+        {
+            name.append(characters.at(random(characters.size())));
+        }
+        return name;
+    }
+    QStringList words;
+    int wordCount=minimumWords+random(maximumWords-minimumWords+1);
+    for(int i=0; i<wordCount; ++i)
+    {
+        QString word;
+        int syllableCount=1+random(3);
+        for(int j=0; j<syllableCount; ++j)
+        {
+            word.append(syllables[random(SyllableCount)]);
+        }
+        word[0]=word.at(0).toUpper();
+        words.append(word);
+    }
+    return words.join(' ');
+}
+
+inline QString KNBenchmarkGenerator::uniqueName(const QString &name,
+                                                QStringList &usedNames)
+{
+    QString result=name;
+    for(int i=2; usedNames.contains(result); ++i)
+    {
+        result=name+" "+QString::number(i);
+    }
+    usedNames.append(result);
+    return result;
+}
+
+inline QByteArray KNBenchmarkGenerator::albumArt(QByteArray &mimeType)
+{
+    //Draw a gradient with noisy blocks, so the compressed image has the size
+    //of a real cover.
+    int size=200+random(301);
+    QImage image(size, size, QImage::Format_RGB32);
+    quint32 startColor=random(), endColor=random();
+    for(int y=0; y<size; y+=8)
+    {
+        for(int x=0; x<size; x+=8)
+        {
+            int position=((x+y)<<8)/(size<<1), noise=random(48)-24;
+            QRgb color=qRgb(
+                        blendChannel(startColor, endColor, 16, position, noise),
+                        blendChannel(startColor, endColor, 8, position, noise),
+                        blendChannel(startColor, endColor, 0, position, noise));
+            for(int blockY=y; blockY<qMin(y+8, size); ++blockY)
+            {
+                QRgb *line=(QRgb *)image.scanLine(blockY);
+                for(int blockX=x; blockX<qMin(x+8, size); ++blockX)
+                {
+                    line[blockX]=color;
+                }
+            }
+        }
+    }
+    m_artSize=image.size();
+    //Most of the covers are JPEG, use PNG when the JPEG plugin is missing.
+    QByteArray imageData;
+    QBuffer imageBuffer(&imageData);
+    imageBuffer.open(QIODevice::WriteOnly);
+    if(image.save(&imageBuffer, "JPG", 85))
+    {
+        mimeType="image/jpeg";
+        return imageData;
+    }
+    imageBuffer.close();
+    imageData.clear();
+    imageBuffer.open(QIODevice::WriteOnly);
+    image.save(&imageBuffer, "PNG");
+    mimeType="image/png";
+    return imageData;
+}
+
+inline QByteArray KNBenchmarkGenerator::mpegFrames(const int &frameCount)
+{
+    //MPEG-1 Layer III, 128kbps, 44.1kHz, joint stereo. The frame with zero
+    //side information and main data is silent.
+    QByteArray frame(MpegFrameSize, '\0');
+    frame[0]=(char)0xFF;
+    frame[1]=(char)0xFB;
+    frame[2]=(char)0x90;
+    frame[3]=(char)0x64;
+    QByteArray frames;
+    frames.reserve(frameCount*MpegFrameSize);
+    for(int i=0; i<frameCount; ++i)
+    {
+        frames.append(frame);
+    }
+    return frames;
+}
+
+inline QByteArray KNBenchmarkGenerator::flacFrames(const int &frameCount)
+{
+    QByteArray frames;
+    for(int i=0; i<frameCount; ++i)
+    {
+        //Fixed block size, 4096 samples at 44.1kHz, stereo, 16 bits.
+        QByteArray frame("\xFF\xF8\xC9\x18", 4);
+        //The frame number is coded like UTF-8.
+        if(i<0x80)
+        {
+            frame.append((char)i);
+        }
+        else
+        {
+            frame.append((char)(0xC0 | (i>>6)));
+            frame.append((char)(0x80 | (i & 0x3F)));
+        }
+        frame.append((char)flacCrc8(frame));
+        //Two constant subframes of silence, the header of the subframe is 0
+        //and the value is 16 bits 0.
+        frame.append(6, '\0');
+        appendBigEndian(frame, flacCrc16(frame), 2);
+        frames.append(frame);
+    }
+    return frames;
+}
+
+inline QByteArray KNBenchmarkGenerator::id3v2Tag(const KNBenchmarkTrack &track,
+                                                 const QByteArray &art,
+                                                 const QByteArray &mimeType)
+{
+    QByteArray frames;
+    appendID3v2Frame(frames, "TIT2", id3v2Text(track.title));
+    appendID3v2Frame(frames, "TPE1", id3v2Text(track.artist));
+    appendID3v2Frame(frames, "TALB", id3v2Text(track.album));
+    appendID3v2Frame(frames, "TPE2", id3v2Text(track.albumArtist));
+    appendID3v2Frame(frames, "TCON", id3v2Text(track.genre));
+    appendID3v2Frame(frames, "TYER", id3v2Text(track.year));
+    appendID3v2Frame(frames, "TRCK",
+                     id3v2Text(QString::number(track.trackNumber)+"/"+
+                               QString::number(track.trackCount)));
+    appendID3v2Frame(frames, "TPOS",
+                     id3v2Text(QString::number(track.discNumber)));
+    if(!track.composer.isEmpty())
+    {
+        appendID3v2Frame(frames, "TCOM", id3v2Text(track.composer));
+    }
+    if(!track.comment.isEmpty())
+    {
+        //Encoding, language, the empty description and the text, the
+        //description is terminated in the encoding of the text.
+        QByteArray text=id3v2Text(track.comment), comment(1, text.at(0));
+        comment.append("eng");
+        comment.append(text.at(0)=='\1'?QByteArray("\xFF\xFE\0\0", 4):
+                                         QByteArray(1, '\0'));
+        comment.append(text.mid(1));
+        appendID3v2Frame(frames, "COMM", comment);
+    }
+    //Encoding, MIME type, picture type 3 (front cover), the empty description
+    //and the picture.
+    QByteArray picture(1, '\0');
+    picture.append(mimeType);
+    picture.append('\0');
+    picture.append('\3');
+    picture.append('\0');
+    picture.append(art);
+    appendID3v2Frame(frames, "APIC", picture);
+    //The header, the size of the tag is sync safe.
+    quint32 tagSize=frames.size()+ID3v2Padding;
+    QByteArray tag("ID3\3\0\0", 6);
+    for(int i=3; i>-1; --i)
+    {
+        tag.append((char)((tagSize>>(i*7)) & 0x7F));
+    }
+    tag.append(frames);
+    tag.append(ID3v2Padding, '\0');
+    return tag;
+}
+
+inline QByteArray KNBenchmarkGenerator::apev2Tag(const KNBenchmarkTrack &track,
+                                                 const QByteArray &art)
+{
+    QByteArray items;
+    int itemCount=0;
+    QList<QPair<QString, QString> > textItems;
+    textItems.append(QPair<QString, QString>("Title", track.title));
+    textItems.append(QPair<QString, QString>("Artist", track.artist));
+    textItems.append(QPair<QString, QString>("Album", track.album));
+    textItems.append(QPair<QString, QString>("Album Artist",
+                                             track.albumArtist));
+    textItems.append(QPair<QString, QString>("Genre", track.genre));
+    textItems.append(QPair<QString, QString>("Year", track.year));
+    textItems.append(QPair<QString, QString>(
+                         "Track",
+                         QString::number(track.trackNumber)+"/"+
+                         QString::number(track.trackCount)));
+    textItems.append(QPair<QString, QString>("Composer", track.composer));
+    textItems.append(QPair<QString, QString>("Comment", track.comment));
+    for(QList<QPair<QString, QString> >::iterator i=textItems.begin();
+        i!=textItems.end();
+        ++i)
+    {
+        if(!(*i).second.isEmpty())
+        {
+            appendAPEv2Item(items, (*i).first, (*i).second.toUtf8());
+            ++itemCount;
+        }
+    }
+    //The binary item of the cover is the file name with a '\0' and the image.
+    appendAPEv2Item(items,
+                    "Cover Art (Front)",
+                    QByteArray("cover.jpg\0", 10)+art,
+                    0x02);
+    ++itemCount;
+    //The size of the tag contains the items and the footer. The tag has both
+    //the header and the footer.
+    quint32 tagSize=items.size()+32;
+    return apev2Header(tagSize, itemCount, 0xA0000000)+items+
+            apev2Header(tagSize, itemCount, 0x80000000);
+}
+
+inline QByteArray KNBenchmarkGenerator::flacFile(const KNBenchmarkTrack &track,
+                                                 const QByteArray &art,
+                                                 const QByteArray &mimeType,
+                                                 const int &frameCount)
+{
+    QByteArray data("fLaC");
+    //STREAMINFO: the block sizes, the unknown frame sizes, then 20 bits sample
+    //rate, 3 bits channels-1, 5 bits bits per sample-1, 36 bits samples and
+    //the MD5 which is not calculated.
+    QByteArray streamInfo;
+    appendBigEndian(streamInfo, FlacBlockSize, 2);
+    appendBigEndian(streamInfo, FlacBlockSize, 2);
+    appendBigEndian(streamInfo, 0, 3);
+    appendBigEndian(streamInfo, 0, 3);
+    appendBigEndian(streamInfo,
+                    ((quint64)FlacSampleRate<<44) | ((quint64)1<<41) |
+                    ((quint64)15<<36) | ((quint64)FlacBlockSize*frameCount),
+                    8);
+    streamInfo.append(16, '\0');
+    appendFlacBlock(data, 0, streamInfo, false);
+    //VORBIS_COMMENT: the vendor string, the count of the comments and the
+    //comments.
+    QByteArray comments, vendor("reference libFLAC 1.3.1 20141125");
+    int commentCount=0;
+    appendVorbisComment(comments, commentCount, "TITLE", track.title);
+    //The album image of the CUE sheet only has the album information.
+    appendVorbisComment(comments, commentCount, "ARTIST",
+                        track.title.isEmpty()?track.albumArtist:track.artist);
+    appendVorbisComment(comments, commentCount, "ALBUM", track.album);
+    appendVorbisComment(comments, commentCount, "ALBUMARTIST",
+                        track.albumArtist);
+    appendVorbisComment(comments, commentCount, "GENRE", track.genre);
+    appendVorbisComment(comments, commentCount, "DATE", track.year);
+    if(track.trackNumber>0)
+    {
+        appendVorbisComment(comments, commentCount, "TRACKNUMBER",
+                            QString::number(track.trackNumber));
+        appendVorbisComment(comments, commentCount, "TRACKTOTAL",
+                            QString::number(track.trackCount));
+        appendVorbisComment(comments, commentCount, "DISCNUMBER",
+                            QString::number(track.discNumber));
+    }
+    appendVorbisComment(comments, commentCount, "COMPOSER", track.composer);
+    appendVorbisComment(comments, commentCount, "COMMENT", track.comment);
+    QByteArray vorbisComment;
+    appendLittleEndian(vorbisComment, vendor.size());
+    vorbisComment.append(vendor);
+    appendLittleEndian(vorbisComment, commentCount);
+    vorbisComment.append(comments);
+    appendFlacBlock(data, 4, vorbisComment, false);
+    //PICTURE: picture type 3 (front cover), the MIME type, the empty
+    //description, width, height, depth, indexed colors and the picture.
+    QByteArray picture;
+    appendBigEndian(picture, 3, 4);
+    appendBigEndian(picture, mimeType.size(), 4);
+    picture.append(mimeType);
+    appendBigEndian(picture, 0, 4);
+    appendBigEndian(picture, m_artSize.width(), 4);
+    appendBigEndian(picture, m_artSize.height(), 4);
+    appendBigEndian(picture, 24, 4);
+    appendBigEndian(picture, 0, 4);
+    appendBigEndian(picture, art.size(), 4);
+    picture.append(art);
+    appendFlacBlock(data, 6, picture, true);
+    //The audio frames.
+    data.append(flacFrames(frameCount));
+    return data;
+}
+
+inline QByteArray KNBenchmarkGenerator::m4aFile(const KNBenchmarkTrack &track,
+                                                const QByteArray &art,
+                                                const QByteArray &mimeType)
+{
+    //The iTunes metadata items.
+    QByteArray items;
+    appendM4AText(items, "\xA9" "nam", track.title);
+    appendM4AText(items, "\xA9" "ART", track.artist);
+    appendM4AText(items, "\xA9" "alb", track.album);
+    appendM4AText(items, "aART", track.albumArtist);
+    appendM4AText(items, "\xA9" "gen", track.genre);
+    appendM4AText(items, "\xA9" "day", track.year);
+    appendM4AText(items, "\xA9" "wrt", track.composer);
+    appendM4AText(items, "\xA9" "cmt", track.comment);
+    //The track number: 2 bytes reserved, 2 bytes number, 2 bytes count and 2
+    //bytes reserved.
+    QByteArray trackNumber(2, '\0');
+    appendBigEndian(trackNumber, track.trackNumber, 2);
+    appendBigEndian(trackNumber, track.trackCount, 2);
+    trackNumber.append(2, '\0');
+    items.append(m4aBox("trkn", m4aDataBox(0, trackNumber)));
+    //Type 13 is JPEG, 14 is PNG.
+    items.append(m4aBox("covr",
+                        m4aDataBox(mimeType=="image/png"?14:13, art)));
+    //The meta box: version and flags, the handler and the items.
+    QByteArray handler(8, '\0');
+    handler.append("mdirappl");
+    handler.append(9, '\0');
+    QByteArray meta(4, '\0');
+    meta.append(m4aBox("hdlr", handler));
+    meta.append(m4aBox("ilst", items));
+    //The movie header: version and flags, the times, the 1000 time scale, the
+    //duration, the rate, the volume, the reserved bytes, the matrix, the
+    //pre-defined bytes and the next track ID.
+    QByteArray movieHeader(12, '\0');
+    appendBigEndian(movieHeader, 1000, 4);
+    appendBigEndian(movieHeader, 1000, 4);
+    appendBigEndian(movieHeader, 0x00010000, 4);
+    appendBigEndian(movieHeader, 0x0100, 2);
+    movieHeader.append(10, '\0');
+    static const quint32 matrix[9]={0x00010000, 0, 0,
+                                    0, 0x00010000, 0,
+                                    0, 0, 0x40000000};
+    for(int i=0; i<9; ++i)
+    {
+        appendBigEndian(movieHeader, matrix[i], 4);
+    }
+    movieHeader.append(24, '\0');
+    appendBigEndian(movieHeader, 2, 4);
+    //The file type box, the movie box and the empty media data.
+    QByteArray fileType("M4A ");
+    appendBigEndian(fileType, 0, 4);
+    fileType.append("M4A mp42isom");
+    fileType.append(4, '\0');
+    return m4aBox("ftyp", fileType)+
+            m4aBox("moov",
+                   m4aBox("mvhd", movieHeader)+
+                   m4aBox("udta", m4aBox("meta", meta)))+
+            m4aBox("mdat", QByteArray());
+}
+
+inline QByteArray KNBenchmarkGenerator::cueSheet(
+        const QList<KNBenchmarkTrack> &tracks,
+        const QString &imageFileName)
+{
+    const KNBenchmarkTrack &albumTrack=tracks.first();
+    QString sheet;
+    sheet+="REM GENRE "+cueText(albumTrack.genre)+"\n";
+    sheet+="REM DATE "+albumTrack.year+"\n";
+    sheet+="PERFORMER "+cueText(albumTrack.albumArtist)+"\n";
+    sheet+="TITLE "+cueText(albumTrack.album)+"\n";
+    sheet+="FILE "+cueText(imageFileName)+" WAVE\n";
+    for(int i=0; i<tracks.size(); ++i)
+    {
+        //The index is in minutes, seconds and frames, 75 frames a second.
+        qint64 startFrame=(qint64)i*FlacFrameCount*FlacBlockSize*75/
+                FlacSampleRate;
+        sheet+="  TRACK "+QString::number(i+1).rightJustified(2, '0')+
+                " AUDIO\n";
+        sheet+="    TITLE "+cueText(tracks.at(i).title)+"\n";
+        sheet+="    PERFORMER "+cueText(tracks.at(i).artist)+"\n";
+        sheet+="    INDEX 01 "+
+                QString::number(startFrame/4500).rightJustified(2, '0')+":"+
+                QString::number(startFrame/75%60).rightJustified(2, '0')+":"+
+                QString::number(startFrame%75).rightJustified(2, '0')+"\n";
+    }
+    return sheet.toUtf8();
+}
+
+inline bool KNBenchmarkGenerator::writePlaylists(
+        const QString &folderPath,
+        const QList<KNBenchmarkTrack> &tracks)
+{
+    QDir folder(folderPath);
+    if(tracks.isEmpty() || !folder.mkpath(folderPath))
+    {
+        return false;
+    }
+    int playlistCount=qMax(1, tracks.size()/FilesPerPlaylist),
+        playlistSize=qMin(PlaylistSize, tracks.size());
+    for(int i=0; i<playlistCount; ++i)
+    {
+        QString playlistName=randomName(1, 3);
+        QList<int> trackIndexes;
+        for(int j=0; j<playlistSize; ++j)
+        {
+            trackIndexes.append(random(tracks.size()));
+        }
+        QString baseName=folderPath+"/"+QString::number(i+1)+" "+
+                fileName(playlistName);
+        //M3U, the paths are relative to the playlist.
+        QString m3uContent="#EXTM3U\n";
+        for(QList<int>::iterator j=trackIndexes.begin();
+            j!=trackIndexes.end();
+            ++j)
+        {
+            const KNBenchmarkTrack &track=tracks.at(*j);
+            m3uContent+="#EXTINF:1,"+track.artist+" - "+track.title+"\n";
+            m3uContent+=folder.relativeFilePath(track.filePath)+"\n";
+        }
+        if(!writeFile(baseName+".m3u", m3uContent.toUtf8()))
+        {
+            return false;
+        }
+        //XSPF.
+        QByteArray xspfContent;
+        QXmlStreamWriter xspfWriter(&xspfContent);
+        xspfWriter.setAutoFormatting(true);
+        xspfWriter.writeStartDocument();
+        xspfWriter.writeStartElement("playlist");
+        xspfWriter.writeAttribute("version", "1");
+        xspfWriter.writeAttribute("xmlns", "http://xspf.org/ns/0/");
+        xspfWriter.writeTextElement("title", playlistName);
+        xspfWriter.writeStartElement("trackList");
+        for(QList<int>::iterator j=trackIndexes.begin();
+            j!=trackIndexes.end();
+            ++j)
+        {
+            const KNBenchmarkTrack &track=tracks.at(*j);
+            xspfWriter.writeStartElement("track");
+            xspfWriter.writeTextElement(
+                        "location",
+                        QUrl::fromLocalFile(track.filePath).toString());
+            xspfWriter.writeTextElement("title", track.title);
+            xspfWriter.writeTextElement("creator", track.artist);
+            xspfWriter.writeTextElement("album", track.album);
+            xspfWriter.writeTextElement("trackNum",
+                                        QString::number(track.trackNumber));
+            xspfWriter.writeEndElement();
+        }
+        xspfWriter.writeEndElement();
+        xspfWriter.writeEndElement();
+        xspfWriter.writeEndDocument();
+        if(!writeFile(baseName+".xspf", xspfContent))
+        {
+            return false;
+        }
+        //iTunes XML, the tracks dict and a playlist refers to the track IDs.
+        QByteArray plistContent;
+        QXmlStreamWriter plistWriter(&plistContent);
+        plistWriter.setAutoFormatting(true);
+        plistWriter.writeStartDocument();
+        plistWriter.writeDTD("<!DOCTYPE plist PUBLIC \"-//Apple Computer//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">");
+        plistWriter.writeStartElement("plist");
+        plistWriter.writeAttribute("version", "1.0");
+        plistWriter.writeStartElement("dict");
+        plistWriter.writeTextElement("key", "Major Version");
+        plistWriter.writeTextElement("integer", "1");
+        plistWriter.writeTextElement("key", "Minor Version");
+        plistWriter.writeTextElement("integer", "1");
+        plistWriter.writeTextElement("key", "Tracks");
+        plistWriter.writeStartElement("dict");
+        QList<int> writtenIndexes;
+        for(QList<int>::iterator j=trackIndexes.begin();
+            j!=trackIndexes.end();
+            ++j)
+        {
+            if(writtenIndexes.contains(*j))
+            {
+                continue;
+            }
+            writtenIndexes.append(*j);
+            const KNBenchmarkTrack &track=tracks.at(*j);
+            QString trackID=QString::number(*j+100);
+            plistWriter.writeTextElement("key", trackID);
+            plistWriter.writeStartElement("dict");
+            plistWriter.writeTextElement("key", "Track ID");
+            plistWriter.writeTextElement("integer", trackID);
+            plistWriter.writeTextElement("key", "Name");
+            plistWriter.writeTextElement("string", track.title);
+            plistWriter.writeTextElement("key", "Artist");
+            plistWriter.writeTextElement("string", track.artist);
+            plistWriter.writeTextElement("key", "Album");
+            plistWriter.writeTextElement("string", track.album);
+            plistWriter.writeTextElement("key", "Location");
+            plistWriter.writeTextElement(
+                        "string",
+                        QUrl::fromLocalFile(track.filePath).toString());
+            plistWriter.writeEndElement();
+        }
+        plistWriter.writeEndElement();
+        plistWriter.writeTextElement("key", "Playlists");
+        plistWriter.writeStartElement("array");
+        plistWriter.writeStartElement("dict");
+        plistWriter.writeTextElement("key", "Name");
+        plistWriter.writeTextElement("string", playlistName);
+        plistWriter.writeTextElement("key", "Playlist Items");
+        plistWriter.writeStartElement("array");
+        for(QList<int>::iterator j=trackIndexes.begin();
+            j!=trackIndexes.end();
+            ++j)
+        {
+            plistWriter.writeStartElement("dict");
+            plistWriter.writeTextElement("key", "Track ID");
+            plistWriter.writeTextElement("integer", QString::number(*j+100));
+            plistWriter.writeEndElement();
+        }
+        plistWriter.writeEndElement();
+        plistWriter.writeEndElement();
+        plistWriter.writeEndElement();
+        plistWriter.writeEndElement();
+        plistWriter.writeEndElement();
+        plistWriter.writeEndDocument();
+        if(!writeFile(baseName+".xml", plistContent))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool KNBenchmarkGenerator::writeFile(const QString &filePath,
+                                            const QByteArray &data)
+{
+    QFile targetFile(filePath);
+    if(!targetFile.open(QIODevice::WriteOnly))
+    {
+        qWarning()<<"Failed to write"<<filePath;
+        return false;
+    }
+    bool result=(targetFile.write(data)==data.size());
+    targetFile.close();
+    return result;
+}
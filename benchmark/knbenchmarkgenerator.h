@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNBENCHMARKGENERATOR_H
+#define KNBENCHMARKGENERATOR_H
+
+#include <QStringList>
+#include <QByteArray>
+#include <QSize>
+
+/*
+ * The generator writes a synthetic music library which could be generated
+ * again with the same seed. The library is made of albums in folders:
+ *  * ID3v2.3 tagged MP3 files, the tags of some artists are in UTF-16.
+ *  * FLAC files with Vorbis comments and picture blocks.
+ *  * M4A files with the iTunes metadata.
+ *  * MP3 files with the APEv2 tags.
+ *  * FLAC album images with CUE sheets.
+ * All the albums have embedded album art, and M3U, XSPF and iTunes XML
+ * playlists of the tracks are written to the Playlists folder. The audio
+ * frames are silent and short, only the tags are realistic.
+ */
+
+struct KNBenchmarkTrack
+{
+    QString title;
+    QString artist;
+    QString album;
+    QString albumArtist;
+    QString genre;
+    QString year;
+    QString composer;
+    QString comment;
+    int trackNumber=0;
+    int trackCount=0;
+    int discNumber=1;
+    QString filePath;
+};
+
+class KNBenchmarkGenerator
+{
+public:
+    KNBenchmarkGenerator(const quint32 &seed);
+    //Generate a library with fileCount music files in the folder, the folder
+    //won't be generated again if it's generated with the same seed.
+    bool generate(const QString &folderPath, const int &fileCount);
+
+private:
+    enum AlbumFormats
+    {
+        FormatID3v2,
+        FormatFLAC,
+        FormatM4A,
+        FormatAPEv2,
+        FormatCue,
+        AlbumFormatCount
+    };
+    inline quint32 random();
+    inline int random(const int &bound);
+    inline QString randomName(const int &minimumWords,
+                              const int &maximumWords);
+    inline QString uniqueName(const QString &name, QStringList &usedNames);
+    inline QByteArray albumArt(QByteArray &mimeType);
+    inline QByteArray mpegFrames(const int &frameCount);
+    inline QByteArray flacFrames(const int &frameCount);
+    inline QByteArray id3v2Tag(const KNBenchmarkTrack &track,
+                               const QByteArray &art,
+                               const QByteArray &mimeType);
+    inline QByteArray apev2Tag(const KNBenchmarkTrack &track,
+                               const QByteArray &art);
+    inline QByteArray flacFile(const KNBenchmarkTrack &track,
+                               const QByteArray &art,
+                               const QByteArray &mimeType,
+                               const int &frameCount);
+    inline QByteArray m4aFile(const KNBenchmarkTrack &track,
+                              const QByteArray &art,
+                              const QByteArray &mimeType);
+    inline QByteArray cueSheet(const QList<KNBenchmarkTrack> &tracks,
+                               const QString &imageFileName);
+    inline bool writePlaylists(const QString &folderPath,
+                               const QList<KNBenchmarkTrack> &tracks);
+    inline bool writeFile(const QString &filePath, const QByteArray &data);
+    quint32 m_seed, m_state;
+    QStringList m_genres;
+    //The size of the last generated album art.
+    QSize m_artSize;
+};
+
+#endif // KNBENCHMARKGENERATOR_H
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNBENCHMARKLRCREFERENCE_H
+#define KNBENCHMARKLRCREFERENCE_H
+
+#include <QMap>
+#include <QRegularExpression>
+#include <QStringList>
+
+#include "knmusiclrcparser.h"
+
+/*
+ * The reference is the LRC parser before the single-pass tokenizer, it finds
+ * the frames with a regular expression. The benchmark times both parsers on
+ * the same lyrics and checks that they give the same result. Only the text is
+ * parsed, the file reading and the codec detection are the same in both.
+ */
+
+class KNBenchmarkLRCReference
+{
+public:
+    KNBenchmarkLRCReference();
+    void parseData(const QString &lyricsTextData,
+                   QMap<int, QString> &properties,
+                   QList<qint64> &positions,
+                   QStringList &lyricsText);
+
+private:
+    void parseFrame(const QString &frame,
+                    const QString &lineData,
+                    QList<LRCFrame> &lyricsData,
+                    QMap<int, QString> &properties);
+    static bool frameLessThan(const LRCFrame &frameLeft,
+                              const LRCFrame &frameRight);
+    QRegularExpression m_frameCatch;
+    QStringList m_headerText;
+};
+
+#endif // KNBENCHMARKLRCREFERENCE_H
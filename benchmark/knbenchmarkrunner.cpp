@@ -0,0 +1,742 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+
+#include "knglobal.h"
+#include "knjsondatabase.h"
+#include "knmusicglobal.h"
+#include "knmusiclrcparser.h"
+#include "knmusicmodelassist.h"
+#include "knmusicparser.h"
+#include "knmusicproxymodel.h"
+#include "knmusicsearcher.h"
+
+#include "module/knmusicplugin/plugin/knmusiccueparser/knmusiccueparser.h"
+#include "module/knmusicplugin/plugin/knmusictagid3v1/knmusictagid3v1.h"
+#include "module/knmusicplugin/plugin/knmusictagapev2/knmusictagapev2.h"
+#include "module/knmusicplugin/plugin/knmusictagflac/knmusictagflac.h"
+#include "module/knmusicplugin/plugin/knmusictagid3v2/knmusictagid3v2.h"
+#include "module/knmusicplugin/plugin/knmusictagm4a/knmusictagm4a.h"
+#include "module/knmusicplugin/plugin/knmusictagwma/knmusictagwma.h"
+#include "module/knmusicplugin/plugin/knmusictagid3v2/knmusictagwav.h"
+#ifdef ENABLE_FFMPEG
+#include "module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysiser.h"
+#endif
+#ifdef ENABLE_LIBBASS
+#include "module/knmusicplugin/plugin/knmusicbackendbass/knmusicbassanalysiser.h"
+#endif
+#ifdef ENABLE_FFMPEG_BACKEND
+#include "module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpeg.h"
+#include "module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpegthread.h"
+#include "module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegdecoder.h"
+#endif
+#include "module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarymodel.h"
+#include "module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbummodel.h"
+#include "module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicgenremodel.h"
+
+#include "knbenchmarklrcreference.h"
+
+#include "knbenchmarkrunner.h"
+
+#include <QDebug>
+
+using namespace KNMusic;
+using namespace KNMusicID3v2;
+
+//The library recover sends the rows to the category models in batches.
+#define CategoryBatchSize 1024
+//The unsynchronised tags are saved in this file of the music library folder
+//while they are parsed.
+#define ID3v2CorpusFileName "ID3v2Unsynchronised.tags"
+//The generated lyrics of every track, the lines are 3.18s apart, and every
+//chorus line is shown twice.
+#define LyricsLineCount 40
+#define LyricsLineInterval 3180
+#define LyricsChorusInterval 8
+//Every file is played to the end in the playback stages, only the first files
+//of the library are played.
+#define PlaybackFileCount 200
+
+static inline quint32 syncSafeSize(const char *data)
+{
+    return (((quint32)data[0] & 0x7F)<<21)+(((quint32)data[1] & 0x7F)<<14)+
+           (((quint32)data[2] & 0x7F)<<7)+((quint32)data[3] & 0x7F);
+}
+
+static inline void appendSyncSafe(QByteArray &data, const quint32 &value)
+{
+    for(int i=3; i>-1; --i)
+    {
+        data.append((char)((value>>(i*7)) & 0x7F));
+    }
+}
+
+//Save a 0x00 after every 0xFF, the same as the unsynchronisation of ID3v2.
+static inline QByteArray unsynchronise(const QByteArray &data)
+{
+    QByteArray result;
+    result.reserve(data.size()+(data.size()>>4));
+    for(QByteArray::const_iterator i=data.constBegin();
+        i!=data.constEnd();
+        ++i)
+    {
+        result.append(*i);
+        if((quint8)(*i)==0xFF)
+        {
+            result.append('\0');
+        }
+    }
+    return result;
+}
+
+static inline QString lrcTime(const qint64 &position)
+{
+    return QString("[%1:%2.%3]").arg(position/60000, 2, 10, QChar('0'))
+                                .arg(position/1000%60, 2, 10, QChar('0'))
+                                .arg(position/10%100, 2, 10, QChar('0'));
+}
+
+//Generate the lyrics of the track from its tags. All the lines are different
+//and the text is simplified, so the parsers should give the same result.
+static inline QString lrcText(const KNMusicDetailInfo &detailInfo)
+{
+    QString lyrics="[ti:"+detailInfo.textLists[Name]+"]\n"
+                   "[ar:"+detailInfo.textLists[Artist]+"]\n"
+                   "[al:"+detailInfo.textLists[Album]+"]\n"
+                   "[by:mu-benchmark]\n";
+    QStringList words=(detailInfo.textLists[Name]+' '+
+                       detailInfo.textLists[Artist]+' '+
+                       detailInfo.textLists[Album]).split(' ',
+                                                          QString::SkipEmptyParts);
+    if(words.isEmpty())
+    {
+        words.append("la");
+    }
+    for(int i=0; i<LyricsLineCount; ++i)
+    {
+        qint64 position=LyricsLineInterval*(i+1);
+        lyrics.append(lrcTime(position));
+        //The chorus is shown again half a line later.
+        if(i%LyricsChorusInterval==0)
+        {
+            lyrics.append(lrcTime(position+(LyricsLineInterval>>1)));
+        }
+        lyrics.append(words.at(i%words.size())+' '+
+                      words.at((i*7+3)%words.size())+' '+
+                      QString::number(i)+'\n');
+    }
+    return lyrics;
+}
+
+//Read the frame IDs and the contents of the ID3v2.3 tag of the file.
+static inline bool readID3v2Frames(const QString &filePath,
+                                   QList<QPair<QByteArray, QByteArray> > &frames)
+{
+    QFile musicFile(filePath);
+    if(!musicFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    QByteArray header=musicFile.read(10);
+    if(header.size()<10 || !header.startsWith("ID3") || header.at(3)!=3)
+    {
+        return false;
+    }
+    QByteArray tagData=musicFile.read(syncSafeSize(header.constData()+6));
+    musicFile.close();
+    int position=0;
+    while(position+10<=tagData.size() && tagData.at(position)!='\0')
+    {
+        const char *frameHeader=tagData.constData()+position;
+        quint32 frameSize=(((quint32)(quint8)frameHeader[4])<<24)+
+                          (((quint32)(quint8)frameHeader[5])<<16)+
+                          (((quint32)(quint8)frameHeader[6])<<8)+
+                          ((quint32)(quint8)frameHeader[7]);
+        if(frameSize>(quint32)(tagData.size()-position-10))
+        {
+            break;
+        }
+        frames.append(qMakePair(QByteArray(frameHeader, 4),
+                                tagData.mid(position+10, frameSize)));
+        position+=10+frameSize;
+    }
+    return !frames.isEmpty();
+}
+
+KNBenchmarkRunner::KNBenchmarkRunner()
+{
+    //Install the parsers in the same way as the music plugin.
+    m_parser=new KNMusicParser;
+    m_parser->installListParser(new KNMusicCueParser);
+    m_parser->installTagParser(new KNMusicTagID3v1);
+    m_parser->installTagParser(new KNMusicTagAPEv2);
+    m_parser->installTagParser(new KNMusicTagFLAC);
+    m_parser->installTagParser(new KNMusicTagID3v2);
+    m_parser->installTagParser(new KNMusicTagM4A);
+    m_parser->installTagParser(new KNMusicTagWMA);
+    m_parser->installTagParser(new KNMusicTagWAV);
+    //The ID3v2 stages use their own parser.
+    m_id3v2=new KNMusicTagID3v2;
+    m_lrcParser=new KNMusicLRCParser;
+    m_lrcReference=new KNBenchmarkLRCReference;
+#ifdef ENABLE_FFMPEG
+    m_parser->installAnalysiser(new KNMusicFFMpegAnalysiser);
+#endif
+#ifdef ENABLE_LIBBASS
+    m_parser->installAnalysiser(new KNMusicBassAnalysiser);
+#endif
+#ifdef ENABLE_FFMPEG_BACKEND
+    //Drop the samples as soon as they are decoded, the time of the playback
+    //stages is the time of the decoding.
+    m_backend=new KNMusicBackendFFMpeg(0, KNMusicBackendFFMpeg::NullSink);
+#endif
+    //The database is saved in the music library folder of the benchmark.
+    m_databasePath=KNMusicGlobal::musicLibraryPath()+"/Library/Music.db";
+}
+
+KNBenchmarkRunner::~KNBenchmarkRunner()
+{
+    delete m_parser;
+    delete m_id3v2;
+    delete m_lrcParser;
+    delete m_lrcReference;
+#ifdef ENABLE_FFMPEG_BACKEND
+    delete m_backend;
+#endif
+}
+
+QJsonObject KNBenchmarkRunner::run(const QString &libraryPath,
+                                   const int &repeatCount)
+{
+    //Clear the samples of the last library.
+    m_samples.clear();
+    m_items.clear();
+    for(int i=0; i<repeatCount; ++i)
+    {
+        runStages(libraryPath);
+    }
+    //Calculate the statistics of the stages.
+    QJsonObject stages;
+    for(QMap<QString, QList<qreal> >::iterator i=m_samples.begin();
+        i!=m_samples.end();
+        ++i)
+    {
+        QList<qreal> samples=i.value();
+        QJsonArray sampleArray;
+        for(QList<qreal>::iterator j=samples.begin(); j!=samples.end(); ++j)
+        {
+            sampleArray.append(*j);
+        }
+        std::sort(samples.begin(), samples.end());
+        int middle=samples.size()>>1;
+        QJsonObject stage;
+        stage.insert("items", m_items.value(i.key()));
+        stage.insert("milliseconds", sampleArray);
+        stage.insert("minimum", samples.first());
+        stage.insert("median", (samples.size() & 1)?
+                         samples.at(middle):
+                         (samples.at(middle-1)+samples.at(middle))/2.0);
+        stages.insert(i.key(), stage);
+    }
+    return stages;
+}
+
+inline void KNBenchmarkRunner::runStages(const QString &libraryPath)
+{
+    QElapsedTimer timer;
+    KNMusicGlobal *musicGlobal=KNMusicGlobal::instance();
+    //Walk the library folder.
+    KNMusicSearcher searcher;
+    QStringList filePaths;
+    QObject::connect(&searcher, &KNMusicSearcher::fileFound,
+                     [&filePaths](const QString &filePath)
+                     {
+                         filePaths.append(filePath);
+                     });
+    timer.start();
+    searcher.analysisUrls(QStringList(libraryPath));
+    record("walk", timer.nsecsElapsed(), filePaths.size());
+    //Decode the ID3v2 tags of the MP3 files.
+    runID3v2Stages(filePaths);
+    //Parse the files, the album art is decoded right after the file is
+    //parsed, so the compressed images of the whole library are never kept.
+    QList<KNMusicDetailInfo> detailInfos;
+    qint64 parseTime=0, albumArtTime=0;
+    int albumArtCount=0;
+    for(QStringList::iterator i=filePaths.begin(); i!=filePaths.end(); ++i)
+    {
+        QList<KNMusicAnalysisItem> analysisItems;
+        timer.start();
+        if(musicGlobal->isMusicListFile(QFileInfo(*i).suffix().toLower()))
+        {
+            m_parser->parseTrackList(*i, analysisItems);
+        }
+        else
+        {
+            KNMusicAnalysisItem analysisItem;
+            m_parser->parseFile(*i, analysisItem);
+            analysisItems.append(analysisItem);
+        }
+        parseTime+=timer.nsecsElapsed();
+        for(QList<KNMusicAnalysisItem>::iterator j=analysisItems.begin();
+            j!=analysisItems.end();
+            ++j)
+        {
+            timer.start();
+            m_parser->parseAlbumArt(*j);
+            albumArtTime+=timer.nsecsElapsed();
+            if(!(*j).coverImage.isNull())
+            {
+                ++albumArtCount;
+            }
+            detailInfos.append((*j).detailInfo);
+        }
+    }
+    record("parseFile", parseTime, detailInfos.size());
+    record("parseAlbumArt", albumArtTime, albumArtCount);
+    //Parse the lyrics of the tracks.
+    runLRCStages(detailInfos);
+#ifdef ENABLE_FFMPEG_BACKEND
+    //Play the files with the main and the preview player.
+    runPlaybackStages(filePaths);
+#endif
+    //Append the rows to the library model, the database saves itself while
+    //the rows are appended like importing the files.
+    QFile::remove(m_databasePath);
+    {
+        KNJSONDatabase database;
+        database.setDatabaseFile(m_databasePath);
+        KNMusicLibraryModel importModel;
+        importModel.setDatabase(&database);
+        timer.start();
+        for(QList<KNMusicDetailInfo>::iterator i=detailInfos.begin();
+            i!=detailInfos.end();
+            ++i)
+        {
+            importModel.appendMusicRow(KNMusicModelAssist::generateRow(*i));
+        }
+        record("modelAppend", timer.nsecsElapsed(), importModel.rowCount());
+        //Save the whole database. The database is only saved when it's
+        //changed, so touch a row first, the database is written exactly once
+        //whether the change triggers the automatic saving or not.
+        if(database.data().isEmpty())
+        {
+            return;
+        }
+        timer.start();
+        database.replace(0, database.at(0));
+        database.write();
+        record("databaseWrite", timer.nsecsElapsed(), database.data().size());
+    }
+    //Load the database.
+    {
+        KNJSONDatabase database;
+        database.setDatabaseFile(m_databasePath);
+        timer.start();
+        database.read();
+        record("databaseRead", timer.nsecsElapsed(), database.data().size());
+    }
+    //Recover the library model, the database lives in this thread, so the
+    //recover works synchronously.
+    KNJSONDatabase database;
+    database.setDatabaseFile(m_databasePath);
+    KNMusicLibraryModel libraryModel;
+    libraryModel.setDatabase(&database);
+    timer.start();
+    libraryModel.recoverModel();
+    record("recoverModel", timer.nsecsElapsed(), libraryModel.rowCount());
+    //Rebuild the category models from the recovered rows.
+    QList<QList<QStandardItem *> > musicRows;
+    for(int row=0; row<libraryModel.rowCount(); ++row)
+    {
+        QList<QStandardItem *> musicRow;
+        for(int column=0; column<libraryModel.columnCount(); ++column)
+        {
+            musicRow.append(libraryModel.item(row, column));
+        }
+        musicRows.append(musicRow);
+    }
+    KNMusicCategoryModel artistModel;
+    artistModel.setCategoryIndex(Artist);
+    KNMusicAlbumModel albumModel;
+    albumModel.setCategoryIndex(Album);
+    KNMusicGenreModel genreModel;
+    genreModel.setCategoryIndex(Genre);
+    KNMusicCategoryModel *categoryModels[3]={&artistModel,
+                                             &albumModel,
+                                             &genreModel};
+    timer.start();
+    for(int i=0; i<musicRows.size(); i+=CategoryBatchSize)
+    {
+        QList<QList<QStandardItem *> > batchRows=
+                musicRows.mid(i, CategoryBatchSize);
+        for(int j=0; j<3; ++j)
+        {
+            categoryModels[j]->onCategoryRecoverRows(batchRows);
+        }
+    }
+    record("categoryRebuild",
+           timer.nsecsElapsed(),
+           artistModel.rowCount()+albumModel.rowCount()+genreModel.rowCount());
+    //Search the library with the proxy model.
+    if(libraryModel.rowCount()==0)
+    {
+        return;
+    }
+    KNMusicProxyModel proxyModel;
+    proxyModel.setSourceModel(&libraryModel);
+    int middleRow=libraryModel.rowCount()>>1;
+    QString middleTitle=libraryModel.item(middleRow, Name)->text();
+    QList<QPair<QString, QString> > queries;
+    queries.append(QPair<QString, QString>(
+                       "artist",
+                       libraryModel.item(middleRow, Artist)->text()));
+    queries.append(QPair<QString, QString>(
+                       "word",
+                       middleTitle.section(' ', 0, 0)));
+    queries.append(QPair<QString, QString>("syllable", "ka"));
+    queries.append(QPair<QString, QString>(
+                       "year",
+                       libraryModel.item(middleRow, Year)->text()));
+    queries.append(QPair<QString, QString>("nothing", "zqxjv"));
+    for(QList<QPair<QString, QString> >::iterator i=queries.begin();
+        i!=queries.end();
+        ++i)
+    {
+        timer.start();
+        proxyModel.setFilterFixedString((*i).second);
+        int resultCount=proxyModel.rowCount();
+        record("proxySearch."+(*i).first, timer.nsecsElapsed(), resultCount);
+    }
+    proxyModel.setFilterFixedString(QString());
+    //Sort the library with the proxy model.
+    QList<QPair<QString, int> > sortColumns;
+    sortColumns.append(QPair<QString, int>("name", Name));
+    sortColumns.append(QPair<QString, int>("artist", Artist));
+    sortColumns.append(QPair<QString, int>("album", Album));
+    sortColumns.append(QPair<QString, int>("time", Time));
+    sortColumns.append(QPair<QString, int>("dateAdded", DateAdded));
+    for(QList<QPair<QString, int> >::iterator i=sortColumns.begin();
+        i!=sortColumns.end();
+        ++i)
+    {
+        timer.start();
+        proxyModel.sort((*i).second, Qt::AscendingOrder);
+        int resultCount=proxyModel.rowCount();
+        record("proxySort."+(*i).first, timer.nsecsElapsed(), resultCount);
+    }
+}
+
+inline void KNBenchmarkRunner::runID3v2Stages(const QStringList &filePaths)
+{
+    //Collect the text frames, and save the tags again as ID3v2.4 tags, all the
+    //frames of them are unsynchronised.
+    QList<QByteArray> textFrames;
+    QByteArray unsynchronisedTags;
+    int tagCount=0;
+    for(QStringList::const_iterator i=filePaths.constBegin();
+        i!=filePaths.constEnd();
+        ++i)
+    {
+        QList<QPair<QByteArray, QByteArray> > frames;
+        if(QFileInfo(*i).suffix().toLower()!="mp3" ||
+                !readID3v2Frames(*i, frames))
+        {
+            continue;
+        }
+        QByteArray tagFrames;
+        for(QList<QPair<QByteArray, QByteArray> >::iterator j=frames.begin();
+            j!=frames.end();
+            ++j)
+        {
+            if((*j).first.startsWith('T'))
+            {
+                textFrames.append((*j).second);
+            }
+            //ID3v2.4 frame header: frame ID, sync safe size and 2 bytes flags,
+            //the data length indicator is the first 4 bytes of the content.
+            QByteArray content=unsynchronise((*j).second);
+            tagFrames.append((*j).first);
+            appendSyncSafe(tagFrames, content.size()+4);
+            tagFrames.append('\0');
+            tagFrames.append((char)(FrameUnsynchronisation |
+                                    FrameDataLengthIndicator));
+            appendSyncSafe(tagFrames, (*j).second.size());
+            tagFrames.append(content);
+        }
+        unsynchronisedTags.append("ID3\4\0\0", 6);
+        appendSyncSafe(unsynchronisedTags, tagFrames.size());
+        unsynchronisedTags.append(tagFrames);
+        ++tagCount;
+    }
+    if(tagCount==0)
+    {
+        return;
+    }
+    //Decode the text frames.
+    QElapsedTimer timer;
+    int textCount=0;
+    timer.start();
+    for(QList<QByteArray>::iterator i=textFrames.begin();
+        i!=textFrames.end();
+        ++i)
+    {
+        if(!m_id3v2->frameToText(*i).isEmpty())
+        {
+            ++textCount;
+        }
+    }
+    record("id3v2FrameText", timer.nsecsElapsed(), textCount);
+    //Parse the unsynchronised tags from one file, the parser reads the tag at
+    //the current position of the stream, so the tags are read one by one.
+    QFile corpusFile(KNGlobal::ensurePathAvaliable(
+                         KNMusicGlobal::musicLibraryPath())+
+                     "/" ID3v2CorpusFileName);
+    if(!corpusFile.open(QIODevice::WriteOnly))
+    {
+        return;
+    }
+    corpusFile.write(unsynchronisedTags);
+    corpusFile.close();
+    if(!corpusFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    QDataStream corpusStream(&corpusFile);
+    int parsedCount=0;
+    timer.start();
+    for(int i=0; i<tagCount; ++i)
+    {
+        KNMusicAnalysisItem analysisItem;
+        if(!m_id3v2->praseTag(corpusFile, corpusStream, analysisItem))
+        {
+            break;
+        }
+        ++parsedCount;
+    }
+    record("id3v2Unsynchronisation", timer.nsecsElapsed(), parsedCount);
+    corpusFile.remove();
+}
+
+inline void KNBenchmarkRunner::runLRCStages(
+        const QList<KNMusicDetailInfo> &detailInfos)
+{
+    if(detailInfos.isEmpty())
+    {
+        return;
+    }
+    QStringList lyricsList;
+    for(QList<KNMusicDetailInfo>::const_iterator i=detailInfos.constBegin();
+        i!=detailInfos.constEnd();
+        ++i)
+    {
+        lyricsList.append(lrcText(*i));
+    }
+    //Parse the lyrics with the LRC parser, keep the results for checking.
+    QElapsedTimer timer;
+    QList<QList<qint64> > parsedPositions;
+    QList<QStringList> parsedTexts;
+    int lineCount=0;
+    timer.start();
+    for(QStringList::iterator i=lyricsList.begin(); i!=lyricsList.end(); ++i)
+    {
+        QMap<int, QString> properties;
+        QList<qint64> positions;
+        QStringList lyricsText;
+        m_lrcParser->parseData(*i, properties, positions, lyricsText);
+        lineCount+=positions.size();
+        parsedPositions.append(positions);
+        parsedTexts.append(lyricsText);
+    }
+    record("lrcParse", timer.nsecsElapsed(), lineCount);
+    //Parse the same lyrics with the reference.
+    QList<QList<qint64> > referencePositions;
+    QList<QStringList> referenceTexts;
+    lineCount=0;
+    timer.start();
+    for(QStringList::iterator i=lyricsList.begin(); i!=lyricsList.end(); ++i)
+    {
+        QMap<int, QString> properties;
+        QList<qint64> positions;
+        QStringList lyricsText;
+        m_lrcReference->parseData(*i, properties, positions, lyricsText);
+        lineCount+=positions.size();
+        referencePositions.append(positions);
+        referenceTexts.append(lyricsText);
+    }
+    record("lrcParseReference", timer.nsecsElapsed(), lineCount);
+    //The time is useless if the parser gives a different result.
+    int differentCount=0;
+    for(int i=0; i<lyricsList.size(); ++i)
+    {
+        if(parsedPositions.at(i)!=referencePositions.at(i) ||
+                parsedTexts.at(i)!=referenceTexts.at(i))
+        {
+            ++differentCount;
+        }
+    }
+    if(differentCount>0)
+    {
+        qWarning()<<"The LRC parser differs from the reference on"
+                  <<differentCount<<"lyrics.";
+    }
+}
+
+#ifdef ENABLE_FFMPEG_BACKEND
+inline void KNBenchmarkRunner::runPlaybackStages(const QStringList &filePaths)
+{
+    //Play the music files, the CUE sheets are skipped.
+    KNMusicGlobal *musicGlobal=KNMusicGlobal::instance();
+    QStringList playFiles;
+    for(QStringList::const_iterator i=filePaths.constBegin();
+        i!=filePaths.constEnd() && playFiles.size()<PlaybackFileCount;
+        ++i)
+    {
+        if(!musicGlobal->isMusicListFile(QFileInfo(*i).suffix().toLower()))
+        {
+            playFiles.append(*i);
+        }
+    }
+    if(playFiles.isEmpty())
+    {
+        return;
+    }
+    runPlaybackStage("playbackMain", playFiles, false);
+    runPlaybackStage("playbackPreview", playFiles, true);
+}
+
+inline void KNBenchmarkRunner::runPlaybackStage(const QString &stage,
+                                                const QStringList &filePaths,
+                                                const bool &preview)
+{
+    //A file is done when it's finished or it can't be played.
+    bool done=false;
+    auto onDone=[&done]
+                {
+                    done=true;
+                };
+    QList<QMetaObject::Connection> connections;
+    if(preview)
+    {
+        connections.append(QObject::connect(m_backend,
+                                            &KNMusicBackend::previewFinished,
+                                            onDone));
+        connections.append(QObject::connect(m_backend,
+                                            &KNMusicBackend::previewCannotLoad,
+                                            onDone));
+    }
+    else
+    {
+        connections.append(QObject::connect(m_backend,
+                                            &KNMusicBackend::finished,
+                                            onDone));
+        connections.append(QObject::connect(m_backend,
+                                            &KNMusicBackend::cannotLoad,
+                                            onDone));
+    }
+    QElapsedTimer timer;
+    qint64 decodedFrames=0, decodeTime=0, firstFrameTime=0;
+    int playedCount=0;
+    for(QStringList::const_iterator i=filePaths.constBegin();
+        i!=filePaths.constEnd();
+        ++i)
+    {
+        done=false;
+        timer.start();
+        //The preview thread is only known after the file is loaded, it may be
+        //one of the cached threads.
+        KNMusicBackendFFMpegThread *thread;
+        if(preview)
+        {
+            m_backend->loadPreview(*i);
+            thread=m_backend->previewThread();
+        }
+        else
+        {
+            m_backend->loadMusic(*i);
+            thread=m_backend->mainThread();
+        }
+        //The counters of the decoder are only changed while decoding.
+        KNMusicFFMpegDecoder *decoder=thread->decoder();
+        qint64 startFrames=decoder->decodedFrames(),
+               startTime=decoder->decodeNanoseconds(),
+               firstFrame=-1;
+        if(preview)
+        {
+            m_backend->playPreview();
+        }
+        else
+        {
+            m_backend->play();
+        }
+        //The sinks and the position updater run in the event loop.
+        while(!done)
+        {
+            QCoreApplication::processEvents();
+            if(firstFrame==-1 && thread->position()>0)
+            {
+                firstFrame=timer.nsecsElapsed();
+            }
+        }
+        //The decoder has been stopped when the playing is finished.
+        decodedFrames+=decoder->decodedFrames()-startFrames;
+        decodeTime+=decoder->decodeNanoseconds()-startTime;
+        if(firstFrame!=-1)
+        {
+            firstFrameTime+=firstFrame;
+            ++playedCount;
+        }
+    }
+    for(QList<QMetaObject::Connection>::iterator i=connections.begin();
+        i!=connections.end();
+        ++i)
+    {
+        QObject::disconnect(*i);
+    }
+    if(preview)
+    {
+        m_backend->resetPreviewPlayer();
+    }
+    else
+    {
+        m_backend->resetMainPlayer();
+    }
+    record(stage+".decode", decodeTime, (int)decodedFrames);
+    record(stage+".firstFrame", firstFrameTime, playedCount);
+    if(playedCount<filePaths.size())
+    {
+        qWarning()<<filePaths.size()-playedCount<<"files can't be played by"
+                  <<stage;
+    }
+}
+#endif
+
+inline void KNBenchmarkRunner::record(const QString &stage,
+                                      const qint64 &nanoseconds,
+                                      const int &items)
+{
+    m_samples[stage].append(nanoseconds/1000000.0);
+    m_items.insert(stage, items);
+}
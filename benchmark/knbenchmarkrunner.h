@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNBENCHMARKRUNNER_H
+#define KNBENCHMARKRUNNER_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QStringList>
+
+#include "knmusicglobal.h"
+
+/*
+ * The runner times the headless stages of the library import and recovery in
+ * the order of the player:
+ *  * walk: search the music files with KNMusicSearcher.
+ *  * id3v2FrameText: decode the text frames of the ID3v2 tags in the library.
+ *  * id3v2Unsynchronisation: parse the same tags saved as ID3v2.4 tags, all
+ *    the frames are unsynchronised and have a data length indicator.
+ *  * parseFile: parse the tags of the files and the CUE sheets.
+ *  * parseAlbumArt: decode the embedded album art.
+ *  * lrcParse/lrcParseReference: parse the generated lyrics of the tracks with
+ *    the LRC parser and the old regular expression parser.
+ *  * modelAppend: append the rows to the library model and the database.
+ *  * databaseWrite/databaseRead: save and load the JSON database.
+ *  * recoverModel: recover the library model from the database.
+ *  * categoryRebuild: rebuild the artist, album and genre models.
+ *  * proxySearch.*: search the library with the proxy model.
+ *  * proxySort.*: sort the library with the proxy model.
+ *  * playbackMain.*/playbackPreview.*: play the first files of the library to
+ *    the end with the main and the preview player of the FFMpeg backend, the
+ *    samples are dropped by the null sink as fast as they are decoded. The
+ *    decode stage counts the decoded frames, the firstFrame stage counts the
+ *    played files, and its time is from loading the file to the first played
+ *    frame. They are only run when the FFMpeg backend is enabled.
+ * All the stages run in the calling thread, so the time doesn't depend on the
+ * scheduling of the threads. Only the decoder of the playback stages has its
+ * own thread, like the player.
+ */
+
+class KNMusicParser;
+class KNMusicTagID3v2;
+class KNMusicLRCParser;
+class KNBenchmarkLRCReference;
+class KNMusicBackendFFMpeg;
+class KNBenchmarkRunner
+{
+public:
+    KNBenchmarkRunner();
+    ~KNBenchmarkRunner();
+    //Run all the stages on the library for repeatCount times, returns the
+    //samples and the statistics of all the stages.
+    QJsonObject run(const QString &libraryPath, const int &repeatCount);
+
+private:
+    inline void runStages(const QString &libraryPath);
+    inline void runID3v2Stages(const QStringList &filePaths);
+    inline void runLRCStages(const QList<KNMusicDetailInfo> &detailInfos);
+#ifdef ENABLE_FFMPEG_BACKEND
+    inline void runPlaybackStages(const QStringList &filePaths);
+    inline void runPlaybackStage(const QString &stage,
+                                 const QStringList &filePaths,
+                                 const bool &preview);
+#endif
+    inline void record(const QString &stage,
+                       const qint64 &nanoseconds,
+                       const int &items);
+    KNMusicParser *m_parser;
+    KNMusicTagID3v2 *m_id3v2;
+    KNMusicLRCParser *m_lrcParser;
+    KNBenchmarkLRCReference *m_lrcReference;
+#ifdef ENABLE_FFMPEG_BACKEND
+    KNMusicBackendFFMpeg *m_backend;
+#endif
+    QString m_databasePath;
+    QMap<QString, QList<qreal> > m_samples;
+    QMap<QString, int> m_items;
+};
+
+#endif // KNBENCHMARKRUNNER_H
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include "knmusicglobal.h"
+#include "kntrace.h"
+
+#include "knbenchmarkgenerator.h"
+#include "knbenchmarkrunner.h"
+
+#include <QDebug>
+
+//Change the seed will generate all the libraries again.
+#define DefaultSeed 20150419
+#define DefaultRepeat 3
+//Change the version when the format of the result is changed.
+#define ResultVersion 1
+
+int main(int argc, char *argv[])
+{
+    //The music global and the models need the widgets, run the benchmark
+    //without a display if no platform is specified.
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("mu-benchmark");
+    //Parse the arguments.
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                "Time the music library stages of Mu on synthetic libraries.");
+    parser.addHelpOption();
+    QCommandLineOption sizesOption(
+                "sizes",
+                "The file counts of the libraries, separated by commas.",
+                "counts",
+                "1000,10000,100000");
+    QCommandLineOption workOption(
+                "work-dir",
+                "The folder of the generated libraries and the database.",
+                "path",
+                QDir::tempPath()+"/mu-benchmark");
+    QCommandLineOption outputOption(
+                "output",
+                "The JSON file of the result, it's printed when it's not set.",
+                "file");
+    QCommandLineOption repeatOption(
+                "repeat",
+                "How many times the stages run on each library.",
+                "count",
+                QString::number(DefaultRepeat));
+    QCommandLineOption seedOption(
+                "seed",
+                "The seed of the generated libraries.",
+                "seed",
+                QString::number(DefaultSeed));
+    parser.addOption(sizesOption);
+    parser.addOption(workOption);
+    parser.addOption(outputOption);
+    parser.addOption(repeatOption);
+    parser.addOption(seedOption);
+#ifdef ENABLE_TRACE
+    QCommandLineOption traceOption(
+                "trace",
+                "The Chrome trace file of the stages.",
+                "file");
+    parser.addOption(traceOption);
+#endif
+    parser.process(app);
+    bool repeatOk, seedOk;
+    int repeatCount=parser.value(repeatOption).toInt(&repeatOk);
+    quint32 seed=parser.value(seedOption).toUInt(&seedOk);
+    if(!repeatOk || repeatCount<1 || !seedOk)
+    {
+        qCritical()<<"The repeat count and the seed must be positive numbers.";
+        return EXIT_FAILURE;
+    }
+    QList<int> fileCounts;
+    QStringList sizeList=parser.value(sizesOption).split(',',
+                                                         QString::SkipEmptyParts);
+    for(QStringList::iterator i=sizeList.begin(); i!=sizeList.end(); ++i)
+    {
+        bool sizeOk;
+        int fileCount=(*i).trimmed().toInt(&sizeOk);
+        if(!sizeOk || fileCount<1)
+        {
+            qCritical()<<"Invalid library size:"<<*i;
+            return EXIT_FAILURE;
+        }
+        fileCounts.append(fileCount);
+    }
+    QDir workDir(parser.value(workOption));
+    if(!workDir.mkpath(workDir.absolutePath()))
+    {
+        qCritical()<<"Failed to create"<<workDir.absolutePath();
+        return EXIT_FAILURE;
+    }
+    //Never touch the library of the user, the database of the benchmark is
+    //saved in the work folder.
+    KNMusicGlobal::instance();
+    KNMusicGlobal::setMusicLibraryPath(workDir.absoluteFilePath("Music"));
+    //Generate the libraries and run the stages on them.
+    KNBenchmarkGenerator generator(seed);
+    KNBenchmarkRunner runner;
+    //The progress is printed to stderr, the result could be printed to stdout.
+    QTextStream progressStream(stderr);
+    QJsonArray libraries;
+    for(QList<int>::iterator i=fileCounts.begin(); i!=fileCounts.end(); ++i)
+    {
+        QString libraryPath=
+                workDir.absoluteFilePath("Library-"+QString::number(*i));
+        progressStream<<"Generating "<<*i<<" files in "<<libraryPath<<endl;
+        if(!generator.generate(libraryPath, *i))
+        {
+            qCritical()<<"Failed to generate the library"<<libraryPath;
+            return EXIT_FAILURE;
+        }
+        progressStream<<"Running the stages on "<<libraryPath<<endl;
+        QJsonObject library;
+        library.insert("files", *i);
+        library.insert("stages", runner.run(libraryPath, repeatCount));
+        libraries.append(library);
+    }
+    //Output the result.
+    QJsonObject result;
+    result.insert("version", ResultVersion);
+    result.insert("seed", (double)seed);
+    result.insert("repeat", repeatCount);
+    result.insert("qt", QString(qVersion()));
+    result.insert("date",
+                  QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    result.insert("libraries", libraries);
+    QByteArray resultData=QJsonDocument(result).toJson();
+    QFile resultFile;
+    if(parser.isSet(outputOption))
+    {
+        resultFile.setFileName(parser.value(outputOption));
+        if(!resultFile.open(QIODevice::WriteOnly))
+        {
+            qCritical()<<"Failed to write"<<parser.value(outputOption);
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        resultFile.open(stdout, QIODevice::WriteOnly);
+    }
+    resultFile.write(resultData);
+    resultFile.close();
+#ifdef ENABLE_TRACE
+    if(parser.isSet(traceOption) && !KNTrace::dump(parser.value(traceOption)))
+    {
+        qCritical()<<"Failed to write"<<parser.value(traceOption);
+        return EXIT_FAILURE;
+    }
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QBuffer>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThreadPool>
+
+#include "knhashpixmaplist.h"
+#include "knjsondatabase.h"
+#include "knmusicmodelassist.h"
+#include "knmusicparser.h"
+#include "knmusicsearcher.h"
+#include "kntrace.h"
+
+#include "module/knmusicplugin/plugin/knmusiccueparser/knmusiccueparser.h"
+#include "module/knmusicplugin/plugin/knmusictagid3v1/knmusictagid3v1.h"
+#include "module/knmusicplugin/plugin/knmusictagapev2/knmusictagapev2.h"
+#include "module/knmusicplugin/plugin/knmusictagflac/knmusictagflac.h"
+#include "module/knmusicplugin/plugin/knmusictagid3v2/knmusictagid3v2.h"
+#include "module/knmusicplugin/plugin/knmusictagm4a/knmusictagm4a.h"
+#include "module/knmusicplugin/plugin/knmusictagwma/knmusictagwma.h"
+#include "module/knmusicplugin/plugin/knmusictagid3v2/knmusictagwav.h"
+#ifdef ENABLE_FFMPEG
+#include "module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysiser.h"
+#endif
+#ifdef ENABLE_LIBBASS
+#include "module/knmusicplugin/plugin/knmusicbackendbass/knmusicbassanalysiser.h"
+#endif
+#include "module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarymodel.h"
+
+#include "knindexerjob.h"
+
+#include "knindexer.h"
+
+#include <QDebug>
+
+//The progress is printed every ProgressInterval milliseconds while parsing.
+#define ProgressInterval 2000
+
+//The key of a track in the library, it's the same as the library model uses.
+static inline QString trackKey(const KNMusicDetailInfo &detailInfo)
+{
+    return detailInfo.filePath+'\n'+detailInfo.trackFilePath+'\n'+
+            QString::number(detailInfo.trackIndex);
+}
+
+//The seconds of the stage, and the items per second.
+static inline QJsonObject stageStatistics(const qint64 &nanoseconds,
+                                          const int &items)
+{
+    QJsonObject stage;
+    qreal seconds=nanoseconds/1000000000.0;
+    stage.insert("items", items);
+    stage.insert("seconds", seconds);
+    stage.insert("itemsPerSecond", seconds>0.0?items/seconds:0.0);
+    return stage;
+}
+
+KNIndexer::KNIndexer(const QString &libraryPath, const int &threadCount) :
+    m_libraryPath(libraryPath),
+    m_artworkPath(libraryPath+"/Artworks"),
+    m_nextFile(0),
+    m_parsedCount(0),
+    m_artworkCount(0)
+{
+    //The parsers are generated in the main thread, the analysisers may need to
+    //initial the global libraries.
+    for(int i=0; i<threadCount; ++i)
+    {
+        m_parsers.append(generateParser());
+    }
+}
+
+KNIndexer::~KNIndexer()
+{
+    qDeleteAll(m_parsers);
+}
+
+QJsonObject KNIndexer::index(const QStringList &paths)
+{
+    QJsonObject statistics;
+    QElapsedTimer timer, totalTimer;
+    totalTimer.start();
+    //Recover the library model from the existing database. The database lives
+    //in this thread, so the model is recovered synchronously. The database is
+    //only written once after all the rows are appended.
+    KNJSONDatabase database;
+    database.setDatabaseFile(m_libraryPath+"/Music.db");
+    database.setAutoWrite(false);
+    KNMusicLibraryModel libraryModel;
+    libraryModel.setDatabase(&database);
+    timer.start();
+    libraryModel.recoverModel();
+    statistics.insert("recover", stageStatistics(timer.nsecsElapsed(),
+                                                 libraryModel.rowCount()));
+    //The files which are already in the library won't be parsed again.
+    QSet<QString> indexedFiles, trackKeys;
+    for(int row=0; row<libraryModel.rowCount(); ++row)
+    {
+        KNMusicDetailInfo detailInfo;
+        detailInfo.filePath=
+                libraryModel.rowProperty(row, FilePathRole).toString();
+        detailInfo.trackFilePath=
+                libraryModel.rowProperty(row, TrackFileRole).toString();
+        detailInfo.trackIndex=
+                libraryModel.rowProperty(row, TrackIndexRole).toInt();
+        indexedFiles.insert(detailInfo.filePath);
+        if(!detailInfo.trackFilePath.isEmpty())
+        {
+            indexedFiles.insert(detailInfo.trackFilePath);
+        }
+        trackKeys.insert(trackKey(detailInfo));
+    }
+    //Walk all the paths.
+    KNMusicSearcher searcher;
+    QStringList foundPaths;
+    QObject::connect(&searcher, &KNMusicSearcher::fileFound,
+                     [&foundPaths](const QString &filePath)
+                     {
+                         foundPaths.append(filePath);
+                     });
+    timer.start();
+    {
+        KNTraceScope("indexer", "KNIndexer::walk");
+        searcher.analysisUrls(paths);
+    }
+    m_filePaths.clear();
+    for(QStringList::iterator i=foundPaths.begin(); i!=foundPaths.end(); ++i)
+    {
+        if(!indexedFiles.contains(*i))
+        {
+            m_filePaths.append(*i);
+        }
+    }
+    statistics.insert("walk", stageStatistics(timer.nsecsElapsed(),
+                                              foundPaths.size()));
+    statistics.insert("skippedFiles", foundPaths.size()-m_filePaths.size());
+    //Parse the files with all the jobs.
+    QDir().mkpath(m_artworkPath);
+    loadArtworkKeys();
+    m_results=QVector<QList<KNMusicDetailInfo> >(m_filePaths.size());
+    //The jobs write the results of the different files at the same time, use
+    //the data directly, the vector never detaches here.
+    m_resultData=m_results.data();
+    m_nextFile.store(0);
+    m_parsedCount.store(0);
+    m_artworkCount.store(0);
+    timer.start();
+    QThreadPool jobPool;
+    jobPool.setMaxThreadCount(m_parsers.size());
+    for(QList<KNMusicParser *>::iterator i=m_parsers.begin();
+        i!=m_parsers.end();
+        ++i)
+    {
+        jobPool.start(new KNIndexerJob(this, *i));
+    }
+    while(!jobPool.waitForDone(ProgressInterval))
+    {
+        printProgress(m_filePaths.size());
+    }
+    statistics.insert("parse", stageStatistics(timer.nsecsElapsed(),
+                                               m_filePaths.size()));
+    statistics.insert("artworks", m_artworkCount.load());
+    //Append the rows in the order of the files, the same track may be listed
+    //in a track list as well, only the first one is appended.
+    timer.start();
+    QList<QList<QStandardItem *> > musicRows;
+    int duplicateCount=0;
+    for(QVector<QList<KNMusicDetailInfo> >::iterator i=m_results.begin();
+        i!=m_results.end();
+        ++i)
+    {
+        for(QList<KNMusicDetailInfo>::iterator j=(*i).begin();
+            j!=(*i).end();
+            ++j)
+        {
+            QString currentKey=trackKey(*j);
+            if(trackKeys.contains(currentKey))
+            {
+                ++duplicateCount;
+                continue;
+            }
+            trackKeys.insert(currentKey);
+            musicRows.append(KNMusicModelAssist::generateRow(*j));
+        }
+    }
+    m_resultData=nullptr;
+    m_results.clear();
+    if(!musicRows.isEmpty())
+    {
+        libraryModel.insertMusicRows(libraryModel.rowCount(), musicRows);
+    }
+    statistics.insert("append", stageStatistics(timer.nsecsElapsed(),
+                                                musicRows.size()));
+    statistics.insert("duplicateTracks", duplicateCount);
+    //Write the database.
+    timer.start();
+    database.write();
+    statistics.insert("write", stageStatistics(timer.nsecsElapsed(),
+                                               libraryModel.rowCount()));
+    statistics.insert("total", stageStatistics(totalTimer.nsecsElapsed(),
+                                               m_filePaths.size()));
+    statistics.insert("threads", m_parsers.size());
+    return statistics;
+}
+
+int KNIndexer::nextFile()
+{
+    int index=m_nextFile.fetchAndAddRelaxed(1);
+    return index<m_filePaths.size()?index:-1;
+}
+
+QString KNIndexer::filePath(const int &index) const
+{
+    return m_filePaths.at(index);
+}
+
+void KNIndexer::setResult(const int &index,
+                          const QList<KNMusicDetailInfo> &detailInfos)
+{
+    m_resultData[index]=detailInfos;
+    m_parsedCount.ref();
+}
+
+QString KNIndexer::saveArtwork(const QByteArray &imageData)
+{
+    if(imageData.isEmpty())
+    {
+        return QString();
+    }
+    //Get the format from the header of the data, the data which isn't an image
+    //is ignored. The player saves the compressed data in the same way.
+    QBuffer imageBuffer;
+    imageBuffer.setData(imageData);
+    imageBuffer.open(QIODevice::ReadOnly);
+    QString imageFormat=QImageReader::imageFormat(&imageBuffer).toLower();
+    imageBuffer.close();
+    if(imageFormat.isEmpty())
+    {
+        return QString();
+    }
+    //Only the first job which finds the album art saves it.
+    QString imageKey=KNHashPixmapList::imageDataKey(imageData);
+    m_artworkLock.lock();
+    bool saved=m_artworkKeys.contains(imageKey);
+    if(!saved)
+    {
+        m_artworkKeys.insert(imageKey);
+    }
+    m_artworkLock.unlock();
+    if(saved)
+    {
+        return imageKey;
+    }
+    KNTraceScope("indexer", "KNIndexer::saveArtwork");
+    QSaveFile imageFile(m_artworkPath+"/"+imageKey+"."+imageFormat);
+    if(imageFile.open(QIODevice::WriteOnly))
+    {
+        imageFile.write(imageData);
+        if(imageFile.commit())
+        {
+            m_artworkCount.ref();
+        }
+    }
+    return imageKey;
+}
+
+inline KNMusicParser *KNIndexer::generateParser()
+{
+    //Install the parsers in the same way as the music plugin.
+    KNMusicParser *parser=new KNMusicParser;
+    parser->installListParser(new KNMusicCueParser);
+    parser->installTagParser(new KNMusicTagID3v1);
+    parser->installTagParser(new KNMusicTagAPEv2);
+    parser->installTagParser(new KNMusicTagFLAC);
+    parser->installTagParser(new KNMusicTagID3v2);
+    parser->installTagParser(new KNMusicTagM4A);
+    parser->installTagParser(new KNMusicTagWMA);
+    parser->installTagParser(new KNMusicTagWAV);
+#ifdef ENABLE_FFMPEG
+    //The analysiser registers the lock manager of FFMpeg here on the main
+    //thread, so the jobs could open the codecs at the same time.
+    parser->installAnalysiser(new KNMusicFFMpegAnalysiser);
+#endif
+#ifdef ENABLE_LIBBASS
+    parser->installAnalysiser(new KNMusicBassAnalysiser);
+#endif
+    return parser;
+}
+
+inline void KNIndexer::loadArtworkKeys()
+{
+    //The album arts which have been saved are named by their keys.
+    m_artworkKeys.clear();
+    QFileInfoList artworkInfos=QDir(m_artworkPath).entryInfoList(QDir::Files);
+    for(QFileInfoList::iterator i=artworkInfos.begin();
+        i!=artworkInfos.end();
+        ++i)
+    {
+        m_artworkKeys.insert((*i).completeBaseName());
+    }
+}
+
+inline void KNIndexer::printProgress(const int &total)
+{
+    //The progress is always printed to stderr, the report could be printed to
+    //stdout.
+    QTextStream progressStream(stderr);
+    progressStream<<"Parsed "<<m_parsedCount.load()<<" of "<<total<<" files, "
+                  <<m_artworkCount.load()<<" album arts saved."<<endl;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNINDEXER_H
+#define KNINDEXER_H
+
+#include <QAtomicInt>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+#include "knmusicglobal.h"
+
+using namespace KNMusic;
+
+/*
+ * The indexer builds the library folder of the player without any window:
+ *  * Music.db: the library database, the same one as the library model saves.
+ *  * Artworks: the album arts, saved in their original format and named by
+ *    their hash key.
+ * The files are parsed by the jobs on all the cores, every job has its own
+ * parser. The rows are appended to the library model in the order of the
+ * files, so the same files always generate the same database.
+ * The files which are already in the database are skipped, so a library could
+ * be updated by indexing the folders again.
+ */
+
+class KNMusicParser;
+class KNIndexer
+{
+public:
+    KNIndexer(const QString &libraryPath, const int &threadCount);
+    ~KNIndexer();
+    //Index all the files and folders into the library, returns the statistics
+    //of the stages.
+    QJsonObject index(const QStringList &paths);
+
+    //The jobs use the functions below, they are thread safe.
+    //Get the index of the next file to parse, returns -1 when all the files
+    //have been taken.
+    int nextFile();
+    QString filePath(const int &index) const;
+    void setResult(const int &index,
+                   const QList<KNMusicDetailInfo> &detailInfos);
+    //Save the compressed album art to the artwork folder, returns the hash key
+    //of the album art, it's empty when the data is not an image.
+    QString saveArtwork(const QByteArray &imageData);
+
+private:
+    inline KNMusicParser *generateParser();
+    inline void loadArtworkKeys();
+    inline void printProgress(const int &total);
+    QString m_libraryPath, m_artworkPath;
+    QList<KNMusicParser *> m_parsers;
+    QStringList m_filePaths;
+    QVector<QList<KNMusicDetailInfo> > m_results;
+    QList<KNMusicDetailInfo> *m_resultData=nullptr;
+    QAtomicInt m_nextFile, m_parsedCount, m_artworkCount;
+    QMutex m_artworkLock;
+    QSet<QString> m_artworkKeys;
+};
+
+#endif // KNINDEXER_H
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QFileInfo>
+
+#include "knmusicglobal.h"
+#include "knmusicparser.h"
+#include "kntrace.h"
+#include "knindexer.h"
+
+#include "knindexerjob.h"
+
+#include <QDebug>
+
+using namespace KNMusic;
+
+KNIndexerJob::KNIndexerJob(KNIndexer *indexer, KNMusicParser *parser) :
+    QRunnable(),
+    m_indexer(indexer),
+    m_parser(parser)
+{
+}
+
+void KNIndexerJob::run()
+{
+    KNMusicGlobal *musicGlobal=KNMusicGlobal::instance();
+    //Take the files one by one until all the files are taken, so the jobs
+    //which get the small files won't be idle.
+    int index;
+    while((index=m_indexer->nextFile())!=-1)
+    {
+        KNTraceScope("indexer", "KNIndexerJob::parseFile");
+        QString filePath=m_indexer->filePath(index);
+        QList<KNMusicAnalysisItem> analysisItems;
+        if(musicGlobal->isMusicListFile(QFileInfo(filePath).suffix().toLower()))
+        {
+            m_parser->parseTrackList(filePath, analysisItems);
+        }
+        else
+        {
+            KNMusicAnalysisItem analysisItem;
+            m_parser->parseFile(filePath, analysisItem);
+            analysisItems.append(analysisItem);
+        }
+        //Save the album arts right now, only the detail info is kept, so the
+        //images of the whole library are never in the memory.
+        QList<KNMusicDetailInfo> detailInfos;
+        for(QList<KNMusicAnalysisItem>::iterator i=analysisItems.begin();
+            i!=analysisItems.end();
+            ++i)
+        {
+            m_parser->parseAlbumArtData(*i);
+            (*i).detailInfo.coverImageHash=
+                    m_indexer->saveArtwork((*i).coverImageData);
+            detailInfos.append((*i).detailInfo);
+        }
+        m_indexer->setResult(index, detailInfos);
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNINDEXERJOB_H
+#define KNINDEXERJOB_H
+
+#include <QRunnable>
+
+class KNMusicParser;
+class KNIndexer;
+class KNIndexerJob : public QRunnable
+{
+public:
+    //The parser is only used by this job.
+    KNIndexerJob(KNIndexer *indexer, KNMusicParser *parser);
+    void run();
+
+private:
+    KNIndexer *m_indexer;
+    KNMusicParser *m_parser;
+};
+
+#endif // KNINDEXERJOB_H
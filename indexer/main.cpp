@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QThread>
+
+#include "knmusicglobal.h"
+#include "kntrace.h"
+
+#include "knindexer.h"
+
+#include <QDebug>
+
+int main(int argc, char *argv[])
+{
+    //The music global needs the widgets, run the indexer without a display if
+    //no platform is specified.
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("mu-indexer");
+    //Initial the music global before parsing the arguments, the default
+    //library is the one of the player.
+    KNMusicGlobal::instance();
+    //Parse the arguments.
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                "Index the music files into a library of Mu without the "
+                "player.\nThe player shouldn't use the library while indexing.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths",
+                                 "The music files and folders to index.",
+                                 "<paths...>");
+    QCommandLineOption libraryOption(
+                "library",
+                "The library folder, Music.db and the Artworks folder are "
+                "saved in it.",
+                "path",
+                KNMusicGlobal::musicLibraryPath()+"/Library");
+    QCommandLineOption threadsOption(
+                "threads",
+                "How many files are parsed at the same time.",
+                "count",
+                QString::number(qMax(QThread::idealThreadCount(), 1)));
+    QCommandLineOption reportOption(
+                "report",
+                "The JSON file of the statistics, it's printed when it's not "
+                "set.",
+                "file");
+    parser.addOption(libraryOption);
+    parser.addOption(threadsOption);
+    parser.addOption(reportOption);
+#ifdef ENABLE_TRACE
+    QCommandLineOption traceOption(
+                "trace",
+                "The Chrome trace file of the indexing.",
+                "file");
+    parser.addOption(traceOption);
+#endif
+    parser.process(app);
+    bool threadsOk;
+    int threadCount=parser.value(threadsOption).toInt(&threadsOk);
+    if(!threadsOk || threadCount<1)
+    {
+        qCritical()<<"The thread count must be a positive number.";
+        return EXIT_FAILURE;
+    }
+    QStringList paths;
+    QStringList positionalArguments=parser.positionalArguments();
+    for(QStringList::iterator i=positionalArguments.begin();
+        i!=positionalArguments.end();
+        ++i)
+    {
+        QFileInfo pathInfo(*i);
+        if(!pathInfo.exists())
+        {
+            qCritical()<<"Path doesn't exist:"<<*i;
+            return EXIT_FAILURE;
+        }
+        paths.append(pathInfo.absoluteFilePath());
+    }
+    if(paths.isEmpty())
+    {
+        parser.showHelp(EXIT_FAILURE);
+    }
+    QDir libraryDir(parser.value(libraryOption));
+    if(!libraryDir.mkpath(libraryDir.absolutePath()))
+    {
+        qCritical()<<"Failed to create"<<libraryDir.absolutePath();
+        return EXIT_FAILURE;
+    }
+    //Index the paths.
+    QTextStream(stderr)<<"Indexing into "<<libraryDir.absolutePath()<<" with "
+                       <<threadCount<<" threads."<<endl;
+    KNIndexer indexer(libraryDir.absolutePath(), threadCount);
+    QByteArray reportData=QJsonDocument(indexer.index(paths)).toJson();
+    //Output the statistics.
+    QFile reportFile;
+    if(parser.isSet(reportOption))
+    {
+        reportFile.setFileName(parser.value(reportOption));
+        if(!reportFile.open(QIODevice::WriteOnly))
+        {
+            qCritical()<<"Failed to write"<<parser.value(reportOption);
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        reportFile.open(stdout, QIODevice::WriteOnly);
+    }
+    reportFile.write(reportData);
+    reportFile.close();
+#ifdef ENABLE_TRACE
+    if(parser.isSet(traceOption) && !KNTrace::dump(parser.value(traceOption)))
+    {
+        qCritical()<<"Failed to write"<<parser.value(traceOption);
+        return EXIT_FAILURE;
+    }
+#endif
+    return EXIT_SUCCESS;
+}
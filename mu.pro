@@ -16,4 +16,7 @@
 
 TEMPLATE = subdirs
 
-SUBDIRS = src
+SUBDIRS = src \
+          benchmark \
+          indexer \
+          test
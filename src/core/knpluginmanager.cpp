@@ -21,6 +21,7 @@
 
 #include "knglobal.h"
 #include "knversion.h"
+#include "kntrace.h"
 #include "knconfiguremanager.h"
 
 #include "knexpandmainwindow.h"
@@ -158,7 +159,36 @@ void KNPluginManager::processArguments()
     }
     //Ask to process the arguments.
     args.removeFirst();
-    emit requireProcessArguments(args);
+    onActionArgumentsAvailable(args);
+}
+
+void KNPluginManager::onActionArgumentsAvailable(QStringList arguments)
+{
+#ifdef ENABLE_TRACE
+    //Dump the trace when it's asked, "--dump-trace=<file>" could specify the
+    //trace file, or else it's saved in the user data folder.
+    for(auto i=arguments.begin(); i!=arguments.end();)
+    {
+        if((*i)=="--dump-trace" || (*i).startsWith("--dump-trace="))
+        {
+            QString traceFilePath=(*i).mid(13);
+            if(traceFilePath.isEmpty())
+            {
+                traceFilePath=KNGlobal::userDataPath()+"/Trace.json";
+            }
+            KNTrace::dump(traceFilePath);
+            i=arguments.erase(i);
+            continue;
+        }
+        ++i;
+    }
+    //Only the trace is asked.
+    if(arguments.isEmpty())
+    {
+        return;
+    }
+#endif
+    emit requireProcessArguments(arguments);
 }
 
 void KNPluginManager::start()
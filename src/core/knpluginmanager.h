@@ -52,6 +52,8 @@ signals:
     void requireProcessArguments(QStringList arguments);
 
 public slots:
+    //Process the arguments from the command line or the other pattern.
+    void onActionArgumentsAvailable(QStringList arguments);
 
 private slots:
     void onActionMainWindowDestory();
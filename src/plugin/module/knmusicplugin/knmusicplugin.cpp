@@ -23,6 +23,7 @@
 
 //Ports
 #include "knmusicbackend.h"
+#include "knmusicspectrumfeed.h"
 #include "knmusicparser.h"
 #include "knmusiclyricsmanager.h"
 #include "knmusicsearchbase.h"
@@ -48,6 +49,9 @@
 #ifdef ENABLE_PHONON
 #include "plugin/knmusicbackendphonon/knmusicbackendphonon.h"
 #endif
+#ifdef ENABLE_FFMPEG_BACKEND
+#include "plugin/knmusicbackendffmpeg/knmusicbackendffmpeg.h"
+#endif
 
 //Analysiser
 #ifdef ENABLE_LIBBASS
@@ -55,6 +59,11 @@
 #endif
 #ifdef ENABLE_FFMPEG
 #include "plugin/knmusicffmpeganalysiser/knmusicffmpeganalysiser.h"
+#include "plugin/knmusicffmpeganalysiser/knmusicffmpeganalysispool.h"
+#include "plugin/knmusicffmpeganalysiser/knmusicffmpegloudnessscanner.h"
+#include "plugin/knmusicffmpeganalysiser/knmusicffmpegwaveformgenerator.h"
+#include "plugin/knmusicffmpeganalysiser/knmusicffmpegfingerprinter.h"
+#include "plugin/knmusicffmpeganalysiser/knmusicffmpegtemposcanner.h"
 #endif
 
 //Tags
@@ -119,6 +128,17 @@ KNMusicPlugin::KNMusicPlugin(QObject *parent) :
     loadDetailInfo(new KNMusicDetailDialog);
     //Initial parser.
     initialParser();
+    //Initial loudness scanner.
+#ifdef ENABLE_FFMPEG
+    //The analysers share one pool which decodes every track once, the pool
+    //should be deleted before the analysers.
+    KNMusicFFMpegAnalysisPool *analysisPool=new KNMusicFFMpegAnalysisPool;
+    m_pluginList.append(analysisPool);
+    initialLoudnessScanner(new KNMusicFFMpegLoudnessScanner(analysisPool));
+    initialWaveformGenerator(new KNMusicFFMpegWaveformGenerator);
+    initialFingerprinter(new KNMusicFFMpegFingerprinter(analysisPool));
+    initialTempoScanner(new KNMusicFFMpegTempoScanner(analysisPool));
+#endif
     //Initial menus.
     initialSoloMenu(new KNMusicSoloMenu);
     initialMultiMenu(new KNMusicMultiMenu);
@@ -134,6 +154,10 @@ KNMusicPlugin::KNMusicPlugin(QObject *parent) :
 #ifdef ENABLE_PHONON
     loadBackend(new KNMusicBackendPhonon);
 #endif
+#ifdef ENABLE_FFMPEG_BACKEND
+    loadBackend(new KNMusicBackendFFMpeg);
+#endif
+    initialSpectrumFeed(new KNMusicSpectrumFeed);
     loadDetailTooptip(new KNMusicDetailTooltip);
     loadNowPlaying(new KNMusicNowPlaying2);
     initialLyricsManager();
@@ -485,6 +509,52 @@ inline void KNMusicPlugin::initialParser()
     KNMusicGlobal::setParser(parser);
 }
 
+inline void KNMusicPlugin::initialLoudnessScanner(
+        KNMusicLoudnessScanner *scanner)
+{
+    //Add this to plugin list.
+    m_pluginList.append(scanner);
+    //Set the loudness scanner.
+    KNMusicGlobal::setLoudnessScanner(scanner);
+}
+
+inline void KNMusicPlugin::initialWaveformGenerator(
+        KNMusicWaveformGenerator *generator)
+{
+    //Add this to plugin list.
+    m_pluginList.append(generator);
+    //Set the waveform generator.
+    KNMusicGlobal::setWaveformGenerator(generator);
+}
+
+inline void KNMusicPlugin::initialFingerprinter(
+        KNMusicFingerprinter *fingerprinter)
+{
+    //Add this to plugin list.
+    m_pluginList.append(fingerprinter);
+    //Set the fingerprinter.
+    KNMusicGlobal::setFingerprinter(fingerprinter);
+}
+
+inline void KNMusicPlugin::initialTempoScanner(KNMusicTempoScanner *scanner)
+{
+    //Add this to plugin list.
+    m_pluginList.append(scanner);
+    //Set the tempo scanner.
+    KNMusicGlobal::setTempoScanner(scanner);
+}
+
+inline void KNMusicPlugin::initialSpectrumFeed(KNMusicSpectrumFeed *spectrumFeed)
+{
+    //The feed reads the backend in its own thread, so it should be deleted
+    //before the backend.
+    m_pluginList.prepend(spectrumFeed);
+    //Set the backend.
+    spectrumFeed->setBackend(m_backend);
+    //Set the spectrum feed.
+    KNMusicGlobal::setSpectrumFeed(spectrumFeed);
+}
+
 inline void KNMusicPlugin::initialLyricsManager()
 {
     //Initial the lyrics manager.
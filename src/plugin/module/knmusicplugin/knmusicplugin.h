@@ -30,6 +30,11 @@ class KNMusicCategoryTabWidget;
 class KNMusicBackend;
 class KNMusicGlobal;
 class KNMusicParser;
+class KNMusicLoudnessScanner;
+class KNMusicWaveformGenerator;
+class KNMusicSpectrumFeed;
+class KNMusicFingerprinter;
+class KNMusicTempoScanner;
 class KNMusicLyricsManager;
 class KNMusicSearchBase;
 class KNMusicMainPlayerBase;
@@ -93,6 +98,11 @@ private slots:
 private:
     inline void initialInfrastructure();
     inline void initialParser();
+    inline void initialLoudnessScanner(KNMusicLoudnessScanner *scanner);
+    inline void initialWaveformGenerator(KNMusicWaveformGenerator *generator);
+    inline void initialFingerprinter(KNMusicFingerprinter *fingerprinter);
+    inline void initialTempoScanner(KNMusicTempoScanner *scanner);
+    inline void initialSpectrumFeed(KNMusicSpectrumFeed *spectrumFeed);
     inline void initialLyricsManager();
     inline void initialSoloMenu(KNMusicSoloMenuBase *soloMenu);
     inline void initialMultiMenu(KNMusicMultiMenuBase *multiMenu);
@@ -51,13 +51,15 @@ KNMusicBackendBass::KNMusicBackendBass(QObject *parent) :
 
     m_preview=new KNMusicBackendBassThread(this);
     setPreviewThread(m_preview);
+    //Keep the last several previewed files opened.
+    setPreviewCacheSize(4);
 }
 
 KNMusicBackendBass::~KNMusicBackendBass()
 {
     //Free the memory.
     m_main->clear();
-    m_preview->clear();
+    clearPreviewThreads();
     //Close the bass.
     BASS_Free();
 }
@@ -160,6 +162,11 @@ void KNMusicBackendBass::initialPlugin(const QString &pluginDirPath)
     }
 }
 
+KNMusicBackendThread *KNMusicBackendBass::generatePreviewThread()
+{
+    return new KNMusicBackendBassThread(this);
+}
+
 void KNMusicBackendBass::changeVolume(const int &volumeSize)
 {
     BASS_SetConfig(BASS_CONFIG_GVOL_STREAM, volumeSize);
@@ -55,6 +55,7 @@ signals:
 public slots:
 
 protected:
+    KNMusicBackendThread *generatePreviewThread();
     void changeVolume(const int &volumeSize);
     qreal smartVolumeScale() const;
 
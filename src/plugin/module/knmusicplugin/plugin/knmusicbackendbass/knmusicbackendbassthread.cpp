@@ -18,6 +18,7 @@
 #include <QTimer>
 
 #include "knmusicbassglobal.h"
+#include "kntrace.h"
 
 #include "knmusicbackendbassthread.h"
 
@@ -43,6 +44,7 @@ KNMusicBackendBassThread::~KNMusicBackendBassThread()
 
 bool KNMusicBackendBassThread::loadFromFile(const QString &filePath)
 {
+    KNTraceScope("playback", "KNMusicBackendBassThread::loadFromFile");
     //Stop the thread first.
     stop();
     //Release all the sync handle.
@@ -206,7 +208,9 @@ void KNMusicBackendBassThread::play()
             setPosition(0);
             //Set the volume to the last volume, because of the reset, the
             //volume is back to 1.0.
-            BASS_ChannelSetAttribute(m_channel, BASS_ATTRIB_VOL, m_lastVolume);
+            BASS_ChannelSetAttribute(m_channel,
+                                     BASS_ATTRIB_VOL,
+                                     m_lastVolume*m_gain);
         }
         //Play the thread.
         BASS_ChannelPlay(m_channel, FALSE);
@@ -217,11 +221,8 @@ void KNMusicBackendBassThread::play()
 
 int KNMusicBackendBassThread::volume()
 {
-    float channelVolume;
-    BASS_ChannelGetAttribute(m_channel,
-                             BASS_ATTRIB_VOL,
-                             &channelVolume);
-    return (int)channelVolume*100;
+    //The channel volume contains the gain, use the backup volume.
+    return (int)(m_lastVolume*100);
 }
 
 qint64 KNMusicBackendBassThread::duration()
@@ -272,13 +273,66 @@ void KNMusicBackendBassThread::playSection(const qint64 &sectionStart,
 void KNMusicBackendBassThread::setVolume(const int &volumeSize)
 {
     float channelVolume=(float)volumeSize/100;
-    BASS_ChannelSetAttribute(m_channel, BASS_ATTRIB_VOL, channelVolume);
+    BASS_ChannelSetAttribute(m_channel, BASS_ATTRIB_VOL, channelVolume*m_gain);
     //Backup the volume
     m_lastVolume=channelVolume;
 }
 
+void KNMusicBackendBassThread::setGain(const qreal &gain)
+{
+    m_gain=gain;
+    BASS_ChannelSetAttribute(m_channel, BASS_ATTRIB_VOL, m_lastVolume*m_gain);
+}
+
+int KNMusicBackendBassThread::recentSamples(float *samples,
+                                           const int &frameCount)
+{
+    //Only the playing channel has the samples in the playback buffer.
+    if(BASS_ChannelIsActive(m_channel)!=BASS_ACTIVE_PLAYING)
+    {
+        return 0;
+    }
+    BASS_CHANNELINFO channelInfo;
+    if(!BASS_ChannelGetInfo(m_channel, &channelInfo) || channelInfo.chans==0)
+    {
+        return 0;
+    }
+    //The scratch buffer is only resized when the channel count grows.
+    int sampleCount=frameCount*channelInfo.chans;
+    if(m_recentBuffer.size()<sampleCount)
+    {
+        m_recentBuffer.resize(sampleCount);
+    }
+    //Peek the samples which are going to be heard from the playback buffer,
+    //the data won't be removed and nothing will be decoded.
+    DWORD dataSize=BASS_ChannelGetData(m_channel,
+                                       m_recentBuffer.data(),
+                                       (sampleCount*sizeof(float)) |
+                                       BASS_DATA_FLOAT);
+    if(dataSize==(DWORD)-1)
+    {
+        return 0;
+    }
+    int copiedFrames=dataSize/(sizeof(float)*channelInfo.chans);
+    //Mix down to mono.
+    const float *buffer=m_recentBuffer.constData();
+    const float channelScale=1.0/channelInfo.chans;
+    for(int i=0; i<copiedFrames; ++i)
+    {
+        float sample=0.0;
+        for(DWORD j=0; j<channelInfo.chans; ++j)
+        {
+            sample+=buffer[j];
+        }
+        samples[i]=sample*channelScale;
+        buffer+=channelInfo.chans;
+    }
+    return copiedFrames;
+}
+
 void KNMusicBackendBassThread::setPosition(const qint64 &position)
 {
+    KNTraceScope("playback", "KNMusicBackendBassThread::setPosition");
     //If no media, ignore.
     if(m_filePath.isEmpty())
     {
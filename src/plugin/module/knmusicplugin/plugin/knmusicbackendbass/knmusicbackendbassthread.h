@@ -45,6 +45,7 @@ public:
                         const qint64 &sectionDuration=-1);
     void playSection(const qint64 &sectionStart=-1,
                      const qint64 &sectionDuration=-1);
+    int recentSamples(float *samples, const int &frameCount);
 
     bool stoppedState() const;
     void setStoppedState(bool stoppedState);
@@ -55,6 +56,7 @@ signals:
 
 public slots:
     void setVolume(const int &volumeSize);
+    void setGain(const qreal &gain);
     void setPosition(const qint64 &position);
 
 private slots:
@@ -69,7 +71,7 @@ private:
     void releaseSyncHandle();
     void setState(const int &state);
     int m_playingState=StoppedState;
-    float m_lastVolume=1.0;
+    float m_lastVolume=1.0, m_gain=1.0;
     QString m_filePath;
     bool m_stoppedState=true;
     qint64 m_startPosition;   //Unit: millisecond
@@ -78,6 +80,7 @@ private:
     qint64 m_totalDuration;   //Unit: millisecond
     QTimer *m_positionUpdater=nullptr;
     QList<HSYNC> m_syncHandles;
+    QVector<float> m_recentBuffer;
     DWORD m_channel;
 };
 
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QDir>
+
+#include "knffmpegglobal.h"
+#include "knmusicffmpegsink.h"
+#include "knmusicbackendffmpegthread.h"
+
+#include "knmusicbackendffmpeg.h"
+
+KNMusicBackendFFMpeg::KNMusicBackendFFMpeg(QObject *parent,
+                                           const int &sinkType,
+                                           const QString &outputDirPath) :
+    KNMusicStandardBackend(parent),
+    m_outputDirPath(outputDirPath),
+    m_sinkType(sinkType)
+{
+    //Initial the global to make sure the FFMpeg has been instanced.
+    KNFFMpegGlobal::instance();
+    //Initial the main and preview thread.
+    m_main=new KNMusicBackendFFMpegThread(
+                generateSink(sinkType, outputDirPath+"/main.wav"),
+                this);
+    setMainThread(m_main);
+
+    m_preview=new KNMusicBackendFFMpegThread(
+                generateSink(sinkType, outputDirPath+"/preview.wav"),
+                this);
+    setPreviewThread(m_preview);
+    //Keep the last several previewed files opened.
+    setPreviewCacheSize(4);
+}
+
+KNMusicBackendFFMpeg::~KNMusicBackendFFMpeg()
+{
+    //Free the memory.
+    m_main->clear();
+    clearPreviewThreads();
+}
+
+bool KNMusicBackendFFMpeg::available()
+{
+    return true;
+}
+
+int KNMusicBackendFFMpeg::volume() const
+{
+    return m_main->volume();
+}
+
+void KNMusicBackendFFMpeg::loadUrl(const QString &url)
+{
+    ;
+}
+
+int KNMusicBackendFFMpeg::volumeMinimal()
+{
+    return 0;
+}
+
+int KNMusicBackendFFMpeg::volumeMaximum()
+{
+    return 100;
+}
+
+KNMusicBackendFFMpegThread *KNMusicBackendFFMpeg::mainThread()
+{
+    return m_main;
+}
+
+KNMusicBackendFFMpegThread *KNMusicBackendFFMpeg::previewThread()
+{
+    //All the preview threads are generated by this backend.
+    return static_cast<KNMusicBackendFFMpegThread *>(activePreviewThread());
+}
+
+KNMusicBackendThread *KNMusicBackendFFMpeg::generatePreviewThread()
+{
+    //Every cached thread writes its own file in the file sink mode.
+    return new KNMusicBackendFFMpegThread(
+                generateSink(m_sinkType,
+                             m_outputDirPath+"/preview-"+
+                             QString::number(++m_previewThreadCount)+".wav"),
+                this);
+}
+
+void KNMusicBackendFFMpeg::changeVolume(const int &volumeSize)
+{
+    m_main->setVolume(volumeSize);
+}
+
+qreal KNMusicBackendFFMpeg::smartVolumeScale() const
+{
+    return 0.2;
+}
+
+KNMusicFFMpegSink *KNMusicBackendFFMpeg::generateSink(const int &sinkType,
+                                                      const QString &filePath)
+{
+    switch(sinkType)
+    {
+    case AutoSink:
+        //Use the sound card when there's one, or else drop the samples in real
+        //time, this is used on the machines without any sound card.
+        return generateSink(KNMusicFFMpegAudioSink::isDeviceAvailable()?
+                                AudioSink:RealTimeNullSink,
+                            filePath);
+    case AudioSink:
+        return new KNMusicFFMpegAudioSink;
+    case RealTimeNullSink:
+    {
+        KNMusicFFMpegNullSink *sink=new KNMusicFFMpegNullSink;
+        sink->setRealTime(true);
+        return sink;
+    }
+    case FileSink:
+    {
+        KNMusicFFMpegFileSink *sink=new KNMusicFFMpegFileSink;
+        sink->setFilePath(QDir::cleanPath(filePath));
+        return sink;
+    }
+    default:
+    {
+        KNMusicFFMpegNullSink *sink=new KNMusicFFMpegNullSink;
+        sink->setRealTime(false);
+        return sink;
+    }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICBACKENDFFMPEG_H
+#define KNMUSICBACKENDFFMPEG_H
+
+/*
+ * This backend decodes the music with FFMpeg only, the decoded samples are
+ * given to a sink through a lock-free ring buffer. The sink could be the sound
+ * card, or a null/file sink when there's no sound card, e.g. running on a
+ * server or in the tests.
+ */
+
+#include "knmusicstandardbackend.h"
+
+class KNMusicFFMpegSink;
+class KNMusicBackendFFMpegThread;
+class KNMusicBackendFFMpeg : public KNMusicStandardBackend
+{
+    Q_OBJECT
+public:
+    enum SinkType
+    {
+        AutoSink,
+        AudioSink,
+        NullSink,
+        RealTimeNullSink,
+        FileSink
+    };
+    explicit KNMusicBackendFFMpeg(QObject *parent = 0,
+                                  const int &sinkType=AutoSink,
+                                  const QString &outputDirPath=QString());
+    ~KNMusicBackendFFMpeg();
+    bool available();
+    int volume() const;
+
+    void loadUrl(const QString &url);
+
+    int volumeMinimal();
+    int volumeMaximum();
+
+    KNMusicBackendFFMpegThread *mainThread();
+    KNMusicBackendFFMpegThread *previewThread();
+
+signals:
+
+public slots:
+
+protected:
+    KNMusicBackendThread *generatePreviewThread();
+    void changeVolume(const int &volumeSize);
+    qreal smartVolumeScale() const;
+
+private:
+    KNMusicFFMpegSink *generateSink(const int &sinkType,
+                                    const QString &filePath);
+    KNMusicBackendFFMpegThread *m_main, *m_preview;
+    QString m_outputDirPath;
+    int m_sinkType, m_previewThreadCount=0;
+};
+
+#endif // KNMUSICBACKENDFFMPEG_H
@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QTimer>
+
+#include "knmusicffmpegdecoder.h"
+#include "knmusicffmpegringbuffer.h"
+#include "knmusicffmpegsink.h"
+#include "kntrace.h"
+
+#include "knmusicbackendffmpegthread.h"
+
+//The ring buffer holds about half a second of 48kHz audio.
+#define RingBufferFrames 24576
+//The sample rates which most of the sound cards support, the file is
+//resampled to them when the device doesn't support the rate of the file.
+#define FallbackSampleRateCount 2
+static const int fallbackSampleRates[FallbackSampleRateCount]={48000, 44100};
+
+KNMusicBackendFFMpegThread::KNMusicBackendFFMpegThread(KNMusicFFMpegSink *sink,
+                                                       QObject *parent) :
+    KNMusicBackendThread(parent),
+    m_sink(sink)
+{
+    //Take over the sink.
+    m_sink->setParent(this);
+    //Initial the decoder and the ring buffer between decoder and sink.
+    m_decoder=new KNMusicFFMpegDecoder(this);
+    m_ringBuffer=new KNMusicFFMpegRingBuffer(RingBufferFrames,
+                                             m_decoder->channels());
+    m_decoder->setRingBuffer(m_ringBuffer);
+    //Initial position updater.
+    m_positionUpdater=new QTimer(this);
+    m_positionUpdater->setInterval(10);
+    connect(m_positionUpdater, &QTimer::timeout,
+            this, &KNMusicBackendFFMpegThread::onActionPositionCheck);
+}
+
+KNMusicBackendFFMpegThread::~KNMusicBackendFFMpegThread()
+{
+    //Stop the decoder and the sink before the ring buffer is gone.
+    haltPipeline();
+    m_decoder->close();
+    delete m_ringBuffer;
+}
+
+bool KNMusicBackendFFMpegThread::loadFromFile(const QString &filePath)
+{
+    KNTraceScope("playback", "KNMusicBackendFFMpegThread::loadFromFile");
+    //Stop the thread first.
+    stop();
+    //Check is the file the current file.
+    if(filePath==m_filePath)
+    {
+        resetState();
+        //Emit load succeed signal.
+        emit loaded();
+        return true;
+    }
+    //Clear the file path.
+    m_filePath.clear();
+    //Try to load the file.
+    if(!m_decoder->open(filePath))
+    {
+        //Loaded failed, emit cannot load signal.
+        emit cannotLoadFile();
+        return false;
+    }
+    //Backup the file path.
+    m_filePath=filePath;
+    //Emit load succeed.
+    emit loaded();
+    //Change the duration.
+    m_totalDuration=m_decoder->duration();
+    emit durationChanged(m_totalDuration);
+    //Reset the thread.
+    resetState();
+    return true;
+}
+
+void KNMusicBackendFFMpegThread::clear()
+{
+    //Stop decoding and close the file.
+    haltPipeline();
+    m_decoder->close();
+    //Reset thread.
+    m_filePath.clear();
+    //Reset the durations.
+    m_totalDuration=0;
+    //Reset thread data.
+    resetState();
+    //Reset the state to stopped.
+    if(m_playingState!=StoppedState)
+    {
+        m_playingState=StoppedState;
+        emit stateChanged(m_playingState);
+    }
+}
+
+void KNMusicBackendFFMpegThread::resetState()
+{
+    //Set stop flag.
+    m_stoppedState=true;
+    //Get the duration
+    m_duration=m_totalDuration;
+    //Set the start position at the very beginning.
+    m_startPosition=0;
+    //Set default end position as the whole file.
+    m_endPosition=m_duration;
+    m_positionBase=0;
+}
+
+void KNMusicBackendFFMpegThread::stop()
+{
+    //Check if the thread data if empty.
+    if(m_filePath.isEmpty())
+    {
+        return;
+    }
+    //Check the state.
+    if(m_playingState!=StoppedState)
+    {
+        //Stop decoding and playing.
+        haltPipeline();
+        //Reset position.
+        m_positionBase=0;
+        //Set stop flag.
+        m_stoppedState=true;
+        //Reset the state.
+        setState(StoppedState);
+        emit stopped();
+    }
+}
+
+void KNMusicBackendFFMpegThread::pause()
+{
+    //Check if the thread data if empty.
+    if(m_filePath.isEmpty())
+    {
+        return;
+    }
+    //Check the state.
+    if(m_playingState==PlayingState)
+    {
+        //Pause the sink, the decoder will stop when the ring buffer is full.
+        m_sink->suspend();
+        //Stop the updater.
+        m_positionUpdater->stop();
+        //Reset the state.
+        setState(PausedState);
+    }
+}
+
+void KNMusicBackendFFMpegThread::play()
+{
+    //Check if the thread data if empty.
+    if(m_filePath.isEmpty())
+    {
+        return;
+    }
+    //Check the state.
+    if(m_playingState!=PlayingState)
+    {
+        //Check whether is now is playing or not.
+        if(m_stoppedState)
+        {
+            //Reset flag.
+            m_stoppedState=false;
+            //Start decoding from the beginning of the section.
+            if(!startFrom(0))
+            {
+                return;
+            }
+        }
+        else
+        {
+            //Continue playing.
+            m_sink->resume();
+        }
+        //Start the position updater.
+        m_positionUpdater->start();
+        //Reset the state.
+        setState(PlayingState);
+    }
+}
+
+int KNMusicBackendFFMpegThread::volume()
+{
+    return m_sink->volume();
+}
+
+qint64 KNMusicBackendFFMpegThread::duration()
+{
+    return m_duration;
+}
+
+qint64 KNMusicBackendFFMpegThread::position()
+{
+    if(m_filePath.isEmpty() || m_decoder->sampleRate()==0)
+    {
+        return 0;
+    }
+    return m_positionBase+
+            m_sink->playedFrames()*1000/m_decoder->sampleRate();
+}
+
+int KNMusicBackendFFMpegThread::recentSamples(float *samples,
+                                             const int &frameCount)
+{
+    //The sink keeps the played frames, only give them out while playing.
+    if(m_playingState!=PlayingState)
+    {
+        return 0;
+    }
+    return m_sink->recentFrames(samples, frameCount);
+}
+
+void KNMusicBackendFFMpegThread::setPlaySection(const qint64 &sectionStart,
+                                                const qint64 &sectionDuration)
+{
+    //Check the start position and duration is still in the duration.
+    //If it's available, set the start position.
+    if(sectionStart!=-1 && sectionStart<m_duration)
+    {
+        m_startPosition=sectionStart;
+        //Update the duration.
+        if(sectionDuration!=-1 && m_startPosition+sectionDuration<m_duration)
+        {
+            m_duration=sectionDuration;
+        }
+        else
+        {
+            m_duration=m_duration-m_startPosition;
+        }
+        //Update the end position.
+        m_endPosition=m_startPosition+m_duration;
+    }
+    //Update the duration like playing file.
+    emit durationChanged(duration());
+}
+
+void KNMusicBackendFFMpegThread::playSection(const qint64 &sectionStart,
+                                             const qint64 &sectionDuration)
+{
+    //Set the section.
+    setPlaySection(sectionStart, sectionDuration);
+    //Play the main thread.
+    play();
+}
+
+KNMusicFFMpegDecoder *KNMusicBackendFFMpegThread::decoder()
+{
+    return m_decoder;
+}
+
+void KNMusicBackendFFMpegThread::setVolume(const int &volumeSize)
+{
+    m_sink->setVolume(volumeSize);
+}
+
+void KNMusicBackendFFMpegThread::setGain(const qreal &gain)
+{
+    //The gain is applied to the decoded samples.
+    m_decoder->setGain(gain);
+}
+
+void KNMusicBackendFFMpegThread::setPosition(const qint64 &position)
+{
+    KNTraceScope("playback", "KNMusicBackendFFMpegThread::setPosition");
+    //If no media, or the media is not started, ignore.
+    if(m_filePath.isEmpty() || m_stoppedState)
+    {
+        return;
+    }
+    //Restart the decoder at the new position, the duration of some files is
+    //unknown.
+    if(!startFrom(m_duration>0?
+                      qBound((qint64)0, position, m_duration):
+                      qMax(position, (qint64)0)))
+    {
+        return;
+    }
+    //Keep the playing state.
+    if(m_playingState==PlayingState)
+    {
+        m_positionUpdater->start();
+    }
+    else
+    {
+        m_sink->suspend();
+    }
+    //Do the position check.
+    onActionPositionCheck();
+}
+
+void KNMusicBackendFFMpegThread::onActionPositionCheck()
+{
+    qint64 currentPosition=position(),
+           playedFrames=m_sink->playedFrames();
+    emit positionChanged(currentPosition);
+    //When the position reach the end of the section, or the decoder is at the
+    //end of the file and the sink has played all the data, it's finished.
+    bool sinkDrained=m_decoder->isAtEnd() &&
+                     m_ringBuffer->readAvailable()==0 &&
+                     playedFrames==m_lastPlayedFrames;
+    m_lastPlayedFrames=playedFrames;
+    if(m_playingState==PlayingState &&
+            ((m_duration>0 && currentPosition>=m_duration) || sinkDrained))
+    {
+        stop();
+        m_stoppedState=true;
+        emit finished();
+    }
+}
+
+bool KNMusicBackendFFMpegThread::startFrom(const qint64 &position)
+{
+    //Stop the pipeline, the ring buffer can only be cleared when both of the
+    //decoder and the sink is stopped.
+    haltPipeline();
+    m_positionBase=position;
+    m_lastPlayedFrames=-1;
+    if(startPipeline(position))
+    {
+        return true;
+    }
+    //The device may not support the sample rate of the file, resample it to
+    //the rates which most of the devices support.
+    for(int i=0; i<FallbackSampleRateCount; ++i)
+    {
+        if(m_decoder->sampleRate()!=fallbackSampleRates[i] &&
+                m_decoder->setSampleRate(fallbackSampleRates[i]) &&
+                startPipeline(position))
+        {
+            return true;
+        }
+    }
+    //Nothing could be played, stop and tell the player, otherwise the playing
+    //stalls without any signal.
+    haltPipeline();
+    m_positionBase=0;
+    m_stoppedState=true;
+    setState(StoppedState);
+    emit cannotLoadFile();
+    return false;
+}
+
+inline bool KNMusicBackendFFMpegThread::startPipeline(const qint64 &position)
+{
+    //Seek the decoder, give out the end of section only when it's a section.
+    if(!m_decoder->seek(m_startPosition+position,
+                        (m_startPosition==0 && m_duration==m_totalDuration)?
+                            -1:m_endPosition))
+    {
+        return false;
+    }
+    //Start the decoder and the sink.
+    m_decoder->start();
+    if(m_sink->start(m_ringBuffer, m_decoder->sampleRate()))
+    {
+        return true;
+    }
+    //The device rejects the format, drop the decoded data.
+    m_decoder->stopDecode();
+    m_ringBuffer->clear();
+    return false;
+}
+
+void KNMusicBackendFFMpegThread::haltPipeline()
+{
+    //Stop position updater.
+    m_positionUpdater->stop();
+    //Stop the decoder and the sink, then drop the rest data.
+    m_decoder->stopDecode();
+    m_sink->stop();
+    m_ringBuffer->clear();
+}
+
+void KNMusicBackendFFMpegThread::setState(const int &state)
+{
+    //If the state is really different, we are going to emit playing state
+    //changed signal.
+    if(state!=m_playingState)
+    {
+        m_playingState=state;
+        emit stateChanged(m_playingState);
+    }
+}
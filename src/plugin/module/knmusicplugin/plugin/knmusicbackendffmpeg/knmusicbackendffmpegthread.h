@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICBACKENDFFMPEGTHREAD_H
+#define KNMUSICBACKENDFFMPEGTHREAD_H
+
+#include "knmusicglobal.h"
+
+#include "knmusicbackendthread.h"
+
+using namespace KNMusic;
+
+class QTimer;
+class KNMusicFFMpegDecoder;
+class KNMusicFFMpegRingBuffer;
+class KNMusicFFMpegSink;
+class KNMusicBackendFFMpegThread : public KNMusicBackendThread
+{
+    Q_OBJECT
+public:
+    explicit KNMusicBackendFFMpegThread(KNMusicFFMpegSink *sink,
+                                        QObject *parent = 0);
+    ~KNMusicBackendFFMpegThread();
+    bool loadFromFile(const QString &filePath);
+    void clear();
+    void resetState();
+    void stop();
+    void pause();
+    void play();
+    int volume();
+    qint64 duration();
+    qint64 position();
+    void setPlaySection(const qint64 &sectionStart=-1,
+                        const qint64 &sectionDuration=-1);
+    void playSection(const qint64 &sectionStart=-1,
+                     const qint64 &sectionDuration=-1);
+    int recentSamples(float *samples, const int &frameCount);
+
+    KNMusicFFMpegDecoder *decoder();
+
+signals:
+
+public slots:
+    void setVolume(const int &volumeSize);
+    void setGain(const qreal &gain);
+    void setPosition(const qint64 &position);
+
+private slots:
+    void onActionPositionCheck();
+
+private:
+    bool startFrom(const qint64 &position);
+    inline bool startPipeline(const qint64 &position);
+    void haltPipeline();
+    void setState(const int &state);
+    int m_playingState=StoppedState;
+    QString m_filePath;
+    bool m_stoppedState=true;
+    qint64 m_startPosition=0;   //Unit: millisecond
+    qint64 m_endPosition=0;     //Unit: millisecond
+    qint64 m_duration=0;        //Unit: millisecond
+    qint64 m_totalDuration=0;   //Unit: millisecond
+    qint64 m_positionBase=0;    //Unit: millisecond
+    qint64 m_lastPlayedFrames=-1;
+    QTimer *m_positionUpdater;
+    KNMusicFFMpegDecoder *m_decoder;
+    KNMusicFFMpegRingBuffer *m_ringBuffer;
+    KNMusicFFMpegSink *m_sink;
+};
+
+#endif // KNMUSICBACKENDFFMPEGTHREAD_H
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QElapsedTimer>
+
+#include "knmusicffmpegringbuffer.h"
+
+#include "knmusicffmpegdecoder.h"
+
+KNMusicFFMpegDecoder::KNMusicFFMpegDecoder(QObject *parent) :
+    QThread(parent),
+    m_quit(0),
+    m_atEnd(0),
+    m_gain(1000)
+{
+}
+
+KNMusicFFMpegDecoder::~KNMusicFFMpegDecoder()
+{
+    //Close the file, this will stop the thread as well.
+    close();
+}
+
+bool KNMusicFFMpegDecoder::open(const QString &filePath)
+{
+    //Close the previous file.
+    close();
+    //Open the file with the sample rate of the file, only change the sample
+    //format to interleaved float and mix the channels into stereo.
+    if(!m_reader.open(filePath, AV_CH_LAYOUT_STEREO))
+    {
+        return false;
+    }
+    m_filePath=filePath;
+    //Some of the formats don't provide the duration, 0 means it's unknown.
+    m_duration=qMax(m_reader.duration(), (qint64)0);
+    m_atEnd.storeRelease(0);
+    return true;
+}
+
+bool KNMusicFFMpegDecoder::setSampleRate(const int &sampleRate)
+{
+    //The sample rate can only be changed when the decoding is stopped.
+    if(!isOpened() || isRunning())
+    {
+        return false;
+    }
+    //The resampler is set when the file is opened, open it again.
+    m_atEnd.storeRelease(0);
+    if(!m_reader.open(m_filePath, AV_CH_LAYOUT_STEREO, sampleRate))
+    {
+        m_filePath.clear();
+        m_duration=0;
+        return false;
+    }
+    return true;
+}
+
+void KNMusicFFMpegDecoder::close()
+{
+    //Stop the decoding first.
+    stopDecode();
+    //Close the file.
+    m_reader.close();
+    //Reset the datas.
+    m_filePath.clear();
+    m_duration=0;
+}
+
+bool KNMusicFFMpegDecoder::isOpened() const
+{
+    return m_reader.isOpened();
+}
+
+int KNMusicFFMpegDecoder::sampleRate() const
+{
+    return m_reader.sampleRate();
+}
+
+int KNMusicFFMpegDecoder::channels() const
+{
+    return m_channels;
+}
+
+qint64 KNMusicFFMpegDecoder::duration() const
+{
+    return m_duration;
+}
+
+void KNMusicFFMpegDecoder::setRingBuffer(KNMusicFFMpegRingBuffer *ringBuffer)
+{
+    m_ringBuffer=ringBuffer;
+}
+
+bool KNMusicFFMpegDecoder::seek(const qint64 &position,
+                                const qint64 &endPosition)
+{
+    //The seek can only be done when the decoding is stopped.
+    if(!isOpened() || isRunning())
+    {
+        return false;
+    }
+    //The reader drops the frames before the position, so a section never
+    //starts with the end of the previous track. Calculate how many frames we
+    //should give out for this section.
+    if(!m_reader.seek(position,
+                      endPosition<0?
+                          -1:
+                          qMax(endPosition-position, (qint64)0)*
+                          m_reader.sampleRate()/1000))
+    {
+        return false;
+    }
+    //Reset the end flag.
+    m_atEnd.storeRelease(0);
+    return true;
+}
+
+void KNMusicFFMpegDecoder::stopDecode()
+{
+    //Ask the decoding loop to quit, and wait for it.
+    if(isRunning())
+    {
+        m_quit.storeRelease(1);
+        wait();
+    }
+    m_quit.storeRelease(0);
+}
+
+void KNMusicFFMpegDecoder::setGain(const qreal &gain)
+{
+    m_gain.storeRelease(qRound(gain*1000.0));
+}
+
+bool KNMusicFFMpegDecoder::isAtEnd() const
+{
+    return m_atEnd.loadAcquire()!=0;
+}
+
+qint64 KNMusicFFMpegDecoder::decodedFrames() const
+{
+    return m_decodedFrames;
+}
+
+qint64 KNMusicFFMpegDecoder::decodeNanoseconds() const
+{
+    return m_decodeNanoseconds;
+}
+
+void KNMusicFFMpegDecoder::run()
+{
+    //Check the decoder state.
+    if(!isOpened() || m_ringBuffer==nullptr)
+    {
+        return;
+    }
+    //Latch the gain for this decoding.
+    m_decodeGain=m_gain.loadAcquire()/1000.0f;
+    QElapsedTimer decodeTimer;
+    float *samples;
+    int frameCount;
+    //Decode until the quit flag is set.
+    while(!m_quit.loadAcquire())
+    {
+        decodeTimer.start();
+        frameCount=m_reader.read(&samples);
+        m_decodeNanoseconds+=decodeTimer.nsecsElapsed();
+        if(frameCount==0)
+        {
+            //Reach the end of the file or the end of the section.
+            m_atEnd.storeRelease(1);
+            return;
+        }
+        applyGain(samples, frameCount*m_channels);
+        m_decodedFrames+=frameCount;
+        //Push the frames to the ring buffer.
+        if(!pushFrames(samples, frameCount))
+        {
+            //We are asked to quit.
+            return;
+        }
+    }
+}
+
+bool KNMusicFFMpegDecoder::pushFrames(const float *data, int frameCount)
+{
+    while(frameCount>0)
+    {
+        int writtenFrames=m_ringBuffer->write(data, frameCount);
+        data+=writtenFrames*m_channels;
+        frameCount-=writtenFrames;
+        if(frameCount>0)
+        {
+            //The sink is slower than us, wait for the sink to read.
+            if(m_quit.loadAcquire())
+            {
+                return false;
+            }
+            QThread::msleep(5);
+        }
+    }
+    return !m_quit.loadAcquire();
+}
+
+inline void KNMusicFFMpegDecoder::applyGain(float *data, const int &sampleCount)
+{
+    //No gain, nothing to do.
+    if(m_decodeGain==1.0f)
+    {
+        return;
+    }
+    //Keep the loop simple, so the compiler could vectorize it.
+    const float gain=m_decodeGain;
+    for(int i=0; i<sampleCount; ++i)
+    {
+        float sample=data[i]*gain;
+        data[i]=sample>1.0f?1.0f:(sample<-1.0f?-1.0f:sample);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGDECODER_H
+#define KNMUSICFFMPEGDECODER_H
+
+#include <QAtomicInt>
+#include <QThread>
+
+#include "../knmusicffmpeganalysiser/knmusicffmpegaudioreader.h"
+
+class KNMusicFFMpegRingBuffer;
+class KNMusicFFMpegDecoder : public QThread
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegDecoder(QObject *parent = 0);
+    ~KNMusicFFMpegDecoder();
+    bool open(const QString &filePath);
+    //Resample the output to the sample rate, 0 sample rate is the sample rate
+    //of the file. The position goes back to the beginning.
+    bool setSampleRate(const int &sampleRate);
+    void close();
+    bool isOpened() const;
+    int sampleRate() const;
+    int channels() const;
+    qint64 duration() const;
+    void setRingBuffer(KNMusicFFMpegRingBuffer *ringBuffer);
+    bool seek(const qint64 &position, const qint64 &endPosition=-1);
+    void stopDecode();
+    void setGain(const qreal &gain);
+    bool isAtEnd() const;
+    qint64 decodedFrames() const;
+    qint64 decodeNanoseconds() const;
+
+signals:
+
+public slots:
+
+protected:
+    void run();
+
+private:
+    inline void applyGain(float *data, const int &sampleCount);
+    bool pushFrames(const float *data, int frameCount);
+    KNMusicFFMpegAudioReader m_reader;
+    KNMusicFFMpegRingBuffer *m_ringBuffer=nullptr;
+    QString m_filePath;
+    int m_channels=2;
+    qint64 m_duration=0;                 //Unit: millisecond
+    QAtomicInt m_quit, m_atEnd;
+    //The linear gain in 1/1000, it's used from the next decoding.
+    QAtomicInt m_gain;
+    float m_decodeGain=1.0;
+    qint64 m_decodedFrames=0, m_decodeNanoseconds=0;
+};
+
+#endif // KNMUSICFFMPEGDECODER_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <cstring>
+
+#include "knmusicffmpegringbuffer.h"
+
+KNMusicFFMpegRingBuffer::KNMusicFFMpegRingBuffer(const int &frameCapacity,
+                                                 const int &channels) :
+    //One frame is always kept empty to tell full from empty.
+    m_capacity((frameCapacity+1)*channels),
+    m_channels(channels),
+    m_readIndex(0),
+    m_writeIndex(0)
+{
+    m_buffer=new float[m_capacity];
+}
+
+KNMusicFFMpegRingBuffer::~KNMusicFFMpegRingBuffer()
+{
+    delete[] m_buffer;
+}
+
+int KNMusicFFMpegRingBuffer::channels() const
+{
+    return m_channels;
+}
+
+int KNMusicFFMpegRingBuffer::readAvailable() const
+{
+    int samples=m_writeIndex.loadAcquire()-m_readIndex.loadAcquire();
+    if(samples<0)
+    {
+        samples+=m_capacity;
+    }
+    return samples/m_channels;
+}
+
+int KNMusicFFMpegRingBuffer::writeAvailable() const
+{
+    return m_capacity/m_channels-1-readAvailable();
+}
+
+int KNMusicFFMpegRingBuffer::write(const float *data, int frameCount)
+{
+    //Only write the frames we can hold.
+    frameCount=qMin(frameCount, writeAvailable());
+    if(frameCount<=0)
+    {
+        return 0;
+    }
+    int writeIndex=m_writeIndex.load(),
+        sampleCount=frameCount*m_channels,
+        firstPart=qMin(sampleCount, m_capacity-writeIndex);
+    //Copy the data in at most two parts.
+    memcpy(m_buffer+writeIndex, data, firstPart*sizeof(float));
+    if(firstPart<sampleCount)
+    {
+        memcpy(m_buffer,
+               data+firstPart,
+               (sampleCount-firstPart)*sizeof(float));
+    }
+    //Publish the data to the reader.
+    m_writeIndex.storeRelease((writeIndex+sampleCount)%m_capacity);
+    return frameCount;
+}
+
+int KNMusicFFMpegRingBuffer::read(float *data, int frameCount)
+{
+    //Only read the frames we have.
+    frameCount=qMin(frameCount, readAvailable());
+    if(frameCount<=0)
+    {
+        return 0;
+    }
+    int readIndex=m_readIndex.load(),
+        sampleCount=frameCount*m_channels,
+        firstPart=qMin(sampleCount, m_capacity-readIndex);
+    //A null buffer means skip the data.
+    if(data!=nullptr)
+    {
+        memcpy(data, m_buffer+readIndex, firstPart*sizeof(float));
+        if(firstPart<sampleCount)
+        {
+            memcpy(data+firstPart,
+                   m_buffer,
+                   (sampleCount-firstPart)*sizeof(float));
+        }
+    }
+    //Give the space back to the writer.
+    m_readIndex.storeRelease((readIndex+sampleCount)%m_capacity);
+    return frameCount;
+}
+
+void KNMusicFFMpegRingBuffer::clear()
+{
+    //This should only be called when both of the reader and writer is stopped.
+    m_readIndex.storeRelease(0);
+    m_writeIndex.storeRelease(0);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGRINGBUFFER_H
+#define KNMUSICFFMPEGRINGBUFFER_H
+
+#include <QAtomicInt>
+
+/*
+ * This is a single producer, single consumer ring buffer of interleaved float
+ * samples. The decoder thread is the only writer and the audio sink is the only
+ * reader, so the read and write index are the only shared states, and no lock
+ * is needed in the audio path.
+ *    All the operations are done in whole frames, the buffer will never give
+ * out half a frame.
+ */
+class KNMusicFFMpegRingBuffer
+{
+public:
+    KNMusicFFMpegRingBuffer(const int &frameCapacity, const int &channels);
+    ~KNMusicFFMpegRingBuffer();
+    int channels() const;
+    int readAvailable() const;
+    int writeAvailable() const;
+    int write(const float *data, int frameCount);
+    int read(float *data, int frameCount);
+    void clear();
+
+private:
+    Q_DISABLE_COPY(KNMusicFFMpegRingBuffer)
+    float *m_buffer;
+    int m_capacity, m_channels;
+    QAtomicInt m_readIndex, m_writeIndex;
+};
+
+#endif // KNMUSICFFMPEGRINGBUFFER_H
@@ -0,0 +1,435 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QAudioDeviceInfo>
+#include <QAudioOutput>
+#include <QDataStream>
+#include <QTimer>
+
+#include "knmusicffmpegringbuffer.h"
+
+#include "knmusicffmpegsink.h"
+
+#define PullBufferFrames 4096
+
+int KNMusicFFMpegSink::recentFrames(float *samples, int frameCount) const
+{
+    //Copy the latest frames before the write position, the writer may be
+    //writing at the same time, a torn frame is fine for a monitor.
+    int position=m_monitorPosition.load();
+    frameCount=qMin(frameCount, MonitorFrames);
+    int start=(position-frameCount+MonitorFrames)%MonitorFrames,
+        headFrames=qMin(frameCount, MonitorFrames-start);
+    memcpy(samples, m_monitor+start, headFrames*sizeof(float));
+    memcpy(samples+headFrames, m_monitor,
+           (frameCount-headFrames)*sizeof(float));
+    return frameCount;
+}
+
+void KNMusicFFMpegSink::monitorFrames(const float *data,
+                                      const int &frameCount)
+{
+    //Only the latest frames are kept, skip the frames which will be
+    //overwritten in this write.
+    int skipFrames=qMax(frameCount-MonitorFrames, 0),
+        position=m_monitorPosition.load();
+    data+=skipFrames<<1;
+    for(int i=skipFrames; i<frameCount; ++i)
+    {
+        m_monitor[position]=(data[0]+data[1])*0.5f;
+        data+=2;
+        position=(position+1)%MonitorFrames;
+    }
+    m_monitorPosition.store(position);
+}
+
+KNMusicFFMpegNullSink::KNMusicFFMpegNullSink(QObject *parent) :
+    KNMusicFFMpegSink(parent)
+{
+    //Initial the puller.
+    m_puller=new QTimer(this);
+    m_puller->setInterval(10);
+    connect(m_puller, &QTimer::timeout,
+            this, &KNMusicFFMpegNullSink::onActionPull);
+}
+
+KNMusicFFMpegNullSink::~KNMusicFFMpegNullSink()
+{
+    delete[] m_buffer;
+}
+
+bool KNMusicFFMpegNullSink::start(KNMusicFFMpegRingBuffer *ringBuffer,
+                                  const int &sampleRate)
+{
+    //Stop the previous playing.
+    stop();
+    //Save the buffer data.
+    m_ringBuffer=ringBuffer;
+    m_sampleRate=sampleRate;
+    if(m_buffer==nullptr)
+    {
+        //The pull buffer is only allocated once.
+        m_buffer=new float[PullBufferFrames*m_ringBuffer->channels()];
+    }
+    //Reset the counter.
+    m_playedFrames=0;
+    //Start to pull the data.
+    resume();
+    return true;
+}
+
+void KNMusicFFMpegNullSink::suspend()
+{
+    m_puller->stop();
+}
+
+void KNMusicFFMpegNullSink::resume()
+{
+    if(m_ringBuffer==nullptr)
+    {
+        return;
+    }
+    //Reset the clock.
+    m_clockStartFrames=m_playedFrames;
+    m_clock.start();
+    //In fast mode, pull the data whenever the event loop is free.
+    m_puller->setInterval(m_realTime?10:0);
+    m_puller->start();
+}
+
+void KNMusicFFMpegNullSink::stop()
+{
+    //Stop pulling.
+    m_puller->stop();
+    //Close the sink.
+    if(m_ringBuffer!=nullptr)
+    {
+        closeSink();
+        m_ringBuffer=nullptr;
+    }
+}
+
+int KNMusicFFMpegNullSink::volume() const
+{
+    return m_volume;
+}
+
+void KNMusicFFMpegNullSink::setVolume(const int &volumeSize)
+{
+    m_volume=volumeSize;
+}
+
+bool KNMusicFFMpegNullSink::isRealTime() const
+{
+    return m_realTime;
+}
+
+void KNMusicFFMpegNullSink::setRealTime(bool realTime)
+{
+    m_realTime=realTime;
+}
+
+qint64 KNMusicFFMpegNullSink::playedFrames() const
+{
+    return m_playedFrames;
+}
+
+void KNMusicFFMpegNullSink::writeFrames(const float *data,
+                                        const int &frameCount)
+{
+    //Null sink drops all the data.
+    Q_UNUSED(data)
+    Q_UNUSED(frameCount)
+}
+
+void KNMusicFFMpegNullSink::closeSink()
+{
+    ;
+}
+
+void KNMusicFFMpegNullSink::onActionPull()
+{
+    //Calculate how many frames should be played.
+    qint64 framesToPull=m_realTime?
+                m_clock.elapsed()*m_sampleRate/1000-
+                    (m_playedFrames-m_clockStartFrames):
+                m_ringBuffer->readAvailable();
+    //Read the data from the ring buffer.
+    while(framesToPull>0)
+    {
+        int readFrames=m_ringBuffer->read(m_buffer,
+                                          qMin(framesToPull,
+                                               (qint64)PullBufferFrames));
+        if(readFrames==0)
+        {
+            //The decoder is slower than us, it's an underrun. Restart the
+            //clock so the missing frames won't be played in a burst.
+            m_clockStartFrames=m_playedFrames;
+            m_clock.start();
+            return;
+        }
+        writeFrames(m_buffer, readFrames);
+        monitorFrames(m_buffer, readFrames);
+        m_playedFrames+=readFrames;
+        framesToPull-=readFrames;
+    }
+}
+
+KNMusicFFMpegFileSink::KNMusicFFMpegFileSink(QObject *parent) :
+    KNMusicFFMpegNullSink(parent)
+{
+    //Write the file as fast as possible.
+    setRealTime(false);
+}
+
+bool KNMusicFFMpegFileSink::start(KNMusicFFMpegRingBuffer *ringBuffer,
+                                  const int &sampleRate)
+{
+    //Stop the previous playing, the file will be closed as well.
+    stop();
+    //Open the file.
+    m_file.setFileName(m_filePath);
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+    //Write a header with an empty size, the size will be written when close.
+    m_sampleRate=sampleRate;
+    m_dataSize=0;
+    writeHeader(0);
+    return KNMusicFFMpegNullSink::start(ringBuffer, sampleRate);
+}
+
+QString KNMusicFFMpegFileSink::filePath() const
+{
+    return m_filePath;
+}
+
+void KNMusicFFMpegFileSink::setFilePath(const QString &filePath)
+{
+    m_filePath=filePath;
+}
+
+void KNMusicFFMpegFileSink::writeFrames(const float *data,
+                                        const int &frameCount)
+{
+    //The output is always stereo float.
+    qint64 dataSize=frameCount*2*sizeof(float);
+    m_file.write((const char *)data, dataSize);
+    m_dataSize+=dataSize;
+}
+
+void KNMusicFFMpegFileSink::closeSink()
+{
+    if(m_file.isOpen())
+    {
+        //Update the header.
+        m_file.seek(0);
+        writeHeader(m_dataSize);
+        m_file.close();
+    }
+}
+
+void KNMusicFFMpegFileSink::writeHeader(const quint32 &dataSize)
+{
+    QDataStream headerStream(&m_file);
+    headerStream.setByteOrder(QDataStream::LittleEndian);
+    //RIFF chunk.
+    headerStream.writeRawData("RIFF", 4);
+    headerStream<<(quint32)(36+dataSize);
+    headerStream.writeRawData("WAVE", 4);
+    //Format chunk, 3 is IEEE float.
+    headerStream.writeRawData("fmt ", 4);
+    headerStream<<(quint32)16
+                <<(quint16)3
+                <<(quint16)2
+                <<(quint32)m_sampleRate
+                <<(quint32)(m_sampleRate*2*sizeof(float))
+                <<(quint16)(2*sizeof(float))
+                <<(quint16)32;
+    //Data chunk.
+    headerStream.writeRawData("data", 4);
+    headerStream<<dataSize;
+}
+
+KNMusicFFMpegAudioDevice::KNMusicFFMpegAudioDevice(KNMusicFFMpegSink *sink) :
+    QIODevice(sink),
+    m_sink(sink)
+{
+    ;
+}
+
+KNMusicFFMpegAudioDevice::~KNMusicFFMpegAudioDevice()
+{
+    delete[] m_buffer;
+}
+
+void KNMusicFFMpegAudioDevice::setRingBuffer(KNMusicFFMpegRingBuffer *ringBuffer)
+{
+    m_ringBuffer=ringBuffer;
+    if(m_buffer==nullptr && m_ringBuffer!=nullptr)
+    {
+        //The convert buffer is only allocated once, readData() is called in
+        //the audio callback, it shouldn't allocate any memory.
+        m_buffer=new float[PullBufferFrames*2];
+    }
+}
+
+qint64 KNMusicFFMpegAudioDevice::bytesAvailable() const
+{
+    return (m_ringBuffer==nullptr?0:m_ringBuffer->readAvailable()*4)+
+            QIODevice::bytesAvailable();
+}
+
+bool KNMusicFFMpegAudioDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 KNMusicFFMpegAudioDevice::readData(char *data, qint64 maxlen)
+{
+    if(m_ringBuffer==nullptr)
+    {
+        return 0;
+    }
+    //The audio output use stereo 16-bit samples, 4 bytes a frame.
+    qint64 framesToRead=maxlen/4, readFrames=0;
+    qint16 *output=(qint16 *)data;
+    //Convert the samples chunk by chunk through the fixed size buffer.
+    while(framesToRead>0)
+    {
+        int frameCount=m_ringBuffer->read(m_buffer,
+                                          qMin(framesToRead,
+                                               (qint64)PullBufferFrames));
+        if(frameCount==0)
+        {
+            break;
+        }
+        m_sink->monitorFrames(m_buffer, frameCount);
+        //Convert the float samples to 16-bit samples.
+        for(int i=0, sampleCount=frameCount*2; i<sampleCount; ++i)
+        {
+            float sample=qBound(-1.0f, m_buffer[i], 1.0f);
+            output[i]=(qint16)(sample*32767.0f);
+        }
+        output+=frameCount*2;
+        readFrames+=frameCount;
+        framesToRead-=frameCount;
+    }
+    return readFrames*4;
+}
+
+qint64 KNMusicFFMpegAudioDevice::writeData(const char *data, qint64 len)
+{
+    //This is a read only device.
+    Q_UNUSED(data)
+    Q_UNUSED(len)
+    return -1;
+}
+
+KNMusicFFMpegAudioSink::KNMusicFFMpegAudioSink(QObject *parent) :
+    KNMusicFFMpegSink(parent)
+{
+    m_device=new KNMusicFFMpegAudioDevice(this);
+}
+
+KNMusicFFMpegAudioSink::~KNMusicFFMpegAudioSink()
+{
+    stop();
+}
+
+bool KNMusicFFMpegAudioSink::isDeviceAvailable()
+{
+    return !QAudioDeviceInfo::defaultOutputDevice().isNull();
+}
+
+bool KNMusicFFMpegAudioSink::start(KNMusicFFMpegRingBuffer *ringBuffer,
+                                   const int &sampleRate)
+{
+    //Stop the previous playing.
+    stop();
+    //Generate the format.
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setCodec("audio/pcm");
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setSampleType(QAudioFormat::SignedInt);
+    if(!QAudioDeviceInfo::defaultOutputDevice().isFormatSupported(format))
+    {
+        return false;
+    }
+    m_sampleRate=sampleRate;
+    //Initial the audio output.
+    m_audioOutput=new QAudioOutput(format, this);
+    m_audioOutput->setVolume((qreal)m_volume/100.0);
+    //Link the device with the ring buffer and start pulling.
+    m_device->setRingBuffer(ringBuffer);
+    m_device->open(QIODevice::ReadOnly);
+    m_audioOutput->start(m_device);
+    return true;
+}
+
+void KNMusicFFMpegAudioSink::suspend()
+{
+    if(m_audioOutput!=nullptr)
+    {
+        m_audioOutput->suspend();
+    }
+}
+
+void KNMusicFFMpegAudioSink::resume()
+{
+    if(m_audioOutput!=nullptr)
+    {
+        m_audioOutput->resume();
+    }
+}
+
+void KNMusicFFMpegAudioSink::stop()
+{
+    if(m_audioOutput!=nullptr)
+    {
+        m_audioOutput->stop();
+        m_audioOutput->deleteLater();
+        m_audioOutput=nullptr;
+    }
+    //Unlink the device.
+    m_device->close();
+    m_device->setRingBuffer(nullptr);
+}
+
+int KNMusicFFMpegAudioSink::volume() const
+{
+    return m_volume;
+}
+
+void KNMusicFFMpegAudioSink::setVolume(const int &volumeSize)
+{
+    m_volume=volumeSize;
+    if(m_audioOutput!=nullptr)
+    {
+        m_audioOutput->setVolume((qreal)m_volume/100.0);
+    }
+}
+
+qint64 KNMusicFFMpegAudioSink::playedFrames() const
+{
+    return m_audioOutput==nullptr?
+                0:m_audioOutput->processedUSecs()*m_sampleRate/1000000;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGSINK_H
+#define KNMUSICFFMPEGSINK_H
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QIODevice>
+
+#include <QObject>
+
+class QTimer;
+class QAudioOutput;
+class KNMusicFFMpegRingBuffer;
+#define MonitorFrames 4096
+/*
+ * The sink is the reader side of the ring buffer. It takes the decoded samples
+ * away, and counts how many frames has been played, the position of the thread
+ * is calculated from this count.
+ * The played frames are also mixed down into a small mono history, which could
+ * be read from any thread by the spectrum feed.
+ */
+class KNMusicFFMpegSink : public QObject
+{
+    Q_OBJECT
+public:
+    KNMusicFFMpegSink(QObject *parent = 0) : QObject(parent)
+    {
+        memset(m_monitor, 0, sizeof(m_monitor));
+    }
+    virtual bool start(KNMusicFFMpegRingBuffer *ringBuffer,
+                       const int &sampleRate)=0;
+    virtual void suspend()=0;
+    virtual void resume()=0;
+    virtual void stop()=0;
+    virtual int volume() const=0;
+    virtual void setVolume(const int &volumeSize)=0;
+    virtual qint64 playedFrames() const=0;
+    int recentFrames(float *samples, int frameCount) const;
+    void monitorFrames(const float *data, const int &frameCount);
+
+private:
+    float m_monitor[MonitorFrames];
+    QAtomicInt m_monitorPosition;
+};
+
+/*
+ * Null sink simply drops all the samples. In real time mode it reads the
+ * samples as fast as a sound card, otherwise it reads as fast as the decoder
+ * can provide, which is used to check the decode speed.
+ */
+class KNMusicFFMpegNullSink : public KNMusicFFMpegSink
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegNullSink(QObject *parent = 0);
+    ~KNMusicFFMpegNullSink();
+    bool start(KNMusicFFMpegRingBuffer *ringBuffer,
+               const int &sampleRate);
+    void suspend();
+    void resume();
+    void stop();
+    int volume() const;
+    void setVolume(const int &volumeSize);
+    bool isRealTime() const;
+    void setRealTime(bool realTime);
+    qint64 playedFrames() const;
+
+protected:
+    virtual void writeFrames(const float *data, const int &frameCount);
+    virtual void closeSink();
+
+private slots:
+    void onActionPull();
+
+private:
+    QTimer *m_puller;
+    QElapsedTimer m_clock;
+    KNMusicFFMpegRingBuffer *m_ringBuffer=nullptr;
+    float *m_buffer=nullptr;
+    qint64 m_playedFrames=0, m_clockStartFrames=0;
+    int m_sampleRate=0, m_volume=100;
+    bool m_realTime=true;
+};
+
+/*
+ * File sink writes all the samples to a wave file, used to check the decoded
+ * output in the tests.
+ */
+class KNMusicFFMpegFileSink : public KNMusicFFMpegNullSink
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegFileSink(QObject *parent = 0);
+    bool start(KNMusicFFMpegRingBuffer *ringBuffer,
+               const int &sampleRate);
+    QString filePath() const;
+    void setFilePath(const QString &filePath);
+
+protected:
+    void writeFrames(const float *data, const int &frameCount);
+    void closeSink();
+
+private:
+    void writeHeader(const quint32 &dataSize);
+    QFile m_file;
+    QString m_filePath;
+    int m_sampleRate=0;
+    quint32 m_dataSize=0;
+};
+
+/*
+ * Audio sink plays the samples through the sound card with QAudioOutput in
+ * pull mode, the audio device reads the ring buffer by itself.
+ */
+class KNMusicFFMpegAudioDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegAudioDevice(KNMusicFFMpegSink *sink);
+    ~KNMusicFFMpegAudioDevice();
+    void setRingBuffer(KNMusicFFMpegRingBuffer *ringBuffer);
+    qint64 bytesAvailable() const;
+    bool isSequential() const;
+
+protected:
+    qint64 readData(char *data, qint64 maxlen);
+    qint64 writeData(const char *data, qint64 len);
+
+private:
+    KNMusicFFMpegSink *m_sink;
+    KNMusicFFMpegRingBuffer *m_ringBuffer=nullptr;
+    float *m_buffer=nullptr;
+};
+
+class KNMusicFFMpegAudioSink : public KNMusicFFMpegSink
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegAudioSink(QObject *parent = 0);
+    ~KNMusicFFMpegAudioSink();
+    static bool isDeviceAvailable();
+    bool start(KNMusicFFMpegRingBuffer *ringBuffer,
+               const int &sampleRate);
+    void suspend();
+    void resume();
+    void stop();
+    int volume() const;
+    void setVolume(const int &volumeSize);
+    qint64 playedFrames() const;
+
+private:
+    QAudioOutput *m_audioOutput=nullptr;
+    KNMusicFFMpegAudioDevice *m_device;
+    int m_sampleRate=0, m_volume=100;
+};
+
+#endif // KNMUSICFFMPEGSINK_H
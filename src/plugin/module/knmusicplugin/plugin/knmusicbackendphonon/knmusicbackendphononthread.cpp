@@ -15,6 +15,8 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
+#include "kntrace.h"
+
 #include "knmusicbackendphononthread.h"
 
 KNMusicBackendPhononThread::KNMusicBackendPhononThread(QObject *parent) :
@@ -58,6 +60,7 @@ KNMusicBackendPhononThread::~KNMusicBackendPhononThread()
 
 bool KNMusicBackendPhononThread::loadFromFile(const QString &filePath)
 {
+    KNTraceScope("playback", "KNMusicBackendPhononThread::loadFromFile");
     //Stop playing.
     stop();
     //Check if the media source is just the current file, then ignore the loading.
@@ -198,11 +201,18 @@ void KNMusicBackendPhononThread::setVolume(const int &volumeSize)
     m_volumeProgress=(qreal)volumeSize/10000.0;
     m_volumeSize=m_volumeCurve.valueForProgress(m_volumeProgress);
     //Try to set the audio output to user set volume.
-    m_audioOutput->setVolume(m_volumeSize);
+    m_audioOutput->setVolume(m_volumeSize*m_gain);
+}
+
+void KNMusicBackendPhononThread::setGain(const qreal &gain)
+{
+    m_gain=gain;
+    m_audioOutput->setVolume(m_volumeSize*m_gain);
 }
 
 void KNMusicBackendPhononThread::setPosition(const qint64 &position)
 {
+    KNTraceScope("playback", "KNMusicBackendPhononThread::setPosition");
     //Check if we are ticking.
     if(!m_ticking)
     {
@@ -226,7 +236,7 @@ void KNMusicBackendPhononThread::onActionStateChanged(const State &newstate,
         //We need to do something here.
         //First try to set the audio output to user set volume, set it again to
         //ensure the volume has been set.
-        m_audioOutput->setVolume(m_volumeSize);
+        m_audioOutput->setVolume(m_volumeSize*m_gain);
         //Then set the tick interval, copied from ProgressSlider.
         m_mediaObject->setTickInterval(100);
         break;
@@ -54,6 +54,7 @@ signals:
 
 public slots:
     void setVolume(const int &volumeSize);
+    void setGain(const qreal &gain);
     void setPosition(const qint64 &position);
 
 private slots:
@@ -73,7 +74,8 @@ private:
     int m_state;
     bool m_ticking=false, m_loadFlag=false;
     qreal m_volumeProgress=1.0,
-          m_volumeSize=1.0;
+          m_volumeSize=1.0,
+          m_gain=1.0;
     QEasingCurve m_volumeCurve=QEasingCurve(QEasingCurve::OutCubic);
     qint64 m_startPosition=-1,
            m_endPosition=-1,
@@ -17,6 +17,8 @@
  */
 #include <QDir>
 
+#include "kntrace.h"
+
 #include "knmusicbackendvlcthread.h"
 
 #include <QDebug>
@@ -52,6 +54,7 @@ KNMusicBackendVLCThread::~KNMusicBackendVLCThread()
 
 bool KNMusicBackendVLCThread::loadFromFile(const QString &filePath)
 {
+    KNTraceScope("playback", "KNMusicBackendVLCThread::loadFromFile");
     //Stop the thread first.
     stop();
     //Load the file to thread.
@@ -153,7 +156,8 @@ void KNMusicBackendVLCThread::play()
 
 int KNMusicBackendVLCThread::volume()
 {
-    return libvlc_audio_get_volume(m_player);
+    //The player volume contains the gain, use the user set volume.
+    return m_volume;
 }
 
 qint64 KNMusicBackendVLCThread::duration()
@@ -217,11 +221,19 @@ void KNMusicBackendVLCThread::positionCheck()
 
 void KNMusicBackendVLCThread::setVolume(const int &volumeSize)
 {
-    libvlc_audio_set_volume(m_player, volumeSize);
+    m_volume=volumeSize;
+    libvlc_audio_set_volume(m_player, (int)(m_volume*m_gain));
+}
+
+void KNMusicBackendVLCThread::setGain(const qreal &gain)
+{
+    m_gain=gain;
+    libvlc_audio_set_volume(m_player, (int)(m_volume*m_gain));
 }
 
 void KNMusicBackendVLCThread::setPosition(const qint64 &position)
 {
+    KNTraceScope("playback", "KNMusicBackendVLCThread::setPosition");
     //If no media, ignore.
     if(m_filePath.isEmpty())
     {
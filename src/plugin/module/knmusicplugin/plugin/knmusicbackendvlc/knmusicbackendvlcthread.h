@@ -59,6 +59,7 @@ signals:
 
 public slots:
     void setVolume(const int &volumeSize);
+    void setGain(const qreal &gain);
     void setPosition(const qint64 &position);
 
 private:
@@ -73,7 +74,8 @@ private:
     libvlc_event_manager_t *m_vlcEventManager;
     libvlc_media_player_t *m_player=nullptr;
     libvlc_media_t *m_media=nullptr;
-    int m_playingState=StoppedState;
+    int m_playingState=StoppedState, m_volume=100;
+    qreal m_gain=1.0;
 
     qint64 m_startPosition;   //Unit: millisecond
     qint64 m_endPosition;     //Unit: millisecond
@@ -27,7 +27,6 @@
 #include "knprogressslider.h"
 #include "knfilepathlabel.h"
 #include "knmusicdetailtooltipartwork.h"
-#include "knmusicmodelassist.h"
 #include "knmusicmodel.h"
 #include "knmusicbackend.h"
 
@@ -50,6 +49,13 @@ KNMusicDetailTooltip::KNMusicDetailTooltip(QWidget *parent) :
     m_disappearCounter->setSingleShot(true);
     connect(m_disappearCounter, &QTimer::timeout,
             this, &KNMusicDetailTooltip::onActionHide);
+    //Initial the prefetch counter. When the mouse stays on a row for a while,
+    //open the file before user moves into the tooltip.
+    m_prefetchCounter=new QTimer(this);
+    m_prefetchCounter->setSingleShot(true);
+    m_prefetchCounter->setInterval(200);
+    connect(m_prefetchCounter, &QTimer::timeout,
+            this, &KNMusicDetailTooltip::onActionPrefetch);
 
     //Initial the layout and widget.
     QBoxLayout *mainLayout=new QBoxLayout(QBoxLayout::LeftToRight,
@@ -166,25 +172,48 @@ void KNMusicDetailTooltip::setPreviewIndex(KNMusicModel *musicModel,
     //Set the current row and model.
     m_currentIndex=index;
     m_currentMusicModel=musicModel;
-    //Get the detail from data.
-    KNMusicAnalysisItem analysisItem;
-    if(KNMusicModelAssist::reanalysisRow(musicModel,
-                                         index,
-                                         analysisItem))
-    {
-        KNMusicDetailInfo &detailInfo=analysisItem.detailInfo;
-        //Set data to details.
-        m_albumArt->setArtwork(analysisItem.coverImage.isNull()?
-                                   KNMusicGlobal::instance()->noAlbumArt():
-                                   QPixmap::fromImage(analysisItem.coverImage));
-        setEliedText(m_labels[ItemTitle], detailInfo.textLists[Name]);
-        setEliedText(m_fileName, tr("In file: %1").arg(detailInfo.fileName));
-        m_fileName->setFilePath(detailInfo.filePath);
-        setEliedText(m_labels[ItemTime], detailInfo.textLists[Time]);
-        setEliedText(m_labels[ItemArtist], detailInfo.textLists[Artist]);
-    }
+    //Show the data of the row first, the row is reanalysised in the analysis
+    //thread, the details will be updated when the result comes back.
+    setDetailInfo(musicModel->detailInfoFromRow(index.row()),
+                  musicModel->songAlbumArt(index.row()));
+    connect(musicModel, &KNMusicModel::rowReanalysised,
+            this, &KNMusicDetailTooltip::onActionRowReanalysised,
+            Qt::UniqueConnection);
+    musicModel->reanalysisRows(QList<QPersistentModelIndex>() << index);
     //Set the position.
     moveToPosition(position);
+    //Start to count the dwell time.
+    m_prefetchCounter->start();
+}
+
+void KNMusicDetailTooltip::onActionRowReanalysised(
+        const QPersistentModelIndex &index,
+        const KNMusicReanalysisItem &reanalysisItem)
+{
+    //Only update the details of the current row.
+    if(!reanalysisItem.available ||
+            index.model()!=m_currentMusicModel ||
+            index.row()!=m_currentIndex.row())
+    {
+        return;
+    }
+    const KNMusicAnalysisItem &analysisItem=reanalysisItem.analysisItem;
+    setDetailInfo(analysisItem.detailInfo,
+                  QPixmap::fromImage(analysisItem.coverImage));
+}
+
+inline void KNMusicDetailTooltip::setDetailInfo(const KNMusicDetailInfo &detailInfo,
+                                                const QPixmap &albumArt)
+{
+    //Set data to details.
+    m_albumArt->setArtwork(albumArt.isNull()?
+                               KNMusicGlobal::instance()->noAlbumArt():
+                               albumArt);
+    setEliedText(m_labels[ItemTitle], detailInfo.textLists[Name]);
+    setEliedText(m_fileName, tr("In file: %1").arg(detailInfo.fileName));
+    m_fileName->setFilePath(detailInfo.filePath);
+    setEliedText(m_labels[ItemTime], detailInfo.textLists[Time]);
+    setEliedText(m_labels[ItemArtist], detailInfo.textLists[Artist]);
 }
 
 inline void KNMusicDetailTooltip::moveToPosition(const QPoint &position)
@@ -240,12 +269,26 @@ void KNMusicDetailTooltip::focusOutEvent(QFocusEvent *event)
 
 void KNMusicDetailTooltip::onActionHide()
 {
+    //Stop the prefetch.
+    m_prefetchCounter->stop();
     //Reset the player.
     resetPreviewPlayer();
     //Hide the hint.
     hide();
 }
 
+void KNMusicDetailTooltip::onActionPrefetch()
+{
+    //Check is the current index still available.
+    if(m_currentIndex.isValid())
+    {
+        //Open the file in the backend preview cache.
+        m_backend->prefetchPreview(
+                    m_currentMusicModel->rowProperty(m_currentIndex.row(),
+                                                     FilePathRole).toString());
+    }
+}
+
 void KNMusicDetailTooltip::onActionMouseInOut(const int &frame)
 {
     //Change the color and palette.
@@ -18,6 +18,8 @@
 #ifndef KNMUSICDETAILTOOLTIP_H
 #define KNMUSICDETAILTOOLTIP_H
 
+#include "knmusicglobal.h"
+
 #include "knmusicdetailtooltipbase.h"
 
 class QBoxLayout;
@@ -50,6 +52,7 @@ protected:
 
 private slots:
     void onActionHide();
+    void onActionPrefetch();
     void onActionMouseInOut(const int &frame);
     void onActionPlayNPauseClick();
     void onActionPreviewStatusChange(const int &state);
@@ -58,6 +61,8 @@ private slots:
     void onActionPreviewPositionChanged(const qint64 &position);
     void onActionPreviewDurationChanged(const qint64 &duration);
     void startDisappearCountWithAnime();
+    void onActionRowReanalysised(const QPersistentModelIndex &index,
+                                 const KNMusicReanalysisItem &reanalysisItem);
 
 private:
     enum ToolTipItems
@@ -72,6 +77,8 @@ private:
     inline void resetPreviewPlayer();
     inline void initialTimeLine(QTimeLine *timeline);
     inline void setEliedText(QLabel *label, const QString &text);
+    inline void setDetailInfo(const KNMusicDetailInfo &detailInfo,
+                              const QPixmap &albumArt);
     inline void moveToPosition(const QPoint &position);
     int m_tooltipWidth=448, m_tooltipHeight=176,
         m_labelWidth=m_tooltipWidth-m_tooltipHeight-11;
@@ -83,7 +90,7 @@ private:
     QLabel *m_labels[ToolTipItemsCount];
     KNFilePathLabel *m_fileName;
     QPalette m_palette;
-    QTimer *m_disappearCounter;
+    QTimer *m_disappearCounter, *m_prefetchCounter;
     QPersistentModelIndex m_currentIndex;
     KNMusicModel *m_currentMusicModel;
     QTimeLine *m_mouseIn, *m_mouseOut;
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGANALYSISCONSUMER_H
+#define KNMUSICFFMPEGANALYSISCONSUMER_H
+
+#include <QtGlobal>
+
+//The sample rate of the mono samples.
+#define AnalysisSampleRate 11025
+
+/*
+ * The consumer takes the samples of a track from the analysis job. All the
+ * consumers of the same track are fed from one decoding, the job decodes only
+ * the ranges the consumers need.
+ * A consumer needs either the stereo samples at the sample rate of the file,
+ * or the mono samples at AnalysisSampleRate. The samples are always
+ * interleaved float.
+ */
+class KNMusicFFMpegAnalysisConsumer
+{
+public:
+    virtual ~KNMusicFFMpegAnalysisConsumer(){}
+    //Called in the job thread before decoding, false means the consumer has
+    //got its result without the samples, e.g. from the cache, it won't be
+    //called any more.
+    virtual bool prepare()=0;
+    virtual bool isStereo() const=0;
+    //The range of the file the consumer needs, in ms. -1 end means to the end
+    //of the file.
+    virtual qint64 rangeStart() const=0;
+    virtual qint64 rangeEnd() const=0;
+    //Called after the file is opened, the rate of the samples it will get.
+    virtual void start(const int &sampleRate)=0;
+    virtual void process(const float *samples, const int &frameCount)=0;
+    //Called after the decoding, decoded is false when the range can't be fully
+    //decoded, or the analysis is aborted.
+    virtual void finish(const bool &decoded)=0;
+};
+
+#endif // KNMUSICFFMPEGANALYSISCONSUMER_H
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QPair>
+
+#include <climits>
+
+#include "knmusicffmpegaudioreader.h"
+#include "knmusicffmpeganalysisconsumer.h"
+#include "knmusicffmpeganalysispool.h"
+
+#include "knmusicffmpeganalysisjob.h"
+
+//The gap between two ranges which is shorter than this is decoded instead of
+//seeking over it, in ms.
+#define SegmentMergeGap 10000
+
+KNMusicFFMpegAnalysisJob::KNMusicFFMpegAnalysisJob(
+        KNMusicFFMpegAnalysisPool *pool,
+        const QString &filePath) :
+    m_pool(pool),
+    m_filePath(filePath)
+{
+}
+
+KNMusicFFMpegAnalysisJob::~KNMusicFFMpegAnalysisJob()
+{
+    //Free the resampler and the buffer.
+    if(m_monoContext!=nullptr)
+    {
+        swr_free(&m_monoContext);
+        m_monoContext=nullptr;
+    }
+    delete[] m_monoBuffer;
+    //The consumers are owned by the job.
+    qDeleteAll(m_consumers);
+}
+
+void KNMusicFFMpegAnalysisJob::addConsumer(
+        KNMusicFFMpegAnalysisConsumer *consumer)
+{
+    m_consumers.append(consumer);
+}
+
+void KNMusicFFMpegAnalysisJob::run()
+{
+    //Find out the consumers which still need the samples.
+    for(QList<KNMusicFFMpegAnalysisConsumer *>::iterator i=m_consumers.begin();
+        i!=m_consumers.end();
+        ++i)
+    {
+        if(m_pool->isAborted())
+        {
+            return;
+        }
+        if(!(*i)->prepare())
+        {
+            continue;
+        }
+        KNMusicFFMpegAnalysisTarget target;
+        target.consumer=*i;
+        target.start=qMax((*i)->rangeStart(), (qint64)0);
+        target.end=(*i)->rangeEnd();
+        target.stereo=(*i)->isStereo();
+        target.decoded=false;
+        m_hasStereo|=target.stereo;
+        m_hasMono|=!target.stereo;
+        m_targets.append(target);
+    }
+    if(m_targets.isEmpty())
+    {
+        return;
+    }
+    KNMusicFFMpegAudioReader reader;
+    if(open(&reader))
+    {
+        //Merge the ranges of the consumers into the segments, every segment
+        //is decoded once.
+        QList<QPair<qint64, qint64> > ranges;
+        for(QList<KNMusicFFMpegAnalysisTarget>::iterator i=m_targets.begin();
+            i!=m_targets.end();
+            ++i)
+        {
+            ranges.append(qMakePair((*i).start, (*i).end));
+        }
+        qSort(ranges.begin(), ranges.end());
+        QList<QPair<qint64, qint64> > segments;
+        segments.append(ranges.first());
+        for(int i=1; i<ranges.size(); ++i)
+        {
+            QPair<qint64, qint64> &segment=segments.last();
+            const QPair<qint64, qint64> &range=ranges.at(i);
+            if(segment.second==-1 ||
+                    range.first<=segment.second+SegmentMergeGap)
+            {
+                //The range is covered or close to the segment.
+                segment.second=(segment.second==-1 || range.second==-1)?
+                            -1:qMax(segment.second, range.second);
+                continue;
+            }
+            segments.append(range);
+        }
+        for(QList<QPair<qint64, qint64> >::iterator i=segments.begin();
+            i!=segments.end() && !m_pool->isAborted();
+            ++i)
+        {
+            bool decoded=decodeSegment(&reader, (*i).first, (*i).second);
+            //Mark the consumers in the segment.
+            for(QList<KNMusicFFMpegAnalysisTarget>::iterator j=
+                    m_targets.begin();
+                j!=m_targets.end();
+                ++j)
+            {
+                if((*j).start>=(*i).first &&
+                        ((*i).second==-1 ||
+                         ((*j).end!=-1 && (*j).end<=(*i).second)))
+                {
+                    (*j).decoded=decoded;
+                }
+            }
+        }
+    }
+    reader.close();
+    //Give the results to the consumers.
+    bool aborted=m_pool->isAborted();
+    for(QList<KNMusicFFMpegAnalysisTarget>::iterator i=m_targets.begin();
+        i!=m_targets.end();
+        ++i)
+    {
+        (*i).consumer->finish((*i).decoded && !aborted);
+    }
+}
+
+inline bool KNMusicFFMpegAnalysisJob::open(KNMusicFFMpegAudioReader *reader)
+{
+    //Only mix the channels into stereo when a consumer needs it, otherwise
+    //the reader gives out the mono samples directly.
+    if(!m_hasStereo)
+    {
+        if(!reader->open(m_filePath, AV_CH_LAYOUT_MONO, AnalysisSampleRate))
+        {
+            return false;
+        }
+        m_sampleRate=reader->sampleRate();
+    }
+    else
+    {
+        if(!reader->open(m_filePath, AV_CH_LAYOUT_STEREO))
+        {
+            return false;
+        }
+        m_sampleRate=reader->sampleRate();
+        //The mono consumers are fed from the stereo samples.
+        if(m_hasMono)
+        {
+            m_monoContext=swr_alloc_set_opts(NULL,
+                                             AV_CH_LAYOUT_MONO,
+                                             AV_SAMPLE_FMT_FLT,
+                                             AnalysisSampleRate,
+                                             AV_CH_LAYOUT_STEREO,
+                                             AV_SAMPLE_FMT_FLT,
+                                             m_sampleRate,
+                                             0,
+                                             NULL);
+            if(m_monoContext==NULL || swr_init(m_monoContext)<0)
+            {
+                return false;
+            }
+        }
+    }
+    //Calculate the ranges in frames.
+    for(QList<KNMusicFFMpegAnalysisTarget>::iterator i=m_targets.begin();
+        i!=m_targets.end();
+        ++i)
+    {
+        qint64 sampleRate=(*i).stereo?m_sampleRate:AnalysisSampleRate;
+        (*i).startFrame=(*i).start*sampleRate/1000;
+        (*i).endFrame=(*i).end==-1?LLONG_MAX:(*i).end*sampleRate/1000;
+        (*i).consumer->start(sampleRate);
+    }
+    return true;
+}
+
+inline bool KNMusicFFMpegAnalysisJob::decodeSegment(
+        KNMusicFFMpegAudioReader *reader,
+        const qint64 &start,
+        const qint64 &end)
+{
+    //The reader gives out the frames exactly from the start of the segment.
+    if(!reader->seek(start, end==-1?-1:(end-start)*m_sampleRate/1000))
+    {
+        return false;
+    }
+    qint64 position=start*m_sampleRate/1000;
+    if(m_monoContext!=nullptr)
+    {
+        //Drop the samples of the previous segment.
+        swr_init(m_monoContext);
+        m_monoPosition=start*AnalysisSampleRate/1000;
+    }
+    float *samples;
+    int frameCount;
+    while(!m_pool->isAborted())
+    {
+        frameCount=reader->read(&samples);
+        if(frameCount==0)
+        {
+            return true;
+        }
+        feed(samples, frameCount, position, m_hasStereo);
+        if(m_monoContext!=nullptr)
+        {
+            feedMono(samples, frameCount);
+        }
+        position+=frameCount;
+    }
+    //We are asked to quit.
+    return false;
+}
+
+inline void KNMusicFFMpegAnalysisJob::feedMono(const float *samples,
+                                               const int &frameCount)
+{
+    //Make sure the mono buffer is large enough, the frames are counted in the
+    //analysis sample rate.
+    int monoFrames=av_rescale_rnd(swr_get_delay(m_monoContext, m_sampleRate)+
+                                  frameCount,
+                                  AnalysisSampleRate,
+                                  m_sampleRate,
+                                  AV_ROUND_UP);
+    if(monoFrames>m_monoBufferFrames)
+    {
+        delete[] m_monoBuffer;
+        m_monoBufferFrames=monoFrames;
+        m_monoBuffer=new float[m_monoBufferFrames];
+    }
+    //Mix the stereo samples into mono and resample them.
+    uint8_t *output=(uint8_t *)m_monoBuffer;
+    const uint8_t *input=(const uint8_t *)samples;
+    monoFrames=swr_convert(m_monoContext,
+                           &output,
+                           m_monoBufferFrames,
+                           &input,
+                           frameCount);
+    if(monoFrames<=0)
+    {
+        return;
+    }
+    feed(m_monoBuffer, monoFrames, m_monoPosition, false);
+    m_monoPosition+=monoFrames;
+}
+
+inline void KNMusicFFMpegAnalysisJob::feed(const float *samples,
+                                           const int &frameCount,
+                                           const qint64 &position,
+                                           const bool &stereo)
+{
+    //Give every consumer the part in its range.
+    int channels=stereo?2:1;
+    for(QList<KNMusicFFMpegAnalysisTarget>::iterator i=m_targets.begin();
+        i!=m_targets.end();
+        ++i)
+    {
+        if((*i).stereo!=stereo)
+        {
+            continue;
+        }
+        qint64 from=qMax(position, (*i).startFrame),
+               to=qMin(position+frameCount, (*i).endFrame);
+        if(from<to)
+        {
+            (*i).consumer->process(samples+(from-position)*channels,
+                                   (int)(to-from));
+        }
+    }
+}
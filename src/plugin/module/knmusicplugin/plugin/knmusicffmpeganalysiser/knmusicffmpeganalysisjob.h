@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGANALYSISJOB_H
+#define KNMUSICFFMPEGANALYSISJOB_H
+
+#include <QList>
+#include <QRunnable>
+#include <QString>
+
+extern "C"
+{
+#include <libswresample/swresample.h>
+}
+
+class KNMusicFFMpegAudioReader;
+class KNMusicFFMpegAnalysisPool;
+class KNMusicFFMpegAnalysisConsumer;
+struct KNMusicFFMpegAnalysisTarget
+{
+    KNMusicFFMpegAnalysisConsumer *consumer;
+    //The range in ms, -1 end means to the end of the file.
+    qint64 start, end;
+    //The range in the frames of the samples the consumer needs.
+    qint64 startFrame, endFrame;
+    bool stereo, decoded;
+};
+
+class KNMusicFFMpegAnalysisJob : public QRunnable
+{
+public:
+    KNMusicFFMpegAnalysisJob(KNMusicFFMpegAnalysisPool *pool,
+                             const QString &filePath);
+    ~KNMusicFFMpegAnalysisJob();
+    void addConsumer(KNMusicFFMpegAnalysisConsumer *consumer);
+    void run();
+
+private:
+    inline bool open(KNMusicFFMpegAudioReader *reader);
+    inline bool decodeSegment(KNMusicFFMpegAudioReader *reader,
+                              const qint64 &start,
+                              const qint64 &end);
+    inline void feedMono(const float *samples, const int &frameCount);
+    inline void feed(const float *samples,
+                     const int &frameCount,
+                     const qint64 &position,
+                     const bool &stereo);
+    KNMusicFFMpegAnalysisPool *m_pool;
+    QString m_filePath;
+    QList<KNMusicFFMpegAnalysisConsumer *> m_consumers;
+    QList<KNMusicFFMpegAnalysisTarget> m_targets;
+    //The resampler from the stereo samples to the mono samples, it's only used
+    //when there are both stereo and mono consumers.
+    SwrContext *m_monoContext=nullptr;
+    float *m_monoBuffer=nullptr;
+    int m_monoBufferFrames=0, m_sampleRate=0;
+    qint64 m_monoPosition=0;
+    bool m_hasStereo=false, m_hasMono=false;
+};
+
+#endif // KNMUSICFFMPEGANALYSISJOB_H
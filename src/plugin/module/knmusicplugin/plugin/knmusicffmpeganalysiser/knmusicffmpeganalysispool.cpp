@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QThread>
+#include <QThreadPool>
+
+#include "knffmpegglobal.h"
+#include "knmusicffmpeganalysisjob.h"
+
+#include "knmusicffmpeganalysispool.h"
+
+KNMusicFFMpegAnalysisPool::KNMusicFFMpegAnalysisPool(QObject *parent) :
+    QObject(parent),
+    m_aborted(0)
+{
+    //Initial the global to make sure the FFMpeg has been instanced.
+    KNFFMpegGlobal::instance();
+    //Initial the analysis pool, every track is decoded in one thread.
+    m_analysisPool=new QThreadPool(this);
+    m_analysisPool->setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+}
+
+KNMusicFFMpegAnalysisPool::~KNMusicFFMpegAnalysisPool()
+{
+    //Drop the tracks which haven't been started, and ask the working tracks
+    //to quit, then wait for them.
+    m_aborted.storeRelease(1);
+    qDeleteAll(m_pendingJobs);
+    m_pendingJobs.clear();
+    m_analysisPool->clear();
+    m_analysisPool->waitForDone();
+}
+
+void KNMusicFFMpegAnalysisPool::analysis(
+        const QString &filePath,
+        const qint64 &startPosition,
+        KNMusicFFMpegAnalysisConsumer *consumer)
+{
+    //The tracks of a list file are different tracks of the same file.
+    QString trackKey=filePath+'\n'+QString::number(startPosition);
+    KNMusicFFMpegAnalysisJob *job=m_pendingJobs.value(trackKey, nullptr);
+    if(job==nullptr)
+    {
+        //Start the jobs after the other scanners have asked for the track.
+        if(m_pendingJobs.isEmpty())
+        {
+            QMetaObject::invokeMethod(this,
+                                      "onActionStartJobs",
+                                      Qt::QueuedConnection);
+        }
+        job=new KNMusicFFMpegAnalysisJob(this, filePath);
+        m_pendingJobs.insert(trackKey, job);
+    }
+    job->addConsumer(consumer);
+}
+
+bool KNMusicFFMpegAnalysisPool::isAborted() const
+{
+    return m_aborted.loadAcquire()!=0;
+}
+
+void KNMusicFFMpegAnalysisPool::onActionStartJobs()
+{
+    for(QHash<QString, KNMusicFFMpegAnalysisJob *>::iterator i=
+            m_pendingJobs.begin();
+        i!=m_pendingJobs.end();
+        ++i)
+    {
+        m_analysisPool->start(*i);
+    }
+    m_pendingJobs.clear();
+}
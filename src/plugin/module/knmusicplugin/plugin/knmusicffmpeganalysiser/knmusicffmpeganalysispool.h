@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGANALYSISPOOL_H
+#define KNMUSICFFMPEGANALYSISPOOL_H
+
+#include <QAtomicInt>
+#include <QHash>
+
+#include <QObject>
+
+class QThreadPool;
+class KNMusicFFMpegAnalysisJob;
+class KNMusicFFMpegAnalysisConsumer;
+/*
+ * The analysis pool is the worker pool of the loudness scanner, the
+ * fingerprinter and the tempo scanner. Every track is decoded in one thread,
+ * so the pool uses all the cores.
+ * The consumers of the same track asked in the same event loop iteration are
+ * put into one job, the track is decoded only once for all of them. The
+ * library asks all the scanners for the new tracks at the same time.
+ * The pool should be deleted before the scanners which use it.
+ */
+class KNMusicFFMpegAnalysisPool : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegAnalysisPool(QObject *parent = 0);
+    ~KNMusicFFMpegAnalysisPool();
+    //The pool takes the consumer, it's deleted after the job finished.
+    void analysis(const QString &filePath,
+                  const qint64 &startPosition,
+                  KNMusicFFMpegAnalysisConsumer *consumer);
+    bool isAborted() const;
+
+signals:
+
+public slots:
+
+private slots:
+    void onActionStartJobs();
+
+private:
+    QThreadPool *m_analysisPool;
+    //The jobs which are still collecting the consumers, keyed by the track.
+    QHash<QString, KNMusicFFMpegAnalysisJob *> m_pendingJobs;
+    QAtomicInt m_aborted;
+};
+
+#endif // KNMUSICFFMPEGANALYSISPOOL_H
@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QDir>
+
+#include "knmusicffmpegaudioreader.h"
+
+KNMusicFFMpegAudioReader::KNMusicFFMpegAudioReader()
+{
+    //Initial the global to make sure the FFMpeg has been instanced.
+    KNFFMpegGlobal::instance();
+    av_init_packet(&m_packet);
+    m_packet.data=NULL;
+    m_packet.size=0;
+    m_packetLeft=m_packet;
+}
+
+KNMusicFFMpegAudioReader::~KNMusicFFMpegAudioReader()
+{
+    close();
+}
+
+bool KNMusicFFMpegAudioReader::open(const QString &filePath,
+                                    const qint64 &channelLayout,
+                                    const int &sampleRate)
+{
+    //Close the previous file.
+    close();
+    //Open the file with ffmpeg.
+    if(avformat_open_input(&m_formatContext,
+                           QDir::toNativeSeparators(filePath).toLocal8Bit().data(),
+                           NULL,
+                           NULL)!=0)
+    {
+        //Open failed.
+        m_formatContext=nullptr;
+        return false;
+    }
+    //Check whether we can find the stream info from the context.
+    if(avformat_find_stream_info(m_formatContext, NULL)<0)
+    {
+        close();
+        return false;
+    }
+    //Find the audio stream.
+    m_audioStream=av_find_best_stream(m_formatContext,
+                                      AVMEDIA_TYPE_AUDIO,
+                                      -1,
+                                      -1,
+                                      NULL,
+                                      0);
+    if(m_audioStream<0)
+    {
+        close();
+        return false;
+    }
+    //Get the audio codec, the files are decoded in parallel already, so use
+    //only one thread for each codec.
+    AVCodecContext *codecContext=m_formatContext->streams[m_audioStream]->codec;
+    AVCodec *codec=avcodec_find_decoder(codecContext->codec_id);
+    codecContext->thread_count=1;
+    if(codec==NULL || avcodec_open2(codecContext, codec, NULL)<0)
+    {
+        close();
+        return false;
+    }
+    m_codecContext=codecContext;
+    m_sourceSampleRate=m_codecContext->sample_rate;
+    if(m_sourceSampleRate<=0)
+    {
+        close();
+        return false;
+    }
+    //Initial the resampler.
+    m_sampleRate=sampleRate>0?sampleRate:m_sourceSampleRate;
+    m_channels=av_get_channel_layout_nb_channels(channelLayout);
+    qint64 sourceLayout=
+            m_codecContext->channel_layout==0?
+                av_get_default_channel_layout(m_codecContext->channels):
+                m_codecContext->channel_layout;
+    m_resampleContext=swr_alloc_set_opts(NULL,
+                                         channelLayout,
+                                         AV_SAMPLE_FMT_FLT,
+                                         m_sampleRate,
+                                         sourceLayout,
+                                         m_codecContext->sample_fmt,
+                                         m_sourceSampleRate,
+                                         0,
+                                         NULL);
+    if(m_resampleContext==NULL || swr_init(m_resampleContext)<0)
+    {
+        close();
+        return false;
+    }
+    m_frame=av_frame_alloc();
+    if(m_frame==NULL)
+    {
+        close();
+        return false;
+    }
+    //Read from the beginning of the file.
+    m_readStarted=false;
+    m_seekFrame=0;
+    m_skipFrames=0;
+    m_framesLeft=-1;
+    return true;
+}
+
+void KNMusicFFMpegAudioReader::close()
+{
+    freePacket();
+    m_draining=false;
+    //Free the frame and the buffer.
+    if(m_frame!=nullptr)
+    {
+        av_frame_free(&m_frame);
+        m_frame=nullptr;
+    }
+    delete[] m_outputBuffer;
+    m_outputBuffer=nullptr;
+    m_outputBufferFrames=0;
+    //Free the resampler.
+    if(m_resampleContext!=nullptr)
+    {
+        swr_free(&m_resampleContext);
+        m_resampleContext=nullptr;
+    }
+    //Close the codec, the lock manager in the global protects it.
+    if(m_codecContext!=nullptr)
+    {
+        avcodec_close(m_codecContext);
+        m_codecContext=nullptr;
+    }
+    //Close the file.
+    if(m_formatContext!=nullptr)
+    {
+        avformat_close_input(&m_formatContext);
+        m_formatContext=nullptr;
+    }
+    //Reset the datas.
+    m_audioStream=-1;
+    m_sourceSampleRate=0;
+    m_sampleRate=0;
+    m_channels=0;
+}
+
+bool KNMusicFFMpegAudioReader::isOpened() const
+{
+    return m_frame!=nullptr;
+}
+
+int KNMusicFFMpegAudioReader::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+int KNMusicFFMpegAudioReader::channels() const
+{
+    return m_channels;
+}
+
+qint64 KNMusicFFMpegAudioReader::duration() const
+{
+    //The duration which AVFormatContext provides is in AV_TIME_BASE fractional
+    //seconds, some of the formats don't have it.
+    if(m_formatContext==nullptr || m_formatContext->duration==AV_NOPTS_VALUE)
+    {
+        return -1;
+    }
+    return m_formatContext->duration/(AV_TIME_BASE/1000);
+}
+
+bool KNMusicFFMpegAudioReader::seek(const qint64 &position,
+                                    const qint64 &frameLimit)
+{
+    if(!isOpened())
+    {
+        return false;
+    }
+    //Seek the stream, position is in ms, change it to AV_TIME_BASE.
+    //The file is at the beginning right after opening, it's not necessary to
+    //seek, some of the streams can't seek at all.
+    qint64 seekPosition=qMax(position, (qint64)0);
+    if((seekPosition>0 || m_readStarted) &&
+            av_seek_frame(m_formatContext,
+                          -1,
+                          seekPosition*(AV_TIME_BASE/1000),
+                          AVSEEK_FLAG_BACKWARD)<0)
+    {
+        return false;
+    }
+    //Drop all the data which is still in the decoder and the resampler.
+    freePacket();
+    m_draining=false;
+    avcodec_flush_buffers(m_codecContext);
+    swr_init(m_resampleContext);
+    //The frames to be dropped are known when the first frame is decoded.
+    m_readStarted=false;
+    m_seekFrame=seekPosition*m_sampleRate/1000;
+    m_skipFrames=-1;
+    m_framesLeft=frameLimit;
+    return true;
+}
+
+int KNMusicFFMpegAudioReader::read(float **samples)
+{
+    if(!isOpened())
+    {
+        return 0;
+    }
+    m_readStarted=true;
+    while(m_framesLeft!=0)
+    {
+        //Decode the rest of the packet first, then read the next packet.
+        if(m_packetLeft.size<=0 && !m_draining)
+        {
+            freePacket();
+            if(av_read_frame(m_formatContext, &m_packet)<0)
+            {
+                //Drain the frames still in the codec.
+                m_draining=true;
+                av_init_packet(&m_packetLeft);
+                m_packetLeft.data=NULL;
+                m_packetLeft.size=0;
+                m_packetLeft.stream_index=m_audioStream;
+            }
+            else
+            {
+                m_packetRead=true;
+                //Only decode the audio stream.
+                if(m_packet.stream_index!=m_audioStream)
+                {
+                    continue;
+                }
+                m_packetLeft=m_packet;
+            }
+        }
+        //A packet may contains several frames, decode one of them.
+        int gotFrame=0;
+        int usedSize=avcodec_decode_audio4(m_codecContext,
+                                           m_frame,
+                                           &gotFrame,
+                                           &m_packetLeft);
+        if(m_draining)
+        {
+            //When draining, no frame means the codec is empty.
+            if(usedSize<0 || !gotFrame)
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            if(usedSize<0)
+            {
+                //Skip the broken packet.
+                m_packetLeft.size=0;
+                continue;
+            }
+            m_packetLeft.data+=usedSize;
+            m_packetLeft.size-=usedSize;
+            if(!gotFrame)
+            {
+                continue;
+            }
+        }
+        int outputFrames=convertFrame(samples);
+        if(outputFrames>0)
+        {
+            return outputFrames;
+        }
+    }
+    return 0;
+}
+
+inline void KNMusicFFMpegAudioReader::freePacket()
+{
+    if(m_packetRead)
+    {
+        av_free_packet(&m_packet);
+        m_packetRead=false;
+    }
+    m_packetLeft.data=NULL;
+    m_packetLeft.size=0;
+}
+
+inline int KNMusicFFMpegAudioReader::convertFrame(float **samples)
+{
+    //The seeking is not accurate, find the frames before the seek position from
+    //the timestamp of the first frame.
+    if(m_skipFrames==-1)
+    {
+        m_skipFrames=0;
+        qint64 timestamp=av_frame_get_best_effort_timestamp(m_frame);
+        if(timestamp!=AV_NOPTS_VALUE)
+        {
+            AVStream *stream=m_formatContext->streams[m_audioStream];
+            if(stream->start_time!=AV_NOPTS_VALUE)
+            {
+                timestamp-=stream->start_time;
+            }
+            m_skipFrames=qMax(m_seekFrame-
+                              av_rescale_q(timestamp,
+                                           stream->time_base,
+                                           AVRational{1, m_sampleRate}),
+                              (qint64)0);
+        }
+    }
+    //Make sure the output buffer is large enough, the frames are counted in
+    //the output sample rate.
+    int outputFrames=av_rescale_rnd(
+                swr_get_delay(m_resampleContext, m_sourceSampleRate)+
+                m_frame->nb_samples,
+                m_sampleRate,
+                m_sourceSampleRate,
+                AV_ROUND_UP);
+    if(outputFrames>m_outputBufferFrames)
+    {
+        delete[] m_outputBuffer;
+        m_outputBufferFrames=outputFrames;
+        m_outputBuffer=new float[m_outputBufferFrames*m_channels];
+    }
+    //Convert the frame to interleaved float.
+    uint8_t *output=(uint8_t *)m_outputBuffer;
+    outputFrames=swr_convert(m_resampleContext,
+                             &output,
+                             m_outputBufferFrames,
+                             (const uint8_t **)m_frame->extended_data,
+                             m_frame->nb_samples);
+    if(outputFrames<=0)
+    {
+        return 0;
+    }
+    //Drop the frames before the seek position.
+    float *outputSamples=m_outputBuffer;
+    if(m_skipFrames>0)
+    {
+        int skipFrames=(int)qMin((qint64)outputFrames, m_skipFrames);
+        outputSamples+=skipFrames*m_channels;
+        outputFrames-=skipFrames;
+        m_skipFrames-=skipFrames;
+    }
+    //Check the frame limit.
+    if(m_framesLeft!=-1)
+    {
+        outputFrames=(int)qMin((qint64)outputFrames, m_framesLeft);
+        m_framesLeft-=outputFrames;
+    }
+    *samples=outputSamples;
+    return outputFrames;
+}
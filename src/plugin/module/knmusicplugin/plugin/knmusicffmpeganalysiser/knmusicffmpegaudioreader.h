@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGAUDIOREADER_H
+#define KNMUSICFFMPEGAUDIOREADER_H
+
+#include <QString>
+
+#include "knffmpegglobal.h"
+
+extern "C"
+{
+#include <libswresample/swresample.h>
+}
+
+/*
+ * The reader decodes the audio stream of a file into the interleaved float
+ * samples, the channels are mixed into the channel layout and resampled to the
+ * sample rate which the user asks for. All the analysis jobs read the files
+ * through it.
+ * The seeking of FFMpeg lands on the frame before the position, the reader
+ * drops the samples before the position, so the reading always starts exactly
+ * at the position.
+ */
+class KNMusicFFMpegAudioReader
+{
+public:
+    KNMusicFFMpegAudioReader();
+    ~KNMusicFFMpegAudioReader();
+    //The sample rate 0 keeps the sample rate of the file.
+    bool open(const QString &filePath,
+              const qint64 &channelLayout,
+              const int &sampleRate=0);
+    void close();
+    bool isOpened() const;
+    int sampleRate() const;
+    int channels() const;
+    //The duration of the file in ms, -1 means the duration is unknown.
+    qint64 duration() const;
+    //Seek to the position in ms, and read at most the frame limit from there.
+    //-1 frame limit means read to the end of the file.
+    bool seek(const qint64 &position, const qint64 &frameLimit=-1);
+    //Read the next frames, the samples are valid until the next reading.
+    //Returns the frame count, 0 means the end of the file or the frame limit.
+    int read(float **samples);
+
+private:
+    inline void freePacket();
+    inline int convertFrame(float **samples);
+    AVFormatContext *m_formatContext=nullptr;
+    AVCodecContext *m_codecContext=nullptr;
+    SwrContext *m_resampleContext=nullptr;
+    AVFrame *m_frame=nullptr;
+    AVPacket m_packet, m_packetLeft;
+    float *m_outputBuffer=nullptr;
+    int m_outputBufferFrames=0, m_audioStream=-1, m_sourceSampleRate=0,
+        m_sampleRate=0, m_channels=0;
+    bool m_packetRead=false, m_draining=false, m_readStarted=false;
+    //The frame of the seek position and the frames still to be dropped, -1
+    //means it's not known until the first frame is decoded.
+    qint64 m_seekFrame=0, m_skipFrames=0;
+    qint64 m_framesLeft=-1;
+};
+
+#endif // KNMUSICFFMPEGAUDIOREADER_H
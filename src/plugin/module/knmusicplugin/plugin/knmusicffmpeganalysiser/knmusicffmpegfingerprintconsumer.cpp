@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "knmusicchromafingerprint.h"
+#include "knmusicffmpegfingerprinter.h"
+
+#include "knmusicffmpegfingerprintconsumer.h"
+
+//The fingerprint is made from the mono samples of the analysis job.
+#if FingerprintSampleRate!=AnalysisSampleRate
+#error "The fingerprint sample rate must be the analysis sample rate."
+#endif
+
+KNMusicFFMpegFingerprintConsumer::KNMusicFFMpegFingerprintConsumer(
+        KNMusicFFMpegFingerprinter *fingerprinter,
+        const KNMusicFingerprintItem &track) :
+    m_fingerprinter(fingerprinter),
+    m_track(track),
+    m_fingerprint(nullptr)
+{
+}
+
+KNMusicFFMpegFingerprintConsumer::~KNMusicFFMpegFingerprintConsumer()
+{
+    delete m_fingerprint;
+}
+
+bool KNMusicFFMpegFingerprintConsumer::prepare()
+{
+    return true;
+}
+
+bool KNMusicFFMpegFingerprintConsumer::isStereo() const
+{
+    return false;
+}
+
+qint64 KNMusicFFMpegFingerprintConsumer::rangeStart() const
+{
+    return qMax(m_track.startPosition, (qint64)0);
+}
+
+qint64 KNMusicFFMpegFingerprintConsumer::rangeEnd() const
+{
+    //Only the beginning of the track is needed, and it shouldn't be longer
+    //than the track.
+    qint64 duration=FingerprintDuration*1000;
+    if(m_track.duration>0)
+    {
+        duration=qMin(duration, m_track.duration);
+    }
+    return rangeStart()+duration;
+}
+
+void KNMusicFFMpegFingerprintConsumer::start(const int &sampleRate)
+{
+    Q_UNUSED(sampleRate)
+    m_fingerprint=new KNMusicChromaFingerprint;
+}
+
+void KNMusicFFMpegFingerprintConsumer::process(const float *samples,
+                                               const int &frameCount)
+{
+    m_fingerprint->process(samples, frameCount);
+}
+
+void KNMusicFFMpegFingerprintConsumer::finish(const bool &decoded)
+{
+    //A track shorter than the duration is still fine.
+    if(!decoded || m_fingerprint==nullptr)
+    {
+        return;
+    }
+    m_track.fingerprint=m_fingerprint->fingerprint();
+    //Don't emit the result when the fingerprinter is going to be deleted.
+    if(!m_track.fingerprint.isEmpty() && !m_fingerprinter->isAborted())
+    {
+        emit m_fingerprinter->trackFingerprinted(m_track);
+    }
+}
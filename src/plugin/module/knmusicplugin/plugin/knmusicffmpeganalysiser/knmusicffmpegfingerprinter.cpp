@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "knmusicffmpeganalysispool.h"
+#include "knmusicffmpegfingerprintconsumer.h"
+
+#include "knmusicffmpegfingerprinter.h"
+
+KNMusicFFMpegFingerprinter::KNMusicFFMpegFingerprinter(
+        KNMusicFFMpegAnalysisPool *pool,
+        QObject *parent) :
+    KNMusicFingerprinter(parent),
+    m_pool(pool)
+{
+}
+
+void KNMusicFFMpegFingerprinter::fingerprint(
+        const QList<KNMusicFingerprintItem> &tracks)
+{
+    for(QList<KNMusicFingerprintItem>::const_iterator i=tracks.constBegin();
+        i!=tracks.constEnd();
+        ++i)
+    {
+        //The track is decoded once with the other analysers asking for it.
+        m_pool->analysis((*i).filePath,
+                         (*i).startPosition,
+                         new KNMusicFFMpegFingerprintConsumer(this, *i));
+    }
+}
+
+bool KNMusicFFMpegFingerprinter::isAborted() const
+{
+    return m_pool->isAborted();
+}
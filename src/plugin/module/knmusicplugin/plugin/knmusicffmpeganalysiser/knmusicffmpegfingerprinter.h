@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGFINGERPRINTER_H
+#define KNMUSICFFMPEGFINGERPRINTER_H
+
+#include "knmusicfingerprinter.h"
+
+class KNMusicFFMpegAnalysisPool;
+class KNMusicFFMpegFingerprinter : public KNMusicFingerprinter
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegFingerprinter(KNMusicFFMpegAnalysisPool *pool,
+                                        QObject *parent = 0);
+    void fingerprint(const QList<KNMusicFingerprintItem> &tracks);
+    bool isAborted() const;
+
+signals:
+
+public slots:
+
+private:
+    KNMusicFFMpegAnalysisPool *m_pool;
+};
+
+#endif // KNMUSICFFMPEGFINGERPRINTER_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "knmusicloudnessmeter.h"
+#include "knmusicffmpegloudnessscanner.h"
+
+#include "knmusicffmpegloudnessconsumer.h"
+
+KNMusicFFMpegLoudnessConsumer::KNMusicFFMpegLoudnessConsumer(
+        KNMusicFFMpegLoudnessScanner *scanner,
+        const QSharedPointer<KNMusicFFMpegLoudnessAlbum> &album,
+        const KNMusicLoudnessItem &track) :
+    m_scanner(scanner),
+    m_album(album),
+    m_track(track),
+    m_meter(nullptr)
+{
+}
+
+KNMusicFFMpegLoudnessConsumer::~KNMusicFFMpegLoudnessConsumer()
+{
+    delete m_meter;
+}
+
+bool KNMusicFFMpegLoudnessConsumer::prepare()
+{
+    return true;
+}
+
+bool KNMusicFFMpegLoudnessConsumer::isStereo() const
+{
+    //Mix the channels into stereo, which is what the meter needs.
+    return true;
+}
+
+qint64 KNMusicFFMpegLoudnessConsumer::rangeStart() const
+{
+    return qMax(m_track.startPosition, (qint64)0);
+}
+
+qint64 KNMusicFFMpegLoudnessConsumer::rangeEnd() const
+{
+    //The whole section of the track is scanned.
+    return m_track.duration>0?rangeStart()+m_track.duration:-1;
+}
+
+void KNMusicFFMpegLoudnessConsumer::start(const int &sampleRate)
+{
+    m_meter=new KNMusicLoudnessMeter(sampleRate);
+}
+
+void KNMusicFFMpegLoudnessConsumer::process(const float *samples,
+                                            const int &frameCount)
+{
+    m_meter->process(samples, frameCount);
+}
+
+void KNMusicFFMpegLoudnessConsumer::finish(const bool &decoded)
+{
+    //Only the fully decoded track has a result.
+    QVector<double> blockEnergies;
+    float peak=0.0;
+    if(decoded && m_meter!=nullptr)
+    {
+        blockEnergies=m_meter->blockEnergies();
+        peak=m_meter->peak();
+        m_track.trackGain=KNMusicLoudnessMeter::replayGain(
+                    KNMusicLoudnessMeter::integratedLoudness(blockEnergies),
+                    peak);
+        m_track.scanned=true;
+    }
+    //Put the result into the album.
+    QList<KNMusicLoudnessItem> scannedTracks;
+    {
+        QMutexLocker albumLocker(&m_album->mutex);
+        //The failed track is given back as well, so it won't be scanned again.
+        m_album->scannedTracks.append(m_track);
+        if(m_track.scanned)
+        {
+            m_album->blockEnergies+=blockEnergies;
+            m_album->peak=qMax(m_album->peak, peak);
+        }
+        //Check whether we are the last track of the album.
+        if(--m_album->remainCount>0)
+        {
+            return;
+        }
+        //The album gain is calculated from the blocks of all the tracks.
+        qreal albumGain=KNMusicLoudnessMeter::replayGain(
+                    KNMusicLoudnessMeter::integratedLoudness(
+                        m_album->blockEnergies),
+                    m_album->peak);
+        for(QList<KNMusicLoudnessItem>::iterator i=
+                m_album->scannedTracks.begin();
+            i!=m_album->scannedTracks.end();
+            ++i)
+        {
+            if((*i).scanned)
+            {
+                (*i).albumGain=albumGain;
+            }
+        }
+        scannedTracks=m_album->scannedTracks;
+    }
+    //Don't emit the result when the scanner is going to be deleted.
+    if(!m_scanner->isAborted())
+    {
+        emit m_scanner->albumScanned(scannedTracks);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGLOUDNESSCONSUMER_H
+#define KNMUSICFFMPEGLOUDNESSCONSUMER_H
+
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "knmusicglobal.h"
+
+#include "knmusicffmpeganalysisconsumer.h"
+
+using namespace KNMusic;
+
+struct KNMusicFFMpegLoudnessAlbum
+{
+    QMutex mutex;
+    //The results of the tracks, the failed tracks are included as well.
+    QList<KNMusicLoudnessItem> scannedTracks;
+    //The gated blocks and the peak of all the tracks.
+    QVector<double> blockEnergies;
+    float peak=0.0;
+    //The count of the tracks which are still scanning.
+    int remainCount=0;
+};
+
+class KNMusicLoudnessMeter;
+class KNMusicFFMpegLoudnessScanner;
+class KNMusicFFMpegLoudnessConsumer : public KNMusicFFMpegAnalysisConsumer
+{
+public:
+    KNMusicFFMpegLoudnessConsumer(KNMusicFFMpegLoudnessScanner *scanner,
+                                  const QSharedPointer<KNMusicFFMpegLoudnessAlbum> &album,
+                                  const KNMusicLoudnessItem &track);
+    ~KNMusicFFMpegLoudnessConsumer();
+    bool prepare();
+    bool isStereo() const;
+    qint64 rangeStart() const;
+    qint64 rangeEnd() const;
+    void start(const int &sampleRate);
+    void process(const float *samples, const int &frameCount);
+    void finish(const bool &decoded);
+
+private:
+    KNMusicFFMpegLoudnessScanner *m_scanner;
+    QSharedPointer<KNMusicFFMpegLoudnessAlbum> m_album;
+    KNMusicLoudnessItem m_track;
+    KNMusicLoudnessMeter *m_meter;
+};
+
+#endif // KNMUSICFFMPEGLOUDNESSCONSUMER_H
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QSharedPointer>
+
+#include "knmusicffmpeganalysispool.h"
+#include "knmusicffmpegloudnessconsumer.h"
+
+#include "knmusicffmpegloudnessscanner.h"
+
+KNMusicFFMpegLoudnessScanner::KNMusicFFMpegLoudnessScanner(
+        KNMusicFFMpegAnalysisPool *pool,
+        QObject *parent) :
+    KNMusicLoudnessScanner(parent),
+    m_pool(pool)
+{
+}
+
+void KNMusicFFMpegLoudnessScanner::scanAlbum(
+        const QList<KNMusicLoudnessItem> &tracks)
+{
+    if(tracks.isEmpty())
+    {
+        return;
+    }
+    //Generate the album, the tracks will put their results into the album.
+    QSharedPointer<KNMusicFFMpegLoudnessAlbum> album(
+                new KNMusicFFMpegLoudnessAlbum);
+    album->remainCount=tracks.size();
+    for(QList<KNMusicLoudnessItem>::const_iterator i=tracks.constBegin();
+        i!=tracks.constEnd();
+        ++i)
+    {
+        //The track is decoded once with the other analysers asking for it.
+        m_pool->analysis((*i).filePath,
+                         (*i).startPosition,
+                         new KNMusicFFMpegLoudnessConsumer(this, album, *i));
+    }
+}
+
+bool KNMusicFFMpegLoudnessScanner::isAborted() const
+{
+    return m_pool->isAborted();
+}
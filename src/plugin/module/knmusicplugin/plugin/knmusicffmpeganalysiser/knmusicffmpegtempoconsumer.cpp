@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "knmusictempodetector.h"
+#include "knmusicffmpegtemposcanner.h"
+
+#include "knmusicffmpegtempoconsumer.h"
+
+//The detector works on the mono samples of the analysis job.
+#if TempoSampleRate!=AnalysisSampleRate
+#error "The tempo sample rate must be the analysis sample rate."
+#endif
+
+KNMusicFFMpegTempoConsumer::KNMusicFFMpegTempoConsumer(
+        KNMusicFFMpegTempoScanner *scanner,
+        const KNMusicTempoItem &track) :
+    m_scanner(scanner),
+    m_track(track),
+    m_detector(nullptr)
+{
+}
+
+KNMusicFFMpegTempoConsumer::~KNMusicFFMpegTempoConsumer()
+{
+    delete m_detector;
+}
+
+bool KNMusicFFMpegTempoConsumer::prepare()
+{
+    //Use the cached result when the file hasn't been changed, the file
+    //doesn't need to be decoded.
+    m_cacheKey=KNMusicFFMpegTempoScanner::cacheKey(m_track);
+    if(!m_scanner->cachedResult(m_cacheKey, m_track))
+    {
+        return true;
+    }
+    //Don't emit the result when the scanner is going to be deleted.
+    if(!m_scanner->isAborted())
+    {
+        emit m_scanner->trackScanned(m_track);
+    }
+    return false;
+}
+
+bool KNMusicFFMpegTempoConsumer::isStereo() const
+{
+    return false;
+}
+
+qint64 KNMusicFFMpegTempoConsumer::rangeStart() const
+{
+    //Only the middle of the track is used, the intro and the outro are often
+    //not in tempo.
+    qint64 startPosition=qMax(m_track.startPosition, (qint64)0);
+    if(m_track.duration>TempoDuration*1000)
+    {
+        startPosition+=(m_track.duration-TempoDuration*1000)>>1;
+    }
+    return startPosition;
+}
+
+qint64 KNMusicFFMpegTempoConsumer::rangeEnd() const
+{
+    //It shouldn't be longer than the track.
+    qint64 duration=TempoDuration*1000;
+    if(m_track.duration>0)
+    {
+        duration=qMin(duration, m_track.duration);
+    }
+    return rangeStart()+duration;
+}
+
+void KNMusicFFMpegTempoConsumer::start(const int &sampleRate)
+{
+    Q_UNUSED(sampleRate)
+    m_detector=new KNMusicTempoDetector;
+}
+
+void KNMusicFFMpegTempoConsumer::process(const float *samples,
+                                         const int &frameCount)
+{
+    m_detector->process(samples, frameCount);
+}
+
+void KNMusicFFMpegTempoConsumer::finish(const bool &decoded)
+{
+    //A track shorter than the duration is still fine.
+    if(!decoded || m_detector==nullptr)
+    {
+        return;
+    }
+    m_track.beatsPerMinute=m_detector->beatsPerMinute();
+    m_track.key=m_detector->key();
+    //Cache the result even nothing is detected, the file won't be decoded
+    //again.
+    m_scanner->cacheResult(m_cacheKey, m_track);
+    //Don't emit the result when the scanner is going to be deleted.
+    if(!m_scanner->isAborted())
+    {
+        emit m_scanner->trackScanned(m_track);
+    }
+}
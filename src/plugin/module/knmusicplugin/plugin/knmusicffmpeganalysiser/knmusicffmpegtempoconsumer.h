@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGTEMPOCONSUMER_H
+#define KNMUSICFFMPEGTEMPOCONSUMER_H
+
+#include "knmusicglobal.h"
+
+#include "knmusicffmpeganalysisconsumer.h"
+
+using namespace KNMusic;
+
+class KNMusicTempoDetector;
+class KNMusicFFMpegTempoScanner;
+class KNMusicFFMpegTempoConsumer : public KNMusicFFMpegAnalysisConsumer
+{
+public:
+    KNMusicFFMpegTempoConsumer(KNMusicFFMpegTempoScanner *scanner,
+                               const KNMusicTempoItem &track);
+    ~KNMusicFFMpegTempoConsumer();
+    bool prepare();
+    bool isStereo() const;
+    qint64 rangeStart() const;
+    qint64 rangeEnd() const;
+    void start(const int &sampleRate);
+    void process(const float *samples, const int &frameCount);
+    void finish(const bool &decoded);
+
+private:
+    KNMusicFFMpegTempoScanner *m_scanner;
+    KNMusicTempoItem m_track;
+    QByteArray m_cacheKey;
+    KNMusicTempoDetector *m_detector;
+};
+
+#endif // KNMUSICFFMPEGTEMPOCONSUMER_H
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "knglobal.h"
+#include "knmusicffmpeganalysispool.h"
+#include "knmusicffmpegtempoconsumer.h"
+
+#include "knmusicffmpegtemposcanner.h"
+
+//The version of the cache file, the cache of the other versions is dropped.
+#define TempoCacheVersion 2
+//The cache is saved after these results are added, a crash won't lose all the
+//results of a large import.
+#define TempoCacheSaveInterval 64
+
+QDataStream &operator<<(QDataStream &stream,
+                        const KNMusicFFMpegTempoCacheItem &item)
+{
+    return stream<<item.filePath<<item.size<<item.lastModified
+                 <<item.beatsPerMinute<<item.key;
+}
+
+QDataStream &operator>>(QDataStream &stream,
+                        KNMusicFFMpegTempoCacheItem &item)
+{
+    return stream>>item.filePath>>item.size>>item.lastModified
+                 >>item.beatsPerMinute>>item.key;
+}
+
+KNMusicFFMpegTempoScanner::KNMusicFFMpegTempoScanner(
+        KNMusicFFMpegAnalysisPool *pool,
+        QObject *parent) :
+    KNMusicTempoScanner(parent),
+    m_pool(pool),
+    m_unsavedCount(0),
+    m_cacheLoaded(false),
+    m_cacheChanged(false)
+{
+}
+
+KNMusicFFMpegTempoScanner::~KNMusicFFMpegTempoScanner()
+{
+    //The pool has been deleted before the scanner, all the jobs are done.
+    //Save the results of this time.
+    saveCache();
+}
+
+void KNMusicFFMpegTempoScanner::scan(const QList<KNMusicTempoItem> &tracks)
+{
+    //Load the cache before the first job starts.
+    loadCache();
+    for(QList<KNMusicTempoItem>::const_iterator i=tracks.constBegin();
+        i!=tracks.constEnd();
+        ++i)
+    {
+        //The track is decoded once with the other analysers asking for it.
+        m_pool->analysis((*i).filePath,
+                         (*i).startPosition,
+                         new KNMusicFFMpegTempoConsumer(this, *i));
+    }
+}
+
+bool KNMusicFFMpegTempoScanner::isAborted() const
+{
+    return m_pool->isAborted();
+}
+
+QByteArray KNMusicFFMpegTempoScanner::cacheKey(const KNMusicTempoItem &track)
+{
+    //The cache is keyed by the hash of the file path and the section, the
+    //tracks of a list file have their own results. A changed file replaces
+    //its old result.
+    QByteArray trackKey=(QFileInfo(track.filePath).absoluteFilePath()+'\n'+
+                         QString::number(track.startPosition)+'\n'+
+                         QString::number(track.duration)).toUtf8();
+    return QCryptographicHash::hash(trackKey, QCryptographicHash::Md5);
+}
+
+bool KNMusicFFMpegTempoScanner::cachedResult(const QByteArray &cacheKey,
+                                             KNMusicTempoItem &track)
+{
+    QFileInfo fileInfo(track.filePath);
+    QMutexLocker cacheLocker(&m_cacheLock);
+    QHash<QByteArray, KNMusicFFMpegTempoCacheItem>::const_iterator result=
+            m_cache.constFind(cacheKey);
+    //The file is scanned again when it has been changed.
+    if(result==m_cache.constEnd() ||
+            (*result).size!=fileInfo.size() ||
+            (*result).lastModified!=
+            fileInfo.lastModified().toMSecsSinceEpoch())
+    {
+        return false;
+    }
+    track.beatsPerMinute=(*result).beatsPerMinute;
+    track.key=(*result).key;
+    return true;
+}
+
+void KNMusicFFMpegTempoScanner::cacheResult(const QByteArray &cacheKey,
+                                            const KNMusicTempoItem &track)
+{
+    QFileInfo fileInfo(track.filePath);
+    KNMusicFFMpegTempoCacheItem item;
+    item.filePath=fileInfo.absoluteFilePath();
+    item.size=fileInfo.size();
+    item.lastModified=fileInfo.lastModified().toMSecsSinceEpoch();
+    item.beatsPerMinute=track.beatsPerMinute;
+    item.key=track.key;
+    bool saveRequired;
+    {
+        QMutexLocker cacheLocker(&m_cacheLock);
+        m_cache.insert(cacheKey, item);
+        m_cacheChanged=true;
+        saveRequired=(++m_unsavedCount>=TempoCacheSaveInterval);
+    }
+    if(saveRequired)
+    {
+        saveCache();
+    }
+}
+
+inline QString KNMusicFFMpegTempoScanner::cacheFilePath()
+{
+    return KNGlobal::ensurePathAvaliable(KNMusicGlobal::musicLibraryPath())+
+            "/Tempo.cache";
+}
+
+inline void KNMusicFFMpegTempoScanner::loadCache()
+{
+    QMutexLocker cacheLocker(&m_cacheLock);
+    if(m_cacheLoaded)
+    {
+        return;
+    }
+    m_cacheLoaded=true;
+    QFile cacheFile(cacheFilePath());
+    if(!cacheFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    QDataStream cacheStream(&cacheFile);
+    qint32 version=0;
+    cacheStream>>version;
+    if(version==TempoCacheVersion)
+    {
+        cacheStream>>m_cache;
+        //Drop the broken cache.
+        if(cacheStream.status()!=QDataStream::Ok)
+        {
+            m_cache.clear();
+        }
+    }
+    cacheFile.close();
+    //Drop the results of the removed files, so the cache won't grow forever.
+    QHash<QByteArray, KNMusicFFMpegTempoCacheItem>::iterator i=m_cache.begin();
+    while(i!=m_cache.end())
+    {
+        if(QFileInfo::exists((*i).filePath))
+        {
+            ++i;
+            continue;
+        }
+        i=m_cache.erase(i);
+        m_cacheChanged=true;
+    }
+}
+
+inline void KNMusicFFMpegTempoScanner::saveCache()
+{
+    //Only one thread writes the file at the same time.
+    QMutexLocker saveLocker(&m_saveLock);
+    //Write a copy of the cache, the jobs don't need to wait for the file.
+    QHash<QByteArray, KNMusicFFMpegTempoCacheItem> cache;
+    {
+        QMutexLocker cacheLocker(&m_cacheLock);
+        if(!m_cacheChanged)
+        {
+            return;
+        }
+        cache=m_cache;
+        m_cacheChanged=false;
+        m_unsavedCount=0;
+    }
+    //The old cache is kept when the writing fails.
+    QSaveFile cacheFile(cacheFilePath());
+    if(cacheFile.open(QIODevice::WriteOnly))
+    {
+        QDataStream cacheStream(&cacheFile);
+        cacheStream<<(qint32)TempoCacheVersion<<cache;
+        if(cacheFile.commit())
+        {
+            return;
+        }
+    }
+    //Try again next time.
+    QMutexLocker cacheLocker(&m_cacheLock);
+    m_cacheChanged=true;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGTEMPOSCANNER_H
+#define KNMUSICFFMPEGTEMPOSCANNER_H
+
+#include <QHash>
+#include <QMutex>
+
+#include "knmusictemposcanner.h"
+
+struct KNMusicFFMpegTempoCacheItem
+{
+    //The file of the result, a changed file is scanned again and a removed
+    //file is dropped from the cache.
+    QString filePath;
+    qint64 size=0;
+    qint64 lastModified=0;
+    double beatsPerMinute=0.0;
+    QString key;
+};
+
+class KNMusicFFMpegAnalysisPool;
+class KNMusicFFMpegTempoScanner : public KNMusicTempoScanner
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegTempoScanner(KNMusicFFMpegAnalysisPool *pool,
+                                       QObject *parent = 0);
+    ~KNMusicFFMpegTempoScanner();
+    void scan(const QList<KNMusicTempoItem> &tracks);
+    bool isAborted() const;
+    static QByteArray cacheKey(const KNMusicTempoItem &track);
+    bool cachedResult(const QByteArray &cacheKey, KNMusicTempoItem &track);
+    void cacheResult(const QByteArray &cacheKey,
+                     const KNMusicTempoItem &track);
+
+signals:
+
+public slots:
+
+private:
+    inline QString cacheFilePath();
+    inline void loadCache();
+    inline void saveCache();
+    KNMusicFFMpegAnalysisPool *m_pool;
+    //The results of the scanned tracks, the tempo and the key. The files are
+    //never scanned twice, even they are removed from the library and added
+    //again.
+    QHash<QByteArray, KNMusicFFMpegTempoCacheItem> m_cache;
+    QMutex m_cacheLock, m_saveLock;
+    int m_unsavedCount;
+    bool m_cacheLoaded, m_cacheChanged;
+};
+
+#endif // KNMUSICFFMPEGTEMPOSCANNER_H
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSharedPointer>
+#include <QThread>
+#include <QThreadPool>
+
+#include "knglobal.h"
+#include "knffmpegglobal.h"
+#include "knmusicglobal.h"
+#include "knmusicffmpegwaveformjob.h"
+
+#include "knmusicffmpegwaveformgenerator.h"
+
+KNMusicFFMpegWaveformGenerator::KNMusicFFMpegWaveformGenerator(QObject *parent) :
+    KNMusicWaveformGenerator(parent),
+    m_generation(0)
+{
+    //Initial the global to make sure the FFMpeg has been instanced.
+    KNFFMpegGlobal::instance();
+    //Initial the generate pool, a long track is split into segments, and the
+    //segments are decoded at the same time.
+    m_generatePool=new QThreadPool(this);
+    m_generatePool->setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+}
+
+KNMusicFFMpegWaveformGenerator::~KNMusicFFMpegWaveformGenerator()
+{
+    //Ask the running jobs to quit, and wait for them.
+    m_generation.fetchAndAddOrdered(1);
+    m_generatePool->clear();
+    m_generatePool->waitForDone();
+}
+
+void KNMusicFFMpegWaveformGenerator::generate(const QString &filePath,
+                                              const qint64 &startPosition,
+                                              const qint64 &duration)
+{
+    //Drop the previous generating.
+    int generation=m_generation.fetchAndAddOrdered(1)+1;
+    m_generatePool->clear();
+    if(!QFileInfo::exists(filePath))
+    {
+        return;
+    }
+    //Check the cache first, the cached waveform could be used directly.
+    QString cachePath=cacheFilePath(filePath, startPosition, duration);
+    QFile cacheFile(cachePath);
+    if(cacheFile.open(QIODevice::ReadOnly))
+    {
+        QByteArray waveform=cacheFile.readAll();
+        cacheFile.close();
+        if(waveform.size()==WaveformBucketCount*3)
+        {
+            emit waveformGenerated(filePath, startPosition, waveform);
+            return;
+        }
+    }
+    //Generate the track, the first job will split the track into segments.
+    QSharedPointer<KNMusicFFMpegWaveformTrack> track(
+                new KNMusicFFMpegWaveformTrack);
+    track->filePath=filePath;
+    track->cachePath=cachePath;
+    track->startPosition=startPosition;
+    track->duration=duration;
+    track->generation=generation;
+    startJob(new KNMusicFFMpegWaveformJob(this, track));
+}
+
+int KNMusicFFMpegWaveformGenerator::generation() const
+{
+    return m_generation.loadAcquire();
+}
+
+void KNMusicFFMpegWaveformGenerator::startJob(KNMusicFFMpegWaveformJob *job)
+{
+    m_generatePool->start(job);
+}
+
+inline QString KNMusicFFMpegWaveformGenerator::cacheFilePath(
+        const QString &filePath,
+        const qint64 &startPosition,
+        const qint64 &duration)
+{
+    //The cache is keyed by the hash of the file path, size and modified time,
+    //a changed file will get a new waveform. The section is a part of the key
+    //as well, the tracks of a list file have their own waveforms.
+    QFileInfo fileInfo(filePath);
+    QByteArray fileKey=(fileInfo.absoluteFilePath()+'\n'+
+                        QString::number(fileInfo.size())+'\n'+
+                        QString::number(fileInfo.lastModified().toMSecsSinceEpoch())+'\n'+
+                        QString::number(startPosition)+'\n'+
+                        QString::number(duration)).toUtf8();
+    return KNGlobal::ensurePathAvaliable(KNMusicGlobal::musicLibraryPath()+
+                                         "/Waveforms")+"/"+
+            QCryptographicHash::hash(fileKey, QCryptographicHash::Md5).toHex()+
+            ".waveform";
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGWAVEFORMGENERATOR_H
+#define KNMUSICFFMPEGWAVEFORMGENERATOR_H
+
+#include <QAtomicInt>
+
+#include "knmusicwaveformgenerator.h"
+
+class QThreadPool;
+class KNMusicFFMpegWaveformJob;
+class KNMusicFFMpegWaveformGenerator : public KNMusicWaveformGenerator
+{
+    Q_OBJECT
+public:
+    explicit KNMusicFFMpegWaveformGenerator(QObject *parent = 0);
+    ~KNMusicFFMpegWaveformGenerator();
+    void generate(const QString &filePath,
+                  const qint64 &startPosition=-1,
+                  const qint64 &duration=-1);
+    int generation() const;
+    void startJob(KNMusicFFMpegWaveformJob *job);
+
+signals:
+
+public slots:
+
+private:
+    inline QString cacheFilePath(const QString &filePath,
+                                 const qint64 &startPosition,
+                                 const qint64 &duration);
+    QThreadPool *m_generatePool;
+    //The generation increases when a new waveform is asked, the jobs of the
+    //previous generation will quit.
+    QAtomicInt m_generation;
+};
+
+#endif // KNMUSICFFMPEGWAVEFORMGENERATOR_H
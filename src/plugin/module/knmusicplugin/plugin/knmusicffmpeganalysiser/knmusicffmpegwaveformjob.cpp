@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QFile>
+#include <QThread>
+#include <QtMath>
+
+#include <climits>
+
+#include "knmusicffmpegwaveformgenerator.h"
+
+#include "knmusicffmpegwaveformjob.h"
+
+//A segment should be at least one minute, the short track is not worth to be
+//split.
+#define MinimumSegmentSeconds 60
+//The lanes of the bucket accumulating, it's a multiple of the vector width.
+#define AccumulateLanes 8
+
+KNMusicFFMpegWaveformJob::KNMusicFFMpegWaveformJob(
+        KNMusicFFMpegWaveformGenerator *generator,
+        const QSharedPointer<KNMusicFFMpegWaveformTrack> &track,
+        const int &firstBucket,
+        const int &lastBucket) :
+    m_generator(generator),
+    m_track(track),
+    m_firstBucket(firstBucket),
+    m_lastBucket(lastBucket)
+{
+}
+
+void KNMusicFFMpegWaveformJob::run()
+{
+    bool finished=false;
+    if(isCurrent() && open())
+    {
+        //The first job has to split the track before decoding.
+        if(m_firstBucket==-1 && !splitTrack())
+        {
+            //No other job is started, the track is failed.
+            return;
+        }
+        finished=seekSegment() && decode();
+    }
+    else if(m_firstBucket==-1)
+    {
+        return;
+    }
+    m_reader.close();
+    if(!finished)
+    {
+        m_track->failed.storeRelease(1);
+    }
+    //The last job of the track builds the waveform.
+    if(!m_track->remainCount.deref())
+    {
+        finishTrack();
+    }
+}
+
+inline bool KNMusicFFMpegWaveformJob::isCurrent() const
+{
+    return m_track->generation==m_generator->generation();
+}
+
+inline bool KNMusicFFMpegWaveformJob::open()
+{
+    //The overview doesn't need the channels, mix all the channels into mono
+    //float, this is a quarter of the work for the buckets of a 5.1 track.
+    if(!m_reader.open(m_track->filePath, AV_CH_LAYOUT_MONO))
+    {
+        return false;
+    }
+    m_sampleRate=m_reader.sampleRate();
+    return true;
+}
+
+inline bool KNMusicFFMpegWaveformJob::splitTrack()
+{
+    //Calculate the frames of the track.
+    qint64 trackFrames;
+    if(m_track->duration>0)
+    {
+        trackFrames=m_track->duration*m_sampleRate/1000;
+    }
+    else
+    {
+        trackFrames=m_reader.duration()*m_sampleRate/1000;
+        if(m_track->startPosition>0)
+        {
+            trackFrames-=m_track->startPosition*m_sampleRate/1000;
+        }
+    }
+    if(trackFrames<=0)
+    {
+        return false;
+    }
+    m_track->trackFrames=trackFrames;
+    m_track->bucketFrames=qMax((trackFrames+WaveformBucketCount-1)/
+                               WaveformBucketCount,
+                               (qint64)1);
+    //Reset the buckets.
+    for(int i=0; i<WaveformBucketCount; ++i)
+    {
+        m_track->minimums[i]=1.0f;
+        m_track->maximums[i]=-1.0f;
+        m_track->energies[i]=0.0;
+        m_track->frameCounts[i]=0;
+    }
+    //Split the track into segments, every thread decodes one segment.
+    int segmentCount=qBound((qint64)1,
+                            trackFrames/(m_sampleRate*MinimumSegmentSeconds),
+                            (qint64)qMax(QThread::idealThreadCount(), 1));
+    m_track->remainCount.storeRelease(segmentCount);
+    for(int i=1; i<segmentCount; ++i)
+    {
+        m_generator->startJob(
+                    new KNMusicFFMpegWaveformJob(m_generator,
+                                                 m_track,
+                                                 i*WaveformBucketCount/segmentCount,
+                                                 (i+1)*WaveformBucketCount/segmentCount));
+    }
+    //This job decodes the first segment.
+    m_firstBucket=0;
+    m_lastBucket=WaveformBucketCount/segmentCount;
+    return true;
+}
+
+inline bool KNMusicFFMpegWaveformJob::seekSegment()
+{
+    //Calculate the frame range of the segment, the last segment decodes to the
+    //end of the track, the duration of the file is not always accurate.
+    qint64 sectionStartFrame=m_track->startPosition>0?
+                m_track->startPosition*m_sampleRate/1000:0;
+    m_segmentStart=m_firstBucket*m_track->bucketFrames;
+    m_segmentEnd=m_lastBucket<WaveformBucketCount?
+                m_lastBucket*m_track->bucketFrames:
+                (m_track->duration>0?m_track->trackFrames:LLONG_MAX);
+    m_position=m_segmentStart;
+    //Seek to the segment, the reader starts exactly at the position in ms.
+    return m_reader.seek((sectionStartFrame+m_segmentStart)*1000/m_sampleRate,
+                         m_segmentEnd==LLONG_MAX?
+                             -1:m_segmentEnd-m_segmentStart);
+}
+
+inline bool KNMusicFFMpegWaveformJob::decode()
+{
+    float *samples;
+    int frameCount;
+    while(isCurrent())
+    {
+        frameCount=m_reader.read(&samples);
+        if(frameCount==0)
+        {
+            //The segment is finished.
+            return true;
+        }
+        processFrames(samples, frameCount);
+    }
+    //A new waveform is asked, the segment is not finished.
+    return false;
+}
+
+inline void KNMusicFFMpegWaveformJob::processFrames(const float *samples,
+                                                    int frameCount)
+{
+    //The reader starts from the segment and stops at the end of it.
+    while(frameCount>0)
+    {
+        //The frames after the duration are put into the last bucket.
+        int bucket=(int)qMin(m_position/m_track->bucketFrames,
+                             (qint64)m_lastBucket-1);
+        int frames=bucket==m_lastBucket-1?
+                    frameCount:
+                    (int)qMin((qint64)frameCount,
+                              (bucket+1)*m_track->bucketFrames-m_position);
+        //Accumulate in independent lanes, so the compiler could put the lanes
+        //into vector registers.
+        float minimum[AccumulateLanes], maximum[AccumulateLanes],
+              energy[AccumulateLanes];
+        for(int j=0; j<AccumulateLanes; ++j)
+        {
+            minimum[j]=m_track->minimums[bucket];
+            maximum[j]=m_track->maximums[bucket];
+            energy[j]=0.0f;
+        }
+        int i=0;
+        for(; i+AccumulateLanes<=frames; i+=AccumulateLanes)
+        {
+            for(int j=0; j<AccumulateLanes; ++j)
+            {
+                float sample=samples[i+j];
+                minimum[j]=sample<minimum[j]?sample:minimum[j];
+                maximum[j]=sample>maximum[j]?sample:maximum[j];
+                energy[j]+=sample*sample;
+            }
+        }
+        //The rest of the frames.
+        for(; i<frames; ++i)
+        {
+            float sample=samples[i];
+            minimum[0]=sample<minimum[0]?sample:minimum[0];
+            maximum[0]=sample>maximum[0]?sample:maximum[0];
+            energy[0]+=sample*sample;
+        }
+        double bucketEnergy=0.0;
+        for(int j=0; j<AccumulateLanes; ++j)
+        {
+            m_track->minimums[bucket]=qMin(m_track->minimums[bucket], minimum[j]);
+            m_track->maximums[bucket]=qMax(m_track->maximums[bucket], maximum[j]);
+            bucketEnergy+=energy[j];
+        }
+        m_track->energies[bucket]+=bucketEnergy;
+        m_track->frameCounts[bucket]+=frames;
+        samples+=frames;
+        frameCount-=frames;
+        m_position+=frames;
+    }
+}
+
+inline void KNMusicFFMpegWaveformJob::finishTrack()
+{
+    //Ignore the failed track and the track which is not needed any more.
+    if(m_track->failed.loadAcquire() || !isCurrent())
+    {
+        return;
+    }
+    //Build the waveform from the buckets.
+    QByteArray waveform;
+    waveform.resize(WaveformBucketCount*3);
+    char *bucketData=waveform.data();
+    for(int i=0; i<WaveformBucketCount; ++i)
+    {
+        if(m_track->frameCounts[i]==0)
+        {
+            bucketData[0]=0;
+            bucketData[1]=0;
+            bucketData[2]=0;
+        }
+        else
+        {
+            bucketData[0]=(qint8)qBound(-127,
+                                        qRound(m_track->minimums[i]*127.0f),
+                                        127);
+            bucketData[1]=(qint8)qBound(-127,
+                                        qRound(m_track->maximums[i]*127.0f),
+                                        127);
+            bucketData[2]=(char)(quint8)qBound(
+                        0,
+                        qRound(qSqrt(m_track->energies[i]/
+                                     m_track->frameCounts[i])*255.0),
+                        255);
+        }
+        bucketData+=3;
+    }
+    //Save the waveform to the cache.
+    QFile cacheFile(m_track->cachePath);
+    if(cacheFile.open(QIODevice::WriteOnly))
+    {
+        cacheFile.write(waveform);
+        cacheFile.close();
+    }
+    emit m_generator->waveformGenerated(m_track->filePath,
+                                        m_track->startPosition,
+                                        waveform);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICFFMPEGWAVEFORMJOB_H
+#define KNMUSICFFMPEGWAVEFORMJOB_H
+
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSharedPointer>
+
+#include "knmusicffmpegaudioreader.h"
+#include "knmusicwaveformgenerator.h"
+
+struct KNMusicFFMpegWaveformTrack
+{
+    QString filePath, cachePath;
+    qint64 startPosition=-1, duration=-1;   //Unit: millisecond
+    int generation=0;
+    //The frames of the track and of a bucket, set by the first job.
+    qint64 trackFrames=0, bucketFrames=1;
+    //The datas of the buckets, every segment job only writes its own buckets.
+    float minimums[WaveformBucketCount], maximums[WaveformBucketCount];
+    double energies[WaveformBucketCount];
+    qint64 frameCounts[WaveformBucketCount];
+    //The count of the jobs which are still running, and the failed flag.
+    QAtomicInt remainCount=1, failed=0;
+};
+
+class KNMusicFFMpegWaveformGenerator;
+class KNMusicFFMpegWaveformJob : public QRunnable
+{
+public:
+    //The job without buckets is the first job of the track, it will split the
+    //track into segments.
+    KNMusicFFMpegWaveformJob(KNMusicFFMpegWaveformGenerator *generator,
+                             const QSharedPointer<KNMusicFFMpegWaveformTrack> &track,
+                             const int &firstBucket=-1,
+                             const int &lastBucket=-1);
+    void run();
+
+private:
+    inline bool isCurrent() const;
+    inline bool open();
+    inline bool splitTrack();
+    inline bool seekSegment();
+    inline bool decode();
+    inline void processFrames(const float *samples, int frameCount);
+    inline void finishTrack();
+    KNMusicFFMpegWaveformGenerator *m_generator;
+    QSharedPointer<KNMusicFFMpegWaveformTrack> m_track;
+    KNMusicFFMpegAudioReader m_reader;
+    int m_sampleRate=0, m_firstBucket, m_lastBucket;
+    //The frame positions in the track.
+    qint64 m_segmentStart=0, m_segmentEnd=0, m_position=0;
+};
+
+#endif // KNMUSICFFMPEGWAVEFORMJOB_H
@@ -20,6 +20,8 @@
 #include <QPaintEvent>
 #include <QPainter>
 
+#include <algorithm>
+
 #include "knconfigure.h"
 
 #include "knmusicheaderplayerbase.h"
@@ -54,7 +56,7 @@ KNMusicHeaderLyrics::KNMusicHeaderLyrics(QWidget *parent) :
 
     //Initial the lyrics moving time line.
     m_moveToCurrent=new QTimeLine(m_animationDuration, this);
-    m_moveToCurrent->setUpdateInterval(2);
+    m_moveToCurrent->setUpdateInterval(16);
     m_moveToCurrent->setEasingCurve(QEasingCurve::OutCubic);
     m_moveToCurrent->setEndFrame(0);
     connect(m_moveToCurrent, &QTimeLine::frameChanged,
@@ -103,50 +105,42 @@ void KNMusicHeaderLyrics::onActionPositionChange(const qint64 &position)
     {
         return;
     }
-    //If there's lines but current line is -1, or we reach the very end,
-    //Find from very beginning.
-    if(m_currentLyricsLine<0 || m_currentLyricsLine>=m_lyricsLines)
+    //Find the line of the position.
+    int positionLine=lyricsLineAt(position);
+    if(positionLine==m_currentLyricsLine)
     {
-        //Find current line from the beginning.
-        m_currentLyricsLine=0;
-        while(m_currentLyricsLine<m_lyricsLines &&
-              position<m_positions.at(m_currentLyricsLine))
-        {
-            m_currentLyricsLine++;
-        }
-        update();
         return;
     }
-    int yOffset=0;
-    //Check the position is previous than the current yet.
-    if(position<m_positions.at(m_currentLyricsLine) &&
-            m_currentLyricsLine!=0)
+    //If current line is -1, or the position is far away from the current
+    //line, it should be a seek, simply jump to the line without animation.
+    if(m_currentLyricsLine<0 ||
+            qAbs(positionLine-m_currentLyricsLine)>2)
     {
-        //Find the matching lyrics.
-        while(m_currentLyricsLine>0 &&
-              m_positions.at(m_currentLyricsLine)>position)
-        {
-            yOffset-=lyricsSize(m_lyricsText.at(m_currentLyricsLine)).height();
-            m_currentLyricsLine--;
-        }
-        update();
-        //Start animation.
-        startMovingAnime((lyricsLineDuration(m_currentLyricsLine)>>2),
-                         yOffset);
+        m_currentLyricsLine=positionLine;
+        m_moveToCurrent->stop();
+        onActionLyricsMoved(0);
         return;
     }
-    //Find the next specific position.
-    while(m_currentLyricsLine<m_lyricsLines-2 &&
-          m_positions.at(m_currentLyricsLine+1)<position)
+    //Calculate the offset from the current line to the position line.
+    int yOffset=0;
+    if(positionLine<m_currentLyricsLine)
     {
-        yOffset+=lyricsSize(m_lyricsText.at(m_currentLyricsLine)).height();
-        m_currentLyricsLine++;
+        for(int i=m_currentLyricsLine; i>positionLine; i--)
+        {
+            yOffset-=m_lyricsHeight.at(i)+m_lineSpacing;
+        }
     }
-    if(yOffset>0)
+    else
     {
-        startMovingAnime((lyricsLineDuration(m_currentLyricsLine)>>2),
-                         yOffset);
+        for(int i=m_currentLyricsLine; i<positionLine; i++)
+        {
+            yOffset+=m_lyricsHeight.at(i)+m_lineSpacing;
+        }
     }
+    m_currentLyricsLine=positionLine;
+    //Start animation.
+    startMovingAnime((lyricsLineDuration(m_currentLyricsLine)>>2),
+                     yOffset);
 }
 
 void KNMusicHeaderLyrics::onActionLyricsReset()
@@ -158,6 +152,8 @@ void KNMusicHeaderLyrics::onActionLyricsReset()
     //Clear lyrics manager.
     m_positions.clear();
     m_lyricsText.clear();
+    m_lyricsStaticText.clear();
+    m_lyricsHeight.clear();
     //Update the viewport.
     update();
 }
@@ -175,6 +171,8 @@ void KNMusicHeaderLyrics::onActionLyricsUpdate()
     //Save the position and lyrics text.
     m_positions=m_lyricsManager->positionList();
     m_lyricsText=m_lyricsManager->textList();
+    //Layout all the lines.
+    updateLyricsCache();
     //Update parameters.
     //Get the lyrics lines.
     m_lyricsLines=m_positions.size();
@@ -203,61 +201,56 @@ void KNMusicHeaderLyrics::paintEvent(QPaintEvent *event)
                            QPainter::TextAntialiasing |
                            QPainter::SmoothPixmapTransform,
                            true);
-    QSize currentSize;
-    QString currentText;
+    //All the lines has been laid out in the cache, only draw them here.
     int centerY=(height()>>1)+m_currentLineOffsetY;
     //Draw the current line.
     painter.setPen(m_highlightColor);
-    currentText=m_lyricsText.at(m_currentLyricsLine);
-    currentSize=lyricsSize(currentText);
-    centerY-=(currentSize.height()>>1);
-    painter.drawText(m_leftSpacing,
-                     centerY,
-                     width(),
-                     currentSize.height(),
-                     Qt::AlignLeft,
-                     currentText);
+    int currentHeight=m_lyricsHeight.at(m_currentLyricsLine);
+    centerY-=(currentHeight>>1);
+    painter.drawStaticText(m_leftSpacing,
+                           centerY,
+                           m_lyricsStaticText.at(m_currentLyricsLine));
     //Draw other lyrics.
     painter.setPen(m_normalText);
     //Draw down lines.
-    int lineTop=centerY+currentSize.height()+m_lineSpacing,
+    int lineTop=centerY+currentHeight+m_lineSpacing,
         paintLine=m_currentLyricsLine+1;
     while(lineTop<height() && paintLine<m_lyricsLines)
     {
         //Draw the line.
-        currentText=m_lyricsText.at(paintLine);
-        currentSize=lyricsSize(currentText);
-        painter.drawText(m_leftSpacing,
-                         lineTop,
-                         width(),
-                         currentSize.height(),
-                         Qt::AlignLeft,
-                         currentText);
+        painter.drawStaticText(m_leftSpacing,
+                               lineTop,
+                               m_lyricsStaticText.at(paintLine));
         //To the next line.
+        lineTop+=m_lyricsHeight.at(paintLine)+m_lineSpacing;
         paintLine++;
-        lineTop+=currentSize.height()+m_lineSpacing;
     }
     //Draw up lines.
     int lineBottom=centerY;
     paintLine=m_currentLyricsLine-1;
     while(lineBottom>0 && paintLine>-1)
     {
-        //Draw the line.
-        currentText=m_lyricsText.at(paintLine);
-        currentSize=lyricsSize(currentText);
         //MAGIC: the line bottom is current line's top, so calculate here.
-        lineBottom-=currentSize.height()+m_lineSpacing;
-        painter.drawText(m_leftSpacing,
-                         lineBottom,
-                         width(),
-                         currentSize.height(),
-                         Qt::AlignLeft,
-                         currentText);
+        lineBottom-=m_lyricsHeight.at(paintLine)+m_lineSpacing;
+        //Draw the line.
+        painter.drawStaticText(m_leftSpacing,
+                               lineBottom,
+                               m_lyricsStaticText.at(paintLine));
         //To the previous line.
         paintLine--;
     }
 }
 
+void KNMusicHeaderLyrics::changeEvent(QEvent *event)
+{
+    KNMusicLyricsBase::changeEvent(event);
+    //When the font changed, the lines should be laid out again.
+    if(event->type()==QEvent::FontChange)
+    {
+        updateLyricsCache();
+    }
+}
+
 void KNMusicHeaderLyrics::applyPreference()
 {
     //Update the lyrics folder.
@@ -351,6 +344,33 @@ inline int KNMusicHeaderLyrics::lyricsLineDuration(const int &index)
     return m_animationDuration<<2;
 }
 
+inline int KNMusicHeaderLyrics::lyricsLineAt(const qint64 &position)
+{
+    //Find the last line which starts before the position.
+    int lineIndex=std::upper_bound(m_positions.constBegin(),
+                                   m_positions.constEnd(),
+                                   position)-m_positions.constBegin()-1;
+    //Before the first line, the first line will be displayed.
+    return qMax(lineIndex, 0);
+}
+
+inline void KNMusicHeaderLyrics::updateLyricsCache()
+{
+    m_lyricsStaticText.clear();
+    m_lyricsHeight.clear();
+    m_lyricsStaticText.reserve(m_lyricsText.size());
+    m_lyricsHeight.reserve(m_lyricsText.size());
+    //Shape all the lines with the current font once.
+    for(auto i=m_lyricsText.constBegin(); i!=m_lyricsText.constEnd(); ++i)
+    {
+        QStaticText lineText(*i);
+        lineText.setTextFormat(Qt::PlainText);
+        lineText.prepare(QTransform(), font());
+        m_lyricsStaticText.append(lineText);
+        m_lyricsHeight.append(lyricsSize(*i).height());
+    }
+}
+
 inline void KNMusicHeaderLyrics::startMovingAnime(const int &durationOffset,
                                                   const int &yOffset)
 {
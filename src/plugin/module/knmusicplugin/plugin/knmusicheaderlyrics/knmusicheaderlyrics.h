@@ -18,6 +18,8 @@
 #ifndef KNMUSICHEADERLYRICS_H
 #define KNMUSICHEADERLYRICS_H
 
+#include <QStaticText>
+
 #include "preference/knpreferenceitemglobal.h"
 
 #include "knmusiclyricsbase.h"
@@ -45,6 +47,7 @@ public slots:
 
 protected:
     void paintEvent(QPaintEvent *event);
+    void changeEvent(QEvent *event);
 
 private slots:
     void applyPreference();
@@ -60,6 +63,8 @@ private:
     inline void generateTitleAndItemInfo(KNPreferenceTitleInfo &listTitle,
                                          QList<KNPreferenceItemInfo> &list);
     inline int lyricsLineDuration(const int &index);
+    inline int lyricsLineAt(const qint64 &position);
+    inline void updateLyricsCache();
     inline void startMovingAnime(const int &durationOffset,
                                  const int &yOffset);
     static KNMusicDetailInfo m_currentDeailInfo;
@@ -70,6 +75,8 @@ private:
 
     QList<qint64> m_positions;
     QStringList m_lyricsText;
+    QList<QStaticText> m_lyricsStaticText;
+    QList<int> m_lyricsHeight;
     QTimeLine *m_moveToCurrent;
     int m_currentLyricsLine=-1, m_lyricsLines=0, m_currentLineOffsetY=0,
         m_leftSpacing=15, m_animationDuration=200, m_lineSpacing=2;
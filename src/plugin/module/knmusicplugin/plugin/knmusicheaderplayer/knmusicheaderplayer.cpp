@@ -35,6 +35,7 @@
 #include "knmusicnowplayingbase.h"
 #include "knmusicbackend.h"
 #include "knmusicglobal.h"
+#include "knmusicwaveformgenerator.h"
 
 #include "knglobal.h"
 
@@ -77,6 +78,15 @@ KNMusicHeaderPlayer::KNMusicHeaderPlayer(QWidget *parent) :
     //Connect drag play request.
     connect(this, &KNMusicHeaderPlayer::requireAnalysisFiles,
             this, &KNMusicHeaderPlayer::onActionPlayDragIn);
+
+    //Link the waveform generator if there's one.
+    KNMusicWaveformGenerator *waveformGenerator=
+            KNMusicGlobal::waveformGenerator();
+    if(waveformGenerator!=nullptr)
+    {
+        connect(waveformGenerator, &KNMusicWaveformGenerator::waveformGenerated,
+                this, &KNMusicHeaderPlayer::onActionWaveformGenerated);
+    }
 }
 
 void KNMusicHeaderPlayer::loadConfigure()
@@ -166,6 +176,8 @@ void KNMusicHeaderPlayer::resetInformation()
     //Set the duration and position.
     setDuration(0);
     setPositionText(0);
+    //Clear the waveform.
+    m_progressSlider->setWaveform(QByteArray());
     //Emit reset signal.
     emit playerReset();
 }
@@ -419,6 +431,18 @@ void KNMusicHeaderPlayer::onActionPlayStateChanged(const int &state)
     setPlayIconMode();
 }
 
+void KNMusicHeaderPlayer::onActionWaveformGenerated(const QString &filePath,
+                                                    const qint64 &startPosition,
+                                                    const QByteArray &waveform)
+{
+    //Check the waveform is still the current track's.
+    if(filePath==m_currentFilePath &&
+            startPosition==waveformStartPosition())
+    {
+        m_progressSlider->setWaveform(waveform);
+    }
+}
+
 void KNMusicHeaderPlayer::setPosition(const qint64 &position)
 {
     m_backend->setPosition(position);
@@ -783,10 +807,28 @@ void KNMusicHeaderPlayer::updatePlayerInfo(const KNMusicAnalysisItem &analysisIt
     updateArtistAndAlbum();
     QPixmap coverImage=QPixmap::fromImage(analysisItem.coverImage);
     setAlbumArt(coverImage.isNull()?m_musicGlobal->noAlbumArt():coverImage);
+    //Clear the waveform of the previous track, and ask to generate the new one.
+    m_progressSlider->setWaveform(QByteArray());
+    KNMusicWaveformGenerator *waveformGenerator=
+            KNMusicGlobal::waveformGenerator();
+    if(waveformGenerator!=nullptr)
+    {
+        waveformGenerator->generate(m_currentFilePath,
+                                    waveformStartPosition(),
+                                    m_currentDetailInfo.trackFilePath.isEmpty()?
+                                        -1:m_currentDetailInfo.duration);
+    }
     //Ask to load lyrics.
 //    emit requireLoadLyrics(m_currentDetailInfo);
 }
 
+inline qint64 KNMusicHeaderPlayer::waveformStartPosition()
+{
+    //Only the track of a list file is a section of the file.
+    return m_currentDetailInfo.trackFilePath.isEmpty()?
+                -1:m_currentDetailInfo.startPosition;
+}
+
 inline void KNMusicHeaderPlayer::initialInformationPanel()
 {
     initialAlbumArt();
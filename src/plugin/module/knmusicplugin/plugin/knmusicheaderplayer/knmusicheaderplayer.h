@@ -70,6 +70,9 @@ private slots:
     void onActionPositionChanged(const qint64 &position);
     void onActionDurationChanged(const qint64 &duration);
     void onActionPlayStateChanged(const int &state);
+    void onActionWaveformGenerated(const QString &filePath,
+                                   const qint64 &startPosition,
+                                   const QByteArray &waveform);
 
     void setPosition(const qint64 &position);
     void updatePlayerInfo(const KNMusicAnalysisItem &analysisItem);
@@ -90,6 +93,7 @@ private:
     inline void setPlayIconMode();
     inline void setPauseIconMode();
     inline void updateArtistAndAlbum();
+    inline qint64 waveformStartPosition();
 
     inline void configureScrollLabel(KNScrollLabel *label);
     inline void configurePanelAnimation(QPropertyAnimation *animation);
@@ -59,6 +59,8 @@ KNMusicLibrary::KNMusicLibrary(QObject *parent) :
     m_libraryModel=new KNMusicLibraryModel(this);
     m_libraryModel->setDatabase(m_libraryDatabase);
     m_libraryModel->setImageManager(m_libraryImageManager);
+    //Playlists find the library tracks through the library model.
+    KNMusicGlobal::setLibraryModel(m_libraryModel);
 
     QList<QAction *> showInActionList;
     //Initial the song tab.
@@ -70,6 +72,7 @@ KNMusicLibrary::KNMusicLibrary(QObject *parent) :
             this, &KNMusicLibrary::onActionLoadLibrary);
     //Get the go to action.
     showInActionList.append(m_librarySongTab->showInAction());
+    showInActionList.append(m_librarySongTab->selectDuplicatesAction());
 
     //Initial the category tabs.
     initialArtistTab();
@@ -101,6 +104,8 @@ KNMusicLibrary::KNMusicLibrary(QObject *parent) :
 
 KNMusicLibrary::~KNMusicLibrary()
 {
+    //The library model is going to be removed.
+    KNMusicGlobal::setLibraryModel(nullptr);
     //Quit the threads.
     m_libraryDatabaseThread->quit();
     m_libraryImageThread->quit();
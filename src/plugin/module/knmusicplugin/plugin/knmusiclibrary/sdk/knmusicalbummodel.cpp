@@ -47,13 +47,8 @@ void KNMusicAlbumModel::onCategoryAdded(const QList<QStandardItem *> &musicRow)
         albumArtist=musicRow.at(Artist)->text();
     }
     //Search the category text.
-    QModelIndexList results=
-            match(index(0,0),
-                  Qt::DisplayRole,
-                  categoryText,
-                  1,
-                  Qt::MatchFixedString | Qt::MatchCaseSensitive);
-    if(results.isEmpty())
+    QModelIndex resultIndex=searchCategory(categoryText, 0);
+    if(!resultIndex.isValid())
     {
         //We need to generate a new item for it.
         QStandardItem *item=generateItem(categoryText);
@@ -63,12 +58,11 @@ void KNMusicAlbumModel::onCategoryAdded(const QList<QStandardItem *> &musicRow)
         artistList.insert(albumArtist, 1);
         item->setData(artistList, CategoryArtistList);
         //Add the item to category model.
-        appendRow(item);
+        appendCategory(item);
     }
     else
     {
         //Add the counter of the result.
-        QModelIndex resultIndex=results.first();
         setData(resultIndex,
                 data(resultIndex, CategoryItemSizeRole).toInt()+1,
                 CategoryItemSizeRole);
@@ -192,13 +186,8 @@ void KNMusicAlbumModel::onCategoryRecover(const QList<QStandardItem *> &musicRow
         albumArtist=musicRow.at(Artist)->text();
     }
     //Search the category text.
-    QModelIndexList results=
-            match(index(0,0),
-                  Qt::DisplayRole,
-                  categoryText,
-                  1,
-                  Qt::MatchFixedString | Qt::MatchCaseSensitive);
-    if(results.isEmpty())
+    QModelIndex resultIndex=searchCategory(categoryText, 0);
+    if(!resultIndex.isValid())
     {
         //We need to generate a new item for it.
         QStandardItem *item=generateItem(categoryText);
@@ -210,12 +199,11 @@ void KNMusicAlbumModel::onCategoryRecover(const QList<QStandardItem *> &musicRow
         artistList.insert(albumArtist, 1);
         item->setData(artistList, CategoryArtistList);
         //Add the item to category model.
-        appendRow(item);
+        appendCategory(item);
     }
     else
     {
         //Add the counter of the result.
-        QModelIndex resultIndex=results.first();
         setData(resultIndex,
                 data(resultIndex, CategoryItemSizeRole).toInt()+1,
                 CategoryItemSizeRole);
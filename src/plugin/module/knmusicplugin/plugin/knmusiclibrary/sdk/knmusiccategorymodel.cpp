@@ -107,29 +107,38 @@ void KNMusicCategoryModel::onCategoryAdded(const QList<QStandardItem *> &musicRo
         return;
     }
     //Search the category text.
-    QModelIndexList results=
-            match(index(1,0),
-                  Qt::DisplayRole,
-                  categoryText,
-                  1,
-                  Qt::MatchFixedString);
-    if(results.isEmpty())
+    QModelIndex resultIndex=searchCategory(categoryText, 1);
+    if(!resultIndex.isValid())
     {
         //We need to generate a new item for it.
         QStandardItem *item=generateItem(categoryText);
         item->setData(1, CategoryItemSizeRole);
-        appendRow(item);
+        appendCategory(item);
     }
     else
     {
         //Add the counter of the result.
-        QModelIndex resultIndex=results.first();
         setData(resultIndex,
                 data(resultIndex, CategoryItemSizeRole).toInt()+1,
                 CategoryItemSizeRole);
     }
 }
 
+void KNMusicCategoryModel::onCategoryAddedRows(const QList<QList<QStandardItem *> > &musicRows)
+{
+    //Remember the rows of the categories while adding the rows, each category
+    //will only be searched once in a batch.
+    m_batch=true;
+    for(QList<QList<QStandardItem *> >::const_iterator i=musicRows.constBegin();
+        i!=musicRows.constEnd();
+        ++i)
+    {
+        onCategoryAdded(*i);
+    }
+    m_batch=false;
+    m_batchRows.clear();
+}
+
 void KNMusicCategoryModel::onCategoryRemoved(const QList<QStandardItem *> &musicRow)
 {
     QModelIndex resultIndex;
@@ -199,31 +208,40 @@ void KNMusicCategoryModel::onCategoryRecover(const QList<QStandardItem *> &music
         return;
     }
     //Search the category text.
-    QModelIndexList results=
-            match(index(1,0),
-                  Qt::DisplayRole,
-                  categoryText,
-                  1,
-                  Qt::MatchFixedString | Qt::MatchCaseSensitive);
-    if(results.isEmpty())
+    QModelIndex resultIndex=searchCategory(categoryText, 1);
+    if(!resultIndex.isValid())
     {
         //We need to generate a new item for it.
         QStandardItem *item=generateItem(categoryText);
         item->setData(1, CategoryItemSizeRole);
         item->setData(musicRow.at(Name)->data(ArtworkKeyRole),
                       CategoryArtworkKeyRole);
-        appendRow(item);
+        appendCategory(item);
     }
     else
     {
         //Add the counter of the result.
-        QModelIndex resultIndex=results.first();
         setData(resultIndex,
                 data(resultIndex, CategoryItemSizeRole).toInt()+1,
                 CategoryItemSizeRole);
     }
 }
 
+void KNMusicCategoryModel::onCategoryRecoverRows(const QList<QList<QStandardItem *> > &musicRows)
+{
+    //Remember the rows of the categories while recovering the rows, each
+    //category will only be searched once in a batch.
+    m_batch=true;
+    for(QList<QList<QStandardItem *> >::const_iterator i=musicRows.constBegin();
+        i!=musicRows.constEnd();
+        ++i)
+    {
+        onCategoryRecover(*i);
+    }
+    m_batch=false;
+    m_batchRows.clear();
+}
+
 void KNMusicCategoryModel::onCoverImageUpdate(const QString &categoryText,
                                               const QString &imageKey,
                                               const QPixmap &image)
@@ -282,6 +300,47 @@ void KNMusicCategoryModel::onImageRecoverComplete(KNHashPixmapList *pixmapList)
     }
 }
 
+QModelIndex KNMusicCategoryModel::searchCategory(const QString &categoryText,
+                                                 const int &startRow)
+{
+    //Check the rows we have found in current batch.
+    if(m_batch)
+    {
+        QHash<QString, int>::const_iterator cachedRow=
+                m_batchRows.constFind(categoryText);
+        if(cachedRow!=m_batchRows.constEnd())
+        {
+            return index(cachedRow.value(), 0);
+        }
+    }
+    //Search the category text.
+    QModelIndexList results=
+            match(index(startRow,0),
+                  Qt::DisplayRole,
+                  categoryText,
+                  1,
+                  Qt::MatchFixedString | Qt::MatchCaseSensitive);
+    if(results.isEmpty())
+    {
+        return QModelIndex();
+    }
+    if(m_batch)
+    {
+        m_batchRows.insert(categoryText, results.first().row());
+    }
+    return results.first();
+}
+
+void KNMusicCategoryModel::appendCategory(QStandardItem *item)
+{
+    //Add the item to the model, remember the row in a batch.
+    appendRow(item);
+    if(m_batch)
+    {
+        m_batchRows.insert(item->text(), item->row());
+    }
+}
+
 QStandardItem *KNMusicCategoryModel::generateItem(const QString &itemText,
                                                   const QPixmap &itemIcon)
 {
@@ -18,6 +18,7 @@
 #ifndef KNMUSICCATEGORYMODEL_H
 #define KNMUSICCATEGORYMODEL_H
 
+#include <QHash>
 #include <QStandardItemModel>
 
 #include "knmusicglobal.h"
@@ -47,8 +48,10 @@ signals:
 
 public slots:
     virtual void onCategoryAdded(const QList<QStandardItem *> &musicRow);
+    virtual void onCategoryAddedRows(const QList<QList<QStandardItem *> > &musicRows);
     virtual void onCategoryRemoved(const QList<QStandardItem *> &musicRow);
     virtual void onCategoryRecover(const QList<QStandardItem *> &musicRow);
+    virtual void onCategoryRecoverRows(const QList<QList<QStandardItem *> > &musicRows);
     virtual void onCoverImageUpdate(const QString &categoryText,
                                     const QString &imageKey,
                                     const QPixmap &image);
@@ -57,6 +60,9 @@ public slots:
 protected:
     virtual QStandardItem *generateItem(const QString &itemText,
                                         const QPixmap &itemIcon=QPixmap());
+    QModelIndex searchCategory(const QString &categoryText,
+                               const int &startRow);
+    void appendCategory(QStandardItem *item);
 
 private:
     inline void resetModel();
@@ -69,8 +75,10 @@ private:
         //Update the artwork key.
         setData(target, artworkKey, CategoryArtworkKeyRole);
     }
+    QHash<QString, int> m_batchRows;
     int m_categoryIndex=-1;
     bool m_updateAlbumArt=true;
+    bool m_batch=false;
     QIcon m_noAlbumIcon;
     QString m_noCategoryText;
 };
@@ -18,6 +18,7 @@
 #include "knhashpixmaplist.h"
 #include "knmusicparser.h"
 #include "knmusicmodelassist.h"
+#include "knmusiclibraryimagemanager.h"
 
 #include "knmusiclibraryanalysisextend.h"
 
@@ -38,14 +39,27 @@ void KNMusicLibraryAnalysisExtend::onActionParseNextImage()
     {
         return;
     }
+    //When the image writers are busy, wait for them, or the images which are
+    //waiting to be written will pile up in the memory.
+    if(m_imageManager!=nullptr && m_imageManager->isSaveQueueFull())
+    {
+        m_waitForImageManager=true;
+        return;
+    }
     //Analysis the first item in the queue.
     AlbumArtItem currentItem=m_analysisQueue.takeFirst();
-    KNMusicGlobal::parser()->parseAlbumArt(currentItem.analysisItem);
-    if(!currentItem.analysisItem.coverImage.isNull())
+    //Only get the compressed data, the tracks of an album always have the
+    //same album art, it will only be decoded when it's a new image.
+    KNMusicGlobal::parser()->parseAlbumArtData(currentItem.analysisItem);
+    //Add the image data in the hash pixmap list, get the hash key.
+    QString imageKey=
+            m_coverImageList->appendImageData(
+                currentItem.analysisItem.coverImageData);
+    if(!imageKey.isEmpty())
     {
-        //Add the image data in the hash pixmap list, get the hash key.
-        currentItem.analysisItem.detailInfo.coverImageHash=
-                m_coverImageList->appendImage(currentItem.analysisItem.coverImage);
+        currentItem.analysisItem.detailInfo.coverImageHash=imageKey;
+        //The row doesn't need the compressed data.
+        currentItem.analysisItem.coverImageData.clear();
         //Require update the row.
         if(currentItem.itemIndex.isValid())
         {
@@ -67,11 +81,40 @@ void KNMusicLibraryAnalysisExtend::setCoverImageList(KNHashPixmapList *coverImag
     m_coverImageList=coverImageList;
 }
 
+void KNMusicLibraryAnalysisExtend::setImageManager(
+        KNMusicLibraryImageManager *imageManager)
+{
+    m_imageManager=imageManager;
+    //Continue the analysis when the image writers are available.
+    connect(m_imageManager, &KNMusicLibraryImageManager::saveQueueAvailable,
+            this, &KNMusicLibraryAnalysisExtend::onActionSaveQueueAvailable);
+}
+
+void KNMusicLibraryAnalysisExtend::onActionSaveQueueAvailable()
+{
+    //Check whether the analysis is waiting.
+    if(m_waitForImageManager)
+    {
+        m_waitForImageManager=false;
+        emit requireParseNextImage();
+    }
+}
+
 void KNMusicLibraryAnalysisExtend::onActionAnalysisComplete(
         const KNMusicAnalysisItem &analysisItem)
 {
-    emit requireAppendLibraryRow(KNMusicModelAssist::generateRow(analysisItem.detailInfo),
-                                 analysisItem);
+    //Save the analysis item first, the pending row may be sent at once.
+    m_pendingItems.append(analysisItem);
+    appendPendingRow(KNMusicModelAssist::generateRow(analysisItem.detailInfo));
+}
+
+void KNMusicLibraryAnalysisExtend::commitPendingRows(
+        const QList<QList<QStandardItem *> > &musicRows)
+{
+    //Send the rows together with their analysis items.
+    QList<KNMusicAnalysisItem> analysisItems;
+    analysisItems.swap(m_pendingItems);
+    emit requireAppendLibraryRows(musicRows, analysisItems);
 }
 
 void KNMusicLibraryAnalysisExtend::onActionAnalysisAlbumArt(QStandardItem *item,
@@ -38,6 +38,7 @@ using namespace KNMusic;
 using namespace KNMusicLibraryAlbumArt;
 
 class KNHashPixmapList;
+class KNMusicLibraryImageManager;
 class KNMusicLibraryAnalysisExtend : public KNMusicAnalysisExtend
 {
     Q_OBJECT
@@ -45,11 +46,12 @@ public:
     explicit KNMusicLibraryAnalysisExtend(QObject *parent = 0);
     KNHashPixmapList *coverImageList() const;
     void setCoverImageList(KNHashPixmapList *coverImageList);
+    void setImageManager(KNMusicLibraryImageManager *imageManager);
 
 signals:
     void requireParseNextImage();
-    void requireAppendLibraryRow(QList<QStandardItem *> musicRow,
-                                 KNMusicAnalysisItem analysisItem);
+    void requireAppendLibraryRows(QList<QList<QStandardItem *> > musicRows,
+                                  QList<KNMusicAnalysisItem> analysisItems);
     void requireUpdateImage(int row,
                             KNMusicAnalysisItem analysisItem);
 
@@ -58,12 +60,19 @@ public slots:
     void onActionAnalysisAlbumArt(QStandardItem *item,
                                   const KNMusicAnalysisItem &analysisItem);
 
+protected:
+    void commitPendingRows(const QList<QList<QStandardItem *> > &musicRows);
+
 private slots:
     void onActionParseNextImage();
+    void onActionSaveQueueAvailable();
 
 private:
+    QList<KNMusicAnalysisItem> m_pendingItems;
     QLinkedList<AlbumArtItem> m_analysisQueue;
     KNHashPixmapList *m_coverImageList;
+    KNMusicLibraryImageManager *m_imageManager=nullptr;
+    bool m_waitForImageManager=false;
 };
 
 #endif // KNMUSICLIBRARYANALYSISEXTEND_H
@@ -18,17 +18,56 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QImageReader>
+#include <QThreadPool>
+#include <QTimer>
 
 #include "knhashpixmaplist.h"
+#include "knmusiclibraryimagewriter.h"
 
 #include "knmusiclibraryimagemanager.h"
 
+//The images which are waiting to be written, when there're more images than
+//this, the analysis will wait for the writers.
+#define MaxPendingImageCount 32
+#define ImageWriterCount 2
+//The removed images are removed together after this delay.
+#define RemoveImageDelay 2000
+
 KNMusicLibraryImageManager::KNMusicLibraryImageManager(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_pendingCount(0)
+{
+    //Initial the writer pool.
+    m_writerPool=new QThreadPool(this);
+    m_writerPool->setMaxThreadCount(ImageWriterCount);
+    //The writers give out the signal in the pool threads.
+    connect(this, &KNMusicLibraryImageManager::imageSaved,
+            this, &KNMusicLibraryImageManager::onActionImageSaved,
+            Qt::QueuedConnection);
+    //Initial the remove timer.
+    m_removeTimer=new QTimer(this);
+    m_removeTimer->setInterval(RemoveImageDelay);
+    m_removeTimer->setSingleShot(true);
+    connect(m_removeTimer, &QTimer::timeout,
+            this, &KNMusicLibraryImageManager::onActionRemoveImages);
+    //Get all the suffixes of the images which could be loaded.
+    QList<QByteArray> imageFormats=QImageReader::supportedImageFormats();
+    for(QList<QByteArray>::iterator i=imageFormats.begin();
+        i!=imageFormats.end();
+        ++i)
+    {
+        m_imageSuffixes.append(QString(*i).toLower());
+    }
+}
+
+KNMusicLibraryImageManager::~KNMusicLibraryImageManager()
 {
-    //Connect mission request loop.
-    connect(this, &KNMusicLibraryImageManager::requireSaveNext,
-            this, &KNMusicLibraryImageManager::onActionSaveNext);
+    //Wait for all the writers.
+    m_writerPool->waitForDone();
+    m_savingImages.clear();
+    //Remove the rest images.
+    onActionRemoveImages();
 }
 
 KNHashPixmapList *KNMusicLibraryImageManager::pixmapList() const
@@ -72,11 +111,12 @@ void KNMusicLibraryImageManager::recoverFromFolder()
         i!=contentInfos.end();
         ++i)
     {
-        //Load all the png image to hash list.
-        if((*i).isFile() && (*i).suffix().toLower()=="png")
+        //Load all the image to hash list, the images are saved in their
+        //original format.
+        if((*i).isFile() && m_imageSuffixes.contains((*i).suffix().toLower()))
         {
             //Load the image.
-            QImage currentImage=QImage((*i).absoluteFilePath(), "png");
+            QImage currentImage=QImage((*i).absoluteFilePath());
             //If there's image data, insert to pixmap list.
             if(!currentImage.isNull())
             {
@@ -88,50 +128,94 @@ void KNMusicLibraryImageManager::recoverFromFolder()
     emit recoverComplete();
 }
 
-void KNMusicLibraryImageManager::removeImage(const QString &imageHash)
+bool KNMusicLibraryImageManager::isSaveQueueFull() const
 {
-    //Check is the file exist.
-    QFileInfo imageFileInfo(m_imageFolderPath + "/" + imageHash + ".png");
-    //If it's exist.
-    if(imageFileInfo.exists())
+    return m_pendingCount.load()>=MaxPendingImageCount;
+}
+
+void KNMusicLibraryImageManager::saveImage(const QString &imageHash,
+                                           const QByteArray &imageData)
+{
+    //The image is used again, don't remove it.
+    m_removeQueue.removeAll(imageHash);
+    //Generate the save item.
+    KNMusicLibraryImageSaveItem saveItem;
+    saveItem.imageFolderPath=m_imageFolderPath;
+    saveItem.imageHash=imageHash;
+    saveItem.imageData=imageData;
+    //Only the image without compressed data need the decoded image.
+    QImage image;
+    if(imageData.isEmpty())
     {
-        //If it's a file, remove it.
-        if(imageFileInfo.isFile())
+        image=m_pixmapList->image(imageHash);
+        if(image.isNull())
         {
-            QFile imageFile(imageFileInfo.absoluteFilePath());
-            imageFile.remove();
             return;
         }
     }
+    //Give the image to the writers.
+    m_pendingCount.ref();
+    m_savingImages[imageHash]++;
+    m_writerPool->start(new KNMusicLibraryImageWriter(this, saveItem, image));
+}
+
+void KNMusicLibraryImageManager::removeImage(const QString &imageHash)
+{
+    //Remove the images later together.
+    if(!m_removeQueue.contains(imageHash))
+    {
+        m_removeQueue.append(imageHash);
+    }
+    m_removeTimer->start();
 }
 
-void KNMusicLibraryImageManager::saveImage(const QString &imageHash)
+void KNMusicLibraryImageManager::onActionImageSaved(const QString &imageHash)
 {
-    //Append the image hash to mission list.
-    m_imageHashList.append(imageHash);
-    //Ask to save.
-    emit requireSaveNext();
+    //Update the saving image counter.
+    QHash<QString, int>::iterator savingImage=m_savingImages.find(imageHash);
+    if(savingImage!=m_savingImages.end() && --savingImage.value()==0)
+    {
+        m_savingImages.erase(savingImage);
+    }
+    //When the queue is not full any more, tell the analysis to continue.
+    if(m_pendingCount.fetchAndAddOrdered(-1)==MaxPendingImageCount)
+    {
+        emit saveQueueAvailable();
+    }
 }
 
-void KNMusicLibraryImageManager::onActionSaveNext()
+void KNMusicLibraryImageManager::onActionRemoveImages()
 {
-    //Check the mission list is empty or not.
-    if(m_imageHashList.isEmpty())
+    QDir imageDir(m_imageFolderPath);
+    QStringList removeQueue;
+    removeQueue.swap(m_removeQueue);
+    for(QStringList::iterator i=removeQueue.begin();
+        i!=removeQueue.end();
+        ++i)
     {
-        return;
+        //If the image is still being written, remove it in the next time.
+        if(m_savingImages.contains(*i))
+        {
+            m_removeQueue.append(*i);
+            continue;
+        }
+        //The image could be saved in any format, find the file with the hash.
+        QFileInfoList imageFileInfos=
+                imageDir.entryInfoList(QStringList((*i)+".*"), QDir::Files);
+        //Remove the image files.
+        for(QFileInfoList::iterator j=imageFileInfos.begin();
+            j!=imageFileInfos.end();
+            ++j)
+        {
+            QFile imageFile((*j).absoluteFilePath());
+            imageFile.remove();
+        }
     }
-    //Get the first image.
-    QString hashData=m_imageHashList.takeFirst();
-    QImage currentImage=m_pixmapList->image(hashData);
-    //Check is the image null, if not, save it.
-    if(!currentImage.isNull())
+    //Check the images left.
+    if(!m_removeQueue.isEmpty())
     {
-        //Using hash data as file name.
-        currentImage.save(m_imageFolderPath + "/" + hashData + ".png",
-                          "PNG");
+        m_removeTimer->start();
     }
-    //Ask to save next image.
-    emit requireSaveNext();
 }
 
 QString KNMusicLibraryImageManager::imageFolderPath() const
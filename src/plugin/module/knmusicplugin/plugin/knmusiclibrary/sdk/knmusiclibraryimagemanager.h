@@ -18,37 +18,56 @@
 #ifndef KNMUSICLIBRARYIMAGEMANAGER_H
 #define KNMUSICLIBRARYIMAGEMANAGER_H
 
+#include <QAtomicInt>
+#include <QHash>
 #include <QStringList>
 
 #include <QObject>
 
+struct KNMusicLibraryImageSaveItem
+{
+    QString imageFolderPath;
+    QString imageHash;
+    QByteArray imageData;
+};
+
+class QThreadPool;
+class QTimer;
 class KNHashPixmapList;
 class KNMusicLibraryImageManager : public QObject
 {
     Q_OBJECT
 public:
     explicit KNMusicLibraryImageManager(QObject *parent = 0);
+    ~KNMusicLibraryImageManager();
     KNHashPixmapList *pixmapList() const;
     void setPixmapList(KNHashPixmapList *pixmapList);
     void recoverFromFolder();
-    void removeImage(const QString &imageHash);
+    bool isSaveQueueFull() const;
     QString imageFolderPath() const;
     void setImageFolderPath(const QString &imageFolderPath);
 
 signals:
-    void requireSaveNext();
     void recoverComplete();
+    void imageSaved(QString imageHash);
+    void saveQueueAvailable();
 
 public slots:
-    void saveImage(const QString &imageHash);
+    void saveImage(const QString &imageHash, const QByteArray &imageData);
+    void removeImage(const QString &imageHash);
 
 private slots:
-    void onActionSaveNext();
+    void onActionImageSaved(const QString &imageHash);
+    void onActionRemoveImages();
 
 private:
-    QStringList m_imageHashList;
+    QHash<QString, int> m_savingImages;
+    QStringList m_imageSuffixes, m_removeQueue;
     QString m_imageFolderPath;
+    QAtomicInt m_pendingCount;
     KNHashPixmapList *m_pixmapList=nullptr;
+    QThreadPool *m_writerPool;
+    QTimer *m_removeTimer;
 };
 
 #endif // KNMUSICLIBRARYIMAGEMANAGER_H
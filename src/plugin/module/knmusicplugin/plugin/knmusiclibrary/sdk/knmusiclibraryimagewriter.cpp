@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QBuffer>
+#include <QImageReader>
+#include <QSaveFile>
+
+#include "kntrace.h"
+
+#include "knmusiclibraryimagewriter.h"
+
+KNMusicLibraryImageWriter::KNMusicLibraryImageWriter(
+        KNMusicLibraryImageManager *imageManager,
+        const KNMusicLibraryImageSaveItem &saveItem,
+        const QImage &image) :
+    QRunnable(),
+    m_imageManager(imageManager),
+    m_saveItem(saveItem),
+    m_image(image)
+{
+}
+
+void KNMusicLibraryImageWriter::run()
+{
+    KNTraceScope("artwork", "KNMusicLibraryImageWriter::run");
+    //Write to a temporary file first, it will be renamed to the image file
+    //only when all the data is written, so there won't be any broken image.
+    QSaveFile imageFile(imageFilePath());
+    if(imageFile.open(QIODevice::WriteOnly))
+    {
+        //Only encode the image when there's no compressed data, or else save
+        //the original data, it doesn't need to be encoded again.
+        if(m_saveItem.imageData.isEmpty())
+        {
+            m_image.save(&imageFile, "PNG");
+        }
+        else
+        {
+            imageFile.write(m_saveItem.imageData);
+        }
+        imageFile.commit();
+    }
+    //Tell the manager the image is saved.
+    emit m_imageManager->imageSaved(m_saveItem.imageHash);
+}
+
+QString KNMusicLibraryImageWriter::imageFilePath()
+{
+    QString imageFormat;
+    if(!m_saveItem.imageData.isEmpty())
+    {
+        //Get the format from the header of the data.
+        QBuffer imageBuffer;
+        imageBuffer.setData(m_saveItem.imageData);
+        imageBuffer.open(QIODevice::ReadOnly);
+        imageFormat=QImageReader::imageFormat(&imageBuffer).toLower();
+        imageBuffer.close();
+    }
+    //Using hash data as file name, the format as the suffix.
+    return m_saveItem.imageFolderPath + "/" + m_saveItem.imageHash + "." +
+            (imageFormat.isEmpty()?QString("png"):imageFormat);
+}
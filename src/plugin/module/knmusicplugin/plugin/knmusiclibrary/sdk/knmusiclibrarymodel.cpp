@@ -15,20 +15,33 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
+#include <QSet>
 #include <QThread>
+#include <QTimer>
 
 #include "knhashpixmaplist.h"
 #include "knjsondatabase.h"
 #include "knglobal.h"
 
 #include "knmusicmodelassist.h"
+#include "knmusicloudnessscanner.h"
+#include "knmusicfingerprinter.h"
+#include "knmusictemposcanner.h"
+#include "knmusicduplicatefinder.h"
 #include "knmusiclibraryanalysisextend.h"
 #include "knmusiclibraryimagemanager.h"
+#include "knmusiclibraryrecover.h"
+#include "kntrace.h"
 
 #include "knmusiclibrarymodel.h"
 
 #include <QDebug>
 
+//The rows are appended in batches while importing, the tracks are analysed
+//when no batch comes in this time. All the analysers ask for the same tracks
+//together, so every track is decoded only once.
+#define AnalysisDelay 2000
+
 KNMusicLibraryModel::KNMusicLibraryModel(QObject *parent) :
     KNMusicModel(parent)
 {
@@ -43,15 +56,62 @@ KNMusicLibraryModel::KNMusicLibraryModel(QObject *parent) :
     m_analysisExtend->setCoverImageList(m_coverImageList);
     connect(m_analysisExtend, &KNMusicLibraryAnalysisExtend::requireUpdateImage,
             this, &KNMusicLibraryModel::updateCoverImage);
-    connect(m_analysisExtend, &KNMusicLibraryAnalysisExtend::requireAppendLibraryRow,
-            this, &KNMusicLibraryModel::appendLibraryMusicRow);
+    connect(m_analysisExtend, &KNMusicLibraryAnalysisExtend::requireAppendLibraryRows,
+            this, &KNMusicLibraryModel::appendLibraryMusicRows);
     setAnalysisExtend(m_analysisExtend);
+    //Initial the analysis timer.
+    m_analysisTimer=new QTimer(this);
+    m_analysisTimer->setSingleShot(true);
+    m_analysisTimer->setInterval(AnalysisDelay);
+    connect(m_analysisTimer, &QTimer::timeout,
+            this, &KNMusicLibraryModel::onActionStartAnalysis);
+    //Link the loudness scanner if there's one.
+    KNMusicLoudnessScanner *loudnessScanner=KNMusicGlobal::loudnessScanner();
+    if(loudnessScanner!=nullptr)
+    {
+        connect(loudnessScanner, &KNMusicLoudnessScanner::albumScanned,
+                this, &KNMusicLibraryModel::onActionAlbumScanned);
+    }
+    //Link the fingerprinter if there's one.
+    KNMusicFingerprinter *fingerprinter=KNMusicGlobal::fingerprinter();
+    if(fingerprinter!=nullptr)
+    {
+        connect(fingerprinter, &KNMusicFingerprinter::trackFingerprinted,
+                this, &KNMusicLibraryModel::onActionTrackFingerprinted);
+    }
+    //Link the tempo scanner if there's one.
+    KNMusicTempoScanner *tempoScanner=KNMusicGlobal::tempoScanner();
+    if(tempoScanner!=nullptr)
+    {
+        connect(tempoScanner, &KNMusicTempoScanner::trackScanned,
+                this, &KNMusicLibraryModel::onActionTrackTempoScanned);
+    }
+    //Initial the duplicate finder, it works in the analysis thread.
+    m_duplicateFinder=new KNMusicDuplicateFinder;
+    m_duplicateFinder->moveToThread(m_musicGlobal->analysisThread());
+    connect(this, &KNMusicLibraryModel::requireFindDuplicates,
+            m_duplicateFinder, &KNMusicDuplicateFinder::findDuplicates);
+    connect(m_duplicateFinder, &KNMusicDuplicateFinder::duplicatesFound,
+            this, &KNMusicLibraryModel::onActionDuplicatesFound);
 
     //Connect language changed request.
     connect(KNGlobal::instance(), &KNGlobal::requireRetranslate,
             this, &KNMusicLibraryModel::retranslate);
 }
 
+KNMusicLibraryModel::~KNMusicLibraryModel()
+{
+    //Recover the memory.
+    delete m_recover;
+    delete m_duplicateFinder;
+    for(QList<QList<QStandardItem *> >::iterator i=m_delayedRows.begin();
+        i!=m_delayedRows.end();
+        ++i)
+    {
+        qDeleteAll(*i);
+    }
+}
+
 Qt::DropActions KNMusicLibraryModel::supportedDropActions() const
 {
     return Qt::IgnoreAction;
@@ -114,6 +174,14 @@ int KNMusicLibraryModel::rowFromDetailInfo(const KNMusicDetailInfo &detailInfo)
     return -1;
 }
 
+int KNMusicLibraryModel::rowFromTrackId(const quint32 &trackId)
+{
+    //The first item of the row is kept for the track, it's still the same item
+    //when the rows are moved.
+    QStandardItem *trackItem=m_trackItems.value(trackId, nullptr);
+    return trackItem==nullptr?-1:trackItem->row();
+}
+
 int KNMusicLibraryModel::playingItemColumn()
 {
     return BlankData;
@@ -191,39 +259,48 @@ void KNMusicLibraryModel::retranslate()
 
 void KNMusicLibraryModel::appendMusicRow(const QList<QStandardItem *> &musicRow)
 {
+    //Give the track an id.
+    registerTrack(musicRow.at(Name));
     //Add the row to model.
     KNMusicModel::appendMusicRow(musicRow);
-    //Add the row to database, generate the data list array.
-    QJsonArray textInformationArray, propertyArray, itemDataArray;
-    int i;
-    for(i=0; i<MusicDataCount; i++)
+    //Add the row to database and category models.
+    appendRowData(musicRow);
+    for(QLinkedList<KNMusicCategoryModel *>::iterator i=m_categoryModels.begin();
+        i!=m_categoryModels.end();
+        ++i)
     {
-        textInformationArray.append(musicRow.at(i)->data(Qt::DisplayRole).toString());
+        (*i)->onCategoryAdded(musicRow);
     }
-    QStandardItem *propertyItem=musicRow.at(0);
-    propertyArray.append(propertyItem->data(FilePathRole).toString()); //PropertyFilePath
-    propertyArray.append(propertyItem->data(FileNameRole).toString()); //PropertyFileName
-    propertyArray.append(propertyItem->data(ArtworkKeyRole).toString()); //PropertyCoverImageHash
-    propertyArray.append(musicRow.at(BitRate)->data(Qt::UserRole).toInt()); //PropertyBitRate
-    propertyArray.append(musicRow.at(Rating)->data(Qt::DisplayRole).toInt()); //PropertyRating
-    propertyArray.append(musicRow.at(SampleRate)->data(Qt::UserRole).toInt()); //PropertySampleRating
-    propertyArray.append(QString::number(musicRow.at(Size)->data(Qt::UserRole).toLongLong())); //PropertySize
-    propertyArray.append(QString::number(musicRow.at(Time)->data(Qt::UserRole).toLongLong())); //PropertyDuration
-    propertyArray.append(KNMusicModelAssist::dateTimeToDataString(musicRow.at(DateAdded)->data(Qt::UserRole))); //PropertyDateAdded
-    propertyArray.append(KNMusicModelAssist::dateTimeToDataString(musicRow.at(DateModified)->data(Qt::UserRole))); //PropertyDateModified
-    propertyArray.append(KNMusicModelAssist::dateTimeToDataString(musicRow.at(LastPlayed)->data(Qt::UserRole))); //PropertyLastPlayed
-    propertyArray.append(propertyItem->data(TrackFileRole).toString()); //PropertyTrackFilePath
-    propertyArray.append(propertyItem->data(TrackIndexRole).toInt()); //PropertyTrackIndex
-    propertyArray.append(QString::number(propertyItem->data(StartPositionRole).toLongLong())); //PropertyStartPosition
-    itemDataArray.append(textInformationArray);
-    itemDataArray.append(propertyArray);
-    m_database->append(itemDataArray);
-    //Add the row data to category models.
+}
+
+void KNMusicLibraryModel::insertMusicRows(int row,
+                                          const QList<QList<QStandardItem *> > &musicRows)
+{
+    Q_UNUSED(row)
+    //The rows in library is always appended to the database, so the rows are
+    //always appended to the model as well. Give all the tracks an id, then add
+    //all the rows to model at once.
+    for(QList<QList<QStandardItem *> >::const_iterator i=musicRows.constBegin();
+        i!=musicRows.constEnd();
+        ++i)
+    {
+        registerTrack((*i).at(Name));
+    }
+    KNMusicModel::insertMusicRows(rowCount(), musicRows);
+    //Add the rows to database.
+    for(QList<QList<QStandardItem *> >::const_iterator i=musicRows.constBegin();
+        i!=musicRows.constEnd();
+        ++i)
+    {
+        appendRowData(*i);
+    }
+    //Add the rows to category models in a batch, each category is only
+    //searched once.
     for(QLinkedList<KNMusicCategoryModel *>::iterator i=m_categoryModels.begin();
         i!=m_categoryModels.end();
         ++i)
     {
-        (*i)->onCategoryAdded(musicRow);
+        (*i)->onCategoryAddedRows(musicRows);
     }
 }
 
@@ -235,7 +312,10 @@ void KNMusicLibraryModel::updateMusicRow(const int &row,
     if(!libraryItem.coverImage.isNull())
     {
         libraryItem.detailInfo.coverImageHash=
-                m_coverImageList->appendImage(libraryItem.coverImage);
+                libraryItem.coverImageData.isEmpty()?
+                    m_coverImageList->appendImage(libraryItem.coverImage):
+                    m_coverImageList->appendImageData(libraryItem.coverImageData,
+                                                      libraryItem.coverImage);
         //Update the row data in database, we need to generate the new information from the row.
         m_database->replace(row, KNMusicModelAssist::rowToJsonArray(this, row));
         //Update the cover image.
@@ -260,8 +340,10 @@ void KNMusicLibraryModel::updateCoverImage(const int &row,
         m_database->replace(row, itemDataArray);
         //Set the artwork key for the model, we have already save the data.
         KNMusicModel::setRowProperty(row, ArtworkKeyRole, detailInfo.coverImageHash);
-        //Get the cover image.
-        QPixmap coverImagePixmap=QPixmap::fromImage(analysisItem.coverImage);
+        //Get the cover image, the analysis item might not decode the image
+        //when the image has been added to the list.
+        QPixmap coverImagePixmap=
+                m_coverImageList->pixmap(detailInfo.coverImageHash);
         //Ask category models to update the cover image.
         for(QLinkedList<KNMusicCategoryModel *>::iterator i=m_categoryModels.begin();
             i!=m_categoryModels.end();
@@ -278,6 +360,8 @@ void KNMusicLibraryModel::removeMusicRow(const int &row)
 {
     //Remove the row from the database.
     m_database->removeAt(row);
+    //Remove the track id.
+    m_trackItems.remove(rowProperty(row, TrackIdRole).toUInt());
     //Quick generate the row, this shouldn't so slow.
     QList<QStandardItem *> currentRow;
     for(int i=0; i<columnCount(); i++)
@@ -304,7 +388,7 @@ void KNMusicLibraryModel::removeMusicRow(const int &row)
              Qt::MatchFixedString | Qt::MatchCaseSensitive).isEmpty())
     {
         //Remove the image from the disk and hash list.
-        m_imageManager->removeImage(currentArtworkKey);
+        emit requireRemoveImage(currentArtworkKey);
         m_coverImageList->removeImage(currentArtworkKey);
         //Ask category model to remove the image and replace it.
         for(QLinkedList<KNMusicCategoryModel *>::iterator i=m_categoryModels.begin();
@@ -358,63 +442,175 @@ void KNMusicLibraryModel::removeMusicRow(const int &row)
     }
 }
 
-void KNMusicLibraryModel::appendLibraryMusicRow(const QList<QStandardItem *> &musicRow,
-                                                const KNMusicAnalysisItem &analysisItem)
+void KNMusicLibraryModel::appendLibraryMusicRows(const QList<QList<QStandardItem *> > &musicRows,
+                                                 const QList<KNMusicAnalysisItem> &analysisItems)
 {
-    const KNMusicDetailInfo &rowDetailInfo=analysisItem.detailInfo;
-    //Check if we have already contains this file.
-    QModelIndexList fileCheck=match(index(0,0),
-                                    FilePathRole,
-                                    rowDetailInfo.filePath,
-                                    -1,
-                                    Qt::MatchFixedString);
-    if(!fileCheck.isEmpty())
+    KNTraceScope("gui", "KNMusicLibraryModel::appendLibraryMusicRows");
+    Q_ASSERT(musicRows.size()==analysisItems.size());
+    //The database is still recovering, the new rows can only be appended after
+    //all the recovered rows.
+    if(m_recovering)
     {
-        for(QModelIndexList::iterator i=fileCheck.begin();
-            i!=fileCheck.end();
-            ++i)
+        m_delayedRows.append(musicRows);
+        m_delayedItems.append(analysisItems);
+        return;
+    }
+    QList<QList<QStandardItem *> > appendRows;
+    QList<KNMusicAnalysisItem> appendItems;
+    //The same track may be analysised twice in one batch, the later one will be
+    //ignored.
+    QSet<QString> appendKeys;
+    for(int i=0; i<musicRows.size(); i++)
+    {
+        const KNMusicAnalysisItem &analysisItem=analysisItems.at(i);
+        const KNMusicDetailInfo &rowDetailInfo=analysisItem.detailInfo;
+        //Check if we have already contains this file.
+        int existRow=rowFromAnalysisItem(analysisItem);
+        if(existRow!=-1)
         {
-            //Check the track file path and track index is the same or not.
-            if((*i).data(TrackFileRole).toString()==rowDetailInfo.trackFilePath
-                    && (*i).data(TrackIndexRole).toInt()==rowDetailInfo.trackIndex)
-            {
-                updateMusicRow((*i).row(), analysisItem);
-                return;
-            }
+            updateMusicRow(existRow, analysisItem);
+            qDeleteAll(musicRows.at(i));
+            continue;
+        }
+        QString trackKey=rowDetailInfo.filePath+'\n'+
+                rowDetailInfo.trackFilePath+'\n'+
+                QString::number(rowDetailInfo.trackIndex);
+        if(appendKeys.contains(trackKey))
+        {
+            qDeleteAll(musicRows.at(i));
+            continue;
         }
+        appendKeys.insert(trackKey);
+        appendRows.append(musicRows.at(i));
+        appendItems.append(analysisItem);
     }
-    //Append the music row first.
-    appendMusicRow(musicRow);
+    if(appendRows.isEmpty())
+    {
+        return;
+    }
+    bool wasEmpty=(rowCount()==0);
+    int firstRow=rowCount();
+    //Append all the new rows in one time.
+    insertMusicRows(firstRow, appendRows);
     //Ask to analysis album art.
-    m_analysisExtend->onActionAnalysisAlbumArt(musicRow.at(Name),
-                                               analysisItem);
-    //Check row count before add the row.
-    if(rowCount()==1)
+    for(int i=0; i<appendRows.size(); i++)
+    {
+        m_analysisExtend->onActionAnalysisAlbumArt(appendRows.at(i).at(Name),
+                                                   appendItems.at(i));
+    }
+    //Ask to scan the loudness of the new rows.
+    QList<int> scanRows;
+    for(int i=firstRow; i<rowCount(); i++)
+    {
+        scanRows.append(i);
+    }
+    scanLoudness(scanRows);
+    fingerprintRows(scanRows);
+    scanTempo(scanRows);
+    //Check row count before add the rows.
+    if(wasEmpty)
     {
         emit libraryNotEmpty();
     }
 }
 
-void KNMusicLibraryModel::recoverMusicRow(const QList<QStandardItem *> &musicRow)
+void KNMusicLibraryModel::recoverMusicRows(const QList<QList<QStandardItem *> > &musicRows)
 {
-    //Add the row to model.
-    KNMusicModel::appendMusicRow(musicRow);
-    //Add the row data to category models.
+    KNTraceScope("gui", "KNMusicLibraryModel::recoverMusicRows");
+    bool wasEmpty=(rowCount()==0);
+    int firstRow=rowCount();
+    //Recover the track ids, the rows from the old database don't have one.
+    QList<int> idAllocatedRows;
+    for(int i=0; i<musicRows.size(); i++)
+    {
+        if(registerTrack(musicRows.at(i).at(Name)))
+        {
+            idAllocatedRows.append(firstRow+i);
+        }
+    }
+    //Add the rows to model.
+    KNMusicModel::insertMusicRows(firstRow, musicRows);
+    //Save the allocated track ids to database.
+    for(QList<int>::iterator i=idAllocatedRows.begin();
+        i!=idAllocatedRows.end();
+        ++i)
+    {
+        m_database->replace(*i, KNMusicModelAssist::rowToJsonArray(this, *i));
+    }
+    //Add the rows data to category models.
     for(QLinkedList<KNMusicCategoryModel *>::iterator i=m_categoryModels.begin();
         i!=m_categoryModels.end();
         ++i)
     {
-        (*i)->onCategoryRecover(musicRow);
+        (*i)->onCategoryRecoverRows(musicRows);
     }
-    //Check row count before add the row.
-    if(rowCount()==1)
+    //Check row count before add the rows.
+    if(wasEmpty && rowCount()>0)
     {
         emit libraryNotEmpty();
     }
 }
 
+void KNMusicLibraryModel::onActionRecoverComplete()
+{
+    m_recovering=false;
+    //Update the images of the category models if the images has been loaded.
+    if(m_imageRecoverDelayed)
+    {
+        m_imageRecoverDelayed=false;
+        imageRecoverComplete();
+    }
+    //Scan the loudness of the rows which haven't been scanned, e.g. the rows
+    //from the old database. The rows which can't be scanned are marked.
+    QList<int> scanRows;
+    for(int i=0; i<rowCount(); i++)
+    {
+        if(!roleData(i, TrackGain, Qt::UserRole).isValid() &&
+                !rowProperty(i, LoudnessScannedRole).toBool())
+        {
+            scanRows.append(i);
+        }
+    }
+    scanLoudness(scanRows);
+    //Fingerprint the rows which don't have one.
+    QList<int> fingerprintList;
+    for(int i=0; i<rowCount(); i++)
+    {
+        if(rowProperty(i, FingerprintRole).toByteArray().isEmpty())
+        {
+            fingerprintList.append(i);
+        }
+    }
+    fingerprintRows(fingerprintList);
+    //Detect the tempo of the rows which haven't been scanned.
+    QList<int> tempoList;
+    for(int i=0; i<rowCount(); i++)
+    {
+        if(!roleData(i, BeatsPerMinuate, Qt::UserRole).isValid())
+        {
+            tempoList.append(i);
+        }
+    }
+    scanTempo(tempoList);
+    //Append the rows which are analysised while recovering.
+    if(!m_delayedRows.isEmpty())
+    {
+        QList<QList<QStandardItem *> > delayedRows;
+        QList<KNMusicAnalysisItem> delayedItems;
+        delayedRows.swap(m_delayedRows);
+        delayedItems.swap(m_delayedItems);
+        appendLibraryMusicRows(delayedRows, delayedItems);
+    }
+}
+
 void KNMusicLibraryModel::imageRecoverComplete()
 {
+    //The category models may not be completed, update them after recovering.
+    if(m_recovering)
+    {
+        m_imageRecoverDelayed=true;
+        return;
+    }
     //Ask category models to update images.
     for(QLinkedList<KNMusicCategoryModel *>::iterator i=m_categoryModels.begin();
         i!=m_categoryModels.end();
@@ -424,6 +620,190 @@ void KNMusicLibraryModel::imageRecoverComplete()
     }
 }
 
+void KNMusicLibraryModel::onActionStartAnalysis()
+{
+    //The tracks might be removed while waiting.
+    startLoudnessScan();
+    KNMusicFingerprinter *fingerprinter=KNMusicGlobal::fingerprinter();
+    if(fingerprinter!=nullptr && !m_fingerprintTracks.isEmpty())
+    {
+        QList<KNMusicFingerprintItem> tracks;
+        for(QList<quint32>::iterator i=m_fingerprintTracks.begin();
+            i!=m_fingerprintTracks.end();
+            ++i)
+        {
+            int row=rowFromTrackId(*i);
+            if(row!=-1)
+            {
+                tracks.append(fingerprintItem(row));
+            }
+        }
+        fingerprinter->fingerprint(tracks);
+    }
+    m_fingerprintTracks.clear();
+    KNMusicTempoScanner *tempoScanner=KNMusicGlobal::tempoScanner();
+    if(tempoScanner!=nullptr && !m_tempoTracks.isEmpty())
+    {
+        QList<KNMusicTempoItem> tracks;
+        for(QList<quint32>::iterator i=m_tempoTracks.begin();
+            i!=m_tempoTracks.end();
+            ++i)
+        {
+            int row=rowFromTrackId(*i);
+            if(row!=-1)
+            {
+                tracks.append(tempoItem(row));
+            }
+        }
+        tempoScanner->scan(tracks);
+    }
+    m_tempoTracks.clear();
+}
+
+inline void KNMusicLibraryModel::startLoudnessScan()
+{
+    KNMusicLoudnessScanner *loudnessScanner=KNMusicGlobal::loudnessScanner();
+    if(loudnessScanner==nullptr)
+    {
+        return;
+    }
+    //Scan the tracks without an album, the track might be removed while
+    //waiting.
+    for(QList<quint32>::iterator i=m_loudnessTracks.begin();
+        i!=m_loudnessTracks.end();
+        ++i)
+    {
+        int row=rowFromTrackId(*i);
+        if(row!=-1)
+        {
+            QList<KNMusicLoudnessItem> singleTrack;
+            singleTrack.append(loudnessItem(row));
+            loudnessScanner->scanAlbum(singleTrack);
+        }
+    }
+    m_loudnessTracks.clear();
+    if(m_loudnessAlbums.isEmpty())
+    {
+        return;
+    }
+    //Find all the tracks of the waiting albums in one pass of the library.
+    QHash<QString, QList<KNMusicLoudnessItem> > albums;
+    for(int i=0; i<rowCount(); i++)
+    {
+        if(itemText(i, Album).isEmpty())
+        {
+            continue;
+        }
+        QString currentAlbum=albumKey(i);
+        if(m_loudnessAlbums.contains(currentAlbum))
+        {
+            albums[currentAlbum].append(loudnessItem(i));
+        }
+    }
+    m_loudnessAlbums.clear();
+    for(QHash<QString, QList<KNMusicLoudnessItem> >::iterator i=albums.begin();
+        i!=albums.end();
+        ++i)
+    {
+        loudnessScanner->scanAlbum(*i);
+    }
+}
+
+void KNMusicLibraryModel::onActionAlbumScanned(QList<KNMusicLoudnessItem> tracks)
+{
+    for(QList<KNMusicLoudnessItem>::iterator i=tracks.begin();
+        i!=tracks.end();
+        ++i)
+    {
+        //The track might be removed while scanning.
+        int row=rowFromTrackId((*i).trackId);
+        if(row==-1)
+        {
+            continue;
+        }
+        //Mark the row, the track which can't be decoded won't be scanned at
+        //every start.
+        KNMusicModel::setRowProperty(row, LoudnessScannedRole, true);
+        //Update the gains, and save the row to the database.
+        if((*i).scanned)
+        {
+            updateItemText(row, TrackGain, KNMusicGlobal::gainToString((*i).trackGain));
+            updateRoleData(row, TrackGain, Qt::UserRole, (*i).trackGain);
+            updateItemText(row, AlbumGain, KNMusicGlobal::gainToString((*i).albumGain));
+            updateRoleData(row, AlbumGain, Qt::UserRole, (*i).albumGain);
+        }
+        m_database->replace(row, KNMusicModelAssist::rowToJsonArray(this, row));
+    }
+}
+
+void KNMusicLibraryModel::onActionTrackFingerprinted(
+        KNMusicFingerprintItem track)
+{
+    //The track might be removed while fingerprinting.
+    int row=rowFromTrackId(track.trackId);
+    if(row==-1)
+    {
+        return;
+    }
+    //Save the fingerprint to the row and the database.
+    KNMusicModel::setRowProperty(row, FingerprintRole, track.fingerprint);
+    m_database->replace(row, KNMusicModelAssist::rowToJsonArray(this, row));
+}
+
+void KNMusicLibraryModel::onActionTrackTempoScanned(KNMusicTempoItem track)
+{
+    //The track might be removed while scanning.
+    int row=rowFromTrackId(track.trackId);
+    if(row==-1)
+    {
+        return;
+    }
+    //Keep the detected results, they are shown only when the tags don't have
+    //the tempo or the key.
+    updateRoleData(row, BeatsPerMinuate, Qt::UserRole, track.beatsPerMinute);
+    updateRoleData(row, MusicalKey, Qt::UserRole, track.key);
+    if(itemText(row, BeatsPerMinuate).isEmpty())
+    {
+        updateItemText(row,
+                       BeatsPerMinuate,
+                       KNMusicGlobal::tempoToString(track.beatsPerMinute));
+    }
+    if(itemText(row, MusicalKey).isEmpty())
+    {
+        updateItemText(row, MusicalKey, track.key);
+    }
+    m_database->replace(row, KNMusicModelAssist::rowToJsonArray(this, row));
+}
+
+void KNMusicLibraryModel::onActionDuplicatesFound(
+        QList<QList<quint32> > trackGroups)
+{
+    //The rows might be moved or removed while finding, find them from the
+    //track ids.
+    QList<QList<int> > rowGroups;
+    for(QList<QList<quint32> >::iterator i=trackGroups.begin();
+        i!=trackGroups.end();
+        ++i)
+    {
+        QList<int> rowGroup;
+        for(QList<quint32>::iterator j=(*i).begin();
+            j!=(*i).end();
+            ++j)
+        {
+            int row=rowFromTrackId(*j);
+            if(row!=-1)
+            {
+                rowGroup.append(row);
+            }
+        }
+        if(rowGroup.size()>1)
+        {
+            rowGroups.append(rowGroup);
+        }
+    }
+    emit duplicatesFound(rowGroups);
+}
+
 inline void KNMusicLibraryModel::initialHeader()
 {
     //Using retranslate to update the header text.
@@ -439,10 +819,212 @@ inline void KNMusicLibraryModel::initialHeader()
     setHeaderData(Time, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
     setHeaderData(Size, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
     setHeaderData(TrackNumber, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
+    setHeaderData(TrackGain, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
+    setHeaderData(AlbumGain, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
     //Set sort flag.
     setHeaderSortFlag();
 }
 
+inline bool KNMusicLibraryModel::registerTrack(QStandardItem *propertyItem)
+{
+    quint32 trackId=propertyItem->data(TrackIdRole).toUInt();
+    bool allocated=(trackId==0);
+    //Allocate a new id for the track which doesn't have one. The id is
+    //generated from the track position, so a track which is removed and added
+    //again will get its id back, the playlists could still find it.
+    if(allocated)
+    {
+        trackId=trackIdSeed(propertyItem->data(FilePathRole).toString(),
+                            propertyItem->data(TrackIndexRole).toInt());
+        while(trackId==0 || m_trackItems.contains(trackId))
+        {
+            ++trackId;
+        }
+        propertyItem->setData(trackId, TrackIdRole);
+    }
+    m_trackItems.insert(trackId, propertyItem);
+    return allocated;
+}
+
+inline QString KNMusicLibraryModel::albumKey(const int &row)
+{
+    //The same album name could be used by different artists, the album artist
+    //is used to tell them apart, use the artist when there's no album artist.
+    QString albumArtist=itemText(row, AlbumArtist);
+    if(albumArtist.isEmpty())
+    {
+        albumArtist=itemText(row, Artist);
+    }
+    return albumArtist+'\n'+itemText(row, Album);
+}
+
+inline KNMusicLoudnessItem KNMusicLibraryModel::loudnessItem(const int &row)
+{
+    KNMusicLoudnessItem item;
+    item.trackId=rowProperty(row, TrackIdRole).toUInt();
+    item.filePath=rowProperty(row, FilePathRole).toString();
+    //Only the track in a list file is a section of the file.
+    item.startPosition=rowProperty(row, StartPositionRole).toLongLong();
+    if(item.startPosition>=0)
+    {
+        item.duration=roleData(row, Time, Qt::UserRole).toLongLong();
+    }
+    return item;
+}
+
+inline void KNMusicLibraryModel::scanLoudness(const QList<int> &rows)
+{
+    if(KNMusicGlobal::loudnessScanner()==nullptr || rows.isEmpty())
+    {
+        return;
+    }
+    //The album gain needs all the tracks of the album, and an album could be
+    //imported in several batches. Only remember the albums here, the whole
+    //albums are scanned once when the importing is idle.
+    for(QList<int>::const_iterator i=rows.constBegin();
+        i!=rows.constEnd();
+        ++i)
+    {
+        //The track without an album is an album itself.
+        if(itemText(*i, Album).isEmpty())
+        {
+            m_loudnessTracks.append(rowProperty(*i, TrackIdRole).toUInt());
+            continue;
+        }
+        m_loudnessAlbums.insert(albumKey(*i));
+    }
+    m_analysisTimer->start();
+}
+
+inline KNMusicFingerprintItem KNMusicLibraryModel::fingerprintItem(
+        const int &row)
+{
+    KNMusicFingerprintItem item;
+    item.trackId=rowProperty(row, TrackIdRole).toUInt();
+    item.filePath=rowProperty(row, FilePathRole).toString();
+    item.startPosition=rowProperty(row, StartPositionRole).toLongLong();
+    item.duration=roleData(row, Time, Qt::UserRole).toLongLong();
+    item.fingerprint=rowProperty(row, FingerprintRole).toByteArray();
+    return item;
+}
+
+inline void KNMusicLibraryModel::fingerprintRows(const QList<int> &rows)
+{
+    if(KNMusicGlobal::fingerprinter()==nullptr || rows.isEmpty())
+    {
+        return;
+    }
+    //Fingerprint the tracks with the other analysers when the importing is
+    //idle.
+    for(QList<int>::const_iterator i=rows.constBegin();
+        i!=rows.constEnd();
+        ++i)
+    {
+        m_fingerprintTracks.append(rowProperty(*i, TrackIdRole).toUInt());
+    }
+    m_analysisTimer->start();
+}
+
+inline KNMusicTempoItem KNMusicLibraryModel::tempoItem(const int &row)
+{
+    KNMusicTempoItem item;
+    item.trackId=rowProperty(row, TrackIdRole).toUInt();
+    item.filePath=rowProperty(row, FilePathRole).toString();
+    item.startPosition=rowProperty(row, StartPositionRole).toLongLong();
+    item.duration=roleData(row, Time, Qt::UserRole).toLongLong();
+    return item;
+}
+
+inline void KNMusicLibraryModel::scanTempo(const QList<int> &rows)
+{
+    if(KNMusicGlobal::tempoScanner()==nullptr || rows.isEmpty())
+    {
+        return;
+    }
+    //Scan the tracks with the other analysers when the importing is idle.
+    for(QList<int>::const_iterator i=rows.constBegin();
+        i!=rows.constEnd();
+        ++i)
+    {
+        m_tempoTracks.append(rowProperty(*i, TrackIdRole).toUInt());
+    }
+    m_analysisTimer->start();
+}
+
+inline void KNMusicLibraryModel::appendRowData(const QList<QStandardItem *> &musicRow)
+{
+    //Add the row to database, generate the data list array.
+    QJsonArray textInformationArray, propertyArray, itemDataArray;
+    int i;
+    for(i=0; i<MusicDataCount; i++)
+    {
+        textInformationArray.append(musicRow.at(i)->data(Qt::DisplayRole).toString());
+    }
+    QStandardItem *propertyItem=musicRow.at(0);
+    propertyArray.append(propertyItem->data(FilePathRole).toString()); //PropertyFilePath
+    propertyArray.append(propertyItem->data(FileNameRole).toString()); //PropertyFileName
+    propertyArray.append(propertyItem->data(ArtworkKeyRole).toString()); //PropertyCoverImageHash
+    propertyArray.append(musicRow.at(BitRate)->data(Qt::UserRole).toInt()); //PropertyBitRate
+    propertyArray.append(musicRow.at(Rating)->data(Qt::DisplayRole).toInt()); //PropertyRating
+    propertyArray.append(musicRow.at(SampleRate)->data(Qt::UserRole).toInt()); //PropertySampleRating
+    propertyArray.append(QString::number(musicRow.at(Size)->data(Qt::UserRole).toLongLong())); //PropertySize
+    propertyArray.append(QString::number(musicRow.at(Time)->data(Qt::UserRole).toLongLong())); //PropertyDuration
+    propertyArray.append(KNMusicModelAssist::dateTimeToDataString(musicRow.at(DateAdded)->data(Qt::UserRole))); //PropertyDateAdded
+    propertyArray.append(KNMusicModelAssist::dateTimeToDataString(musicRow.at(DateModified)->data(Qt::UserRole))); //PropertyDateModified
+    propertyArray.append(KNMusicModelAssist::dateTimeToDataString(musicRow.at(LastPlayed)->data(Qt::UserRole))); //PropertyLastPlayed
+    propertyArray.append(propertyItem->data(TrackFileRole).toString()); //PropertyTrackFilePath
+    propertyArray.append(propertyItem->data(TrackIndexRole).toInt()); //PropertyTrackIndex
+    propertyArray.append(QString::number(propertyItem->data(StartPositionRole).toLongLong())); //PropertyStartPosition
+    propertyArray.append(QString::number(propertyItem->data(TrackIdRole).toUInt())); //PropertyTrackId
+    propertyArray.append(KNMusicModelAssist::gainToDataString(musicRow.at(TrackGain)->data(Qt::UserRole))); //PropertyTrackGain
+    propertyArray.append(KNMusicModelAssist::gainToDataString(musicRow.at(AlbumGain)->data(Qt::UserRole))); //PropertyAlbumGain
+    propertyArray.append(QString(propertyItem->data(FingerprintRole).toByteArray().toBase64())); //PropertyFingerprint
+    propertyArray.append(KNMusicModelAssist::gainToDataString(musicRow.at(BeatsPerMinuate)->data(Qt::UserRole))); //PropertyTempo
+    propertyArray.append(musicRow.at(MusicalKey)->data(Qt::UserRole).toString()); //PropertyMusicalKey
+    propertyArray.append(propertyItem->data(LoudnessScannedRole).toBool()); //PropertyLoudnessScanned
+    itemDataArray.append(textInformationArray);
+    itemDataArray.append(propertyArray);
+    m_database->append(itemDataArray);
+}
+
+inline int KNMusicLibraryModel::rowFromAnalysisItem(const KNMusicAnalysisItem &analysisItem)
+{
+    const KNMusicDetailInfo &rowDetailInfo=analysisItem.detailInfo;
+    //The track ids are allocated from the file path and the track index, find
+    //the track in the same order as registerTrack() allocates them.
+    for(quint32 trackId=trackIdSeed(rowDetailInfo.filePath,
+                                    rowDetailInfo.trackIndex);
+        ;
+        ++trackId)
+    {
+        if(trackId==0)
+        {
+            continue;
+        }
+        QStandardItem *trackItem=m_trackItems.value(trackId, nullptr);
+        if(trackItem==nullptr)
+        {
+            return -1;
+        }
+        //Check the file path, the track file path and the track index is the
+        //same or not.
+        if(trackItem->data(FilePathRole).toString()==rowDetailInfo.filePath &&
+                trackItem->data(TrackFileRole).toString()==
+                rowDetailInfo.trackFilePath &&
+                trackItem->data(TrackIndexRole).toInt()==
+                rowDetailInfo.trackIndex)
+        {
+            return trackItem->row();
+        }
+    }
+}
+
+inline quint32 KNMusicLibraryModel::trackIdSeed(const QString &filePath,
+                                                const int &trackIndex)
+{
+    return qHash(filePath+'\n'+QString::number(trackIndex));
+}
+
 KNMusicLibraryImageManager *KNMusicLibraryModel::imageManager() const
 {
     return m_imageManager;
@@ -456,20 +1038,33 @@ void KNMusicLibraryModel::setImageManager(KNMusicLibraryImageManager *imageManag
     //Link request.
     connect(m_imageManager, &KNMusicLibraryImageManager::recoverComplete,
             this, &KNMusicLibraryModel::imageRecoverComplete);
+    //The image manager is working in another thread.
+    connect(this, &KNMusicLibraryModel::requireRemoveImage,
+            m_imageManager, &KNMusicLibraryImageManager::removeImage);
+    //Let the album art analysis wait for the image writers.
+    m_analysisExtend->setImageManager(m_imageManager);
 }
 
-void KNMusicLibraryModel::recoverModel()
+void KNMusicLibraryModel::findDuplicates()
 {
-    //Read the database information.
-    m_database->read();
-    //Recover the model for all the array data.
-    for(QJsonArray::iterator i=m_database->begin();
-        i!=m_database->end();
-        i++)
+    //Only the fingerprinted rows could be compared.
+    QList<KNMusicFingerprintItem> tracks;
+    for(int i=0; i<rowCount(); i++)
     {
-        //Recover the row.
-        recoverMusicRow(KNMusicModelAssist::generateRow((*i).toArray()));
+        if(!rowProperty(i, FingerprintRole).toByteArray().isEmpty())
+        {
+            tracks.append(fingerprintItem(i));
+        }
     }
+    emit requireFindDuplicates(tracks);
+}
+
+void KNMusicLibraryModel::recoverModel()
+{
+    //Read the database and generate the rows in the database thread, the rows
+    //will be sent back in batches.
+    m_recovering=true;
+    emit requireRecoverModel();
 }
 
 KNJSONDatabase *KNMusicLibraryModel::database() const
@@ -480,4 +1075,17 @@ KNJSONDatabase *KNMusicLibraryModel::database() const
 void KNMusicLibraryModel::setDatabase(KNJSONDatabase *database)
 {
     m_database = database;
+    //Initial the recover, it works in the same thread as the database.
+    if(m_recover==nullptr)
+    {
+        m_recover=new KNMusicLibraryRecover;
+        connect(this, &KNMusicLibraryModel::requireRecoverModel,
+                m_recover, &KNMusicLibraryRecover::recoverFromDatabase);
+        connect(m_recover, &KNMusicLibraryRecover::recoverRows,
+                this, &KNMusicLibraryModel::recoverMusicRows);
+        connect(m_recover, &KNMusicLibraryRecover::recoverComplete,
+                this, &KNMusicLibraryModel::onActionRecoverComplete);
+    }
+    m_recover->setDatabase(m_database);
+    m_recover->moveToThread(m_database->thread());
 }
@@ -18,26 +18,33 @@
 #ifndef KNMUSICLIBRARYMODEL_H
 #define KNMUSICLIBRARYMODEL_H
 
+#include <QHash>
 #include <QLinkedList>
+#include <QSet>
 
 #include "knmusiccategorymodel.h"
 
 #include "knmusicmodel.h"
 
+class QTimer;
 class KNHashPixmapList;
 class KNJSONDatabase;
 class KNMusicLibraryImageManager;
 class KNMusicLibraryAnalysisExtend;
+class KNMusicLibraryRecover;
+class KNMusicDuplicateFinder;
 class KNMusicLibraryModel : public KNMusicModel
 {
     Q_OBJECT
 public:
     explicit KNMusicLibraryModel(QObject *parent = 0);
+    ~KNMusicLibraryModel();
     Qt::DropActions supportedDropActions() const;
     Qt::ItemFlags flags(const QModelIndex &index) const;
     QPixmap artwork(const QString &key);
     int rowFromFilePath(const QString &filePath);
     int rowFromDetailInfo(const KNMusicDetailInfo &detailInfo);
+    int rowFromTrackId(const quint32 &trackId);
     int playingItemColumn();
     bool dropMimeData(const QMimeData *data,
                       Qt::DropAction action,
@@ -56,15 +63,23 @@ public:
     KNMusicLibraryImageManager *imageManager() const;
     void setImageManager(KNMusicLibraryImageManager *imageManager);
     void recoverModel();
+    void findDuplicates();
 
 signals:
     void libraryNotEmpty();
     void libraryEmpty();
     void hashRemoved();
+    void requireRecoverModel();
+    void requireRemoveImage(QString imageHash);
+    void requireFindDuplicates(QList<KNMusicFingerprintItem> tracks);
+    //The rows of the same recordings, every group has two rows at least.
+    void duplicatesFound(QList<QList<int> > rowGroups);
 
 public slots:
     void retranslate();
     void appendMusicRow(const QList<QStandardItem *> &musicRow);
+    void insertMusicRows(int row,
+                         const QList<QList<QStandardItem *> > &musicRows);
     void updateMusicRow(const int &row,
                         const KNMusicAnalysisItem &analysisItem);
     void updateCoverImage(const int &row,
@@ -72,20 +87,51 @@ public slots:
     void removeMusicRow(const int &row);
 
 private slots:
-    void appendLibraryMusicRow(const QList<QStandardItem *> &musicRow,
-                               const KNMusicAnalysisItem &analysisItem);
-    void recoverMusicRow(const QList<QStandardItem *> &musicRow);
+    void appendLibraryMusicRows(const QList<QList<QStandardItem *> > &musicRows,
+                                const QList<KNMusicAnalysisItem> &analysisItems);
+    void recoverMusicRows(const QList<QList<QStandardItem *> > &musicRows);
+    void onActionRecoverComplete();
     void imageRecoverComplete();
+    void onActionStartAnalysis();
+    void onActionAlbumScanned(QList<KNMusicLoudnessItem> tracks);
+    void onActionTrackFingerprinted(KNMusicFingerprintItem track);
+    void onActionTrackTempoScanned(KNMusicTempoItem track);
+    void onActionDuplicatesFound(QList<QList<quint32> > trackGroups);
 
 private:
     inline void initialHeader();
+    inline void appendRowData(const QList<QStandardItem *> &musicRow);
+    inline int rowFromAnalysisItem(const KNMusicAnalysisItem &analysisItem);
+    inline quint32 trackIdSeed(const QString &filePath,
+                               const int &trackIndex);
+    inline bool registerTrack(QStandardItem *propertyItem);
+    inline QString albumKey(const int &row);
+    inline KNMusicLoudnessItem loudnessItem(const int &row);
+    inline void scanLoudness(const QList<int> &rows);
+    inline void startLoudnessScan();
+    inline KNMusicFingerprintItem fingerprintItem(const int &row);
+    inline void fingerprintRows(const QList<int> &rows);
+    inline KNMusicTempoItem tempoItem(const int &row);
+    inline void scanTempo(const QList<int> &rows);
     QLinkedList<KNMusicCategoryModel *> m_categoryModels;
+    QList<QList<QStandardItem *> > m_delayedRows;
+    QList<KNMusicAnalysisItem> m_delayedItems;
+    QHash<quint32, QStandardItem *> m_trackItems;
+    //The albums and the single tracks waiting for the loudness scanning, and
+    //the tracks waiting for the fingerprinter and the tempo scanner.
+    QSet<QString> m_loudnessAlbums;
+    QList<quint32> m_loudnessTracks, m_fingerprintTracks, m_tempoTracks;
+    QTimer *m_analysisTimer;
 
     KNJSONDatabase *m_database;
     KNMusicGlobal *m_musicGlobal;
     KNMusicLibraryAnalysisExtend *m_analysisExtend;
     KNHashPixmapList *m_coverImageList;
     KNMusicLibraryImageManager *m_imageManager;
+    KNMusicLibraryRecover *m_recover=nullptr;
+    KNMusicDuplicateFinder *m_duplicateFinder;
+    bool m_recovering=false;
+    bool m_imageRecoverDelayed=false;
 };
 
 #endif // KNMUSICLIBRARYMODEL_H
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "knjsondatabase.h"
+
+#include "knmusicmodelassist.h"
+
+#include "knmusiclibraryrecover.h"
+
+#include <QDebug>
+
+//The first batch only fills the first page of the song list, so the library
+//could be used as soon as possible.
+#define FIRST_BATCH 64
+#define MAX_BATCH 1024
+
+KNMusicLibraryRecover::KNMusicLibraryRecover(QObject *parent) :
+    QObject(parent)
+{
+}
+
+KNJSONDatabase *KNMusicLibraryRecover::database() const
+{
+    return m_database;
+}
+
+void KNMusicLibraryRecover::setDatabase(KNJSONDatabase *database)
+{
+    m_database=database;
+}
+
+void KNMusicLibraryRecover::recoverFromDatabase()
+{
+    //Read the database information.
+    m_database->read();
+    //Take a copy of the data, the model may change the database while we are
+    //generating the rows.
+    const QJsonArray databaseData=m_database->data();
+    //Generate the rows, send them in batches.
+    QList<QList<QStandardItem *> > musicRows;
+    int batchSize=FIRST_BATCH;
+    musicRows.reserve(batchSize);
+    for(QJsonArray::const_iterator i=databaseData.constBegin();
+        i!=databaseData.constEnd();
+        ++i)
+    {
+        musicRows.append(KNMusicModelAssist::generateRow((*i).toArray()));
+        if(musicRows.size()==batchSize)
+        {
+            emit recoverRows(musicRows);
+            musicRows=QList<QList<QStandardItem *> >();
+            batchSize=MAX_BATCH;
+            musicRows.reserve(batchSize);
+        }
+    }
+    //Send the rest rows.
+    if(!musicRows.isEmpty())
+    {
+        emit recoverRows(musicRows);
+    }
+    emit recoverComplete();
+}
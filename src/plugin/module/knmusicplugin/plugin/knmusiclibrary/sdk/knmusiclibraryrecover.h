@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICLIBRARYRECOVER_H
+#define KNMUSICLIBRARYRECOVER_H
+
+#include <QList>
+#include <QStandardItem>
+
+#include <QObject>
+
+class KNJSONDatabase;
+class KNMusicLibraryRecover : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KNMusicLibraryRecover(QObject *parent = 0);
+    KNJSONDatabase *database() const;
+    void setDatabase(KNJSONDatabase *database);
+
+signals:
+    void recoverRows(QList<QList<QStandardItem *> > musicRows);
+    void recoverComplete();
+
+public slots:
+    void recoverFromDatabase();
+
+private:
+    KNJSONDatabase *m_database=nullptr;
+};
+
+#endif // KNMUSICLIBRARYRECOVER_H
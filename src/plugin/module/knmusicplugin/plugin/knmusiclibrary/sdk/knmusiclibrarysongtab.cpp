@@ -87,6 +87,11 @@ QAction *KNMusicLibrarySongTab::showInAction()
     return m_showInSongTab;
 }
 
+QAction *KNMusicLibrarySongTab::selectDuplicatesAction()
+{
+    return m_selectDuplicates;
+}
+
 QString KNMusicLibrarySongTab::caption()
 {
     return tr("Songs");
@@ -121,6 +126,7 @@ void KNMusicLibrarySongTab::showInTab(const KNMusicDetailInfo &detailInfo)
 void KNMusicLibrarySongTab::retranslate()
 {
     m_showInSongTab->setText(tr("Go to Songs"));
+    m_selectDuplicates->setText(tr("Select Duplicates"));
 }
 
 void KNMusicLibrarySongTab::setLibraryModel(KNMusicLibraryModel *model)
@@ -139,6 +145,9 @@ void KNMusicLibrarySongTab::setLibraryModel(KNMusicLibraryModel *model)
             m_viewer, &KNEmptyStateWidget::showContentWidget);
     connect(m_musicLibrary, &KNMusicLibraryModel::libraryEmpty,
             m_viewer, &KNEmptyStateWidget::showEmptyWidget);
+    //Connect the duplicates result.
+    connect(m_musicLibrary, &KNMusicLibraryModel::duplicatesFound,
+            this, &KNMusicLibrarySongTab::onActionDuplicatesFound);
     //Reset the header state.
     m_treeview->resetHeaderState();
     //Set default sort state.
@@ -155,10 +164,56 @@ void KNMusicLibrarySongTab::onActionShowInSong()
     showInTab(KNMusicGlobal::soloMenu()->currentDetailInfo());
 }
 
+void KNMusicLibrarySongTab::onActionSelectDuplicates()
+{
+    //Save the track, the duplicates are found in the analysis thread.
+    m_duplicateDetailInfo=KNMusicGlobal::soloMenu()->currentDetailInfo();
+    m_findingDuplicates=true;
+    m_musicLibrary->findDuplicates();
+}
+
+void KNMusicLibrarySongTab::onActionDuplicatesFound(
+        QList<QList<int> > rowGroups)
+{
+    if(!m_findingDuplicates)
+    {
+        return;
+    }
+    m_findingDuplicates=false;
+    int musicRow=m_musicLibrary->rowFromDetailInfo(m_duplicateDetailInfo);
+    if(musicRow==-1)
+    {
+        return;
+    }
+    //Find the group of the track, the track itself is selected when it doesn't
+    //have any duplicate.
+    QList<int> selectRows;
+    selectRows.append(musicRow);
+    for(QList<QList<int> >::iterator i=rowGroups.begin();
+        i!=rowGroups.end();
+        ++i)
+    {
+        if((*i).contains(musicRow))
+        {
+            (*i).removeOne(musicRow);
+            selectRows.append(*i);
+            break;
+        }
+    }
+    //Clear the search result, and select the rows.
+    KNMusicGlobal::musicSearch()->search("");
+    m_treeview->selectSourceSongRows(selectRows);
+    //Ask to show current tab.
+    emit requireShowTab();
+}
+
 void KNMusicLibrarySongTab::initialShowInAction()
 {
     //Initial the show in actions.
     m_showInSongTab=new QAction(this);
     connect(m_showInSongTab, SIGNAL(triggered()),
             this, SLOT(onActionShowInSong()));
+    m_selectDuplicates=new QAction(this);
+    connect(m_selectDuplicates, SIGNAL(triggered()),
+            this, SLOT(onActionSelectDuplicates()));
 }
@@ -31,6 +31,7 @@ public:
     explicit KNMusicLibrarySongTab(QObject *parent = 0);
     ~KNMusicLibrarySongTab();
     QAction *showInAction();
+    QAction *selectDuplicatesAction();
     QString caption();
     QPixmap icon();
     QWidget *widget();
@@ -45,6 +46,8 @@ public slots:
 
 private slots:
     void onActionShowInSong();
+    void onActionSelectDuplicates();
+    void onActionDuplicatesFound(QList<QList<int> > rowGroups);
 
 private:
     inline void initialShowInAction();
@@ -52,8 +55,11 @@ private:
     KNMusicLibraryEmptyHint *m_emptyHint;
     KNDropProxyContainer *m_dropProxy;
     KNMusicLibraryTreeView *m_treeview;
-    QAction *m_showInSongTab;
+    QAction *m_showInSongTab, *m_selectDuplicates;
     KNMusicLibraryModel *m_musicLibrary;
+    //The track which is asked to select its duplicates.
+    KNMusicDetailInfo m_duplicateDetailInfo;
+    bool m_findingDuplicates=false;
 };
 
 #endif // KNMUSICLIBRARYSONGTAB_H
@@ -21,6 +21,8 @@
 
 #include "knhighlightlabel.h"
 
+#include "knmusicspectrumvisualizer.h"
+
 #include "knmusicmainplayer.h"
 
 #include <QDebug>
@@ -66,6 +68,8 @@ KNMusicMainPlayer::KNMusicMainPlayer(QWidget *parent) :
     detailLayout->addWidget(m_detail);
     detailLayout->addWidget(m_title);
 
+    playerLayout->addWidget(m_visualizer, 1);
+
     //--Debug--.
     m_detail->setText("BiBi - Cutie Panther");
     m_title->setText("Cutie Panther");
@@ -110,6 +114,9 @@ inline void KNMusicMainPlayer::initialWidgets()
     pal.setColor(QPalette::WindowText, QColor(0xff, 0xa5, 0x00));
     m_title->setPalette(pal);
 
+    //Initial the spectrum visualizer.
+    m_visualizer=new KNMusicSpectrumVisualizer(this);
+
     //Initial the font.
     m_captionFont=m_detail->font();
     m_titleFont=m_title->font();
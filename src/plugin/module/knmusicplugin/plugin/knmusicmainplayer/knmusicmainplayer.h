@@ -23,6 +23,7 @@
 class QPropertyAnimation;
 class QLabel;
 class KNHighlightLabel;
+class KNMusicSpectrumVisualizer;
 class KNMusicMainPlayer : public KNMusicMainPlayerBase
 {
 public:
@@ -36,6 +37,7 @@ private:
     inline void initialWidgets();
     KNHighlightLabel *m_albumArt;
     QLabel *m_title, *m_detail;
+    KNMusicSpectrumVisualizer *m_visualizer;
     QFont m_captionFont, m_titleFont;
 };
 
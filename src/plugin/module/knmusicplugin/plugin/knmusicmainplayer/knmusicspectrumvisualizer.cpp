@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QPainter>
+#include <QtMath>
+
+#include "knmusicglobal.h"
+#include "knmusicspectrumfeed.h"
+
+#include "knmusicspectrumvisualizer.h"
+
+#include <QDebug>
+
+//The bars show the amplitude from -60dB to 0dB.
+#define MinimumLevel -60.0
+//How much a bar could fall in an update.
+#define BarFalloff 0.04
+#define BarSpacing 2
+
+KNMusicSpectrumVisualizer::KNMusicSpectrumVisualizer(QWidget *parent) :
+    QWidget(parent),
+    m_spectrumFeed(KNMusicGlobal::spectrumFeed()),
+    m_barColor(QColor(0xff, 0xa5, 0x00, 0xc0))
+{
+    //Split the bins into the bars in log scale, so every bar covers about the
+    //same octaves, each bar has one bin at least.
+    m_barStart[0]=1;
+    for(int i=1; i<=SpectrumBarCount; ++i)
+    {
+        int barStart=(int)qPow(SpectrumBinCount,
+                               (qreal)i/(qreal)SpectrumBarCount);
+        m_barStart[i]=qMax(barStart, m_barStart[i-1]+1);
+        m_barHeight[i-1]=0.0;
+    }
+    m_barStart[SpectrumBarCount]=qMin(m_barStart[SpectrumBarCount],
+                                      SpectrumBinCount);
+    //Link the feed.
+    if(!m_spectrumFeed.isNull())
+    {
+        connect(m_spectrumFeed.data(), &KNMusicSpectrumFeed::spectrumUpdated,
+                this, &KNMusicSpectrumVisualizer::onActionSpectrumUpdated);
+    }
+}
+
+KNMusicSpectrumVisualizer::~KNMusicSpectrumVisualizer()
+{
+    stopListen();
+}
+
+void KNMusicSpectrumVisualizer::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+    QPainter painter(this);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(m_barColor);
+    //Draw the bars from the bottom.
+    qreal barWidth=(qreal)width()/SpectrumBarCount;
+    for(int i=0; i<SpectrumBarCount; ++i)
+    {
+        qreal barHeight=m_barHeight[i]*height();
+        painter.drawRect(QRectF(i*barWidth,
+                                height()-barHeight,
+                                qMax(barWidth-BarSpacing, 1.0),
+                                barHeight));
+    }
+}
+
+void KNMusicSpectrumVisualizer::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    //Only ask for the spectrum when it can be seen.
+    startListen();
+}
+
+void KNMusicSpectrumVisualizer::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    stopListen();
+}
+
+void KNMusicSpectrumVisualizer::onActionSpectrumUpdated(
+        const QVector<float> &bins)
+{
+    //The spectrum may be queued before the widget is hidden, ignore it.
+    if(!isVisible() || bins.size()<SpectrumBinCount)
+    {
+        return;
+    }
+    const float *binData=bins.constData();
+    for(int i=0; i<SpectrumBarCount; ++i)
+    {
+        //Use the peak of the bins in the bar.
+        float amplitude=0.0;
+        for(int j=m_barStart[i]; j<m_barStart[i+1]; ++j)
+        {
+            amplitude=qMax(amplitude, binData[j]);
+        }
+        float level=amplitude>0.0?
+                    qBound(0.0,
+                           (20.0*log10(amplitude)-MinimumLevel)/-MinimumLevel,
+                           1.0):
+                    0.0;
+        //The bar rises at once, but falls down slowly.
+        m_barHeight[i]=qMax(level, (float)(m_barHeight[i]-BarFalloff));
+    }
+    update();
+}
+
+inline void KNMusicSpectrumVisualizer::startListen()
+{
+    if(!m_spectrumFeed.isNull() && !m_listening)
+    {
+        m_listening=true;
+        m_spectrumFeed->addListener();
+    }
+}
+
+inline void KNMusicSpectrumVisualizer::stopListen()
+{
+    if(!m_spectrumFeed.isNull() && m_listening)
+    {
+        m_listening=false;
+        m_spectrumFeed->removeListener();
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICSPECTRUMVISUALIZER_H
+#define KNMUSICSPECTRUMVISUALIZER_H
+
+#include <QPointer>
+#include <QVector>
+
+#include <QWidget>
+
+#define SpectrumBarCount 32
+
+class KNMusicSpectrumFeed;
+class KNMusicSpectrumVisualizer : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit KNMusicSpectrumVisualizer(QWidget *parent = 0);
+    ~KNMusicSpectrumVisualizer();
+
+signals:
+
+public slots:
+
+protected:
+    void paintEvent(QPaintEvent *event);
+    void showEvent(QShowEvent *event);
+    void hideEvent(QHideEvent *event);
+
+private slots:
+    void onActionSpectrumUpdated(const QVector<float> &bins);
+
+private:
+    inline void startListen();
+    inline void stopListen();
+    //The feed may be deleted before the main player.
+    QPointer<KNMusicSpectrumFeed> m_spectrumFeed;
+    //The first bin of each bar, the last one is the end of the last bar.
+    int m_barStart[SpectrumBarCount+1];
+    //The height of the bars, from 0.0 to 1.0.
+    float m_barHeight[SpectrumBarCount];
+    QColor m_barColor;
+    bool m_listening=false;
+};
+
+#endif // KNMUSICSPECTRUMVISUALIZER_H
@@ -26,60 +26,82 @@
 
 KNMusicNeteaseLyrics::KNMusicNeteaseLyrics(QObject *parent):
     KNMusicLyricsDownloader(parent)
-{
-    ;
-}
-
-void KNMusicNeteaseLyrics::downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                                        QList<KNMusicLyricsDetails> &lyricsList)
 {
     //Generate cookies.
     QNetworkCookie neteaseCookie;
     neteaseCookie.setName("appver");
     neteaseCookie.setValue("2.0.2;");
-    QVariant neteaseCookieData;
-    neteaseCookieData.setValue(neteaseCookie);
+    m_cookie.setValue(neteaseCookie);
+}
+
+void KNMusicNeteaseLyrics::search(const KNMusicDetailInfo &detailInfo)
+{
     //Generate search url.
     QString musicSearchURL="http://music.163.com/api/search/get/";
-    QByteArray responseData, parameter;
+    QByteArray parameter;
     parameter.append("limit=20&offset=0&type=1&s="+
                      QUrl::toPercentEncoding(detailInfo.textLists[Name]));
     post(musicSearchURL,
-         responseData,
          parameter,
-         neteaseCookieData,
+         SearchSong,
+         QVariant(),
+         m_cookie,
          "http://music.163.com/");
-    //Parse the json data.
-    QJsonObject songListObject=QJsonDocument::fromJson(responseData).object();
-    if(!songListObject.contains("result"))
+}
+
+void KNMusicNeteaseLyrics::processReply(const int &step,
+                                        const QByteArray &responseData,
+                                        const QVariant &user)
+{
+    switch(step)
     {
-        return;
-    }
-    //Get the result list.
-    QJsonObject resultObject=songListObject.value("result").toObject();
-    if(resultObject.value("songCount")==0)
+    case SearchSong:
     {
-        return;
+        //Parse the json data.
+        QJsonObject songListObject=QJsonDocument::fromJson(responseData).object();
+        if(!songListObject.contains("result"))
+        {
+            return;
+        }
+        //Get the result list.
+        QJsonObject resultObject=songListObject.value("result").toObject();
+        if(resultObject.value("songCount")==0)
+        {
+            return;
+        }
+        QJsonArray resultList=resultObject.value("songs").toArray();
+        for(QJsonArray::iterator i=resultList.begin();
+            i!=resultList.end();
+            ++i)
+        {
+            //Each song contains the name, artist and id.
+            QJsonObject currentSong=(*i).toObject();
+            QString artist;
+            QJsonArray artistList=currentSong.value("artists").toArray();
+            for(QJsonArray::iterator j=artistList.begin();
+                j!=artistList.end();
+                ++j)
+            {
+                QJsonObject artistObject=(*j).toObject();
+                artist+=(artist.isEmpty()?",":"")+
+                        artistObject.value("name").toString();
+            }
+            //Get the lyrics, save the title and artist to the request.
+            get("http://music.163.com/api/song/lyric?os=pc&id="+
+                    QString::number(currentSong.value("id").toInt())+
+                    "&lv=-1&tv=-1",
+                GetLyrics,
+                QStringList() << currentSong.value("name").toString() << artist,
+                m_cookie,
+                "http://music.163.com");
+        }
+        break;
     }
-    QJsonArray resultList=resultObject.value("songs").toArray();
-    for(QJsonArray::iterator i=resultList.begin();
-        i!=resultList.end();
-        ++i)
+    case GetLyrics:
     {
-        //Each song contains the name, artist and id.
-        QJsonObject currentSong=(*i).toObject();
-        //Generate the lyrics URL.
-        QString lyricsURL="http://music.163.com/api/song/lyric?os=pc&id="+
-                           QString::number(currentSong.value("id").toInt())+
-                           "&lv=-1&tv=-1";
-        //Get the lyrics.
-        get(lyricsURL,
-            responseData,
-            neteaseCookieData,
-            "http://music.163.com");
         if(responseData.isEmpty())
         {
-            continue;
+            return;
         }
         //Parse the response data as json object.
         QJsonObject lyricsObject=QJsonDocument::fromJson(responseData).object();
@@ -88,22 +110,16 @@ void KNMusicNeteaseLyrics::downloadLyrics(const KNMusicDetailInfo &detailInfo,
         {
             QJsonObject lrcObject=lyricsObject.value("lrc").toObject();
             //Generate the lyrics detail.
+            QStringList songInfo=user.toStringList();
             KNMusicLyricsDetails currentLyrics;
-            currentLyrics.title=currentSong.value("name").toString();
-            QJsonArray artistList=currentSong.value("artists").toArray();
-            for(QJsonArray::iterator j=artistList.begin();
-                j!=artistList.end();
-                ++j)
-            {
-                QJsonObject artistObject=(*j).toObject();
-                currentLyrics.artist+=(currentLyrics.artist.isEmpty()?",":"")+
-                            artistObject.value("name").toString();
-            }
-            saveLyrics(detailInfo,
+            currentLyrics.title=songInfo.at(0);
+            currentLyrics.artist=songInfo.at(1);
+            saveLyrics(detailInfo(),
                        lrcObject.value("lyric").toString(),
                        currentLyrics);
-            //Add to list.
-            lyricsList.append(currentLyrics);
+            emit lyricsDownloaded(currentLyrics);
         }
+        break;
+    }
     }
 }
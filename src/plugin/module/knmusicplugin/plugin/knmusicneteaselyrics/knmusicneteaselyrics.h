@@ -29,10 +29,20 @@ public:
     {
         return "Baidu Music";
     }
-    void downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                        QList<KNMusicLyricsDetails> &lyricsList);
+
+protected:
+    void search(const KNMusicDetailInfo &detailInfo);
+    void processReply(const int &step,
+                      const QByteArray &responseData,
+                      const QVariant &user);
 
 private:
+    enum NeteaseSteps
+    {
+        SearchSong,
+        GetLyrics
+    };
+    QVariant m_cookie;
 };
 
 #endif // KNMUSICBAIDULYRICS_H
@@ -21,7 +21,6 @@
 #include "knconfigure.h"
 
 #include "knmusicsingleplaylistmodel.h"
-#include "knmusicmodelassist.h"
 #include "knmusicproxymodel.h"
 #include "knmusictab.h"
 
@@ -53,6 +52,7 @@ KNMusicNowPlaying2::KNMusicNowPlaying2(QObject *parent) :
     //Link the retranslate request signal and do retranslate.
     connect(KNGlobal::instance(), &KNGlobal::requireRetranslate,
             this, &KNMusicNowPlaying2::retranslate);
+    retranslate();
 }
 
 KNMusicNowPlaying2::~KNMusicNowPlaying2()
@@ -146,6 +146,8 @@ void KNMusicNowPlaying2::resetCurrentPlaying()
     //Clear the current index and analysis item.
     m_currentPlayingIndex=QPersistentModelIndex();
     m_currentPlayingAnalysisItem=KNMusicAnalysisItem();
+    m_currentPlayingLoaded=false;
+    m_currentPlayingReanalysised=false;
 }
 
 void KNMusicNowPlaying2::restoreConfigure()
@@ -406,18 +408,55 @@ void KNMusicNowPlaying2::onActionLoaded()
     m_playingMusicModel->setRowProperty(m_currentPlayingIndex.row(),
                                         CantPlayFlagRole,
                                         false);
-    //Give out the update signal.
-    emit nowPlayingChanged(m_currentPlayingAnalysisItem);
+    //Give out the update signal when the row is reanalysised.
+    m_currentPlayingLoaded=true;
+    if(m_currentPlayingReanalysised)
+    {
+        emit nowPlayingChanged(m_currentPlayingAnalysisItem);
+    }
+}
+
+void KNMusicNowPlaying2::onActionRowReanalysised(
+        const QPersistentModelIndex &index,
+        const KNMusicReanalysisItem &reanalysisItem)
+{
+    //Only the result of the current playing row is used.
+    if(m_currentPlayingReanalysised ||
+            index.model()!=m_playingMusicModel ||
+            index.row()!=m_currentPlayingIndex.row())
+    {
+        return;
+    }
+    //Keep the data of the row when the row can't be analysised.
+    m_currentPlayingReanalysised=true;
+    if(reanalysisItem.available)
+    {
+        m_currentPlayingAnalysisItem=reanalysisItem.analysisItem;
+    }
+    //Give out the update signal when the row is loaded.
+    if(m_currentPlayingLoaded)
+    {
+        emit nowPlayingChanged(m_currentPlayingAnalysisItem);
+    }
 }
 
 void KNMusicNowPlaying2::retranslate()
 {
-    ;
+    //Get the latest title and item info.
+    KNPreferenceTitleInfo playbackTitle;
+    QList<KNPreferenceItemInfo> itemList;
+    generateTitleAndItemInfo(playbackTitle, itemList);
+    //Ask to insert the info list.
+    KNMusicGlobal::instance()->insertItemInfoList(playbackTitle, itemList);
 }
 
 void KNMusicNowPlaying2::applyPreference()
 {
-    ;
+    //Update the replay gain settings.
+    m_replayGain=m_musicConfigure->getData("ReplayGain",
+                                           m_replayGain).toBool();
+    m_albumGain=m_musicConfigure->getData("AlbumGain",
+                                          m_albumGain).toBool();
 }
 
 inline void KNMusicNowPlaying2::initialTemporaryModel()
@@ -532,33 +571,68 @@ inline void KNMusicNowPlaying2::playRow(const int &proxyRow)
                                      BlankData,
                                      Qt::DecorationRole,
                                      m_playingIcon);
-    //First we need to reanalysis that row, if we cannot analysis that row,
-    //means we cannot .
-    KNMusicAnalysisItem currentAnalysisItem;
-    if(KNMusicModelAssist::reanalysisRow(m_playingMusicModel,
-                                         m_currentPlayingIndex,
-                                         currentAnalysisItem))
+    //Play the row with the data in the model, the row is reanalysised in the
+    //analysis thread, and the now playing information is given out when the
+    //row is loaded and the result comes back.
+    m_currentPlayingAnalysisItem=KNMusicAnalysisItem();
+    m_currentPlayingAnalysisItem.detailInfo=
+            m_playingMusicModel->detailInfoFromRow(m_currentPlayingIndex.row());
+    m_currentPlayingLoaded=false;
+    m_currentPlayingReanalysised=false;
+    connect(m_playingMusicModel, &KNMusicModel::rowReanalysised,
+            this, &KNMusicNowPlaying2::onActionRowReanalysised,
+            Qt::UniqueConnection);
+    m_playingMusicModel->reanalysisRows(QList<QPersistentModelIndex>()
+                                        << m_currentPlayingIndex);
+    //Get the detail info.
+    KNMusicDetailInfo &currentInfo=m_currentPlayingAnalysisItem.detailInfo;
+    //Set the gain of the row before playing.
+    applyReplayGain();
+    //Play the music, according to the detail information.
+    //This is a much better judge than the original version.
+    if(currentInfo.trackFilePath.isEmpty())
     {
-        //Process events.
-        qApp->processEvents();
-        //Save the current analsys item.
-        m_currentPlayingAnalysisItem=currentAnalysisItem;
-        //Get the detail info.
-        KNMusicDetailInfo &currentInfo=m_currentPlayingAnalysisItem.detailInfo;
-        //Update the music model row.
-        m_playingMusicModel->updateMusicRow(m_currentPlayingIndex.row(),
-                                            currentAnalysisItem);
-        //Play the music, according to the detail information.
-        //This is a much better judge than the original version.
-        if(currentInfo.trackFilePath.isEmpty())
-        {
-            m_backend->playFile(currentInfo.filePath);
-        }
-        else
-        {
-            m_backend->playSection(currentInfo.filePath,
-                                   currentInfo.startPosition,
-                                   currentInfo.duration);
-        }
+        m_backend->playFile(currentInfo.filePath);
+    }
+    else
+    {
+        m_backend->playSection(currentInfo.filePath,
+                               currentInfo.startPosition,
+                               currentInfo.duration);
+    }
+}
+
+inline void KNMusicNowPlaying2::generateTitleAndItemInfo(KNPreferenceTitleInfo &listTitle,
+                                                         QList<KNPreferenceItemInfo> &list)
+{
+    //Set the title.
+    listTitle.advanced=false;
+    listTitle.title=tr("Playback");
+    listTitle.titleIdentifier="Playback";
+
+    //Clear the list.
+    list.clear();
+    //Add the current info.
+    list.append(KNPreferenceItemGlobal::generateInfo(SwitcherItem,
+                                                     tr("Volume Normalization"),
+                                                     "ReplayGain",
+                                                     m_replayGain));
+    list.append(KNPreferenceItemGlobal::generateInfo(SwitcherItem,
+                                                     tr("Use Album Gain"),
+                                                     "AlbumGain",
+                                                     m_albumGain));
+}
+
+inline void KNMusicNowPlaying2::applyReplayGain()
+{
+    //The gain is scanned by the loudness scanner, the row which hasn't been
+    //scanned doesn't have a gain.
+    QVariant gain;
+    if(m_replayGain)
+    {
+        gain=m_playingMusicModel->roleData(m_currentPlayingIndex.row(),
+                                           m_albumGain?AlbumGain:TrackGain,
+                                           Qt::UserRole);
     }
+    m_backend->setReplayGain(gain.isValid()?gain.toReal():0.0);
 }
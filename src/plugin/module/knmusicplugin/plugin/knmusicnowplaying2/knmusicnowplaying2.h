@@ -18,6 +18,8 @@
 #ifndef KNMUSICNOWPLAYING2_H
 #define KNMUSICNOWPLAYING2_H
 
+#include "preference/knpreferenceitemglobal.h"
+
 #include "knmusicnowplayingbase.h"
 
 class KNMusicNowPlaying2 : public KNMusicNowPlayingBase
@@ -89,6 +91,8 @@ private slots:
     void applyPreference();
     //Play the specific row in the model.
     void playRow(const int &proxyRow);
+    void onActionRowReanalysised(const QPersistentModelIndex &index,
+                                 const KNMusicReanalysisItem &reanalysisItem);
 
 private:
     //Common functions.
@@ -96,6 +100,9 @@ private:
     inline void initialShadowModel();
     inline void clearNowPlayingIcon();
     inline void clearShadowModel();
+    inline void generateTitleAndItemInfo(KNPreferenceTitleInfo &listTitle,
+                                         QList<KNPreferenceItemInfo> &list);
+    inline void applyReplayGain();
 
     inline int nextRow(int currentProxyRow, bool ignoreLoopMode=false);
     inline int prevRow(int currentProxyRow, bool ignoreLoopMode=false);
@@ -120,7 +127,8 @@ private:
     KNMusicTab *m_currentTab=nullptr;
 
     //Flags.
-    bool m_manualPlayed=false;
+    bool m_manualPlayed=false, m_replayGain=true, m_albumGain=false,
+         m_currentPlayingLoaded=false, m_currentPlayingReanalysised=false;
 };
 
 #endif // KNMUSICNOWPLAYING2_H
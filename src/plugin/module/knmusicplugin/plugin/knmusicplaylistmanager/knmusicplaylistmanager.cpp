@@ -33,7 +33,6 @@
 
 #include "knmusicglobal.h"
 #include "knmusicnowplayingbase.h"
-#include "knmusicmodelassist.h"
 
 #include "knmusicplaylistmanager.h"
 
@@ -167,32 +166,17 @@ void KNMusicPlaylistManager::onActionAddToPlaylist(const int &row,
     {
         KNMusicPlaylistListAssistant::buildPlaylist(playlistItem);
     }
-    //Add files to the item.
+    //Add files to the item, the rows will be saved when they are analysised.
     playlistItem->playlistModel()->addFiles(filePaths);
-    //Set the changed flag.
-    playlistItem->setChanged(true);
 }
 
 void KNMusicPlaylistManager::onActionAddRowToPlaylist(const int &row,
-                                                      const QByteArray &rowData)
+                                                      const QList<QList<QStandardItem *> > &musicRows)
 {
     //Get the playlist item.
     KNMusicPlaylistListItem *playlistItem=m_playlistList->playlistItem(row);
-    //Check whether the item has been built before.
-    if(!playlistItem->built())
-    {
-        KNMusicPlaylistListAssistant::buildPlaylist(playlistItem);
-    }
-    //Add files to the item.
-    QJsonArray rowArray=KNMusicModelAssist::byteDataToJsonArray(rowData);
-    for(QJsonArray::iterator i=rowArray.begin();
-        i!=rowArray.end();
-        ++i)
-    {
-        playlistItem->playlistModel()->appendMusicRow(KNMusicModelAssist::generateRow((*i).toArray()));
-    }
-    //Set the changed flag.
-    playlistItem->setChanged(true);
+    //Add rows to the item.
+    KNMusicPlaylistListAssistant::appendPlaylistRows(playlistItem, musicRows);
 }
 
 void KNMusicPlaylistManager::onActionRemovePlaylist(const QModelIndex &index)
@@ -278,18 +262,12 @@ void KNMusicPlaylistManager::onActionCreatePlaylist(const int &row,
 }
 
 void KNMusicPlaylistManager::onActionCreatePlaylistWithRow(const int &row,
-                                                           const QByteArray &rowData)
+                                                           const QList<QList<QStandardItem *> > &musicRows)
 {
     //Genreate a blank playlist first.
     KNMusicPlaylistListItem *playlistItem=createBlankPlaylist(row);
-    //Add files to the item.
-    QJsonArray rowArray=KNMusicModelAssist::byteDataToJsonArray(rowData);
-    for(QJsonArray::iterator i=rowArray.begin();
-        i!=rowArray.end();
-        ++i)
-    {
-        playlistItem->playlistModel()->appendMusicRow(KNMusicModelAssist::generateRow((*i).toArray()));
-    }
+    //Add rows to the item.
+    playlistItem->playlistModel()->appendMusicRows(musicRows);
     //Set the changed flag.
     playlistItem->setChanged(true);
 }
@@ -336,6 +314,20 @@ void KNMusicPlaylistManager::locateIndexInModel(KNMusicModel *model,
     }
 }
 
+void KNMusicPlaylistManager::onActionResolveProgress(
+        KNMusicPlaylistListItem *playlistItem,
+        int resolved,
+        int total)
+{
+    //Show the progress as the tooltip of the playlist, the playlist tab will
+    //update the playlist info when the item is changed.
+    playlistItem->setToolTip(resolved<total?
+                                 tr("Importing %1 of %2 files...").arg(
+                                     QString::number(resolved),
+                                     QString::number(total)):
+                                 QString());
+}
+
 void KNMusicPlaylistManager::initialPlaylistLoader()
 {
     //Initial the loader.
@@ -346,6 +338,9 @@ void KNMusicPlaylistManager::initialPlaylistLoader()
     m_playlistLoader->installPlaylistParser(new KNMusicTTPLParser);
     m_playlistLoader->installPlaylistParser(new KNMusicWPLParser);
     m_playlistLoader->installPlaylistParser(new KNMusicM3UParser);
+    //Show the progress of importing the playlists.
+    connect(m_playlistLoader, &KNMusicPlaylistLoader::resolveProgress,
+            this, &KNMusicPlaylistManager::onActionResolveProgress);
 }
 
 void KNMusicPlaylistManager::saveChangedPlaylist()
@@ -379,6 +374,8 @@ KNMusicPlaylistListItem *KNMusicPlaylistManager::importPlaylistFromFile(const QS
     //Parse other type of the data.
     if(m_playlistLoader->parsePlaylist(filePath, playlistItem))
     {
+        //The parser adds the rows to the model directly.
+        playlistItem->setBuilt(true);
         //Set a file path for the item.
         playlistItem->setPlaylistFilePath(KNMusicPlaylistListAssistant::alloctPlaylistFilePath());
         //Add to playlist list.
@@ -412,8 +409,9 @@ KNMusicPlaylistListItem *KNMusicPlaylistManager::recoverPlaylistFromFile(const Q
 {
     KNMusicPlaylistListItem *playlistItem=
             KNMusicPlaylistListAssistant::generatePlaylist();
-    //Using the mu playlist parser to try to parse it.
-    if(KNMusicPlaylistListAssistant::readPlaylist(filePath, playlistItem))
+    //Using the mu playlist parser to try to parse it, only the header is read
+    //here, the tracks will be loaded when the playlist is displayed.
+    if(KNMusicPlaylistListAssistant::readPlaylistHeader(filePath, playlistItem))
     {
         //If we can parse it, means it's a standard playlist, add to playlist.
         m_playlistList->appendPlaylist(playlistItem);
@@ -24,6 +24,7 @@
 
 #include "knmusicplaylistmanagerbase.h"
 
+class QStandardItem;
 class KNMusicPlaylistLoader;
 class KNMusicPlaylistTab;
 class KNMusicPlaylistList;
@@ -47,7 +48,7 @@ private slots:
     void onActionAddToPlaylist(const int &row,
                                const QStringList &filePaths);
     void onActionAddRowToPlaylist(const int &row,
-                                  const QByteArray &rowData);
+                                  const QList<QList<QStandardItem *> > &musicRows);
     void onActionRemovePlaylist(const QModelIndex &index);
     void onActionImportPlaylist(QStringList playlistPaths);
     void onActionExportPlaylist(const QString &filePath,
@@ -56,10 +57,13 @@ private slots:
     void onActionCreatePlaylist(const int &row,
                                 const QStringList &filePaths);
     void onActionCreatePlaylistWithRow(const int &row,
-                                       const QByteArray &rowData);
+                                       const QList<QList<QStandardItem *> > &musicRows);
     void onActionCurrentPlaylistChanged(const QModelIndex &current,
                                         const QModelIndex &previous);
     void locateIndexInModel(KNMusicModel *model, QModelIndex index);
+    void onActionResolveProgress(KNMusicPlaylistListItem *playlistItem,
+                                 int resolved,
+                                 int total);
 
 private:
     inline void initialPlaylistLoader();
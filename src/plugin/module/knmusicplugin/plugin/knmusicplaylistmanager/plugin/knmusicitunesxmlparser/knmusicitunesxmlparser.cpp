@@ -16,9 +16,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 #include <QFile>
-#include <QLinkedList>
 #include <QUrl>
 #include <QFileInfo>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
 #include "knmusicparser.h"
 #include "knmusicmodelassist.h"
@@ -53,160 +54,69 @@ bool KNMusiciTunesXMLParser::parse(const QString &playlistFilePath,
     {
         return false;
     }
-    //Use QDomDocument to parse the file.
-    QDomDocument plistDocument;
-    if(!plistDocument.setContent(&plistFile, true))
+    //Read the file as a stream, the library file could be very large, never
+    //load the whole document into memory.
+    QXmlStreamReader plistReader(&plistFile);
+    //Check the root of the document.
+    if(!plistReader.readNextStartElement() ||
+            plistReader.name()!="plist" ||
+            plistReader.attributes().value("version")!="1.0")
     {
-        //If there's any error, return false.
         return false;
     }
-    //Close the playlist file.
-    plistFile.close();
-    //Get the root of the document, check the root.
-    QDomElement plistRoot=plistDocument.documentElement();
-    if(plistRoot.nodeName()!="plist" ||
-            !plistRoot.hasAttribute("version") ||
-            plistRoot.attribute("version")!="1.0")
-    {
-        return false;
-    }
-    //Get the dict elements.
-    QDomNodeList root=plistRoot.elementsByTagName("dict");
-    if(root.isEmpty())
-    {
-        return false;
-    }
-    QDomNodeList dictElement=root.at(0).toElement().childNodes();
-    //Check dict childe nodes size.
-    if(dictElement.isEmpty())
+    //Get the dict element.
+    if(!plistReader.readNextStartElement() ||
+            plistReader.name()!="dict")
     {
         return false;
     }
-    //Initial the track info hash.
-    QHash<QString, QString> musicLocateHash;
-    QStringList playlistIndexList;
-    //Get the first node.
-    QDomElement keyNode=dictElement.at(0).toElement(),
-                valueNode=keyNode.nextSiblingElement();
-    while(!keyNode.isNull() && !keyNode.isNull())
+    //Initial the track id to file path table and the playlist track list.
+    QHash<int, QString> trackLocations;
+    QList<int> playlistTrackIDs;
+    //The dict is made of key and value pairs.
+    while(plistReader.readNextStartElement())
     {
-        if(keyNode.text()=="Tracks")
+        if(plistReader.name()!="key")
         {
-            if(!valueNode.childNodes().isEmpty())
-            {
-                //Get all the tracks information.
-                QDomElement trackKeyNode=valueNode.childNodes().at(0).toElement(),
-                            trackValueNode=trackKeyNode.nextSiblingElement();
-                while(!trackKeyNode.isNull() && !trackValueNode.isNull())
-                {
-                    //Parse the track dict information.
-                    QDomElement songKeyNode=trackValueNode.childNodes().at(0).toElement(),
-                                songValueNode=songKeyNode.nextSiblingElement();
-                    while(!songKeyNode.isNull() && !songValueNode.isNull())
-                    {
-                        if(songKeyNode.text()=="Location")
-                        {
-                            QString rawUrlText=QUrl::fromPercentEncoding(songValueNode.text().toUtf8());
-                            if(rawUrlText.length()>17 &&
-                                    rawUrlText.left(17)=="file://localhost/")
-                            {
-                                rawUrlText.remove(0, 17);
-                            }
-                            else
-                            {
-                                rawUrlText=QUrl(rawUrlText).path();
-                            }
-                            QFileInfo currentFileInfo(rawUrlText);
-                            //Set the hash.
-                            musicLocateHash.insert(trackKeyNode.text(), currentFileInfo.absoluteFilePath());
-                            break;
-                        }
-                        //Get the next elements.
-                        songKeyNode=songValueNode.nextSiblingElement();
-                        if(songKeyNode.isNull())
-                        {
-                            break;
-                        }
-                        songValueNode=songKeyNode.nextSiblingElement();
-                    }
-                    //Get the next elements.
-                    trackKeyNode=trackValueNode.nextSiblingElement();
-                    if(trackKeyNode.isNull())
-                    {
-                        break;
-                    }
-                    trackValueNode=trackKeyNode.nextSiblingElement();
-                }
-            }
+            plistReader.skipCurrentElement();
+            continue;
         }
-        else if(keyNode.text()=="Playlists")
+        QString key=plistReader.readElementText();
+        //Get the value element.
+        if(!plistReader.readNextStartElement())
         {
-            if(valueNode.childNodes().size()!=0)
-            {
-                QDomElement playlistDict=valueNode.childNodes().at(0).toElement();
-                if(playlistDict.childNodes().size()!=0)
-                {
-                    QDomElement playlistKey=playlistDict.childNodes().at(0).toElement(),
-                                playlistValue=playlistKey.nextSiblingElement();
-                    //Read the playlist information.
-                    while(!playlistKey.isNull() && !playlistValue.isNull())
-                    {
-                        if(playlistKey.text()=="Name")
-                        {
-                            playlistItem->setText(playlistValue.text());
-                        }
-                        else if(playlistKey.text()=="Playlist Items")
-                        {
-                            //Check the array is empty or not.
-                            QDomNodeList itemsArray=playlistValue.childNodes();
-                            if(!itemsArray.isEmpty())
-                            {
-                                for(int i=0; i<itemsArray.size(); i++)
-                                {
-                                    QDomElement currentTrack=itemsArray.at(i).toElement();
-                                    if(currentTrack.childNodes().size()==2)
-                                    {
-                                        QDomElement trackElement=currentTrack.childNodes().at(0).toElement(),
-                                                    trackIndex=trackElement.nextSiblingElement();
-                                        if(trackElement.text()=="Track ID")
-                                        {
-                                            //Insert the track.
-                                            playlistIndexList.append(trackIndex.text());
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        //Get the playlist key.
-                        playlistKey=playlistValue.nextSiblingElement();
-                        if(playlistKey.isNull())
-                        {
-                            break;
-                        }
-                        playlistValue=playlistKey.nextSiblingElement();
-                    }
-                }
-            }
+            break;
         }
-        //Get the next elements.
-        keyNode=valueNode.nextSiblingElement();
-        if(keyNode.isNull())
+        if(key=="Tracks" && plistReader.name()=="dict")
         {
-            break;
+            parseTracks(plistReader, trackLocations);
+        }
+        else if(key=="Playlists" && plistReader.name()=="array")
+        {
+            parsePlaylists(plistReader, playlistItem, playlistTrackIDs);
+        }
+        else
+        {
+            plistReader.skipCurrentElement();
         }
-        valueNode=keyNode.nextSiblingElement();
     }
+    //Close the playlist file.
+    plistFile.close();
     //Check the result.
-    if(musicLocateHash.isEmpty() || playlistIndexList.isEmpty())
+    if(plistReader.hasError() ||
+            trackLocations.isEmpty() ||
+            playlistTrackIDs.isEmpty())
     {
         return false;
     }
     QStringList musicFileList;
+    musicFileList.reserve(playlistTrackIDs.size());
     //Prepare the file list.
-    while(!playlistIndexList.isEmpty())
+    for(QList<int>::iterator i=playlistTrackIDs.begin();
+        i!=playlistTrackIDs.end();
+        ++i)
     {
-        QString currentFilePath=musicLocateHash.value(playlistIndexList.takeFirst(),
-                                                      QString());
+        QString currentFilePath=trackLocations.value(*i);
         if(!currentFilePath.isEmpty())
         {
             musicFileList.append(currentFilePath);
@@ -222,171 +132,258 @@ bool KNMusiciTunesXMLParser::parse(const QString &playlistFilePath,
 bool KNMusiciTunesXMLParser::write(const QString &playlistFilePath,
                                    KNMusicPlaylistListItem *playlistItem)
 {
-    QDomDocument plistDocument;
+    //Open the destination file.
+    QFile plistFile(playlistFilePath);
+    if(!plistFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    //Write the document as a stream.
+    QXmlStreamWriter plistWriter(&plistFile);
+    plistWriter.setAutoFormatting(true);
+    plistWriter.setAutoFormattingIndent(4);
+    plistWriter.writeStartDocument();
+    plistWriter.writeDTD("<!DOCTYPE plist PUBLIC \"-//Apple Computer//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">");
     //Initial the plist element.
-    QDomElement plistRoot=plistDocument.createElement("plist");
-    plistRoot.setAttribute("version", "1.0");
-    plistDocument.appendChild(plistRoot);
-
+    plistWriter.writeStartElement("plist");
+    plistWriter.writeAttribute("version", "1.0");
     //Initial the dict element.
-    QDomElement dictElement=plistDocument.createElement("dict");
-    plistRoot.appendChild(dictElement);
-    appendDictValue(plistDocument, dictElement, "Major Version", 1);
-    appendDictValue(plistDocument, dictElement, "Minor Version", 1);
-    appendDictValue(plistDocument, dictElement, "Date", QDateTime::currentDateTime());
-    appendDictValue(plistDocument, dictElement, "Features", 5);
-    appendDictValue(plistDocument, dictElement, "Show Content Ratings", true);
+    plistWriter.writeStartElement("dict");
+    writeDictValue(plistWriter, "Major Version", 1);
+    writeDictValue(plistWriter, "Minor Version", 1);
+    writeDictValue(plistWriter, "Date", QDateTime::currentDateTime());
+    writeDictValue(plistWriter, "Features", 5);
+    writeDictValue(plistWriter, "Show Content Ratings", true);
 
-    //Generate database and song index list.
+    //Output the database info to dict, every file will be written only once.
     QHash<QString, int> filePathIndex;
-    QLinkedList<int> playlistIndexList;
     KNMusicPlaylistModel *playlistModel=playlistItem->playlistModel();
-    for(int i=0; i<playlistModel->rowCount(); i++)
+    plistWriter.writeTextElement("key", "Tracks");
+    plistWriter.writeStartElement("dict");
+    for(int currentRow=0; currentRow<playlistModel->rowCount(); currentRow++)
     {
-        QString currentPath=playlistModel->filePathFromRow(i);
-        int currentIndex=filePathIndex.value(currentPath, -1);
+        QString currentPath=playlistModel->filePathFromRow(currentRow);
         //Check if we have already have the path in the index.
-        if(currentIndex==-1)
+        if(filePathIndex.contains(currentPath))
         {
-            currentIndex=i;
-            //Insert the path to the hash.
-            filePathIndex.insert(currentPath, currentIndex);
+            continue;
         }
-        //Append the list.
-        playlistIndexList.append(currentIndex);
-    }
-
-    //Output the database info to dict.
-    //Initial the elements.
-    QDomElement tracksKey=plistDocument.createElement("key"),
-                tracksDict=plistDocument.createElement("dict");
-    QDomText tracksKeyValue=plistDocument.createTextNode("Tracks");
-    tracksKey.appendChild(tracksKeyValue);
-    //Add to dict elements.
-    dictElement.appendChild(tracksKey);
-    dictElement.appendChild(tracksDict);
-    //Write database info.
-    QList<int> songIndexList=filePathIndex.values();
-    while(!songIndexList.isEmpty())
-    {
-        int currentRow=songIndexList.takeFirst(),
-                trackID=currentRow+100;
+        filePathIndex.insert(currentPath, currentRow);
+        int trackID=currentRow+100;
         //Generate current row key and dict.
-        QDomElement trackKey=plistDocument.createElement("key"),
-                    trackDict=plistDocument.createElement("dict");
-        QDomText trackKeyValue=plistDocument.createTextNode(QString::number(trackID));
-        trackKey.appendChild(trackKeyValue);
-        //Generate the dict.
-        appendDictValue(plistDocument, trackDict, "Track ID", trackID);
-        appendDictValue(plistDocument, trackDict, "Name", playlistModel->itemText(currentRow, Name));
-        appendDictValue(plistDocument, trackDict, "Artist", playlistModel->itemText(currentRow, Artist));
-        appendDictValue(plistDocument, trackDict, "Album Artist", playlistModel->itemText(currentRow, AlbumArtist));
-        appendDictValue(plistDocument, trackDict, "Genre", playlistModel->itemText(currentRow, Genre));
-        appendDictValue(plistDocument, trackDict, "Kind", playlistModel->itemText(currentRow, Kind));
-        appendDictValue(plistDocument, trackDict, "Size", playlistModel->roleData(currentRow, Size, Qt::UserRole).toLongLong());
-        appendDictValue(plistDocument, trackDict, "Total Time", playlistModel->roleData(currentRow, Time, Qt::UserRole).toLongLong());
-        appendDictValue(plistDocument, trackDict, "Track Number", playlistModel->itemText(currentRow, TrackNumber).toInt());
-        appendDictValue(plistDocument, trackDict, "Track Count", playlistModel->itemText(currentRow, TrackCount).toInt());
-        appendDictValue(plistDocument, trackDict, "Year", playlistModel->itemText(currentRow, Year).toInt());
-        appendDictValue(plistDocument, trackDict, "Date Modified", playlistModel->roleData(currentRow, DateModified, Qt::UserRole).toDateTime());
-        appendDictValue(plistDocument, trackDict, "Date Added", playlistModel->roleData(currentRow, DateAdded, Qt::UserRole).toDateTime());
-        appendDictValue(plistDocument, trackDict, "Bit Rate", playlistModel->roleData(currentRow, BitRate, Qt::UserRole).toLongLong());
-        appendDictValue(plistDocument, trackDict, "Sample Rate", playlistModel->roleData(currentRow, SampleRate, Qt::UserRole).toLongLong());
-        appendDictValue(plistDocument, trackDict, "Track Type", "File");
-        QString fileLocate=QUrl::fromLocalFile(playlistModel->filePathFromRow(currentRow)).toString();
+        plistWriter.writeTextElement("key", QString::number(trackID));
+        plistWriter.writeStartElement("dict");
+        writeDictValue(plistWriter, "Track ID", trackID);
+        writeDictValue(plistWriter, "Name", playlistModel->itemText(currentRow, Name));
+        writeDictValue(plistWriter, "Artist", playlistModel->itemText(currentRow, Artist));
+        writeDictValue(plistWriter, "Album Artist", playlistModel->itemText(currentRow, AlbumArtist));
+        writeDictValue(plistWriter, "Genre", playlistModel->itemText(currentRow, Genre));
+        writeDictValue(plistWriter, "Kind", playlistModel->itemText(currentRow, Kind));
+        writeDictValue(plistWriter, "Size", playlistModel->roleData(currentRow, Size, Qt::UserRole).toLongLong());
+        writeDictValue(plistWriter, "Total Time", playlistModel->roleData(currentRow, Time, Qt::UserRole).toLongLong());
+        writeDictValue(plistWriter, "Track Number", playlistModel->itemText(currentRow, TrackNumber).toInt());
+        writeDictValue(plistWriter, "Track Count", playlistModel->itemText(currentRow, TrackCount).toInt());
+        writeDictValue(plistWriter, "Year", playlistModel->itemText(currentRow, Year).toInt());
+        writeDictValue(plistWriter, "Date Modified", playlistModel->roleData(currentRow, DateModified, Qt::UserRole).toDateTime());
+        writeDictValue(plistWriter, "Date Added", playlistModel->roleData(currentRow, DateAdded, Qt::UserRole).toDateTime());
+        writeDictValue(plistWriter, "Bit Rate", playlistModel->roleData(currentRow, BitRate, Qt::UserRole).toLongLong());
+        writeDictValue(plistWriter, "Sample Rate", playlistModel->roleData(currentRow, SampleRate, Qt::UserRole).toLongLong());
+        writeDictValue(plistWriter, "Track Type", "File");
+        QString fileLocate=QUrl::fromLocalFile(currentPath).toString();
 #ifdef Q_OS_WIN32
         fileLocate.insert(7, "localhost");
 #endif
-        appendDictValue(plistDocument, trackDict, "Location", QString(QUrl::toPercentEncoding(fileLocate, "/:")));
-        appendDictValue(plistDocument, trackDict, "File Folder Count", -1);
-        appendDictValue(plistDocument, trackDict, "Library Folder Count", -1);
-        //Add the key and dict to track.
-        tracksDict.appendChild(trackKey);
-        tracksDict.appendChild(trackDict);
+        writeDictValue(plistWriter, "Location", QString(QUrl::toPercentEncoding(fileLocate, "/:")));
+        writeDictValue(plistWriter, "File Folder Count", -1);
+        writeDictValue(plistWriter, "Library Folder Count", -1);
+        plistWriter.writeEndElement();
     }
+    plistWriter.writeEndElement();
 
     //Output the playlist info to dict.
-    QDomElement playlistKey=plistDocument.createElement("key"),
-                playlistArray=plistDocument.createElement("array");
-    QDomText playlistKeyValue=plistDocument.createTextNode("Playlists");
-    playlistKey.appendChild(playlistKeyValue);
-    //Add the key and array to dict element.
-    dictElement.appendChild(playlistKey);
-    dictElement.appendChild(playlistArray);
+    plistWriter.writeTextElement("key", "Playlists");
+    plistWriter.writeStartElement("array");
     //Generate current playlist information.
-    QDomElement playlistDict=plistDocument.createElement("dict");
-    playlistArray.appendChild(playlistDict);
-    //Set playlist information to the dict.
-    appendDictValue(plistDocument, playlistDict, "Name", playlistItem->text());
-    appendDictValue(plistDocument, playlistDict, "Playlist ID", "99");
-    appendDictValue(plistDocument, playlistDict, "All Items", true);
+    plistWriter.writeStartElement("dict");
+    writeDictValue(plistWriter, "Name", playlistItem->text());
+    writeDictValue(plistWriter, "Playlist ID", "99");
+    writeDictValue(plistWriter, "All Items", true);
     //Generate playlist items array.
-    QDomElement playlistItemsKey=plistDocument.createElement("key"),
-                playlistItemsArray=plistDocument.createElement("array");
-    QDomText playlistItemsKeyValue=plistDocument.createTextNode("Playlist Items");
-    playlistItemsKey.appendChild(playlistItemsKeyValue);
-    //Add to current playlist dict.
-    playlistDict.appendChild(playlistItemsKey);
-    playlistDict.appendChild(playlistItemsArray);
-    //Generate Track ID dicts.
-    while(!playlistIndexList.isEmpty())
+    plistWriter.writeTextElement("key", "Playlist Items");
+    plistWriter.writeStartElement("array");
+    for(int currentRow=0; currentRow<playlistModel->rowCount(); currentRow++)
+    {
+        //Generate Track ID dicts.
+        plistWriter.writeStartElement("dict");
+        writeDictValue(plistWriter,
+                       "Track ID",
+                       100+filePathIndex.value(
+                           playlistModel->filePathFromRow(currentRow)));
+        plistWriter.writeEndElement();
+    }
+    //Close the playlist items array, playlist dict and playlists array, and
+    //all the rest elements.
+    plistWriter.writeEndDocument();
+    //Close the file.
+    plistFile.close();
+    return !plistWriter.hasError();
+}
+
+inline void KNMusiciTunesXMLParser::parseTracks(QXmlStreamReader &plistReader,
+                                                QHash<int, QString> &trackLocations)
+{
+    //The tracks dict is made of track id keys and track dicts.
+    while(plistReader.readNextStartElement())
     {
-        QDomElement currentTrackDict=plistDocument.createElement("dict");
-        appendDictValue(plistDocument,
-                        currentTrackDict,
-                        "Track ID",
-                        100+playlistIndexList.takeFirst());
-        //Add the dict to the array.
-        playlistItemsArray.appendChild(currentTrackDict);
+        if(plistReader.name()!="key")
+        {
+            plistReader.skipCurrentElement();
+            continue;
+        }
+        int trackID=plistReader.readElementText().toInt();
+        //Get the track dict.
+        if(!plistReader.readNextStartElement())
+        {
+            return;
+        }
+        if(plistReader.name()!="dict")
+        {
+            plistReader.skipCurrentElement();
+            continue;
+        }
+        //We only need the location of the track, the values of the other keys
+        //will be skipped as non-key elements.
+        while(plistReader.readNextStartElement())
+        {
+            if(plistReader.name()!="key")
+            {
+                plistReader.skipCurrentElement();
+                continue;
+            }
+            if(plistReader.readElementText()!="Location")
+            {
+                continue;
+            }
+            if(!plistReader.readNextStartElement())
+            {
+                break;
+            }
+            trackLocations.insert(trackID,
+                                  locationToFilePath(
+                                      plistReader.readElementText()));
+        }
     }
-    return writePlaylistContentToFile(playlistFilePath,
-                                      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
-                                      "<!DOCTYPE plist PUBLIC \"-//Apple Computer//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"+
-                                      plistDocument.toString(4));
 }
 
-void KNMusiciTunesXMLParser::appendDictValue(QDomDocument &plistDocument,
-                                             QDomElement &dict,
-                                             const QString &key,
-                                             const QVariant &value)
+inline void KNMusiciTunesXMLParser::parsePlaylists(QXmlStreamReader &plistReader,
+                                                   KNMusicPlaylistListItem *playlistItem,
+                                                   QList<int> &playlistTrackIDs)
+{
+    bool playlistParsed=false;
+    while(plistReader.readNextStartElement())
+    {
+        //We only import the first playlist.
+        if(playlistParsed || plistReader.name()!="dict")
+        {
+            plistReader.skipCurrentElement();
+            continue;
+        }
+        playlistParsed=true;
+        //Read the playlist information.
+        while(plistReader.readNextStartElement())
+        {
+            if(plistReader.name()!="key")
+            {
+                plistReader.skipCurrentElement();
+                continue;
+            }
+            QString key=plistReader.readElementText();
+            //Get the value element.
+            if(!plistReader.readNextStartElement())
+            {
+                break;
+            }
+            if(key=="Name")
+            {
+                playlistItem->setText(plistReader.readElementText());
+            }
+            else if(key=="Playlist Items" && plistReader.name()=="array")
+            {
+                //Every item is a dict which contains the track id.
+                while(plistReader.readNextStartElement())
+                {
+                    while(plistReader.readNextStartElement())
+                    {
+                        if(plistReader.name()!="key")
+                        {
+                            plistReader.skipCurrentElement();
+                            continue;
+                        }
+                        if(plistReader.readElementText()!="Track ID")
+                        {
+                            continue;
+                        }
+                        if(!plistReader.readNextStartElement())
+                        {
+                            break;
+                        }
+                        playlistTrackIDs.append(
+                                    plistReader.readElementText().toInt());
+                    }
+                }
+            }
+            else
+            {
+                plistReader.skipCurrentElement();
+            }
+        }
+    }
+}
+
+inline QString KNMusiciTunesXMLParser::locationToFilePath(const QString &location)
+{
+    QString rawUrlText=QUrl::fromPercentEncoding(location.toUtf8());
+    if(rawUrlText.length()>17 &&
+            rawUrlText.left(17)=="file://localhost/")
+    {
+        rawUrlText.remove(0, 17);
+    }
+    else
+    {
+        rawUrlText=QUrl(rawUrlText).path();
+    }
+    return QFileInfo(rawUrlText).absoluteFilePath();
+}
+
+inline void KNMusiciTunesXMLParser::writeDictValue(QXmlStreamWriter &plistWriter,
+                                                   const QString &key,
+                                                   const QVariant &value)
 {
-    QDomElement keyElement=plistDocument.createElement("key"),
-                valueElement;
-    QDomText keyElementData=plistDocument.createTextNode(key),
-             valueElementData;
     switch(value.type())
     {
     case QVariant::Int:
-        valueElement=plistDocument.createElement("integer");
-        valueElementData=plistDocument.createTextNode(QString::number(value.toInt()));
+        plistWriter.writeTextElement("key", key);
+        plistWriter.writeTextElement("integer", QString::number(value.toInt()));
         break;
     case QVariant::DateTime:
-        valueElement=plistDocument.createElement("date");
-        valueElementData=plistDocument.createTextNode(
-                    value.toDateTime().toString("yyyy-MM-ddThh:mm:ssZ"));
+        plistWriter.writeTextElement("key", key);
+        plistWriter.writeTextElement("date",
+                                     value.toDateTime().toString("yyyy-MM-ddThh:mm:ssZ"));
         break;
     case QVariant::Bool:
-        valueElement=plistDocument.createElement(value.toBool()?"true":"false");
+        plistWriter.writeTextElement("key", key);
+        plistWriter.writeEmptyElement(value.toBool()?"true":"false");
         break;
     case QVariant::String:
-        valueElement=plistDocument.createElement("string");
-        valueElementData=plistDocument.createTextNode(value.toString());
+        plistWriter.writeTextElement("key", key);
+        plistWriter.writeTextElement("string", value.toString());
         break;
     case QVariant::LongLong:
-        valueElement=plistDocument.createElement("integer");
-        valueElementData=plistDocument.createTextNode(QString::number(value.toLongLong()));
+        plistWriter.writeTextElement("key", key);
+        plistWriter.writeTextElement("integer", QString::number(value.toLongLong()));
         break;
     default:
         //I don't support others!
         return;
     }
-    //Set the data to key and value element.
-    keyElement.appendChild(keyElementData);
-    if(!valueElement.isNull())
-    {
-        valueElement.appendChild(valueElementData);
-    }
-    //Add data to dict.
-    dict.appendChild(keyElement);
-    dict.appendChild(valueElement);
 }
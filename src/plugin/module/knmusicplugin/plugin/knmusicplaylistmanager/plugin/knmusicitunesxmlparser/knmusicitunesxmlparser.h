@@ -18,13 +18,12 @@
 #ifndef KNMUSICITUNESXMLPARSER_H
 #define KNMUSICITUNESXMLPARSER_H
 
-#include <QHash>
-#include <QDomDocument>
-
 #include <QHash>
 
 #include "../../sdk/knmusicplaylistparser.h"
 
+class QXmlStreamReader;
+class QXmlStreamWriter;
 class KNMusiciTunesXMLParser : public KNMusicPlaylistParser
 {
 public:
@@ -37,10 +36,15 @@ public:
                KNMusicPlaylistListItem *playlistItem);
 
 private:
-    inline void appendDictValue(QDomDocument &plistDocument,
-                                QDomElement &dict,
-                                const QString &key,
-                                const QVariant &value);
+    inline void parseTracks(QXmlStreamReader &plistReader,
+                            QHash<int, QString> &trackLocations);
+    inline void parsePlaylists(QXmlStreamReader &plistReader,
+                               KNMusicPlaylistListItem *playlistItem,
+                               QList<int> &playlistTrackIDs);
+    inline QString locationToFilePath(const QString &location);
+    inline void writeDictValue(QXmlStreamWriter &plistWriter,
+                               const QString &key,
+                               const QVariant &value);
 };
 
 #endif // KNMUSICITUNESXMLPARSER_H
@@ -19,10 +19,9 @@
 #include <QFileInfo>
 #include <QTextStream>
 
-#include "knmusicparser.h"
-#include "knmusicmodelassist.h"
 #include "../../sdk/knmusicplaylistlistitem.h"
 #include "../../sdk/knmusicplaylistmodel.h"
+#include "../../sdk/knmusicplaylistpathresolver.h"
 
 #include "knmusicm3uparser.h"
 
@@ -48,61 +47,52 @@ bool KNMusicM3UParser::parse(const QString &playlistFilePath,
 {
     //Open the playlist file first.
     QFile m3uFile(playlistFilePath);
+    QFileInfo m3uFileInfo(m3uFile);
     if(!m3uFile.open(QIODevice::ReadOnly))
     {
         return false;
     }
-    //Read all the file from the playlist.
+    //Read the file line by line.
     QTextStream m3uStream(&m3uFile);
-    QStringList fileLines=m3uStream.readAll().split(QRegExp("[\n\r]"),
-                                                    QString::SkipEmptyParts),
-                availableFilePath;
+    //M3U8 is the UTF-8 version of M3U.
+    if(m3uFileInfo.suffix().toLower()=="m3u8")
+    {
+        m3uStream.setCodec("UTF-8");
+    }
+    //The other parsers have been tried before this one, a file which is not
+    //named as M3U should at least has the extended M3U header.
+    QString currentLine=m3uStream.readLine();
+    if(!m3uFileInfo.suffix().startsWith("m3u", Qt::CaseInsensitive) &&
+            !currentLine.startsWith("#EXTM3U"))
+    {
+        return false;
+    }
+    //The paths will be checked in the search thread.
+    KNMusicPlaylistPathResolver *resolver=new KNMusicPlaylistPathResolver;
+    resolver->setBasePath(m3uFileInfo.absolutePath());
     //Until we cannot read any more.
-    for(QStringList::iterator currentLine=fileLines.begin();
-        currentLine!=fileLines.end();
-        ++currentLine)
+    while(!currentLine.isNull())
     {
-        //Check is this line unuseable.
-        if((*currentLine).at(0)=='#')
+        currentLine=currentLine.trimmed();
+        //Ignore the empty lines and the comments.
+        if(!currentLine.isEmpty() && currentLine.at(0)!='#')
         {
-            continue;
-        }
-        //Check is the file available.
-        QFileInfo currentFile(*currentLine);
-        //If exist, add it to file path list.
-        if(currentFile.exists())
-        {
-            availableFilePath.append(currentFile.absoluteFilePath());
+            resolver->appendPath(currentLine);
         }
+        currentLine=m3uStream.readLine();
     }
-    //Clear the no use data.
-    fileLines.clear();
     //Close the file.
     m3uFile.close();
     //Check if the file is available.
-    if(availableFilePath.isEmpty())
+    if(resolver->pathCount()==0)
     {
+        delete resolver;
         return false;
     }
-
     //Set the file name as the title.
-    QFileInfo m3uFileInfo(m3uFile);
     playlistItem->setText(m3uFileInfo.baseName());
-    //Get the model and the parser.
-    KNMusicPlaylistModel *playlistModel=playlistItem->playlistModel();
-    KNMusicParser *parser=KNMusicGlobal::parser();
-    //Parse all the file in the file list.
-    for(QStringList::iterator currentFilePath=availableFilePath.begin();
-        currentFilePath!=availableFilePath.end();
-        ++currentFilePath)
-    {
-        KNMusicAnalysisItem analysisItem;
-        //Treat it as a music file, parse it.
-        parser->parseFile(*currentFilePath, analysisItem);
-        //Add this song to playlist.
-        playlistModel->appendMusicRow(
-                    KNMusicModelAssist::generateRow(analysisItem.detailInfo));
-    }
+    //Resolve the files and add them to the playlist.
+    resolvePlaylistFiles(playlistItem, resolver);
     return true;
 }
 
@@ -23,6 +23,7 @@
 #include "knmusicmodelassist.h"
 #include "../../sdk/knmusicplaylistlistitem.h"
 #include "../../sdk/knmusicplaylistmodel.h"
+#include "../../sdk/knmusicplaylistpathresolver.h"
 
 #include "knmusicwplparser.h"
 
@@ -81,38 +82,21 @@ bool KNMusicWPLParser::parse(const QString &playlistFilePath,
     }
     //Read the title and body information
     playlistItem->setText(headNode.firstChildElement("title").text());
-    //Get the model and the parser.
-    KNMusicPlaylistModel *playlistModel=playlistItem->playlistModel();
-    //Read the seq node information.
-    QString nativeSeparatorPlaylistPath=
-            QDir::toNativeSeparators(wplFileInfo.absolutePath());
-    QStringList playlistFileList;
+    //Read the seq node information, the paths will be checked in the search
+    //thread, the relative path is relative to the playlist file.
+    KNMusicPlaylistPathResolver *resolver=new KNMusicPlaylistPathResolver;
+    resolver->setBasePath(wplFileInfo.absolutePath());
     for(QDomNode i=seqNode.firstChild();
         i!=seqNode.lastChild();
         i=i.nextSibling())
     {
         if(i.nodeName()=="media" && i.hasAttributes())
         {
-            QDomElement currentElement=i.toElement();
-            QString srcInformation=currentElement.attribute("src");
-            //Check is the file path absolute path.
-            QFileInfo currentFileInfo(srcInformation);
-            if(!currentFileInfo.exists())
-            {
-                //Treat it as relative file path.
-                currentFileInfo.setFile(nativeSeparatorPlaylistPath+"\\"+currentElement.attribute("src"));
-                //If the file is still not exist, then abandon this file track.
-                if(!currentFileInfo.exists())
-                {
-                    continue;
-                }
-            }
-            //Add this file to playlist file list.
-            playlistFileList.append(currentFileInfo.absoluteFilePath());
+            resolver->appendPath(i.toElement().attribute("src"));
         }
     }
     //Add to playlist.
-    playlistModel->addFiles(playlistFileList);
+    resolvePlaylistFiles(playlistItem, resolver);
     return true;
 }
 
@@ -24,6 +24,7 @@
 
 #include "../../sdk/knmusicplaylistlistitem.h"
 #include "../../sdk/knmusicplaylistmodel.h"
+#include "../../sdk/knmusicplaylistpathresolver.h"
 
 #include "knmusicxspfparser.h"
 
@@ -81,20 +82,20 @@ bool KNMusicXSPFParser::parse(const QString &playlistFilePath,
     }
     //Get the track list.
     QDomNodeList trackList=trackListData.childNodes();
-    QStringList fileList;
+    //The paths will be checked in the search thread.
+    KNMusicPlaylistPathResolver *resolver=new KNMusicPlaylistPathResolver;
+    resolver->setBasePath(QFileInfo(xspfFile).absolutePath());
     for(int i=0, trackCount=trackList.size(); i<trackCount; i++)
     {
         //Get the current track.
         QDomElement currentTrack=trackList.at(i).toElement();
         //Use QUrl to parse the location.
         QUrl currentUrl=QUrl(currentTrack.firstChildElement("location").text());
-        //Get the track file path set to a music detail info.
-        QFileInfo currentInfo(currentUrl.path());
-        //Add to detail list.
-        fileList.append(currentInfo.absoluteFilePath());
+        //Add the track file path to the resolver.
+        resolver->appendPath(currentUrl.path());
     }
     //Add files to playlist item model.
-    playlistItem->playlistModel()->addFiles(fileList);
+    resolvePlaylistFiles(playlistItem, resolver);
     //Set changed flags.
     playlistItem->setChanged(true);
     return true;
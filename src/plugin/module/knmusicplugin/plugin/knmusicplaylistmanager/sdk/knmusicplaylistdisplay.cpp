@@ -128,12 +128,13 @@ void KNMusicPlaylistDisplay::displayPlaylistItem(KNMusicPlaylistListItem *item)
     KNMusicPlaylistModel *musicModel=m_currentItem->playlistModel();
     m_playlistTreeView->setMusicModel(musicModel);
     //When user add or remove file to playlist, should update the detail info.
+    //The added and removed rows are saved by the playlist itself.
     m_modelSignalHandler->addConnectionHandle(
                 connect(musicModel, &KNMusicPlaylistModel::itemChanged,
                         this, &KNMusicPlaylistDisplay::onActionRowChanged));
     m_modelSignalHandler->addConnectionHandle(
                 connect(musicModel, &KNMusicPlaylistModel::rowCountChanged,
-                        this, &KNMusicPlaylistDisplay::onActionRowChanged));
+                        this, &KNMusicPlaylistDisplay::updateDetailInfo));
     //Update the informations.
     updatePlaylistInfo();
 }
@@ -15,11 +15,14 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
+#include <QJsonArray>
 #include <QMimeData>
 
 #include "knglobal.h"
 #include "knconnectionhandler.h"
 #include "knmusicglobal.h"
+#include "knmusicmodelassist.h"
+#include "knmusicrowmimedata.h"
 #include "knmusicplaylistlistitem.h"
 #include "knmusicplaylistlistassistant.h"
 
@@ -79,15 +82,35 @@ bool KNMusicPlaylistList::dropMimeData(const QMimeData *data,
         //Check is the data contains music row.
         if(data->hasFormat("org.kreogist.mu.musicrowlist"))
         {
+            //Copy the rows from the model directly when it's dragged from Mu,
+            //or else parse the rows data.
+            QList<QList<QStandardItem *> > musicRows;
+            const KNMusicRowMimeData *rowMimeData=
+                    qobject_cast<const KNMusicRowMimeData *>(data);
+            if(rowMimeData!=nullptr)
+            {
+                musicRows=rowMimeData->musicRows();
+            }
+            else
+            {
+                QJsonArray rowArray=KNMusicModelAssist::byteDataToJsonArray(
+                            data->data("org.kreogist.mu.musicrowlist"));
+                musicRows.reserve(rowArray.size());
+                for(QJsonArray::iterator i=rowArray.begin();
+                    i!=rowArray.end();
+                    ++i)
+                {
+                    musicRows.append(KNMusicModelAssist::generateRow((*i).toArray()));
+                }
+            }
             if(parent.isValid())
             {
-                emit requireAddRowToPlaylist(parent.row(),
-                                             data->data("org.kreogist.mu.musicrowlist"));
+                emit requireAddRowToPlaylist(parent.row(), musicRows);
             }
             else
             {
                 emit requireCreatePlaylistRow(row==-1?rowCount():row,
-                                              data->data("org.kreogist.mu.musicrowlist"));
+                                              musicRows);
             }
             return true;
         }
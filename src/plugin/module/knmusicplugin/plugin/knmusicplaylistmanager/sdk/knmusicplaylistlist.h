@@ -47,9 +47,11 @@ public:
 
 signals:
     void requireAddFileToPlaylist(int playlistRowIndex, QStringList fileList);
-    void requireAddRowToPlaylist(int playlistRowIndex, QByteArray rowData);
+    void requireAddRowToPlaylist(int playlistRowIndex,
+                                 QList<QList<QStandardItem *> > musicRows);
     void requireCreatePlaylist(int preferRow, QStringList fileList);
-    void requireCreatePlaylistRow(int preferRow, QByteArray rowData);
+    void requireCreatePlaylistRow(int preferRow,
+                                  QList<QList<QStandardItem *> > musicRows);
     void requireShowContent();
     void requireHideContent();
 
@@ -15,6 +15,7 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
+#include <QDataStream>
 #include <QDateTime>
 #include <QFileInfo>
 #include <QFile>
@@ -22,6 +23,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QPersistentModelIndex>
 
 #include "knglobal.h"
 
@@ -36,10 +38,27 @@
 
 using namespace KNMusic;
 
+//The magic number of the binary playlist file, "KNPL".
+#define PlaylistMagicNumber 0x4B4E504C
+//The position of the version and the track count in the binary playlist file.
+#define PlaylistHeaderVersionOffset 4
+#define PlaylistHeaderCountOffset 8
+//The oldest binary version which could still be read, the playlists before
+//version 5 save the name before the string list and don't have the track count,
+//the duration and the replay gain columns, and the playlists before version 6
+//don't have the key column.
+#define MinimumBinaryVersion 4
+#define HeaderBinaryVersion 5
+#define GainBinaryVersion 5
+#define KeyBinaryVersion 6
+//The whole playlist will be saved when there're too many journals.
+#define MaxJournalCount 256
+
 QIcon KNMusicPlaylistListAssistant::m_playlistIcon=QIcon();
 QString KNMusicPlaylistListAssistant::m_playlistFolderPath=QString();
 QString KNMusicPlaylistListAssistant::m_playlistSuffix="mplst";
 int KNMusicPlaylistListAssistant::m_version=3;
+int KNMusicPlaylistListAssistant::m_binaryVersion=6;
 
 KNMusicPlaylistListAssistant::KNMusicPlaylistListAssistant(QObject *parent) :
     QObject(parent)
@@ -55,123 +74,197 @@ bool KNMusicPlaylistListAssistant::writePlaylistToFile(const QString &filePath,
     {
         return false;
     }
-    //Create the playlist content.
-    KNMusicPlaylistModel *playlistModel=item->playlistModel();
-    QJsonArray playlistContent;
-    //Check if the playlist model null. If not, save data.
-    if(playlistModel!=nullptr)
-    {
-        for(int row=0, songSize=playlistModel->rowCount();
-            row<songSize;
-            ++row)
-        {
-            //Initial the music item.
-            QJsonObject musicItem;
-            //Save the text data.
-            QJsonArray textData;
-            for(int j=0; j<MusicDataCount; j++)
-            {
-                textData.append(playlistModel->itemText(row, j));
-            }
-            musicItem["Text"]=textData;
-            //Save appendix data.
-            musicItem["FilePath"]=
-                    playlistModel->rowProperty(row, FilePathRole).toString();
-            musicItem["FileName"]=
-                    playlistModel->rowProperty(row, FileNameRole).toString();
-            musicItem["TrackFilePath"]=
-                    playlistModel->rowProperty(row, TrackFileRole).toString();
-            musicItem["TrackIndex"]=
-                    playlistModel->rowProperty(row, TrackIndexRole).toInt();
-            musicItem["StartPosition"]=
-                    playlistModel->rowProperty(row, StartPositionRole).toInt();
-            musicItem["Size"]=
-                    playlistModel->roleData(row, Size, Qt::UserRole).toInt();
-            musicItem["DateModified"]=
-                    KNMusicModelAssist::dateTimeToDataString(
-                        playlistModel->roleData(row,
-                                                DateModified,
-                                                Qt::UserRole));
-            musicItem["DateAdded"]=
-                    KNMusicModelAssist::dateTimeToDataString(
-                        playlistModel->roleData(row,
-                                                DateAdded,
-                                                Qt::UserRole));
-            musicItem["LastPlayed"]=
-                    KNMusicModelAssist::dateTimeToDataString(
-                        playlistModel->roleData(row,
-                                                LastPlayed,
-                                                Qt::UserRole));
-            musicItem["Time"]=
-                    playlistModel->roleData(row, Time, Qt::UserRole).toInt();
-            musicItem["BitRate"]=
-                    playlistModel->roleData(row, BitRate, Qt::UserRole).toInt();
-            musicItem["SampleRate"]=
-                    playlistModel->roleData(row, SampleRate, Qt::UserRole).toInt();
-            //Add to playlist content.
-            playlistContent.append(musicItem);
-        }
-    }
-    //Create the playlist object.
-    QJsonObject playlistObject;
-    //Set the data of the playlist.
-    playlistObject["Version"]=m_version;
-    playlistObject["Name"]=item->data(Qt::DisplayRole).toString();
-    playlistObject["Songs"]=playlistContent;
-    //Create playlist document
-    QJsonDocument playlistDocument;
-    playlistDocument.setObject(playlistObject);
-    //Write document data to the file.
-    playlistFile.write(playlistDocument.toJson());
+    //Get the tracks of the playlist.
+    QList<KNMusicPlaylistTrack> tracks=playlistTracks(item);
+    //Write the header, the track count and the duration are written before the
+    //name, so that they could be updated without rewriting the file.
+    QDataStream playlistStream(&playlistFile);
+    playlistStream.setVersion(QDataStream::Qt_5_0);
+    playlistStream<<(quint32)PlaylistMagicNumber
+                  <<(qint32)m_binaryVersion
+                  <<(qint32)tracks.size()
+                  <<(qint64)item->totalDuration()
+                  <<item->data(Qt::DisplayRole).toString();
+    //Write the tracks.
+    writeTracks(playlistStream, tracks);
     //Close the file.
     playlistFile.close();
     return true;
 }
 
-QString KNMusicPlaylistListAssistant::playlistFolderPath()
+void KNMusicPlaylistListAssistant::writeTracks(QDataStream &playlistStream,
+                                               const QList<KNMusicPlaylistTrack> &tracks)
 {
-    return m_playlistFolderPath;
+    //All the strings are saved once in the string list, the tracks only keep
+    //the index of the strings. The tracks are written to a buffer first.
+    QStringList stringList;
+    QHash<QString, quint32> stringIndexes;
+    QByteArray trackData;
+    QDataStream trackStream(&trackData, QIODevice::WriteOnly);
+    trackStream.setVersion(QDataStream::Qt_5_0);
+    trackStream<<(quint32)tracks.size();
+    for(QList<KNMusicPlaylistTrack>::const_iterator i=tracks.constBegin();
+        i!=tracks.constEnd();
+        ++i)
+    {
+        const KNMusicDetailInfo &detailInfo=(*i).detailInfo;
+        trackStream<<(*i).trackId;
+        //Save the file information for all the tracks, the library track could
+        //be found from file when the library is not available.
+        trackStream<<stringIndex(detailInfo.filePath, stringIndexes, stringList)
+                   <<stringIndex(detailInfo.trackFilePath, stringIndexes, stringList)
+                   <<(qint32)detailInfo.trackIndex;
+        //The library track only need the track id.
+        if((*i).trackId!=0)
+        {
+            continue;
+        }
+        //Save the text data.
+        for(int j=0; j<MusicDataCount; j++)
+        {
+            trackStream<<stringIndex(detailInfo.textLists[j],
+                                     stringIndexes,
+                                     stringList);
+        }
+        //Save appendix data.
+        trackStream<<stringIndex(detailInfo.fileName, stringIndexes, stringList)
+                   <<(qint64)detailInfo.startPosition
+                   <<(qint64)detailInfo.size
+                   <<(qint64)detailInfo.duration
+                   <<(qint64)detailInfo.bitRate
+                   <<(qint64)detailInfo.samplingRate
+                   <<(qint32)detailInfo.rating
+                   <<detailInfo.dateModified
+                   <<detailInfo.dateAdded
+                   <<detailInfo.lastPlayed
+                   <<(double)detailInfo.trackGain
+                   <<(double)detailInfo.albumGain;
+    }
+    //Write the string list and the tracks.
+    playlistStream<<stringList;
+    playlistStream.writeRawData(trackData.constData(), trackData.size());
 }
 
-void KNMusicPlaylistListAssistant::setPlaylistFolderPath(
-        const QString &playlistFolderPath)
+bool KNMusicPlaylistListAssistant::readTracks(QDataStream &playlistStream,
+                                              QList<KNMusicPlaylistTrack> &tracks,
+                                              const int &version)
 {
-    m_playlistFolderPath = KNGlobal::ensurePathAvaliable(playlistFolderPath);
+    //The old versions don't have the gain and the key columns, which are the
+    //last columns.
+    int textCount=(version<GainBinaryVersion)?(int)TrackGain:
+                  (version<KeyBinaryVersion)?(int)MusicalKey:(int)MusicDataCount;
+    //Read the string list.
+    QStringList stringList;
+    playlistStream>>stringList;
+    quint32 trackCount=0, trackId, filePathIndex, trackFilePathIndex, textIndex;
+    qint32 trackIndex, rating;
+    qint64 startPosition, size, duration, bitRate, samplingRate;
+    double trackGain=0.0, albumGain=0.0;
+    playlistStream>>trackCount;
+    for(quint32 i=0;
+        i<trackCount && playlistStream.status()==QDataStream::Ok;
+        ++i)
+    {
+        KNMusicPlaylistTrack track;
+        KNMusicDetailInfo &detailInfo=track.detailInfo;
+        //Read the file information.
+        playlistStream>>trackId>>filePathIndex>>trackFilePathIndex>>trackIndex;
+        track.trackId=trackId;
+        detailInfo.filePath=stringList.value(filePathIndex);
+        detailInfo.trackFilePath=stringList.value(trackFilePathIndex);
+        detailInfo.trackIndex=trackIndex;
+        if(trackId!=0)
+        {
+            //Use the file name as the title of the library track, it will be
+            //updated when the track is built.
+            detailInfo.fileName=QFileInfo(detailInfo.filePath).fileName();
+            detailInfo.textLists[Name]=detailInfo.fileName;
+            tracks.append(track);
+            continue;
+        }
+        //Read the text data.
+        for(int j=0; j<textCount; j++)
+        {
+            playlistStream>>textIndex;
+            detailInfo.textLists[j]=stringList.value(textIndex);
+        }
+        //Read appendix data.
+        playlistStream>>textIndex
+                      >>startPosition
+                      >>size
+                      >>duration
+                      >>bitRate
+                      >>samplingRate
+                      >>rating
+                      >>detailInfo.dateModified
+                      >>detailInfo.dateAdded
+                      >>detailInfo.lastPlayed;
+        if(version>=GainBinaryVersion)
+        {
+            playlistStream>>trackGain>>albumGain;
+        }
+        detailInfo.fileName=stringList.value(textIndex);
+        detailInfo.startPosition=startPosition;
+        detailInfo.size=size;
+        detailInfo.duration=duration;
+        detailInfo.bitRate=bitRate;
+        detailInfo.samplingRate=samplingRate;
+        detailInfo.rating=rating;
+        detailInfo.trackGain=trackGain;
+        detailInfo.albumGain=albumGain;
+        tracks.append(track);
+    }
+    //Check the data is complete.
+    return playlistStream.status()==QDataStream::Ok;
 }
 
-void KNMusicPlaylistListAssistant::loadPlaylistDatabase(const QString &filePath,
-                                                        QStringList &data)
+QList<KNMusicPlaylistTrack> KNMusicPlaylistListAssistant::playlistTracks(
+        KNMusicPlaylistListItem *item)
 {
-    //Clear the data first.
-    data=QStringList();
-    //Open the list file.
-    QFile playlistListFile(filePath);
-    if(!playlistListFile.exists() ||
-            !playlistListFile.open(QIODevice::ReadOnly))
+    //If the playlist has never been built, the content is the tracks.
+    if(!item->built())
     {
-        return;
-    }
-    //Load the data from file.
-    QJsonDocument playlistListData=
-            QJsonDocument::fromJson(playlistListFile.readAll());
-    //CLose the file ASAP.
-    playlistListFile.close();
-    QJsonObject playlistListObject=playlistListData.object();
-    //Check the version, we can only load one version.
-    if(playlistListObject["Version"].toInt()!=m_version)
-    {
-        return;
+        loadPlaylistContent(item);
+        return item->playlistContent();
     }
-    //Set the data to the string list.
-    QJsonArray playlistData=playlistListObject["Playlists"].toArray();
-    while(!playlistData.isEmpty())
+    KNMusicPlaylistModel *playlistModel=item->playlistModel();
+    return modelTracks(playlistModel, 0, playlistModel->rowCount());
+}
+
+QList<KNMusicPlaylistTrack> KNMusicPlaylistListAssistant::modelTracks(
+        KNMusicPlaylistModel *playlistModel,
+        const int &row,
+        const int &count)
+{
+    QList<KNMusicPlaylistTrack> tracks;
+    tracks.reserve(count);
+    for(int i=row, end=row+count; i<end; ++i)
     {
-        data.append(playlistData.takeAt(0).toString());
+        KNMusicPlaylistTrack track;
+        //The row which is copied from the library has the track id.
+        track.trackId=playlistModel->rowProperty(i, TrackIdRole).toUInt();
+        if(track.trackId==0)
+        {
+            track.detailInfo=playlistModel->detailInfoFromRow(i);
+        }
+        else
+        {
+            KNMusicDetailInfo &detailInfo=track.detailInfo;
+            detailInfo.filePath=
+                    playlistModel->rowProperty(i, FilePathRole).toString();
+            detailInfo.trackFilePath=
+                    playlistModel->rowProperty(i, TrackFileRole).toString();
+            detailInfo.trackIndex=
+                    playlistModel->rowProperty(i, TrackIndexRole).toInt();
+        }
+        tracks.append(track);
     }
+    return tracks;
 }
 
-bool KNMusicPlaylistListAssistant::readPlaylist(const QString &filePath,
-                                                KNMusicPlaylistListItem *item)
+bool KNMusicPlaylistListAssistant::readPlaylistFile(const QString &filePath,
+                                                    KNMusicPlaylistListItem *item,
+                                                    bool loadContent)
 {
     QFile playlistFile(filePath);
     //If you cannot open it, return false.
@@ -179,11 +272,179 @@ bool KNMusicPlaylistListAssistant::readPlaylist(const QString &filePath,
     {
         return false;
     }
-    //Read the document from file.
-    QJsonDocument playlistDocument=
-            QJsonDocument::fromJson(playlistFile.readAll());
+    //Check the magic number of the binary playlist.
+    QDataStream playlistStream(&playlistFile);
+    playlistStream.setVersion(QDataStream::Qt_5_0);
+    quint32 magicNumber=0;
+    playlistStream>>magicNumber;
+    bool readResult=false;
+    if(magicNumber==PlaylistMagicNumber)
+    {
+        QString playlistName;
+        qint32 version, trackCount;
+        qint64 totalDuration;
+        if(readBinaryHeader(playlistStream,
+                            version,
+                            playlistName,
+                            trackCount,
+                            totalDuration))
+        {
+            //Initial the items.
+            item->setData(playlistName, Qt::DisplayRole);
+            item->setTrackCount(trackCount);
+            item->setTotalDuration(totalDuration);
+            item->setChanged(false);
+            //The tracks will be loaded when they are used.
+            item->setContentLoaded(false);
+            if(version<HeaderBinaryVersion)
+            {
+                //The old header doesn't have the track count and the duration,
+                //load the tracks to get them. The duration of the library
+                //tracks is updated when the playlist is built.
+                readResult=readBinaryContent(playlistStream, item, version);
+                if(readResult)
+                {
+                    QList<KNMusicPlaylistTrack> tracks=item->playlistContent();
+                    qint64 totalDuration=0;
+                    for(QList<KNMusicPlaylistTrack>::const_iterator
+                            i=tracks.constBegin();
+                        i!=tracks.constEnd();
+                        ++i)
+                    {
+                        totalDuration+=(*i).detailInfo.duration;
+                    }
+                    item->setTotalDuration(totalDuration);
+                    //Save the playlist in the current layout.
+                    item->setChanged(true);
+                }
+            }
+            else
+            {
+                readResult=!loadContent ||
+                        readBinaryContent(playlistStream, item, version);
+            }
+        }
+    }
+    else
+    {
+        //It should be a playlist in the old json format.
+        playlistFile.seek(0);
+        readResult=readJsonPlaylist(playlistFile.readAll(), item);
+    }
     //Close the playlist ASAP.
     playlistFile.close();
+    if(!readResult)
+    {
+        return false;
+    }
+    QFileInfo playlistFileInfo(playlistFile);
+    item->setPlaylistFilePath(playlistFileInfo.absoluteFilePath());
+    return true;
+}
+
+bool KNMusicPlaylistListAssistant::readBinaryHeader(QDataStream &playlistStream,
+                                                    qint32 &version,
+                                                    QString &playlistName,
+                                                    qint32 &trackCount,
+                                                    qint64 &totalDuration)
+{
+    //Check the version.
+    version=0;
+    playlistStream>>version;
+    if(version<MinimumBinaryVersion || version>m_binaryVersion)
+    {
+        return false;
+    }
+    //The old header only has the name.
+    if(version<HeaderBinaryVersion)
+    {
+        trackCount=0;
+        totalDuration=0;
+        playlistStream>>playlistName;
+        return playlistStream.status()==QDataStream::Ok;
+    }
+    playlistStream>>trackCount>>totalDuration>>playlistName;
+    return playlistStream.status()==QDataStream::Ok;
+}
+
+bool KNMusicPlaylistListAssistant::readBinaryContent(QDataStream &playlistStream,
+                                                     KNMusicPlaylistListItem *item,
+                                                     const int &version)
+{
+    //Read the saved tracks.
+    QList<KNMusicPlaylistTrack> tracks;
+    if(!readTracks(playlistStream, tracks, version))
+    {
+        return false;
+    }
+    //Apply the journals after the tracks.
+    int journalCount=0;
+    bool journalBroken=false;
+    quint8 journalType;
+    qint32 row, count;
+    while(!playlistStream.atEnd())
+    {
+        playlistStream>>journalType>>row;
+        if(playlistStream.status()!=QDataStream::Ok)
+        {
+            journalBroken=true;
+            break;
+        }
+        if(journalType==JournalInsert)
+        {
+            QList<KNMusicPlaylistTrack> insertTracks;
+            if(!readTracks(playlistStream, insertTracks, version))
+            {
+                journalBroken=true;
+                break;
+            }
+            row=qBound(0, row, tracks.size());
+            for(QList<KNMusicPlaylistTrack>::iterator i=insertTracks.begin();
+                i!=insertTracks.end();
+                ++i)
+            {
+                tracks.insert(row++, *i);
+            }
+        }
+        else if(journalType==JournalRemove)
+        {
+            playlistStream>>count;
+            if(playlistStream.status()!=QDataStream::Ok)
+            {
+                journalBroken=true;
+                break;
+            }
+            for(int i=0; i<count && row>-1 && row<tracks.size(); ++i)
+            {
+                tracks.removeAt(row);
+            }
+        }
+        else
+        {
+            journalBroken=true;
+            break;
+        }
+        ++journalCount;
+    }
+    //Set the content to the item.
+    item->setPlaylistContent(tracks);
+    item->setContentLoaded(true);
+    item->setTrackCount(tracks.size());
+    item->setJournalCount(journalCount);
+    //When the last journal is broken, e.g. the application crashed while it's
+    //writing, save the whole playlist again.
+    if(journalBroken)
+    {
+        item->setChanged(true);
+    }
+    return true;
+}
+
+bool KNMusicPlaylistListAssistant::readJsonPlaylist(const QByteArray &playlistData,
+                                                    KNMusicPlaylistListItem *item)
+{
+    //Read the document from the data.
+    QJsonDocument playlistDocument=QJsonDocument::fromJson(playlistData);
     //Get the playlist object.
     QJsonObject playlistObject=playlistDocument.object();
     if(playlistObject.isEmpty())
@@ -197,28 +458,19 @@ bool KNMusicPlaylistListAssistant::readPlaylist(const QString &filePath,
     }
     //Initial the items.
     item->setData(playlistObject["Name"].toString(), Qt::DisplayRole);
-    QFileInfo playlistFileInfo(playlistFile);
-    item->setPlaylistFilePath(playlistFileInfo.absoluteFilePath());
-    //Set the data to the string list.
-    item->setPlaylistContent(playlistObject["Songs"].toArray());
-    //Set the flag.
-    item->setChanged(false);
-    return true;
-}
-
-void KNMusicPlaylistListAssistant::buildPlaylist(KNMusicPlaylistListItem *item)
-{
-    //Get the playlist content from the item.
-    QJsonArray playlistContent=item->playlistContent();
-    item->clearPlaylistContent();
-    //Initial the model from the content.
+    //Translate the songs to the tracks.
+    QJsonArray playlistContent=playlistObject["Songs"].toArray();
+    QList<KNMusicPlaylistTrack> tracks;
+    tracks.reserve(playlistContent.size());
+    qint64 totalDuration=0;
     for(auto i=playlistContent.begin();
         i!=playlistContent.end();
         ++i)
     {
         //Prepare line data.
         QJsonObject musicItem=(*i).toObject();
-        KNMusicDetailInfo currentInfo;
+        KNMusicPlaylistTrack track;
+        KNMusicDetailInfo &currentInfo=track.detailInfo;
         //Get the text data.
         QJsonArray textData=musicItem["Text"].toArray();
         for(int i=0; i<MusicDataCount; i++)
@@ -244,6 +496,236 @@ void KNMusicPlaylistListAssistant::buildPlaylist(KNMusicPlaylistListItem *item)
         currentInfo.duration=musicItem["Time"].toInt();
         currentInfo.bitRate=musicItem["BitRate"].toDouble();
         currentInfo.samplingRate=musicItem["SampleRate"].toDouble();
+        totalDuration+=currentInfo.duration;
+        tracks.append(track);
+    }
+    item->setPlaylistContent(tracks);
+    item->setContentLoaded(true);
+    item->setTrackCount(tracks.size());
+    item->setTotalDuration(totalDuration);
+    //The playlist should be saved in the binary format.
+    item->setChanged(true);
+    return true;
+}
+
+void KNMusicPlaylistListAssistant::loadPlaylistContent(KNMusicPlaylistListItem *item)
+{
+    //Check whether the content has been loaded.
+    if(item->contentLoaded())
+    {
+        return;
+    }
+    //Even the file is broken, we won't try to read it again.
+    item->setContentLoaded(true);
+    QFile playlistFile(item->playlistFilePath());
+    if(!playlistFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    //Skip the header, the header data in the item may be changed.
+    QDataStream playlistStream(&playlistFile);
+    playlistStream.setVersion(QDataStream::Qt_5_0);
+    quint32 magicNumber=0;
+    QString playlistName;
+    qint32 version, trackCount;
+    qint64 totalDuration;
+    playlistStream>>magicNumber;
+    if(magicNumber==PlaylistMagicNumber &&
+            readBinaryHeader(playlistStream,
+                             version,
+                             playlistName,
+                             trackCount,
+                             totalDuration))
+    {
+        readBinaryContent(playlistStream, item, version);
+    }
+    playlistFile.close();
+}
+
+void KNMusicPlaylistListAssistant::journalInsertTracks(
+        KNMusicPlaylistListItem *item,
+        const int &row,
+        const QList<KNMusicPlaylistTrack> &tracks)
+{
+    //Generate the journal data.
+    QByteArray journalData;
+    QDataStream journalStream(&journalData, QIODevice::WriteOnly);
+    journalStream.setVersion(QDataStream::Qt_5_0);
+    journalStream<<(quint8)JournalInsert<<(qint32)row;
+    writeTracks(journalStream, tracks);
+    //Write the journal.
+    writeJournal(item, journalData);
+}
+
+void KNMusicPlaylistListAssistant::journalRemoveTracks(
+        KNMusicPlaylistListItem *item,
+        const int &row,
+        const int &count)
+{
+    //Generate the journal data.
+    QByteArray journalData;
+    QDataStream journalStream(&journalData, QIODevice::WriteOnly);
+    journalStream.setVersion(QDataStream::Qt_5_0);
+    journalStream<<(quint8)JournalRemove<<(qint32)row<<(qint32)count;
+    //Write the journal.
+    writeJournal(item, journalData);
+}
+
+inline void KNMusicPlaylistListAssistant::writeJournal(
+        KNMusicPlaylistListItem *item,
+        const QByteArray &journalData)
+{
+    //The journal can only be appended to a saved binary playlist, the changed
+    //playlist will be saved as a whole later.
+    if(item->changed())
+    {
+        return;
+    }
+    QFile playlistFile(item->playlistFilePath());
+    if(!playlistFile.exists() || !playlistFile.open(QIODevice::ReadWrite))
+    {
+        item->setChanged(true);
+        return;
+    }
+    //The journal is written in the current version, it can't be appended to
+    //a playlist saved in an old version, save the whole playlist instead.
+    QDataStream playlistStream(&playlistFile);
+    playlistStream.setVersion(QDataStream::Qt_5_0);
+    qint32 version=0;
+    playlistFile.seek(PlaylistHeaderVersionOffset);
+    playlistStream>>version;
+    if(version!=m_binaryVersion)
+    {
+        playlistFile.close();
+        item->setChanged(true);
+        return;
+    }
+    //Update the track count and the duration in the header.
+    playlistFile.seek(PlaylistHeaderCountOffset);
+    playlistStream<<(qint32)item->trackCount()<<(qint64)item->totalDuration();
+    //Append the journal to the end of the file.
+    playlistFile.seek(playlistFile.size());
+    playlistFile.write(journalData);
+    playlistFile.close();
+    //Too many journals will slow down the loading, save the whole playlist
+    //when it's too many.
+    item->setJournalCount(item->journalCount()+1);
+    if(item->journalCount()>=MaxJournalCount)
+    {
+        item->setChanged(true);
+    }
+}
+
+inline quint32 KNMusicPlaylistListAssistant::stringIndex(
+        const QString &text,
+        QHash<QString, quint32> &stringIndexes,
+        QStringList &stringList)
+{
+    //Find the string in the list.
+    QHash<QString, quint32>::const_iterator textIndex=stringIndexes.constFind(text);
+    if(textIndex!=stringIndexes.constEnd())
+    {
+        return textIndex.value();
+    }
+    //Add the string to the list.
+    quint32 index=stringList.size();
+    stringIndexes.insert(text, index);
+    stringList.append(text);
+    return index;
+}
+
+QString KNMusicPlaylistListAssistant::playlistFolderPath()
+{
+    return m_playlistFolderPath;
+}
+
+void KNMusicPlaylistListAssistant::setPlaylistFolderPath(
+        const QString &playlistFolderPath)
+{
+    m_playlistFolderPath = KNGlobal::ensurePathAvaliable(playlistFolderPath);
+}
+
+void KNMusicPlaylistListAssistant::loadPlaylistDatabase(const QString &filePath,
+                                                        QStringList &data)
+{
+    //Clear the data first.
+    data=QStringList();
+    //Open the list file.
+    QFile playlistListFile(filePath);
+    if(!playlistListFile.exists() ||
+            !playlistListFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    //Load the data from file.
+    QJsonDocument playlistListData=
+            QJsonDocument::fromJson(playlistListFile.readAll());
+    //CLose the file ASAP.
+    playlistListFile.close();
+    QJsonObject playlistListObject=playlistListData.object();
+    //Check the version, we can only load one version.
+    if(playlistListObject["Version"].toInt()!=m_version)
+    {
+        return;
+    }
+    //Set the data to the string list.
+    QJsonArray playlistData=playlistListObject["Playlists"].toArray();
+    while(!playlistData.isEmpty())
+    {
+        data.append(playlistData.takeAt(0).toString());
+    }
+}
+
+bool KNMusicPlaylistListAssistant::readPlaylistHeader(const QString &filePath,
+                                                      KNMusicPlaylistListItem *item)
+{
+    //Only read the header, the tracks will be loaded when it's needed.
+    return readPlaylistFile(filePath, item, false);
+}
+
+bool KNMusicPlaylistListAssistant::readPlaylist(const QString &filePath,
+                                                KNMusicPlaylistListItem *item)
+{
+    return readPlaylistFile(filePath, item, true);
+}
+
+void KNMusicPlaylistListAssistant::buildPlaylist(KNMusicPlaylistListItem *item)
+{
+    //Load the tracks from the playlist file.
+    loadPlaylistContent(item);
+    //Get the playlist content from the item.
+    QList<KNMusicPlaylistTrack> playlistContent=item->playlistContent();
+    item->clearPlaylistContent();
+    KNMusicPlaylistModel *playlistModel=item->playlistModel();
+    KNMusicModel *libraryModel=KNMusicGlobal::libraryModel();
+    //Generate all the rows from the content.
+    QList<QList<QStandardItem *> > musicRows;
+    QList<QPersistentModelIndex> missingRows;
+    QList<int> missingPositions;
+    for(QList<KNMusicPlaylistTrack>::iterator i=playlistContent.begin();
+        i!=playlistContent.end();
+        ++i)
+    {
+        KNMusicDetailInfo &currentInfo=(*i).detailInfo;
+        //Copy the row of library track from the library.
+        if((*i).trackId!=0)
+        {
+            int libraryRow=(libraryModel==nullptr)?
+                        -1:libraryModel->rowFromTrackId((*i).trackId);
+            if(libraryRow!=-1)
+            {
+                musicRows.append(libraryModel->songRow(libraryRow));
+                continue;
+            }
+            //The library is not loaded or the track has been removed, generate
+            //the row from the file information, and analysis it again.
+            QList<QStandardItem *> musicRow=
+                    KNMusicModelAssist::generateRow(currentInfo);
+            musicRow.at(Name)->setData((*i).trackId, TrackIdRole);
+            missingPositions.append(musicRows.size());
+            musicRows.append(musicRow);
+            continue;
+        }
         //Here we need to update some info for multi-locale.
         currentInfo.textLists[DateModified]=
                 KNMusicModelAssist::dateTimeToString(currentInfo.dateModified);
@@ -251,14 +733,88 @@ void KNMusicPlaylistListAssistant::buildPlaylist(KNMusicPlaylistListItem *item)
                 KNMusicModelAssist::dateTimeToString(currentInfo.dateAdded);
         currentInfo.textLists[LastPlayed]=
                 KNMusicModelAssist::dateTimeToString(currentInfo.lastPlayed);
-        //Insert the music row.
-        item->playlistModel()->appendMusicRow(
-                    KNMusicModelAssist::generateRow(currentInfo));
+        musicRows.append(KNMusicModelAssist::generateRow(currentInfo));
+    }
+    //Insert all the music rows.
+    int firstRow=playlistModel->rowCount();
+    playlistModel->appendMusicRows(musicRows);
+    //Analysis the missing library tracks.
+    if(!missingPositions.isEmpty())
+    {
+        for(QList<int>::iterator i=missingPositions.begin();
+            i!=missingPositions.end();
+            ++i)
+        {
+            missingRows.append(QPersistentModelIndex(
+                                   playlistModel->index(firstRow+(*i), Name)));
+        }
+        playlistModel->reanalysisRows(missingRows);
     }
     //Set builded flag.
     item->setBuilt(true);
 }
 
+void KNMusicPlaylistListAssistant::appendPlaylistRows(
+        KNMusicPlaylistListItem *item,
+        const QList<QList<QStandardItem *> > &musicRows)
+{
+    //Check whether all the rows are library tracks.
+    bool libraryTracks=true;
+    for(QList<QList<QStandardItem *> >::const_iterator i=musicRows.constBegin();
+        i!=musicRows.constEnd();
+        ++i)
+    {
+        if((*i).at(Name)->data(TrackIdRole).toUInt()==0)
+        {
+            libraryTracks=false;
+            break;
+        }
+    }
+    //If the playlist has been built, or there's a row which is not in library,
+    //the rows should be added to the model.
+    if(item->built() || !libraryTracks)
+    {
+        //Check whether the item has been built before.
+        if(!item->built())
+        {
+            buildPlaylist(item);
+        }
+        item->playlistModel()->appendMusicRows(musicRows);
+        return;
+    }
+    //Only the references to the library tracks are needed for the playlist
+    //which is not built, the rows will be copied from the library when it's
+    //built.
+    loadPlaylistContent(item);
+    QList<KNMusicPlaylistTrack> tracks;
+    qint64 tracksDuration=0;
+    for(QList<QList<QStandardItem *> >::const_iterator i=musicRows.constBegin();
+        i!=musicRows.constEnd();
+        ++i)
+    {
+        QStandardItem *propertyItem=(*i).at(Name);
+        KNMusicPlaylistTrack track;
+        track.trackId=propertyItem->data(TrackIdRole).toUInt();
+        track.detailInfo.filePath=propertyItem->data(FilePathRole).toString();
+        track.detailInfo.fileName=propertyItem->data(FileNameRole).toString();
+        track.detailInfo.trackFilePath=propertyItem->data(TrackFileRole).toString();
+        track.detailInfo.trackIndex=propertyItem->data(TrackIndexRole).toInt();
+        track.detailInfo.textLists[Name]=propertyItem->text();
+        tracks.append(track);
+        tracksDuration+=(*i).at(Time)->data(Qt::UserRole).toLongLong();
+        //The rows are not used any more.
+        qDeleteAll(*i);
+    }
+    QList<KNMusicPlaylistTrack> playlistContent=item->playlistContent();
+    int row=playlistContent.size();
+    playlistContent.append(tracks);
+    item->setPlaylistContent(playlistContent);
+    item->setTrackCount(playlistContent.size());
+    item->setTotalDuration(item->totalDuration()+tracksDuration);
+    //Save the tracks to the playlist file.
+    journalInsertTracks(item, row, tracks);
+}
+
 bool KNMusicPlaylistListAssistant::writePlaylist(KNMusicPlaylistListItem *item)
 {
     //We still need to check this item.
@@ -267,7 +823,14 @@ bool KNMusicPlaylistListAssistant::writePlaylist(KNMusicPlaylistListItem *item)
         return false;
     }
     //Write the playlist to the item's file.
-    return writePlaylistToFile(item->playlistFilePath(), item);
+    if(!writePlaylistToFile(item->playlistFilePath(), item))
+    {
+        return false;
+    }
+    //The whole playlist is saved, the journals are gone.
+    item->setChanged(false);
+    item->setJournalCount(0);
+    return true;
 }
 
 bool KNMusicPlaylistListAssistant::exportPlaylist(const QString &filePath,
@@ -362,5 +925,27 @@ KNMusicPlaylistListItem *KNMusicPlaylistListAssistant::generatePlaylist(
     KNMusicPlaylistListItem *playlistItem=new KNMusicPlaylistListItem();
     playlistItem->setIcon(m_playlistIcon);
     playlistItem->setText(caption);
+    //Save the changes of the rows as journals. The rows which are inserted when
+    //building the playlist are already in the file.
+    KNMusicPlaylistModel *playlistModel=playlistItem->playlistModel();
+    connect(playlistModel, &KNMusicPlaylistModel::musicRowsInserted,
+            [=](int row, int count)
+            {
+                if(playlistItem->built())
+                {
+                    journalInsertTracks(playlistItem,
+                                        row,
+                                        modelTracks(playlistModel, row, count));
+                }
+            });
+    connect(playlistModel, &KNMusicPlaylistModel::rowsRemoved,
+            [=](const QModelIndex &parent, int first, int last)
+            {
+                Q_UNUSED(parent)
+                if(playlistItem->built())
+                {
+                    journalRemoveTracks(playlistItem, first, last-first+1);
+                }
+            });
     return playlistItem;
 }
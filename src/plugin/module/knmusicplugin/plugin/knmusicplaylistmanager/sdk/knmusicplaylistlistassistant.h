@@ -18,22 +18,23 @@
 #ifndef KNMUSICPLAYLISTLISTASSISTANT_H
 #define KNMUSICPLAYLISTLISTASSISTANT_H
 
+#include <QHash>
 #include <QIcon>
 #include <QStringList>
 
 #include <QObject>
 
+class QDataStream;
+class QStandardItem;
 class KNMusicPlaylistModel;
 class KNMusicPlaylistListItem;
+struct KNMusicPlaylistTrack;
 class KNMusicPlaylistListAssistant : public QObject
 {
     Q_OBJECT
 public:
     static KNMusicPlaylistListItem *generateBlankPlaylist(const QString &caption);
     static KNMusicPlaylistListItem *generatePlaylist(const QString &caption=QString());
-    static bool parsePlaylistFile(const QString &playlistFilePath,
-                                  QString &title,
-                                  QJsonArray &playlistData);
     static QIcon playlistIcon();
     static void setPlaylistIcon(const QIcon &playlistIcon);
     static QString playlistSuffix();
@@ -41,9 +42,13 @@ public:
     static void setPlaylistFolderPath(const QString &playlistFolderPath);
     static void loadPlaylistDatabase(const QString &filePath,
                                      QStringList &data);
+    static bool readPlaylistHeader(const QString &filePath,
+                                   KNMusicPlaylistListItem *item);
     static bool readPlaylist(const QString &filePath,
                              KNMusicPlaylistListItem *item);
     static void buildPlaylist(KNMusicPlaylistListItem *item);
+    static void appendPlaylistRows(KNMusicPlaylistListItem *item,
+                                   const QList<QList<QStandardItem *> > &musicRows);
     static bool writePlaylist(KNMusicPlaylistListItem *item);
     static bool exportPlaylist(const QString &filePath,
                                KNMusicPlaylistListItem *item);
@@ -59,10 +64,50 @@ private:
     explicit KNMusicPlaylistListAssistant(QObject *parent = 0);
     static bool writePlaylistToFile(const QString &filePath,
                                     KNMusicPlaylistListItem *item);
+    enum PlaylistJournalType
+    {
+        JournalInsert=1,
+        JournalRemove
+    };
+    static void writeTracks(QDataStream &playlistStream,
+                            const QList<KNMusicPlaylistTrack> &tracks);
+    static bool readTracks(QDataStream &playlistStream,
+                           QList<KNMusicPlaylistTrack> &tracks,
+                           const int &version);
+    static QList<KNMusicPlaylistTrack> playlistTracks(KNMusicPlaylistListItem *item);
+    static QList<KNMusicPlaylistTrack> modelTracks(KNMusicPlaylistModel *playlistModel,
+                                                   const int &row,
+                                                   const int &count);
+    static bool readPlaylistFile(const QString &filePath,
+                                 KNMusicPlaylistListItem *item,
+                                 bool loadContent);
+    static bool readBinaryHeader(QDataStream &playlistStream,
+                                 qint32 &version,
+                                 QString &playlistName,
+                                 qint32 &trackCount,
+                                 qint64 &totalDuration);
+    static bool readBinaryContent(QDataStream &playlistStream,
+                                  KNMusicPlaylistListItem *item,
+                                  const int &version);
+    static bool readJsonPlaylist(const QByteArray &playlistData,
+                                 KNMusicPlaylistListItem *item);
+    static void loadPlaylistContent(KNMusicPlaylistListItem *item);
+    static void journalInsertTracks(KNMusicPlaylistListItem *item,
+                                    const int &row,
+                                    const QList<KNMusicPlaylistTrack> &tracks);
+    static void journalRemoveTracks(KNMusicPlaylistListItem *item,
+                                    const int &row,
+                                    const int &count);
+    static inline void writeJournal(KNMusicPlaylistListItem *item,
+                                    const QByteArray &journalData);
+    static inline quint32 stringIndex(const QString &text,
+                                      QHash<QString, quint32> &stringIndexes,
+                                      QStringList &stringList);
     static QIcon m_playlistIcon;
     static QString m_playlistFolderPath;
     static QString m_playlistSuffix;
     static int m_version;
+    static int m_binaryVersion;
 };
 
 #endif // KNMUSICPLAYLISTLISTASSISTANT_H
@@ -55,19 +55,19 @@ void KNMusicPlaylistListItem::setChanged(bool changed)
 {
     m_changed = changed;
 }
-QJsonArray KNMusicPlaylistListItem::playlistContent() const
+QList<KNMusicPlaylistTrack> KNMusicPlaylistListItem::playlistContent() const
 {
     return m_playlistContent;
 }
 
-void KNMusicPlaylistListItem::setPlaylistContent(const QJsonArray &playlistContent)
+void KNMusicPlaylistListItem::setPlaylistContent(const QList<KNMusicPlaylistTrack> &playlistContent)
 {
     m_playlistContent = playlistContent;
 }
 
 void KNMusicPlaylistListItem::clearPlaylistContent()
 {
-    m_playlistContent=QJsonArray();
+    m_playlistContent.clear();
 }
 bool KNMusicPlaylistListItem::built() const
 {
@@ -79,5 +79,43 @@ void KNMusicPlaylistListItem::setBuilt(bool builded)
     m_builded = builded;
 }
 
+bool KNMusicPlaylistListItem::contentLoaded() const
+{
+    return m_contentLoaded;
+}
 
+void KNMusicPlaylistListItem::setContentLoaded(bool contentLoaded)
+{
+    m_contentLoaded = contentLoaded;
+}
 
+int KNMusicPlaylistListItem::trackCount()
+{
+    //After the playlist is built, the model is the playlist.
+    return m_builded?m_playlistModel->rowCount():m_trackCount;
+}
+
+void KNMusicPlaylistListItem::setTrackCount(int trackCount)
+{
+    m_trackCount = trackCount;
+}
+
+qint64 KNMusicPlaylistListItem::totalDuration()
+{
+    return m_builded?m_playlistModel->totalDuration():m_totalDuration;
+}
+
+void KNMusicPlaylistListItem::setTotalDuration(const qint64 &totalDuration)
+{
+    m_totalDuration = totalDuration;
+}
+
+int KNMusicPlaylistListItem::journalCount() const
+{
+    return m_journalCount;
+}
+
+void KNMusicPlaylistListItem::setJournalCount(int journalCount)
+{
+    m_journalCount = journalCount;
+}
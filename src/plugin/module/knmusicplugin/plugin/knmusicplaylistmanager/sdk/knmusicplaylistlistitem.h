@@ -18,10 +18,21 @@
 #ifndef KNMUSICPLAYLISTLISTITEM_H
 #define KNMUSICPLAYLISTLISTITEM_H
 
-#include <QJsonArray>
+#include <QList>
 
 #include <QStandardItem>
 
+#include "knmusicglobal.h"
+
+struct KNMusicPlaylistTrack
+{
+    //The id of the track in the music library, 0 when the track is not in the
+    //library. Only the file information in the detail info is available for a
+    //library track.
+    quint32 trackId=0;
+    KNMusicDetailInfo detailInfo;
+};
+
 class KNMusicPlaylistModel;
 class KNMusicPlaylistListItem : public QStandardItem
 {
@@ -33,17 +44,27 @@ public:
     void setPlaylistFilePath(const QString &playlistFilePath);
     bool changed() const;
     void setChanged(bool changed);
-    QJsonArray playlistContent() const;
-    void setPlaylistContent(const QJsonArray &playlistContent);
+    QList<KNMusicPlaylistTrack> playlistContent() const;
+    void setPlaylistContent(const QList<KNMusicPlaylistTrack> &playlistContent);
     void clearPlaylistContent();
     bool built() const;
     void setBuilt(bool built);
+    bool contentLoaded() const;
+    void setContentLoaded(bool contentLoaded);
+    int trackCount();
+    void setTrackCount(int trackCount);
+    qint64 totalDuration();
+    void setTotalDuration(const qint64 &totalDuration);
+    int journalCount() const;
+    void setJournalCount(int journalCount);
 
 private:
     KNMusicPlaylistModel *m_playlistModel=nullptr;
     QString m_playlistFilePath;
-    QJsonArray m_playlistContent;
-    bool m_changed=false, m_builded=false;
+    QList<KNMusicPlaylistTrack> m_playlistContent;
+    qint64 m_totalDuration=0;
+    int m_trackCount=0, m_journalCount=0;
+    bool m_changed=false, m_builded=false, m_contentLoaded=true;
 };
 
 #endif // KNMUSICPLAYLISTLISTITEM_H
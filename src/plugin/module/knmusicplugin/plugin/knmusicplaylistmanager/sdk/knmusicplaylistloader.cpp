@@ -38,6 +38,9 @@ KNMusicPlaylistLoader::~KNMusicPlaylistLoader()
 void KNMusicPlaylistLoader::installPlaylistParser(KNMusicPlaylistParser *parser)
 {
     m_parsers.append(parser);
+    //Give out the resolving progress of the parser.
+    connect(parser, &KNMusicPlaylistParser::resolveProgress,
+            this, &KNMusicPlaylistLoader::resolveProgress);
 }
 
 bool KNMusicPlaylistLoader::parsePlaylist(const QString &filePath,
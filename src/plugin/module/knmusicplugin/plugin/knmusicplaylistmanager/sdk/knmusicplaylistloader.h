@@ -44,6 +44,9 @@ public:
                        KNMusicPlaylistListItem *playlistItem);
 
 signals:
+    void resolveProgress(KNMusicPlaylistListItem *playlistItem,
+                         int resolved,
+                         int total);
 
 public slots:
 
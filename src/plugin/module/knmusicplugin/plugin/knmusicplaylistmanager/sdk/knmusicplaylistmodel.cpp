@@ -57,6 +57,37 @@ void KNMusicPlaylistModel::retranslate()
     setHorizontalHeaderLabels(header);
 }
 
+void KNMusicPlaylistModel::appendMusicRow(const QList<QStandardItem *> &musicRow)
+{
+    int row=rowCount();
+    KNMusicModel::appendMusicRow(musicRow);
+    //The rows are ready, tell the playlist to save them.
+    emit musicRowsInserted(row, 1);
+}
+
+void KNMusicPlaylistModel::insertMusicRow(const int &row,
+                                          const QList<QStandardItem *> &musicRow)
+{
+    KNMusicModel::insertMusicRow(row, musicRow);
+    emit musicRowsInserted(row, 1);
+}
+
+void KNMusicPlaylistModel::insertMusicRows(int row,
+                                           const QList<QList<QStandardItem *> > &musicRows)
+{
+    if(musicRows.isEmpty())
+    {
+        return;
+    }
+    //Check the row, -1 means append the rows.
+    if(row<0 || row>rowCount())
+    {
+        row=rowCount();
+    }
+    KNMusicModel::insertMusicRows(row, musicRows);
+    emit musicRowsInserted(row, musicRows.size());
+}
+
 void KNMusicPlaylistModel::initialHeader()
 {
     //Using retranslate to update the header text.
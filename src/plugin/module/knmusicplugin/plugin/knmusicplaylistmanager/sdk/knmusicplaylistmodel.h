@@ -29,9 +29,15 @@ public:
     int playingItemColumn();
 
 signals:
+    void musicRowsInserted(int row, int count);
 
 public slots:
     void retranslate();
+    void appendMusicRow(const QList<QStandardItem *> &musicRow);
+    void insertMusicRow(const int &row,
+                        const QList<QStandardItem *> &musicRow);
+    void insertMusicRows(int row,
+                         const QList<QList<QStandardItem *> > &musicRows);
 
 private:
     inline void initialHeader();
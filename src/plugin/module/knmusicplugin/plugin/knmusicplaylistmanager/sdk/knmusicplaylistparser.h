@@ -11,10 +11,12 @@
 #include <QFile>
 
 #include "knmusicglobal.h"
+#include "knmusicplaylistlistitem.h"
+#include "knmusicplaylistmodel.h"
+#include "knmusicplaylistpathresolver.h"
 
 #include <QObject>
 
-class KNMusicPlaylistListItem;
 class KNMusicPlaylistParser : public QObject
 {
     Q_OBJECT
@@ -28,10 +30,34 @@ public:
                        KNMusicPlaylistListItem *playlistItem)=0;
 
 signals:
+    void resolveProgress(KNMusicPlaylistListItem *playlistItem,
+                         int resolved,
+                         int total);
 
 public slots:
 
 protected:
+    inline void resolvePlaylistFiles(KNMusicPlaylistListItem *playlistItem,
+                                     KNMusicPlaylistPathResolver *resolver)
+    {
+        KNMusicPlaylistModel *playlistModel=playlistItem->playlistModel();
+        //The model is the context of the connections, when the playlist is
+        //removed before the resolving finished, the result will be dropped.
+        connect(resolver, &KNMusicPlaylistPathResolver::pathsResolved,
+                playlistModel, &KNMusicPlaylistModel::addFiles);
+        connect(resolver, &KNMusicPlaylistPathResolver::resolveProgress,
+                playlistModel, [=](int resolved, int total)
+                {
+                    emit resolveProgress(playlistItem, resolved, total);
+                });
+        connect(resolver, &KNMusicPlaylistPathResolver::resolveFinished,
+                resolver, &KNMusicPlaylistPathResolver::deleteLater);
+        //Resolve the paths in the search thread.
+        resolver->moveToThread(KNMusicGlobal::instance()->searchThread());
+        emit resolver->requireResolveNext();
+    }
+
+
     inline bool writePlaylistContentToFile(const QString &filePath,
                                            const QString &fileContent)
     {
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QFileInfo>
+#include <QUrl>
+
+#include "knmusicplaylistpathresolver.h"
+
+#include <QDebug>
+
+#define ResolveBatchSize 64
+
+KNMusicPlaylistPathResolver::KNMusicPlaylistPathResolver(QObject *parent) :
+    QObject(parent)
+{
+    //Resolve the next batch in a queued connection, give the event loop of the
+    //search thread a chance to handle the other requests between two batches.
+    connect(this, &KNMusicPlaylistPathResolver::requireResolveNext,
+            this, &KNMusicPlaylistPathResolver::resolveNext,
+            Qt::QueuedConnection);
+}
+
+void KNMusicPlaylistPathResolver::setBasePath(const QString &basePath)
+{
+    m_baseDir.setPath(basePath);
+}
+
+void KNMusicPlaylistPathResolver::appendPath(const QString &path)
+{
+    m_paths.append(path);
+}
+
+int KNMusicPlaylistPathResolver::pathCount() const
+{
+    return m_paths.size();
+}
+
+void KNMusicPlaylistPathResolver::resolveNext()
+{
+    //Check the paths of the current batch.
+    int batchEnd=qMin(m_resolvedCount+ResolveBatchSize, m_paths.size());
+    QStringList resolvedPaths;
+    for(int i=m_resolvedCount; i<batchEnd; ++i)
+    {
+        QString filePath=resolvePath(m_paths.at(i));
+        if(!filePath.isEmpty())
+        {
+            resolvedPaths.append(filePath);
+        }
+    }
+    m_resolvedCount=batchEnd;
+    //Give out the existing files of this batch.
+    if(!resolvedPaths.isEmpty())
+    {
+        emit pathsResolved(resolvedPaths);
+    }
+    emit resolveProgress(m_resolvedCount, m_paths.size());
+    //Check whether there's still any path left.
+    if(m_resolvedCount<m_paths.size())
+    {
+        emit requireResolveNext();
+        return;
+    }
+    //Clear the cache.
+    m_directoryExist.clear();
+    emit resolveFinished();
+}
+
+QString KNMusicPlaylistPathResolver::resolvePath(QString path)
+{
+    //Some playlists save the file as a local url.
+    if(path.startsWith("file:", Qt::CaseInsensitive))
+    {
+        path=QUrl(path).toLocalFile();
+    }
+    //A relative path is relative to the playlist file.
+    QFileInfo fileInfo(m_baseDir.absoluteFilePath(QDir::fromNativeSeparators(path)));
+    //The files of a playlist are always in a few folders, check the folder
+    //first, if the folder is missing, all the files in it are missing.
+    QString folderPath=fileInfo.absolutePath();
+    QHash<QString, bool>::iterator folderExist=m_directoryExist.find(folderPath);
+    if(folderExist==m_directoryExist.end())
+    {
+        folderExist=m_directoryExist.insert(folderPath,
+                                            QFileInfo(folderPath).isDir());
+    }
+    if(!folderExist.value() || !fileInfo.isFile())
+    {
+        return QString();
+    }
+    return fileInfo.absoluteFilePath();
+}
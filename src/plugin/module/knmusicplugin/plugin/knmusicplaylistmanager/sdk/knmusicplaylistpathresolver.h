@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNMUSICPLAYLISTPATHRESOLVER_H
+#define KNMUSICPLAYLISTPATHRESOLVER_H
+
+#include <QDir>
+#include <QHash>
+#include <QStringList>
+
+#include <QObject>
+
+/*
+ * The path resolver checks the file paths of an imported playlist in the
+ * search thread. The paths are checked in small batches, every batch gives
+ * out the existing files to the model, the model will analysis them in the
+ * analysis thread while the next batch is being checked.
+ */
+
+class KNMusicPlaylistPathResolver : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KNMusicPlaylistPathResolver(QObject *parent = 0);
+    void setBasePath(const QString &basePath);
+    void appendPath(const QString &path);
+    int pathCount() const;
+
+signals:
+    void requireResolveNext();
+    void pathsResolved(QStringList filePaths);
+    void resolveProgress(int resolved, int total);
+    void resolveFinished();
+
+public slots:
+
+private slots:
+    void resolveNext();
+
+private:
+    inline QString resolvePath(QString path);
+    QHash<QString, bool> m_directoryExist;
+    QStringList m_paths;
+    QDir m_baseDir;
+    int m_resolvedCount=0;
+};
+
+#endif // KNMUSICPLAYLISTPATHRESOLVER_H
@@ -17,7 +17,6 @@
  */
 #include <QUrl>
 #include <QTextCodec>
-#include <QLinkedList>
 #include <QDomDocument>
 
 #include "knmusicqqlyrics.h"
@@ -31,15 +30,19 @@ KNMusicQQLyrics::KNMusicQQLyrics(QObject *parent) :
     m_gbkCodec=QTextCodec::codecForName("GBK");
 }
 
-void KNMusicQQLyrics::downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                                     QList<KNMusicLyricsDetails> &lyricsList)
+void KNMusicQQLyrics::search(const KNMusicDetailInfo &detailInfo)
 {
     //Generate the url and get the data from the url.
-    QString url="http://qqmusic.qq.com/fcgi-bin/qm_getLyricId.fcg?name="+
+    get("http://qqmusic.qq.com/fcgi-bin/qm_getLyricId.fcg?name="+
             processKeywordsToGBK(detailInfo.textLists[Name])+"&singer="+
-            processKeywordsToGBK(detailInfo.textLists[Artist])+"&from=qqplayer";
-    QByteArray responseData;
-    get(url, responseData);
+            processKeywordsToGBK(detailInfo.textLists[Artist])+"&from=qqplayer",
+        SearchSong);
+}
+
+void KNMusicQQLyrics::processReply(const int &step,
+                                   const QByteArray &responseData,
+                                   const QVariant &user)
+{
     //Check the response.
     if(responseData.isEmpty())
     {
@@ -49,74 +52,60 @@ void KNMusicQQLyrics::downloadLyrics(const KNMusicDetailInfo &detailInfo,
     //with DomDocument.
     QDomDocument xmlDoc;
     xmlDoc.setContent(m_gbkCodec->toUnicode(responseData));
-    //To find whether it contains song info.
-    QDomNodeList nameList=xmlDoc.elementsByTagName("name"),
-                 singerNameList=xmlDoc.elementsByTagName("singername"),
-                 songInfoList=xmlDoc.elementsByTagName("songinfo");
-    if(songInfoList.isEmpty())
+    switch(step)
     {
-        return;
-    }
-    //Get the song id from the song info.
-    QStringList songIDList;
-    QLinkedList<KNMusicLyricsDetails> lyricsDetails;
-    for(int i=0; i<songInfoList.length(); i++)
+    case SearchSong:
     {
-        //Ensure the song info is available.
-        QDomElement currentSongInfo=songInfoList.at(i).toElement();
-        if(currentSongInfo.isNull())
-        {
-            continue;
-        }
-        //Ensure the id is not empty.
-        QString currentID=currentSongInfo.attribute("id");
-        if(!currentID.isEmpty())
+        //To find whether it contains song info.
+        QDomNodeList nameList=xmlDoc.elementsByTagName("name"),
+                     singerNameList=xmlDoc.elementsByTagName("singername"),
+                     songInfoList=xmlDoc.elementsByTagName("songinfo");
+        //Get the song id from the song info.
+        for(int i=0; i<songInfoList.length(); i++)
         {
-            //Save the title and artist information.
-            KNMusicLyricsDetails currentDetails;
-            currentDetails.title=
-                    QUrl::fromPercentEncoding(nameList.at(i).toElement().text().toUtf8());
-            currentDetails.artist=
-                    QUrl::fromPercentEncoding(singerNameList.at(i).toElement().text().toUtf8());
-            //Write to the list.
-            lyricsDetails.append(currentDetails);
-            songIDList.append(currentID);
+            //Ensure the song info is available.
+            QDomElement currentSongInfo=songInfoList.at(i).toElement();
+            if(currentSongInfo.isNull())
+            {
+                continue;
+            }
+            //Ensure the id is not empty.
+            QString currentID=currentSongInfo.attribute("id");
+            if(!currentID.isEmpty())
+            {
+                //Get the detail data for the song, save the title and artist
+                //information to the request.
+                get(generateRequestString(currentID),
+                    GetLyrics,
+                    QStringList()
+                    << QUrl::fromPercentEncoding(nameList.at(i).toElement().text().toUtf8())
+                    << QUrl::fromPercentEncoding(singerNameList.at(i).toElement().text().toUtf8()));
+            }
         }
+        break;
     }
-    //Check if the song id is empty.
-    if(songIDList.isEmpty())
+    case GetLyrics:
     {
-        return;
-    }
-    //Get the detail data for each song.
-    for(QStringList::iterator i=songIDList.begin();
-        i!=songIDList.end();
-        ++i)
-    {
-        KNMusicLyricsDetails currentDetails=lyricsDetails.takeFirst();
-        get(generateRequestString(*i), responseData);
-        //Check the response data is empty or not.
-        if(responseData.isEmpty())
-        {
-            continue;
-        }
-        //Parse the response data.
-        QString xml_text=m_gbkCodec->toUnicode(responseData);
-        xmlDoc.setContent(xml_text);
         //Find the lyrics.
         QDomNodeList lr=xmlDoc.elementsByTagName("lyric");
         if(lr.isEmpty())
         {
-            continue;
+            return;
         }
         QString lyricsContent=lr.at(0).childNodes().at(0).toText().data();
         if(lyricsContent.isEmpty())
         {
-            continue;
+            return;
         }
         //Save the lyrics data and calculate the similarity.
-        saveLyrics(detailInfo, lyricsContent, currentDetails);
-        lyricsList.append(currentDetails);
+        QStringList songInfo=user.toStringList();
+        KNMusicLyricsDetails currentDetails;
+        currentDetails.title=songInfo.at(0);
+        currentDetails.artist=songInfo.at(1);
+        saveLyrics(detailInfo(), lyricsContent, currentDetails);
+        emit lyricsDownloaded(currentDetails);
+        break;
+    }
     }
 }
 
@@ -29,14 +29,23 @@ public:
     {
         return "QQ Music";
     }
-    void downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                        QList<KNMusicLyricsDetails> &lyricsList);
 
 signals:
 
 public slots:
 
+protected:
+    void search(const KNMusicDetailInfo &detailInfo);
+    void processReply(const int &step,
+                      const QByteArray &responseData,
+                      const QVariant &user);
+
 private:
+    enum QQSteps
+    {
+        SearchSong,
+        GetLyrics
+    };
     inline QString processKeywordsToGBK(const QString &keywords);
     inline QString generateRequestString(const QString &id);
     QTextCodec *m_gbkCodec;
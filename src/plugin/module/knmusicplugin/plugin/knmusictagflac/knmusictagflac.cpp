@@ -118,14 +118,14 @@ bool KNMusicTagFLAC::parseAlbumArt(KNMusicAnalysisItem &analysisItem)
     //If there's a album art image after parse all the album art, set.
     if(imageMap.contains(3))
     {
-        analysisItem.coverImage=imageMap[3].image;
+        analysisItem.coverImageData=imageMap[3].imageData;
     }
     else
     {
         //Or else use the first image.
         if(!imageMap.isEmpty())
         {
-            analysisItem.coverImage=imageMap.begin().value().image;
+            analysisItem.coverImageData=imageMap.begin().value().imageData;
         }
     }
     return true;
@@ -189,7 +189,8 @@ inline void KNMusicTagFLAC::parsePicture(QByteArray &blockData,
     //Here should read these 4-bytes data: width, height, depth, index color num
     //and the size of image, but Qt is so powerful that we don't need to do these.
     //I love you! Qt! Daisuki!
-    frame.image.loadFromData(blockData.mid(dataPointer+dataSize+24));
+    //Keep the compressed data, it will be decoded when it's used.
+    frame.imageData=blockData.mid(dataPointer+dataSize+24);
     //Set the frame to the hash.
     imageMap[imageType]=frame;
 }
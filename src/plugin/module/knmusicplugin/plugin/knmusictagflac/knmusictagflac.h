@@ -39,7 +39,7 @@ struct PictureFrame
 {
     QString mimeType;
     QString description;
-    QImage image;
+    QByteArray imageData;
 };
 }
 
@@ -15,6 +15,8 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
+#include <cstring>
+
 #include <QTextCodec>
 
 #include "knglobal.h"
@@ -37,18 +39,13 @@ KNMusicTagID3v2::KNMusicTagID3v2(QObject *parent) :
     //Initial music global.
     m_musicGlobal=KNMusicGlobal::instance();
 
-    //Initial unsynchronisation data.
-    //Using forced conversation to ignore the ambiguous calling.
-    m_unsynchronisationRaw.append((char)0xff);
-    m_unsynchronisationRaw.append((char)0x00);
-    m_unsynchronisationTo.append((char)0xff);
-
     //Initial frame ID Index.
     m_frameIDIndex["TIT2"]=Name;
     m_frameIDIndex["TPE1"]=Artist;
     m_frameIDIndex["TALB"]=Album;
     m_frameIDIndex["TPE2"]=AlbumArtist;
     m_frameIDIndex["TBPM"]=BeatsPerMinuate;
+    m_frameIDIndex["TKEY"]=MusicalKey;
     m_frameIDIndex["TIT1"]=Category;
     m_frameIDIndex["COMM"]=Comments;
     m_frameIDIndex["TCOM"]=Composer;
@@ -64,6 +61,7 @@ KNMusicTagID3v2::KNMusicTagID3v2(QObject *parent) :
     m_frameIDIndex["TAL"]=Album;
     m_frameIDIndex["TP2"]=AlbumArtist;
     m_frameIDIndex["TBP"]=BeatsPerMinuate;
+    m_frameIDIndex["TKE"]=MusicalKey;
     m_frameIDIndex["TT1"]=Category;
     m_frameIDIndex["COM"]=Comments;
     m_frameIDIndex["TCM"]=Composer;
@@ -145,20 +143,20 @@ bool KNMusicTagID3v2::parseAlbumArt(KNMusicAnalysisItem &analysisItem)
     //If there's a album art image after parse all the album art, set.
     if(imageMap.contains(3))
     {
-        analysisItem.coverImage=imageMap[3].image;
+        analysisItem.coverImageData=imageMap[3].imageData;
     }
     else
     {
         //Or else use the first image.
         if(!imageMap.isEmpty())
         {
-            analysisItem.coverImage=imageMap.begin().value().image;
+            analysisItem.coverImageData=imageMap.begin().value().imageData;
         }
     }
     return true;
 }
 
-QString KNMusicTagID3v2::frameToText(QByteArray content)
+QString KNMusicTagID3v2::frameToText(const QByteArray &content)
 {
     //Check is content empty.
     if(content.isEmpty())
@@ -167,38 +165,52 @@ QString KNMusicTagID3v2::frameToText(QByteArray content)
     }
     //Get the codec according to the first char.
     //The first char of the ID3v2 text is the encoding of the current text.
-    //Using a state to catch the convert state.
+    //The text is decoded from the data after the first char directly, and it
+    //is simplified and the '\0' is removed in the same pass.
     quint8 encoding=(quint8)(content.at(0));
-    content.remove(0, 1);
+    const char *textData=content.constData()+1;
+    int textSize=content.size()-1;
     switch(encoding)
     {
     case EncodeISO: //0 = ISO-8859-1
+        //Most of the texts are ASCII, which are the same in all the codecs.
+        if(!m_usingDefaultCodec || isAscii(textData, textSize))
+        {
+            return latin1ToText(textData, textSize);
+        }
         //Use unicode codec to translate.
-        return m_usingDefaultCodec?
-                    m_localeCodec->toUnicode(content).simplified().remove(QChar('\0')):
-                    m_isoCodec->toUnicode(content).simplified().remove(QChar('\0'));
+        return simplifiedText(m_localeCodec->toUnicode(textData, textSize));
     case EncodeUTF16BELE: //1 = UTF-16 LE/BE (Treat other as no BOM UTF-16)
         //Decode via first two bytes.
-        if(content.size()>1)
+        if(textSize>1)
         {
-            if((quint8)content.at(0)==0xFE && (quint8)content.at(1)==0xFF)
+            if((quint8)textData[0]==0xFE && (quint8)textData[1]==0xFF)
             {
-                return m_utf16BECodec->toUnicode(content).simplified().remove(QChar('\0'));
+                return utf16ToText(textData+2, textSize-2, true);
             }
-            if((quint8)content.at(0)==0xFF && (quint8)content.at(1)==0xFE)
+            if((quint8)textData[0]==0xFF && (quint8)textData[1]==0xFE)
             {
-                return m_utf16LECodec->toUnicode(content).simplified().remove(QChar('\0'));
+                return utf16ToText(textData+2, textSize-2, false);
             }
         }
-        return m_utf16Codec->toUnicode(content).simplified().remove(QChar('\0'));
+        return simplifiedText(m_utf16Codec->toUnicode(textData, textSize));
     case EncodeUTF16: //2 = UTF-16 BE without BOM
         //Decode with UTF-16
-        return m_utf16Codec->toUnicode(content).simplified().remove(QChar('\0'));
+        return simplifiedText(m_utf16Codec->toUnicode(textData, textSize));
     case EncodeUTF8: //3 = UTF-8
+        //ASCII is also UTF-8.
+        if(isAscii(textData, textSize))
+        {
+            return latin1ToText(textData, textSize);
+        }
         //Use UTF-8 to decode it.
-        return m_utf8Codec->toUnicode(content).simplified().remove(QChar('\0'));
+        return simplifiedText(m_utf8Codec->toUnicode(textData, textSize));
     default://Use locale codec.
-        return m_localeCodec->toUnicode(content).simplified().remove(QChar('\0'));
+        if(isAscii(textData, textSize))
+        {
+            return latin1ToText(textData, textSize);
+        }
+        return simplifiedText(m_localeCodec->toUnicode(textData, textSize));
     }
 }
 
@@ -257,23 +269,33 @@ void KNMusicTagID3v2::writeID3v2ToDetails(const QLinkedList<ID3v2Frame> &frames,
         ++i)
     {
         //Process the data according to the flag before we use it.
-        QByteArray frameData;
+        char *frameStart=(*i).start;
+        int frameSize=(*i).size, dataLength=-1;
         //Check if it contains a data length indicator.
         if((*i).flags[1] & FrameDataLengthIndicator)
         {
-            frameData=QByteArray((*i).start+4,
-                                 ((*(property.toSize))((*i).start)));
-        }
-        else
-        {
-            frameData=QByteArray((*i).start, (*i).size);
+            //The indicator needs 4 bytes, skip the broken frame.
+            if(frameSize<4)
+            {
+                continue;
+            }
+            dataLength=(*(property.toSize))(frameStart);
+            frameStart+=4;
+            frameSize-=4;
         }
         //Check if the frame is unsynchronisation.
         if((*i).flags[1] & FrameUnsynchronisation)
         {
-            frameData.replace(m_unsynchronisationRaw,
-                              m_unsynchronisationTo);
+            //The raw tag data won't be used after this, remove the
+            //unsynchronisation in the raw data directly.
+            frameSize=removeUnsynchronisation(frameStart, frameSize);
+        }
+        if(dataLength>-1 && dataLength<frameSize)
+        {
+            frameSize=dataLength;
         }
+        //The frame data refers to the raw tag data without copying it.
+        QByteArray frameData=QByteArray::fromRawData(frameStart, frameSize);
         //Get the frame Index.
         QString frameID=QString((*i).frameID).toUpper();
         if(frameID=="APIC" || frameID=="PIC")
@@ -284,7 +306,9 @@ void KNMusicTagID3v2::writeID3v2ToDetails(const QLinkedList<ID3v2Frame> &frames,
             //If the frameID is "APIC", add a 1 to the "ID3v2" array, or else
             //add a 0.
             imageTypeList.append((int)(frameID=="APIC"));
-            analysisItem.imageData["ID3v2_Images"].append(frameData);
+            //The raw tag data will be freed, copy the image data.
+            analysisItem.imageData["ID3v2_Images"].append(
+                        QByteArray(frameData.constData(), frameData.size()));
             continue;
         }
         if(!m_frameIDIndex.contains((*i).frameID))
@@ -456,9 +480,10 @@ inline void KNMusicTagID3v2::parseAPICImageData(QByteArray imageData,
     default:
         break;
     }
-    currentFrame.image.loadFromData(imageData);
-    //If parse the image success, add it to map.
-    if(!currentFrame.image.isNull())
+    //Keep the compressed data, it will be decoded when it's used.
+    currentFrame.imageData=imageData;
+    //If there's any image data, add it to map.
+    if(!currentFrame.imageData.isEmpty())
     {
         imageMap[pictureType]=currentFrame;
     }
@@ -518,13 +543,15 @@ void KNMusicTagID3v2::parsePICImageData(QByteArray imageData,
     default:
         break;
     }
-    currentFrame.image.loadFromData(imageData);
-    //If parse the image success, add it to map.
-    if(!currentFrame.image.isNull())
+    //Keep the compressed data, it will be decoded when it's used.
+    currentFrame.imageData=imageData;
+    //If there's any image data, add it to map.
+    if(!currentFrame.imageData.isEmpty())
     {
         imageMap[pictureType]=currentFrame;
     }
 }
+
 bool KNMusicTagID3v2::usingDefaultCodec() const
 {
     return m_usingDefaultCodec;
@@ -535,3 +562,132 @@ void KNMusicTagID3v2::setUsingDefaultCodec(bool usingDefaultCodec)
     m_usingDefaultCodec = usingDefaultCodec;
 }
 
+int KNMusicTagID3v2::removeUnsynchronisation(char *data, int size)
+{
+    //Every 0xFF 0x00 is saved as 0xFF, find the 0xFF with memchr() which is
+    //optimized by the C library, and move the data between them only once.
+    char *end=data+size,
+         *reader=static_cast<char *>(memchr(data, 0xFF, size)),
+         *writer;
+    if(reader==nullptr)
+    {
+        return size;
+    }
+    writer=++reader;
+    while(reader<end)
+    {
+        //Skip the 0x00 after 0xFF.
+        if(*reader==0x00)
+        {
+            ++reader;
+        }
+        //Find the next 0xFF.
+        char *nextFF=static_cast<char *>(memchr(reader, 0xFF, end-reader));
+        char *blockEnd=nextFF==nullptr?end:nextFF+1;
+        //Move the block to the writer.
+        int blockSize=blockEnd-reader;
+        if(writer!=reader)
+        {
+            memmove(writer, reader, blockSize);
+        }
+        writer+=blockSize;
+        reader=blockEnd;
+    }
+    return writer-data;
+}
+
+bool KNMusicTagID3v2::isAscii(const char *data, int size)
+{
+    //Check 8 bytes at once.
+    const char *end=data+size;
+    quint64 highBits=0;
+    for(; end-data>=8; data+=8)
+    {
+        quint64 block;
+        memcpy(&block, data, 8);
+        highBits|=block;
+    }
+    for(; data<end; ++data)
+    {
+        highBits|=(quint8)(*data);
+    }
+    return (highBits & Q_UINT64_C(0x8080808080808080))==0;
+}
+
+void KNMusicTagID3v2::appendSimplified(QChar *text,
+                                       int &length,
+                                       bool &spacePending,
+                                       const ushort &unicode)
+{
+    //Works as QString::simplified().remove(QChar('\0')) in one pass.
+    if(unicode==0)
+    {
+        return;
+    }
+    //Check the spaces, a space is only written when there's a non-space after
+    //it, and the spaces at the beginning is ignored.
+    if((unicode>=0x09 && unicode<=0x0D) || unicode==0x20 ||
+            (unicode>=0x80 && QChar(unicode).isSpace()))
+    {
+        spacePending=(length>0);
+        return;
+    }
+    if(spacePending)
+    {
+        text[length++]=QChar(' ');
+        spacePending=false;
+    }
+    text[length++]=QChar(unicode);
+}
+
+QString KNMusicTagID3v2::latin1ToText(const char *data, int size)
+{
+    //Write to a preallocated text.
+    QString text(size, Qt::Uninitialized);
+    QChar *textData=text.data();
+    int length=0;
+    bool spacePending=false;
+    for(const char *end=data+size; data<end; ++data)
+    {
+        appendSimplified(textData, length, spacePending, (quint8)(*data));
+    }
+    text.resize(length);
+    return text;
+}
+
+QString KNMusicTagID3v2::utf16ToText(const char *data,
+                                     int size,
+                                     bool bigEndian)
+{
+    //Write to a preallocated text.
+    QString text(size>>1, Qt::Uninitialized);
+    QChar *textData=text.data();
+    int length=0;
+    bool spacePending=false;
+    for(const char *end=data+(size & ~1); data<end; data+=2)
+    {
+        appendSimplified(textData,
+                         length,
+                         spacePending,
+                         bigEndian?
+                             (((ushort)(quint8)data[0])<<8)|(quint8)data[1]:
+                             (((ushort)(quint8)data[1])<<8)|(quint8)data[0]);
+    }
+    text.resize(length);
+    return text;
+}
+
+QString KNMusicTagID3v2::simplifiedText(const QString &text)
+{
+    //Simplify the decoded text in one pass.
+    QString result(text.size(), Qt::Uninitialized);
+    QChar *resultData=result.data();
+    int length=0;
+    bool spacePending=false;
+    for(const QChar *i=text.constData(), *end=i+text.size(); i<end; ++i)
+    {
+        appendSimplified(resultData, length, spacePending, (*i).unicode());
+    }
+    result.resize(length);
+    return result;
+}
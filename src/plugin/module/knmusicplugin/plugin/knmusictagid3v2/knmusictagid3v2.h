@@ -61,7 +61,7 @@ struct ID3v2PictureFrame
 {
     QString mimeType;
     QString description;
-    QImage image;
+    QByteArray imageData;
 };
 typedef quint32 (*FrameSizeCalculator)(char *);
 typedef void (*FlagSaver)(char *, ID3v2Frame &);
@@ -86,7 +86,7 @@ public:
                   QDataStream &musicDataStream,
                   KNMusicAnalysisItem &analysisItem);
     bool parseAlbumArt(KNMusicAnalysisItem &analysisItem);
-    QString frameToText(QByteArray content);
+    QString frameToText(const QByteArray &content);
     bool usingDefaultCodec() const;
     void setUsingDefaultCodec(bool usingDefaultCodec);
 
@@ -213,6 +213,17 @@ private:
         frameData.flags[1]=rawTagData[9];
     }
 
+    static inline int removeUnsynchronisation(char *data, int size);
+    static inline bool isAscii(const char *data, int size);
+    static inline void appendSimplified(QChar *text,
+                                        int &length,
+                                        bool &spacePending,
+                                        const ushort &unicode);
+    static inline QString latin1ToText(const char *data, int size);
+    static inline QString utf16ToText(const char *data,
+                                      int size,
+                                      bool bigEndian);
+    static inline QString simplifiedText(const QString &text);
     inline void parseAPICImageData(QByteArray imageData,
                                    QHash<int, ID3v2PictureFrame> &imageMap);
     inline void parsePICImageData(QByteArray imageData,
@@ -220,7 +231,6 @@ private:
     QHash<QString, int> m_frameIDIndex;
     KNMusicGlobal *m_musicGlobal;
 
-    QByteArray m_unsynchronisationRaw, m_unsynchronisationTo;
     QTextCodec *m_isoCodec,
                *m_utf16BECodec,
                *m_utf16LECodec,
@@ -171,8 +171,8 @@ bool KNMusicTagM4A::parseAlbumArt(KNMusicAnalysisItem &analysisItem)
         return false;
     }
     //Remember, there's 8 bytes version and flags here.
-    analysisItem.coverImage.loadFromData(QByteArray(expandList.first().data+8,
-                                                  expandList.first().size-8));
+    analysisItem.coverImageData=QByteArray(expandList.first().data+8,
+                                           expandList.first().size-8);
     return true;
 }
 
@@ -40,6 +40,7 @@ KNMusicTagWMA::KNMusicTagWMA(QObject *parent) :
     m_attributesIndex["WM/AlbumTitle"]=Rating;
     m_attributesIndex["WM/ParentalRating"]=AlbumRating;
     m_attributesIndex["WM/BeatsPerMinute"]=BeatsPerMinuate;
+    m_attributesIndex["WM/InitialKey"]=MusicalKey;
     m_attributesIndex["WM/ContentGroupDescription"]=Category;
     m_attributesIndex["WM/Text"]=Comments;
     m_attributesIndex["WM/Composer"]=Composer;
@@ -146,7 +147,7 @@ bool KNMusicTagWMA::parseAlbumArt(KNMusicAnalysisItem &analysisItem)
     WMAPicture albumArt;
     if(parseImageData(imageRawDatas.first(), albumArt))
     {
-        analysisItem.coverImage=albumArt.image;
+        analysisItem.coverImageData=albumArt.imageData;
         return true;
     }
     return false;
@@ -280,9 +281,9 @@ bool KNMusicTagWMA::parseImageData(QByteArray imageData,
     albumArt.description=frameToText(descriptionText);
     //Get the image.
     imageData.remove(0, descriptionEnd+1);
-    albumArt.image.loadFromData(imageData);
-    //If parse the image success, add it to map.
-    return !albumArt.image.isNull();
+    //Keep the compressed data, it will be decoded when it's used.
+    albumArt.imageData=imageData;
+    return !albumArt.imageData.isEmpty();
 }
 
 void KNMusicTagWMA::writeTagMapToDetailInfo(const QList<KNMusicWMAFrame> &frameList,
@@ -42,7 +42,7 @@ struct WMAPicture
 {
     QString mimeType;
     QString description;
-    QImage image;
+    QByteArray imageData;
 };
 }
 
@@ -34,63 +34,66 @@ KNMusicTTPlayerLyrics::~KNMusicTTPlayerLyrics()
 
 }
 
-void KNMusicTTPlayerLyrics::downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                                           QList<KNMusicLyricsDetails> &lyricsList)
+void KNMusicTTPlayerLyrics::search(const KNMusicDetailInfo &detailInfo)
 {
     //Another address: http://ttlrccnc.qianqian.com
-    QString queryUrl="http://ttlrcct.qianqian.com"
-                     "/dll/lyricsvr.dll?sh?Artist="+
-                     utf16LEHex(processKeywords(detailInfo.textLists[Artist])) +
-                     "&Title="+
-                     utf16LEHex(processKeywords(detailInfo.textLists[Name])) +
-                     "&Flags=0";
     //Get the xml data from the url.
-    QByteArray responseData;
-    get(queryUrl, responseData);
-    //Found song lyrics info.
-    QDomDocument songInfoDocument;
-    songInfoDocument.setContent(responseData);
-    QDomNodeList lyrics=songInfoDocument.documentElement().elementsByTagName("lrc");
-    if(lyrics.isEmpty())
+    get("http://ttlrcct.qianqian.com"
+        "/dll/lyricsvr.dll?sh?Artist="+
+            utf16LEHex(processKeywords(detailInfo.textLists[Artist])) +
+            "&Title="+
+            utf16LEHex(processKeywords(detailInfo.textLists[Name])) +
+            "&Flags=0",
+        SearchSong);
+}
+
+void KNMusicTTPlayerLyrics::processReply(const int &step,
+                                         const QByteArray &responseData,
+                                         const QVariant &user)
+{
+    switch(step)
     {
-        return;
-    }
-    //Save the ids.
-    QList<QHash<QString, QString>> lyricsInfoList;
-    for(int i=0; i<lyrics.size(); i++)
+    case SearchSong:
     {
-        QDomElement currentLyrics=lyrics.at(i).toElement();
-        //Generate the lyrics info.
-        QHash<QString, QString> lyricsInfo;
-        lyricsInfo.insert("title", currentLyrics.attribute("title"));
-        lyricsInfo.insert("artist", currentLyrics.attribute("artist"));
-        lyricsInfo.insert("id", currentLyrics.attribute("id"));
-        //Add to lyrics info.
-        lyricsInfoList.append(lyricsInfo);
+        //Found song lyrics info.
+        QDomDocument songInfoDocument;
+        songInfoDocument.setContent(responseData);
+        QDomNodeList lyrics=songInfoDocument.documentElement().elementsByTagName("lrc");
+        for(int i=0; i<lyrics.size(); i++)
+        {
+            QDomElement currentLyrics=lyrics.at(i).toElement();
+            //Generate the lyrics info.
+            QHash<QString, QString> lyricsInfo;
+            lyricsInfo.insert("title", currentLyrics.attribute("title"));
+            lyricsInfo.insert("artist", currentLyrics.attribute("artist"));
+            lyricsInfo.insert("id", currentLyrics.attribute("id"));
+            //Download lyrics, save the title and artist to the request.
+            get("http://ttlrcct.qianqian.com"
+                "/dll/lyricsvr.dll?dl?Id=" +
+                    lyricsInfo.value("id") +
+                    "&Code="+
+                    generateCode(lyricsInfo),
+                GetLyrics,
+                QStringList() << lyricsInfo.value("title")
+                              << lyricsInfo.value("artist"));
+        }
+        break;
     }
-    //Download lyrics.
-    for(QList<QHash<QString, QString>>::iterator i=lyricsInfoList.begin();
-        i!=lyricsInfoList.end();
-        ++i)
+    case GetLyrics:
     {
-        QString downloadUrl="http://ttlrcct.qianqian.com"
-                            "/dll/lyricsvr.dll?dl?Id=" +
-                            (*i).value("id") +
-                            "&Code="+
-                            generateCode(*i);
-        //Download data.
-        get(downloadUrl, responseData);
         if(!responseData.isEmpty() &&
                 !responseData.contains("errmsg"))
         {
             //Generate the lyrics details data.
+            QStringList songInfo=user.toStringList();
             KNMusicLyricsDetails currentDetails;
-            currentDetails.title=(*i).value("title");
-            currentDetails.artist=(*i).value("artist");
-            saveLyrics(detailInfo, responseData, currentDetails);
-            //Add to list.
-            lyricsList.append(currentDetails);
+            currentDetails.title=songInfo.at(0);
+            currentDetails.artist=songInfo.at(1);
+            saveLyrics(detailInfo(), responseData, currentDetails);
+            emit lyricsDownloaded(currentDetails);
         }
+        break;
+    }
     }
 }
 
@@ -30,10 +30,19 @@ public:
     {
         return "TTPlayer";
     }
-    void downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                        QList<KNMusicLyricsDetails> &lyricsList);
+
+protected:
+    void search(const KNMusicDetailInfo &detailInfo);
+    void processReply(const int &step,
+                      const QByteArray &responseData,
+                      const QVariant &user);
 
 private:
+    enum TTPlayerSteps
+    {
+        SearchSong,
+        GetLyrics
+    };
     struct lrcInfo
     {
         QString id;
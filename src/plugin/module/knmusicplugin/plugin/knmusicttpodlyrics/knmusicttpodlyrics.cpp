@@ -70,71 +70,84 @@ KNMusicTTPodLyrics::~KNMusicTTPodLyrics()
     ;
 }
 
-void KNMusicTTPodLyrics::downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                                        QList<KNMusicLyricsDetails> &lyricsList)
+void KNMusicTTPodLyrics::search(const KNMusicDetailInfo &detailInfo)
 {
-    QString searchUrl="http://so.ard.iyyin.com/search.do?q=" +
-                      processKeywords(detailInfo.textLists[Name]) +
-                      "+" +
-                      processKeywords(detailInfo.textLists[Artist]);
-    QByteArray responseData;
     //Get the response from URL.
-    get(searchUrl, responseData);
+    get("http://so.ard.iyyin.com/search.do?q=" +
+            processKeywords(detailInfo.textLists[Name]) +
+            "+" +
+            processKeywords(detailInfo.textLists[Artist]),
+        SearchSong);
+}
+
+void KNMusicTTPodLyrics::processReply(const int &step,
+                                      const QByteArray &responseData,
+                                      const QVariant &user)
+{
     //Check the response data.
     if(responseData.isEmpty())
     {
         return;
     }
-    //Get the data, and parse the json.
-    QJsonDocument songInfoList=QJsonDocument::fromJson(responseData);
-    if(songInfoList.isNull())
+    switch(step)
     {
-        return;
+    case SearchSong:
+    {
+        //Get the data, and parse the json.
+        QJsonDocument songInfoList=QJsonDocument::fromJson(responseData);
+        if(songInfoList.isNull())
+        {
+            return;
+        }
+        //Get the 'data' to from the base object.
+        QJsonArray songListData=songInfoList.object().value("data").toArray();
+        for(QJsonArray::iterator i=songListData.begin();
+            i!=songListData.end();
+            ++i)
+        {
+            QJsonObject currentObject=(*i).toObject();
+            QString singerName=currentObject.value("singerName").toString(),
+                    songName=currentObject.value("songName").toString();
+            //Get the data from the download URL.
+            get("http://lp.music.ttpod.com/lrc/down?artist=" +
+                    singerName +
+                    "&title=" +
+                    songName +
+                    "&code=" +
+                    process_code(currentObject.value("neid").toVariant()),
+                GetLyrics,
+                QStringList() << singerName << songName);
+        }
+        break;
     }
-    //Get the 'data' to from the base object.
-    QJsonArray songListData=songInfoList.object().value("data").toArray();
-    for(QJsonArray::iterator i=songListData.begin();
-        i!=songListData.end();
-        ++i)
+    case GetLyrics:
     {
-        QJsonObject currentObject=(*i).toObject();
-        //Generate the URL.
-        QString downloadURL="http://lp.music.ttpod.com/lrc/down?artist=" +
-                            currentObject.value("singerName").toString() +
-                            "&title=" +
-                            currentObject.value("songName").toString() +
-                            "&code=" +
-                            process_code(currentObject.value("neid").toVariant());
-        //Get the data from the download URL.
-        get(downloadURL, responseData);
-        //Check the response data.
-        if(!responseData.isEmpty())
+        QJsonDocument lyricsDocument=QJsonDocument::fromJson(responseData);
+        //Get the data object from the document.
+        QJsonObject lyricsObject=lyricsDocument.object();
+        if(lyricsObject.isEmpty())
+        {
+            return;
+        }
+        //Get the lrc in the data object in the lyrics object.
+        QJsonObject dataObject=lyricsObject.value("data").toObject();
+        if(dataObject.isEmpty())
         {
-            QJsonDocument lyricsDocument=QJsonDocument::fromJson(responseData);
-            //Get the data object from the document.
-            QJsonObject lyricsObject=lyricsDocument.object();
-            if(lyricsObject.isEmpty())
-            {
-                continue;
-            }
-            //Get the lrc in the data object in the lyrics object.
-            QJsonObject dataObject=lyricsObject.value("data").toObject();
-            if(dataObject.isEmpty())
-            {
-                continue;
-            }
-            QString lrcText=dataObject.value("lrc").toString();
-            if(!lrcText.isEmpty())
-            {
-                KNMusicLyricsDetails currentDetails;
-                //Don't ask me why, they are just wrong.
-                currentDetails.title=currentObject.value("singerName").toString();
-                currentDetails.artist=currentObject.value("songName").toString();
-                saveLyrics(detailInfo, lrcText, currentDetails);
-                //Add to lyrics list.
-                lyricsList.append(currentDetails);
-            }
+            return;
         }
+        QString lrcText=dataObject.value("lrc").toString();
+        if(!lrcText.isEmpty())
+        {
+            QStringList songInfo=user.toStringList();
+            KNMusicLyricsDetails currentDetails;
+            //Don't ask me why, they are just wrong.
+            currentDetails.title=songInfo.at(0);
+            currentDetails.artist=songInfo.at(1);
+            saveLyrics(detailInfo(), lrcText, currentDetails);
+            emit lyricsDownloaded(currentDetails);
+        }
+        break;
+    }
     }
 }
 
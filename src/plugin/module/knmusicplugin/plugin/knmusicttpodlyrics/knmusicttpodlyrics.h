@@ -29,10 +29,19 @@ public:
     {
         return "TTPod";
     }
-    void downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                        QList<KNMusicLyricsDetails> &lyricsList);
+
+protected:
+    void search(const KNMusicDetailInfo &detailInfo);
+    void processReply(const int &step,
+                      const QByteArray &responseData,
+                      const QVariant &user);
 
 private:
+    enum TTPodSteps
+    {
+        SearchSong,
+        GetLyrics
+    };
     inline QString process_code(const QVariant &str);
     inline qint32 crc32(const QString &str);
     inline QString utf8HexText(const QString &original);
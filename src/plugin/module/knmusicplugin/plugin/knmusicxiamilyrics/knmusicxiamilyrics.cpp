@@ -15,7 +15,6 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
-#include <QLinkedList>
 #include <QDomDocument>
 #include <QRegularExpression>
 
@@ -29,83 +28,80 @@ KNMusicXiaMiLyrics::KNMusicXiaMiLyrics(QObject *parent) :
 
 }
 
-void KNMusicXiaMiLyrics::downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                                        QList<KNMusicLyricsDetails> &lyricsList)
+void KNMusicXiaMiLyrics::search(const KNMusicDetailInfo &detailInfo)
 {
-    //Generate the url.
-    QString url="http://www.xiami.com/search/song-lyric?key=" +
-                processKeywords(detailInfo.textLists[Name]);
     //Get the data from url.
-    QByteArray responseData;
-    get(url, responseData);
+    get("http://www.xiami.com/search/song-lyric?key=" +
+            processKeywords(detailInfo.textLists[Name]),
+        SearchSong);
+}
+
+void KNMusicXiaMiLyrics::processReply(const int &step,
+                                      const QByteArray &responseData,
+                                      const QVariant &user)
+{
     if(responseData.isEmpty())
     {
         return;
     }
-    QString xmlhttpText=responseData;
-    //Parse the data.
-    QStringList songid;
-    QRegularExpression rex("<a.*?href=\".*?/song/(\\d+).*?><b.*?key_red");
-    QRegularExpressionMatchIterator i=rex.globalMatch(xmlhttpText);
-    while(i.hasNext())
+    switch(step)
+    {
+    case SearchSong:
     {
-        QRegularExpressionMatch match=i.next();
-        songid.append(match.captured(1));
+        QString xmlhttpText=responseData;
+        //Parse the data.
+        QRegularExpression rex("<a.*?href=\".*?/song/(\\d+).*?><b.*?key_red");
+        QRegularExpressionMatchIterator i=rex.globalMatch(xmlhttpText);
+        while(i.hasNext())
+        {
+            QRegularExpressionMatch match=i.next();
+            get("http://www.xiami.com/song/playlist/id/"+match.captured(1),
+                GetPlaylist);
+        }
+        break;
     }
-    for(QStringList::iterator i=songid.begin();
-        i!=songid.end();
-        ++i)
+    case GetPlaylist:
     {
-        url="http://www.xiami.com/song/playlist/id/"+(*i);
-        get(url, responseData);
-        if(!responseData.isEmpty())
+        //Parse the document.
+        QDomDocument lyricsDocument;
+        lyricsDocument.setContent(responseData);
+        //Get the tracklist.
+        QDomElement root=lyricsDocument.documentElement();
+        QDomNodeList trackList=root.elementsByTagName("trackList");
+        //Get the information from the tracklist.
+        for(int j=0; j<trackList.size(); j++)
         {
-            QLinkedList<KNMusicLyricsDetails> rawLyricsDetail;
-            QStringList lyricsUrlList;
-            //Parse the document.
-            QDomDocument lyricsDocument;
-            lyricsDocument.setContent(responseData);
-            //Get the tracklist.
-            QDomElement root=lyricsDocument.documentElement();
-            QDomNodeList trackList=root.elementsByTagName("trackList");
-            //Get the information from the tracklist.
-            for(int j=0; j<trackList.size(); j++)
-            {
-                QDomElement currentTrack=trackList.at(j).toElement();
-                //Find lyrics url.
-                QDomNodeList lyricUrlList=
-                        currentTrack.elementsByTagName("lyric");
-                if(!lyricUrlList.isEmpty())
-                {
-                    QDomNodeList lyricsUrl=lyricUrlList.at(0).toElement().childNodes();
-                    if(!lyricsUrl.isEmpty())
-                    {
-                        //Save the lyrics information.
-                        KNMusicLyricsDetails currentDetail;
-                        currentDetail.title=currentTrack.elementsByTagName("title").at(0).toElement().childNodes().at(0).nodeValue();
-                        currentDetail.artist=currentTrack.elementsByTagName("artist").at(0).toElement().childNodes().at(0).nodeValue();
-                        //Add the lyrics information and url to the list.
-                        rawLyricsDetail.append(currentDetail);
-                        lyricsUrlList.append(lyricsUrl.at(0).nodeValue());
-                    }
-                }
-            }
-
-            //Try to download the lyrics.
-            for(QStringList::iterator i=lyricsUrlList.begin();
-                i!=lyricsUrlList.end();
-                ++i)
+            QDomElement currentTrack=trackList.at(j).toElement();
+            //Find lyrics url.
+            QDomNodeList lyricUrlList=
+                    currentTrack.elementsByTagName("lyric");
+            if(!lyricUrlList.isEmpty())
             {
-                KNMusicLyricsDetails currentDetail=rawLyricsDetail.takeFirst();
-                //Get the data from the url.
-                get((*i), responseData);
-                //This is the lyrics file! Add to the lyrics list.
-                if(!responseData.isEmpty())
+                QDomNodeList lyricsUrl=lyricUrlList.at(0).toElement().childNodes();
+                if(!lyricsUrl.isEmpty())
                 {
-                    saveLyrics(detailInfo, responseData, currentDetail);
-                    lyricsList.append(currentDetail);
+                    //Try to download the lyrics, save the lyrics information
+                    //to the request.
+                    get(lyricsUrl.at(0).nodeValue(),
+                        GetLyrics,
+                        QStringList()
+                        << currentTrack.elementsByTagName("title").at(0).toElement().childNodes().at(0).nodeValue()
+                        << currentTrack.elementsByTagName("artist").at(0).toElement().childNodes().at(0).nodeValue());
                 }
             }
         }
+        break;
+    }
+    case GetLyrics:
+    {
+        //This is the lyrics file!
+        QStringList songInfo=user.toStringList();
+        KNMusicLyricsDetails currentDetail;
+        currentDetail.title=songInfo.at(0);
+        currentDetail.artist=songInfo.at(1);
+        saveLyrics(detailInfo(), responseData, currentDetail);
+        emit lyricsDownloaded(currentDetail);
+        break;
+    }
     }
 }
@@ -29,8 +29,20 @@ public:
     {
         return "XiaMi Music";
     }
-    void downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                        QList<KNMusicLyricsDetails> &lyricsList);
+
+protected:
+    void search(const KNMusicDetailInfo &detailInfo);
+    void processReply(const int &step,
+                      const QByteArray &responseData,
+                      const QVariant &user);
+
+private:
+    enum XiaMiSteps
+    {
+        SearchSong,
+        GetPlaylist,
+        GetLyrics
+    };
 };
 
 #endif // KNMUSICXIAMILYRICS_H
@@ -11,9 +11,12 @@
 #include "knconnectionhandler.h"
 
 #include <QFileInfo>
+#include <QHash>
 
 #include <QDebug>
 
+#define ReanalysisBatch 64
+
 KNMusicAnalysisCache::KNMusicAnalysisCache(QObject *parent) :
     QObject(parent)
 {
@@ -57,7 +60,9 @@ void KNMusicAnalysisCache::parseItem(KNMusicAnalysisItem &currentItem,
         //Emit the analysis finished signal, give out the detail info.
         if(blocked)
         {
-            emit requireAppendRow(KNMusicModelAssist::generateRow(currentItem.detailInfo));
+            QList<QList<QStandardItem *> > musicRows;
+            musicRows.append(KNMusicModelAssist::generateRow(currentItem.detailInfo));
+            emit requireAppendRows(musicRows);
             return;
         }
         emit analysisComplete(currentItem);
@@ -66,15 +71,21 @@ void KNMusicAnalysisCache::parseItem(KNMusicAnalysisItem &currentItem,
     //So, it must be a list now.
     QList<KNMusicAnalysisItem> trackDetailInfo;
     m_parser->parseTrackList(currentFilePath, trackDetailInfo);
-    while(!trackDetailInfo.isEmpty())
+    if(blocked)
     {
-        if(blocked)
+        //Add all the tracks of the list at once.
+        QList<QList<QStandardItem *> > musicRows;
+        musicRows.reserve(trackDetailInfo.size());
+        while(!trackDetailInfo.isEmpty())
         {
-            emit requireAppendRow(
-                        KNMusicModelAssist::generateRow(
-                            trackDetailInfo.takeFirst().detailInfo));
-            continue;
+            musicRows.append(KNMusicModelAssist::generateRow(
+                                 trackDetailInfo.takeFirst().detailInfo));
         }
+        emit requireAppendRows(musicRows);
+        return;
+    }
+    while(!trackDetailInfo.isEmpty())
+    {
         //Give out the analysis complete info by track index.
         emit analysisComplete(trackDetailInfo.takeFirst());
     }
@@ -116,3 +127,62 @@ void KNMusicAnalysisCache::onActionAnalysisNext()
     //Require to analysis next.
     emit analysisNext();
 }
+
+void KNMusicAnalysisCache::reanalysisRows(QList<KNMusicReanalysisItem> reanalysisItems)
+{
+    //The parsed track lists, every list will only be parsed once.
+    QHash<QString, QList<KNMusicAnalysisItem> > trackLists;
+    QList<KNMusicReanalysisItem> completeItems;
+    for(QList<KNMusicReanalysisItem>::iterator i=reanalysisItems.begin();
+        i!=reanalysisItems.end();
+        ++i)
+    {
+        KNMusicAnalysisItem &analysisItem=(*i).analysisItem;
+        const KNMusicDetailInfo &detailInfo=analysisItem.detailInfo;
+        //Check the start position, if it's -1, means it's a music file.
+        if(detailInfo.startPosition==-1)
+        {
+            KNMusicAnalysisItem fileItem;
+            m_parser->parseFile(detailInfo.filePath, fileItem);
+            analysisItem=fileItem;
+            (*i).available=true;
+        }
+        else
+        {
+            //Parse the list if we haven't parsed it.
+            QString trackFilePath=detailInfo.trackFilePath;
+            if(!trackLists.contains(trackFilePath))
+            {
+                QList<KNMusicAnalysisItem> trackList;
+                m_parser->parseTrackList(trackFilePath, trackList);
+                trackLists.insert(trackFilePath, trackList);
+            }
+            const QList<KNMusicAnalysisItem> &trackList=
+                    trackLists[trackFilePath];
+            int trackPosition=
+                    KNMusicModelAssist::trackListPosition(trackList,
+                                                          detailInfo.trackIndex);
+            if(trackPosition!=-1)
+            {
+                analysisItem=trackList.at(trackPosition);
+                (*i).available=true;
+            }
+        }
+        if((*i).available)
+        {
+            m_parser->parseAlbumArt(analysisItem);
+        }
+        completeItems.append(*i);
+        //Give out the result in batches.
+        if(completeItems.size()==ReanalysisBatch)
+        {
+            emit reanalysisComplete(completeItems);
+            completeItems.clear();
+        }
+    }
+    //Give out the rest results.
+    if(!completeItems.isEmpty())
+    {
+        emit reanalysisComplete(completeItems);
+    }
+}
@@ -29,13 +29,15 @@ public:
 
 signals:
     void analysisNext();
-    void requireAppendRow(QList<QStandardItem *> musicRow);
+    void requireAppendRows(QList<QList<QStandardItem *> > musicRows);
     void analysisComplete(KNMusicAnalysisItem detailInfo);
+    void reanalysisComplete(QList<KNMusicReanalysisItem> reanalysisItems);
 
 public slots:
     void appendFilePath(const QString &filePath);
     void analysisFile(const QString &filePath);
     void onActionAnalysisNext();
+    void reanalysisRows(QList<KNMusicReanalysisItem> reanalysisItems);
 
 private:
     void parseItem(KNMusicAnalysisItem &currentItem, bool blocked=false);
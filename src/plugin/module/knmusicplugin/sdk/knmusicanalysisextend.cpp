@@ -4,6 +4,8 @@
  * terms of the Do What The Fuck You Want To Public License, Version 2,
  * as published by Sam Hocevar. See the COPYING file for more details.
  */
+#include <QTimer>
+
 #include "knmusicmodelassist.h"
 
 #include "knmusicanalysisextend.h"
@@ -13,10 +15,86 @@
 KNMusicAnalysisExtend::KNMusicAnalysisExtend(QObject *parent) :
     QObject(parent)
 {
+    //Initial the flush timer, it's a child so it will be moved to the analysis
+    //thread together with the extend.
+    m_flushTimer=new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(m_batchLatency);
+    connect(m_flushTimer, &QTimer::timeout,
+            this, &KNMusicAnalysisExtend::flushPendingRows);
+}
+
+KNMusicAnalysisExtend::~KNMusicAnalysisExtend()
+{
+    //Recover the memory of the rows which are never sent.
+    for(QList<QList<QStandardItem *> >::iterator i=m_pendingRows.begin();
+        i!=m_pendingRows.end();
+        ++i)
+    {
+        qDeleteAll(*i);
+    }
+}
+
+int KNMusicAnalysisExtend::batchSize() const
+{
+    return m_batchSize;
+}
+
+void KNMusicAnalysisExtend::setBatchSize(int batchSize)
+{
+    m_batchSize=qMax(batchSize, 1);
+}
+
+int KNMusicAnalysisExtend::batchLatency() const
+{
+    return m_batchLatency;
+}
+
+void KNMusicAnalysisExtend::setBatchLatency(int batchLatency)
+{
+    m_batchLatency=qMax(batchLatency, 0);
+    m_flushTimer->setInterval(m_batchLatency);
 }
 
 void KNMusicAnalysisExtend::onActionAnalysisComplete(const KNMusicAnalysisItem &analysisItem)
 {
-    //Add this detail to model.
-    emit requireAppendRow(KNMusicModelAssist::generateRow(analysisItem.detailInfo));
+    //Add this detail to the pending rows.
+    appendPendingRow(KNMusicModelAssist::generateRow(analysisItem.detailInfo));
+}
+
+void KNMusicAnalysisExtend::flushPendingRows()
+{
+    //Stop the timer, it will be started again by the next pending row.
+    m_flushTimer->stop();
+    if(m_pendingRows.isEmpty())
+    {
+        return;
+    }
+    //Take all the pending rows and send them as one batch.
+    QList<QList<QStandardItem *> > musicRows;
+    musicRows.swap(m_pendingRows);
+    commitPendingRows(musicRows);
+}
+
+void KNMusicAnalysisExtend::appendPendingRow(const QList<QStandardItem *> &musicRow)
+{
+    //The first row of a batch starts the latency clock.
+    if(m_pendingRows.isEmpty())
+    {
+        m_batchElapsed.start();
+        m_flushTimer->start();
+    }
+    m_pendingRows.append(musicRow);
+    //The analysis loop may keep the event loop busy, so the latency is also
+    //checked here instead of only waiting for the timer.
+    if(m_pendingRows.size()>=m_batchSize ||
+            m_batchElapsed.elapsed()>=m_batchLatency)
+    {
+        flushPendingRows();
+    }
+}
+
+void KNMusicAnalysisExtend::commitPendingRows(const QList<QList<QStandardItem *> > &musicRows)
+{
+    emit requireAppendRows(musicRows);
 }
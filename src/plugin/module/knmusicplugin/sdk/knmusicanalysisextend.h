@@ -7,23 +7,43 @@
 #ifndef KNMUSICANALYSISEXTEND_H
 #define KNMUSICANALYSISEXTEND_H
 
-#include <QObject>
+#include <QElapsedTimer>
 
 #include "knmusicglobal.h"
 
+#include <QObject>
+
 using namespace KNMusic;
 
+class QTimer;
 class KNMusicAnalysisExtend : public QObject
 {
     Q_OBJECT
 public:
     explicit KNMusicAnalysisExtend(QObject *parent = 0);
+    ~KNMusicAnalysisExtend();
+    int batchSize() const;
+    void setBatchSize(int batchSize);
+    int batchLatency() const;
+    void setBatchLatency(int batchLatency);
 
 signals:
-    void requireAppendRow(QList<QStandardItem *> musicRow);
+    void requireAppendRows(QList<QList<QStandardItem *> > musicRows);
 
 public slots:
     virtual void onActionAnalysisComplete(const KNMusicAnalysisItem &analysisItem);
+    void flushPendingRows();
+
+protected:
+    void appendPendingRow(const QList<QStandardItem *> &musicRow);
+    virtual void commitPendingRows(const QList<QList<QStandardItem *> > &musicRows);
+
+private:
+    QList<QList<QStandardItem *> > m_pendingRows;
+    QElapsedTimer m_batchElapsed;
+    QTimer *m_flushTimer;
+    int m_batchSize=128;
+    int m_batchLatency=100; //Unit: millisecond
 };
 
 #endif // KNMUSICANALYSISEXTEND_H
@@ -39,6 +39,17 @@ public:
     virtual void stop()=0;
     virtual void resetMainPlayer()=0;
     virtual int volume() const=0;
+    //Set the replay gain of the main player in dB, it's applied over the
+    //volume, 0.0 means no gain.
+    virtual void setReplayGain(const qreal &gain)=0;
+    //Copy the latest samples of the main player for the spectrum feed, see
+    //KNMusicBackendThread::recentSamples().
+    virtual int spectrumSamples(float *samples, const int &frameCount)
+    {
+        Q_UNUSED(samples)
+        Q_UNUSED(frameCount)
+        return 0;
+    }
 
     virtual void loadPreview(const QString &filePath)=0;
     virtual qint64 previewDuration() const=0;
@@ -53,6 +64,11 @@ public:
     virtual void pausePreview()=0;
     virtual void stopPreview()=0;
     virtual void resetPreviewPlayer()=0;
+    virtual void prefetchPreview(const QString &filePath)
+    {
+        //Open the file before it's previewed, do nothing by default.
+        Q_UNUSED(filePath)
+    }
 
     virtual void loadUrl(const QString &url)=0;
 
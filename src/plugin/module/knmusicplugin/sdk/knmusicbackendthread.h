@@ -27,6 +27,15 @@ public:
                                 const qint64 &sectionDuration=-1)=0;
     virtual void playSection(const qint64 &sectionStart=-1,
                              const qint64 &sectionDuration=-1)=0;
+    //Copy the latest mono samples which have been played, it's called from
+    //the spectrum feed thread. Returns the number of the copied frames, the
+    //thread which can't provide the samples returns 0.
+    virtual int recentSamples(float *samples, const int &frameCount)
+    {
+        Q_UNUSED(samples)
+        Q_UNUSED(frameCount)
+        return 0;
+    }
 
 signals:
     void cannotLoadFile();
@@ -39,6 +48,8 @@ signals:
 
 public slots:
     virtual void setVolume(const int &volumeSize)=0;
+    //The gain is the linear scale of the volume, 1.0 means no change.
+    virtual void setGain(const qreal &gain)=0;
     virtual void setPosition(const qint64 &position)=0;
 
 };
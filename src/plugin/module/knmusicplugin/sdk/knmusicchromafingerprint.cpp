@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QtEndian>
+#include <QtMath>
+
+#include "knmusicchromafingerprint.h"
+
+//The chroma is calculated from A1 to A7.
+#define ChromaMinimumFrequency 55.0
+#define ChromaMaximumFrequency 3520.0
+
+KNMusicChromaFingerprint::KNMusicChromaFingerprint() :
+    m_fft(FingerprintFrameSize),
+    m_frame(FingerprintFrameSize),
+    m_amplitudes(FingerprintFrameSize>>1),
+    m_binPitch(FingerprintFrameSize>>1)
+{
+    //Map the bins to the pitch classes, pitch class 0 is A.
+    const qreal binFrequency=(qreal)FingerprintSampleRate/FingerprintFrameSize;
+    m_firstBin=qCeil(ChromaMinimumFrequency/binFrequency);
+    m_lastBin=qMin(qFloor(ChromaMaximumFrequency/binFrequency),
+                   (FingerprintFrameSize>>1)-1);
+    for(int i=0; i<m_binPitch.size(); ++i)
+    {
+        if(i<m_firstBin || i>m_lastBin)
+        {
+            m_binPitch[i]=-1;
+            continue;
+        }
+        int semitone=qRound(12.0*log2(i*binFrequency/440.0));
+        m_binPitch[i]=((semitone%12)+12)%12;
+    }
+    for(int i=0; i<12; ++i)
+    {
+        m_lastChroma[i]=0.0;
+    }
+    //Reserve the sub-fingerprints of the whole duration.
+    m_subFingerprints.reserve(FingerprintDuration*FingerprintSampleRate/
+                              FingerprintHopSize+1);
+}
+
+void KNMusicChromaFingerprint::process(const float *samples, int frameCount)
+{
+    float *frame=m_frame.data();
+    while(frameCount>0)
+    {
+        //Fill the frame.
+        int copyCount=qMin(frameCount, FingerprintFrameSize-m_framePosition);
+        memcpy(frame+m_framePosition, samples, copyCount*sizeof(float));
+        m_framePosition+=copyCount;
+        samples+=copyCount;
+        frameCount-=copyCount;
+        if(m_framePosition<FingerprintFrameSize)
+        {
+            return;
+        }
+        analysisFrame();
+        //Keep the overlapped part for the next frame.
+        memmove(frame,
+                frame+FingerprintHopSize,
+                (FingerprintFrameSize-FingerprintHopSize)*sizeof(float));
+        m_framePosition=FingerprintFrameSize-FingerprintHopSize;
+    }
+}
+
+QByteArray KNMusicChromaFingerprint::fingerprint() const
+{
+    //Save the sub-fingerprints in little endian.
+    QByteArray fingerprintData;
+    fingerprintData.resize(m_subFingerprints.size()*4);
+    uchar *data=(uchar *)fingerprintData.data();
+    for(QVector<quint32>::const_iterator i=m_subFingerprints.constBegin();
+        i!=m_subFingerprints.constEnd();
+        ++i)
+    {
+        qToLittleEndian(*i, data);
+        data+=4;
+    }
+    return fingerprintData;
+}
+
+QVector<quint32> KNMusicChromaFingerprint::subFingerprints(
+        const QByteArray &fingerprint)
+{
+    QVector<quint32> subFingerprints(fingerprint.size()/4);
+    const uchar *data=(const uchar *)fingerprint.constData();
+    for(QVector<quint32>::iterator i=subFingerprints.begin();
+        i!=subFingerprints.end();
+        ++i)
+    {
+        *i=qFromLittleEndian<quint32>(data);
+        data+=4;
+    }
+    return subFingerprints;
+}
+
+inline void KNMusicChromaFingerprint::analysisFrame()
+{
+    m_fft.amplitudes(m_frame.constData(), m_amplitudes.data());
+    //Fold the energy of the bins into the pitch classes.
+    float *chroma=m_chromaHistory[m_chromaCount % ChromaSmoothFrames];
+    for(int i=0; i<12; ++i)
+    {
+        chroma[i]=0.0;
+    }
+    const float *amplitudes=m_amplitudes.constData();
+    const int *binPitch=m_binPitch.constData();
+    for(int i=m_firstBin; i<=m_lastBin; ++i)
+    {
+        chroma[binPitch[i]]+=amplitudes[i]*amplitudes[i];
+    }
+    ++m_chromaCount;
+    //Wait for enough frames to smooth.
+    if(m_chromaCount<ChromaSmoothFrames)
+    {
+        return;
+    }
+    //Smooth the latest frames, and normalize it, so the volume doesn't matter.
+    float smoothChroma[12], norm=0.0;
+    for(int i=0; i<12; ++i)
+    {
+        smoothChroma[i]=0.0;
+        for(int j=0; j<ChromaSmoothFrames; ++j)
+        {
+            smoothChroma[i]+=m_chromaHistory[j][i];
+        }
+        norm+=smoothChroma[i]*smoothChroma[i];
+    }
+    norm=norm>0.0?1.0/qSqrt(norm):0.0;
+    for(int i=0; i<12; ++i)
+    {
+        smoothChroma[i]*=norm;
+    }
+    //Bits 0-11: the pitch class is stronger than the next one.
+    //Bits 12-23: the pitch class is stronger than it was in the last frame.
+    //Bits 24-31: the pitch class is stronger than the minor third above it.
+    quint32 subFingerprint=0;
+    for(int i=0; i<12; ++i)
+    {
+        if(smoothChroma[i]>smoothChroma[(i+1)%12])
+        {
+            subFingerprint|=1u<<i;
+        }
+        if(smoothChroma[i]>m_lastChroma[i])
+        {
+            subFingerprint|=1u<<(12+i);
+        }
+        if(i<8 && smoothChroma[i]>smoothChroma[i+3])
+        {
+            subFingerprint|=1u<<(24+i);
+        }
+        m_lastChroma[i]=smoothChroma[i];
+    }
+    //The first smoothed frame has nothing to compare with.
+    if(m_chromaCount>ChromaSmoothFrames)
+    {
+        m_subFingerprints.append(subFingerprint);
+    }
+}
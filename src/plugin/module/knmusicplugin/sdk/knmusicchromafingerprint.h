@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICCHROMAFINGERPRINT_H
+#define KNMUSICCHROMAFINGERPRINT_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include "knmusicfft.h"
+
+/*
+ * The chroma fingerprint describes the beginning of a recording. The mono
+ * samples at FingerprintSampleRate are cut into overlapped frames, the energy
+ * of each frame is folded into the 12 pitch classes (the chroma). Every frame
+ * gives a 32-bit sub-fingerprint from how the smoothed chroma compares to its
+ * neighbour pitch classes and to the previous frame. The comparisons don't
+ * depend on the volume and survive the lossy encoders, so the different rips
+ * of the same recording have nearly the same bits.
+ */
+
+#define FingerprintSampleRate 11025
+//Only the first minute of the track is used.
+#define FingerprintDuration 60
+#define FingerprintFrameSize 4096
+#define FingerprintHopSize 1024
+#define ChromaSmoothFrames 4
+
+class KNMusicChromaFingerprint
+{
+public:
+    KNMusicChromaFingerprint();
+    void process(const float *samples, int frameCount);
+    QByteArray fingerprint() const;
+    static QVector<quint32> subFingerprints(const QByteArray &fingerprint);
+
+private:
+    inline void analysisFrame();
+    KNMusicFFT m_fft;
+    QVector<float> m_frame, m_amplitudes;
+    //The pitch class of the bins, the bins out of the range are not used.
+    QVector<int> m_binPitch;
+    int m_firstBin, m_lastBin, m_framePosition=0;
+    //The raw chroma of the latest frames, and the last smoothed chroma.
+    float m_chromaHistory[ChromaSmoothFrames][12], m_lastChroma[12];
+    int m_chromaCount=0;
+    QVector<quint32> m_subFingerprints;
+};
+
+#endif // KNMUSICCHROMAFINGERPRINT_H
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QHash>
+#include <QVector>
+#include <QtAlgorithms>
+
+#include "knmusicchromafingerprint.h"
+
+#include "knmusicduplicatefinder.h"
+
+//Only index every second position, the queries use all the positions, so
+//every offset could still be found.
+#define IndexStep 2
+//The positions are saved in the low 10 bits of the index entries.
+#define PositionBits 10
+#define PositionMask 0x3FF
+//The bucket which is too large is a common pattern, e.g. silence, it's not
+//useful to tell the tracks apart.
+#define MaximumBucketSize 64
+#define MinimumVotes 4
+#define OffsetBase 2048
+//The overlapped sub-fingerprints to check, and the ratio of the different
+//bits which are allowed.
+#define MinimumOverlap 64
+#define MaximumBitErrorRate 0.3
+
+static inline quint32 bandKey(const quint32 *subFingerprints,
+                              const int &band)
+{
+    //The band index and the band bits of three continuous sub-fingerprints.
+    int shift=band<<3;
+    return ((quint32)band<<24) |
+            (((subFingerprints[0]>>shift) & 0xFF)<<16) |
+            (((subFingerprints[1]>>shift) & 0xFF)<<8) |
+            ((subFingerprints[2]>>shift) & 0xFF);
+}
+
+KNMusicDuplicateFinder::KNMusicDuplicateFinder(QObject *parent) :
+    QObject(parent)
+{
+}
+
+QList<QList<int> > KNMusicDuplicateFinder::cluster(
+        const QList<QByteArray> &fingerprints)
+{
+    int trackCount=fingerprints.size();
+    QVector<QVector<quint32> > subFingerprints(trackCount);
+    for(int i=0; i<trackCount; ++i)
+    {
+        subFingerprints[i]=
+                KNMusicChromaFingerprint::subFingerprints(fingerprints.at(i));
+        //The positions have to fit the index entry.
+        if(subFingerprints.at(i).size()>PositionMask)
+        {
+            subFingerprints[i].resize(PositionMask);
+        }
+    }
+    //Build the index.
+    QHash<quint32, QVector<quint32> > index;
+    for(int i=0; i<trackCount; ++i)
+    {
+        const quint32 *trackData=subFingerprints.at(i).constData();
+        for(int j=0, keyCount=subFingerprints.at(i).size()-2;
+            j<keyCount;
+            j+=IndexStep)
+        {
+            for(int band=0; band<4; ++band)
+            {
+                index[bandKey(trackData+j, band)].append(
+                            ((quint32)i<<PositionBits) | j);
+            }
+        }
+    }
+    //Every track is a group at the beginning.
+    QVector<int> parents(trackCount);
+    for(int i=0; i<trackCount; ++i)
+    {
+        parents[i]=i;
+    }
+    //Query the index with every track, only the tracks before it are checked,
+    //so every pair is checked once.
+    QHash<quint64, int> votes;
+    for(int i=1; i<trackCount; ++i)
+    {
+        votes.clear();
+        const quint32 *trackData=subFingerprints.at(i).constData();
+        for(int j=0, keyCount=subFingerprints.at(i).size()-2; j<keyCount; ++j)
+        {
+            for(int band=0; band<4; ++band)
+            {
+                QHash<quint32, QVector<quint32> >::const_iterator bucket=
+                        index.constFind(bandKey(trackData+j, band));
+                if(bucket==index.constEnd() ||
+                        (*bucket).size()>MaximumBucketSize)
+                {
+                    continue;
+                }
+                for(QVector<quint32>::const_iterator k=(*bucket).constBegin();
+                    k!=(*bucket).constEnd();
+                    ++k)
+                {
+                    quint32 track=(*k)>>PositionBits;
+                    if(track>=(quint32)i)
+                    {
+                        continue;
+                    }
+                    //Vote for the track and the offset.
+                    int offset=j-(int)((*k) & PositionMask)+OffsetBase;
+                    ++votes[((quint64)track<<16) | offset];
+                }
+            }
+        }
+        //Check the voted pairs.
+        for(QHash<quint64, int>::const_iterator j=votes.constBegin();
+            j!=votes.constEnd();
+            ++j)
+        {
+            if(j.value()<MinimumVotes)
+            {
+                continue;
+            }
+            int track=j.key()>>16,
+                trackRoot=findRoot(parents, track),
+                currentRoot=findRoot(parents, i);
+            //The tracks might be put together by another pair.
+            if(trackRoot==currentRoot)
+            {
+                continue;
+            }
+            if(isSameRecording(subFingerprints.at(track),
+                               subFingerprints.at(i),
+                               (int)(j.key() & 0xFFFF)-OffsetBase))
+            {
+                parents[currentRoot]=trackRoot;
+            }
+        }
+    }
+    //Collect the groups.
+    QHash<int, QList<int> > groups;
+    for(int i=0; i<trackCount; ++i)
+    {
+        groups[findRoot(parents, i)].append(i);
+    }
+    QList<QList<int> > duplicates;
+    for(QHash<int, QList<int> >::const_iterator i=groups.constBegin();
+        i!=groups.constEnd();
+        ++i)
+    {
+        if((*i).size()>1)
+        {
+            duplicates.append(*i);
+        }
+    }
+    return duplicates;
+}
+
+void KNMusicDuplicateFinder::findDuplicates(
+        const QList<KNMusicFingerprintItem> &tracks)
+{
+    QList<QByteArray> fingerprints;
+    for(QList<KNMusicFingerprintItem>::const_iterator i=tracks.constBegin();
+        i!=tracks.constEnd();
+        ++i)
+    {
+        fingerprints.append((*i).fingerprint);
+    }
+    //Translate the indexes to the track ids.
+    QList<QList<int> > groups=cluster(fingerprints);
+    QList<QList<quint32> > trackGroups;
+    for(QList<QList<int> >::const_iterator i=groups.constBegin();
+        i!=groups.constEnd();
+        ++i)
+    {
+        QList<quint32> trackGroup;
+        for(QList<int>::const_iterator j=(*i).constBegin();
+            j!=(*i).constEnd();
+            ++j)
+        {
+            trackGroup.append(tracks.at(*j).trackId);
+        }
+        trackGroups.append(trackGroup);
+    }
+    emit duplicatesFound(trackGroups);
+}
+
+inline int KNMusicDuplicateFinder::findRoot(QVector<int> &parents, int index)
+{
+    //Find the root, and point the path to the root directly.
+    int root=index;
+    while(parents.at(root)!=root)
+    {
+        root=parents.at(root);
+    }
+    while(parents.at(index)!=root)
+    {
+        int parent=parents.at(index);
+        parents[index]=root;
+        index=parent;
+    }
+    return root;
+}
+
+inline bool KNMusicDuplicateFinder::isSameRecording(
+        const QVector<quint32> &first,
+        const QVector<quint32> &second,
+        const int &offset)
+{
+    //The position p of the second one is the position p-offset of the first.
+    int start=qMax(0, offset),
+        end=qMin(second.size(), first.size()+offset);
+    if(end-start<MinimumOverlap)
+    {
+        return false;
+    }
+    const quint32 *firstData=first.constData(),
+                  *secondData=second.constData();
+    int differentBits=0;
+    for(int i=start; i<end; ++i)
+    {
+        differentBits+=qPopulationCount(firstData[i-offset]^secondData[i]);
+    }
+    return differentBits<=MaximumBitErrorRate*32*(end-start);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICDUPLICATEFINDER_H
+#define KNMUSICDUPLICATEFINDER_H
+
+#include "knmusicglobal.h"
+
+#include <QObject>
+
+using namespace KNMusic;
+
+/*
+ * The duplicate finder groups the tracks whose fingerprints are the same
+ * recording. Comparing every pair of the library is too slow, so the
+ * fingerprints are put into a locality sensitive hash index first: every 8-bit
+ * band of three continuous sub-fingerprints is a key, the near-matched
+ * fingerprints share many keys at the same time offset. Only the pairs which
+ * get enough votes are compared bit by bit at the voted offset.
+ */
+
+class KNMusicDuplicateFinder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KNMusicDuplicateFinder(QObject *parent = 0);
+    static QList<QList<int> > cluster(const QList<QByteArray> &fingerprints);
+
+signals:
+    //The track ids of the groups, every group has two tracks at least.
+    void duplicatesFound(QList<QList<quint32> > trackGroups);
+
+public slots:
+    void findDuplicates(const QList<KNMusicFingerprintItem> &tracks);
+
+private:
+    static inline int findRoot(QVector<int> &parents, int index);
+    static inline bool isSameRecording(const QVector<quint32> &first,
+                                       const QVector<quint32> &second,
+                                       const int &offset);
+};
+
+#endif // KNMUSICDUPLICATEFINDER_H
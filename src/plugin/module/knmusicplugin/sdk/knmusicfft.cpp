@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QtMath>
+
+#include "knmusicfft.h"
+
+KNMusicFFT::KNMusicFFT(const int &size) :
+    m_size(size),
+    m_window(size),
+    m_real(size),
+    m_imaginary(size),
+    m_twiddleReal(size),
+    m_twiddleImaginary(size),
+    m_reverseIndex(size)
+{
+    //Calculate the Hann window.
+    for(int i=0; i<m_size; ++i)
+    {
+        m_window[i]=0.5-0.5*qCos(2.0*M_PI*i/(m_size-1));
+    }
+    //Calculate the bit reversed indexes.
+    int bits=0;
+    while((1<<bits)<m_size)
+    {
+        ++bits;
+    }
+    for(int i=0; i<m_size; ++i)
+    {
+        int reversed=0;
+        for(int j=0; j<bits; ++j)
+        {
+            reversed|=((i>>j) & 1)<<(bits-1-j);
+        }
+        m_reverseIndex[i]=reversed;
+    }
+    //Calculate the twiddles stage by stage, so a stage reads its twiddles one
+    //by one.
+    for(int half=1; half<m_size; half<<=1)
+    {
+        for(int k=0; k<half; ++k)
+        {
+            double angle=-M_PI*k/half;
+            m_twiddleReal[half-1+k]=qCos(angle);
+            m_twiddleImaginary[half-1+k]=qSin(angle);
+        }
+    }
+}
+
+int KNMusicFFT::size() const
+{
+    return m_size;
+}
+
+void KNMusicFFT::amplitudes(const float *samples, float *amplitudes)
+{
+    //Put the windowed samples in the bit reversed order.
+    const float *window=m_window.constData();
+    const int *reverseIndex=m_reverseIndex.constData();
+    float *real=m_real.data(), *imaginary=m_imaginary.data();
+    for(int i=0; i<m_size; ++i)
+    {
+        real[reverseIndex[i]]=samples[i]*window[i];
+        imaginary[i]=0.0;
+    }
+    transform();
+    //The sum of the Hann window is a half of the size, scale the amplitude of a
+    //full scale sine wave to 1.0.
+    const float scale=4.0/m_size;
+    for(int i=0, binCount=m_size>>1; i<binCount; ++i)
+    {
+        amplitudes[i]=qSqrt(real[i]*real[i]+imaginary[i]*imaginary[i])*scale;
+    }
+}
+
+inline void KNMusicFFT::transform()
+{
+    //Iterative radix-2 FFT on the bit reversed data. In a group, the
+    //butterflies read the two halves and the twiddles contiguously and don't
+    //depend on each other, so the compiler could vectorize the inner loop.
+    float *real=m_real.data(), *imaginary=m_imaginary.data();
+    for(int half=1; half<m_size; half<<=1)
+    {
+        const float *twiddleReal=m_twiddleReal.constData()+half-1,
+                    *twiddleImaginary=m_twiddleImaginary.constData()+half-1;
+        for(int start=0; start<m_size; start+=(half<<1))
+        {
+            float *topReal=real+start, *topImaginary=imaginary+start,
+                  *bottomReal=topReal+half, *bottomImaginary=topImaginary+half;
+            for(int k=0; k<half; ++k)
+            {
+                float butterflyReal=bottomReal[k]*twiddleReal[k]-
+                        bottomImaginary[k]*twiddleImaginary[k],
+                      butterflyImaginary=bottomReal[k]*twiddleImaginary[k]+
+                        bottomImaginary[k]*twiddleReal[k];
+                bottomReal[k]=topReal[k]-butterflyReal;
+                bottomImaginary[k]=topImaginary[k]-butterflyImaginary;
+                topReal[k]+=butterflyReal;
+                topImaginary[k]+=butterflyImaginary;
+            }
+        }
+    }
+}
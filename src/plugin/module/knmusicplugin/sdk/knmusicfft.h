@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICFFT_H
+#define KNMUSICFFT_H
+
+#include <QVector>
+
+/*
+ * The FFT calculates the amplitudes of the Hann windowed real samples. The size
+ * must be a power of 2, all the buffers are allocated when it's constructed,
+ * so it could be used in the loops without any allocation.
+ */
+
+class KNMusicFFT
+{
+public:
+    explicit KNMusicFFT(const int &size);
+    int size() const;
+    //Transform size samples, and save the size/2 amplitudes from 0Hz to the
+    //half of the sample rate. A full scale sine wave has the amplitude 1.0.
+    void amplitudes(const float *samples, float *amplitudes);
+
+private:
+    inline void transform();
+    int m_size;
+    QVector<float> m_window;
+    //The FFT works on separate real and imaginary arrays, so the butterflies
+    //of a stage are contiguous.
+    QVector<float> m_real, m_imaginary;
+    //The twiddles of all the stages, the stage of size n uses n/2 twiddles
+    //starting from n/2-1.
+    QVector<float> m_twiddleReal, m_twiddleImaginary;
+    QVector<int> m_reverseIndex;
+};
+
+#endif // KNMUSICFFT_H
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICFINGERPRINTER_H
+#define KNMUSICFINGERPRINTER_H
+
+#include "knmusicglobal.h"
+
+#include <QObject>
+
+using namespace KNMusic;
+
+class KNMusicFingerprinter : public QObject
+{
+    Q_OBJECT
+public:
+    KNMusicFingerprinter(QObject *parent = 0):QObject(parent){}
+    //Calculate the fingerprints of the tracks in the background,
+    //trackFingerprinted() will be emitted for every track which could be
+    //decoded.
+    virtual void fingerprint(const QList<KNMusicFingerprintItem> &tracks)=0;
+
+signals:
+    void trackFingerprinted(KNMusicFingerprintItem track);
+
+public slots:
+
+private:
+};
+
+#endif // KNMUSICFINGERPRINTER_H
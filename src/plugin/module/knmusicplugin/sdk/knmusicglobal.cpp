@@ -26,12 +26,18 @@
 KNMusicGlobal *KNMusicGlobal::m_instance=nullptr;
 
 KNMusicParser *KNMusicGlobal::m_parser=nullptr;
+KNMusicLoudnessScanner *KNMusicGlobal::m_loudnessScanner=nullptr;
+KNMusicWaveformGenerator *KNMusicGlobal::m_waveformGenerator=nullptr;
+KNMusicSpectrumFeed *KNMusicGlobal::m_spectrumFeed=nullptr;
+KNMusicFingerprinter *KNMusicGlobal::m_fingerprinter=nullptr;
+KNMusicTempoScanner *KNMusicGlobal::m_tempoScanner=nullptr;
 KNMusicNowPlayingBase *KNMusicGlobal::m_nowPlaying=nullptr;
 KNMusicSoloMenuBase *KNMusicGlobal::m_soloMenu=nullptr;
 KNMusicMultiMenuBase *KNMusicGlobal::m_multiMenu=nullptr;
 KNMusicSearchBase *KNMusicGlobal::m_musicSearch=nullptr;
 KNMusicDetailTooltipBase *KNMusicGlobal::m_detailTooltip=nullptr;
 KNMusicDetailDialogBase *KNMusicGlobal::m_detailDialog=nullptr;
+KNMusicModel *KNMusicGlobal::m_libraryModel=nullptr;
 QString KNMusicGlobal::m_musicLibraryPath=QString();
 QString KNMusicGlobal::m_musicRowFormat=QString("org.kreogist.mu/MusicModelRow");
 bool KNMusicGlobal::m_dragMusicRowTaken=false;
@@ -86,6 +92,17 @@ QDateTime KNMusicGlobal::dataStringToDateTime(const QString &text)
     return QDateTime::fromString(text, "yyyyMMddHHmmss");
 }
 
+QString KNMusicGlobal::gainToString(const qreal &gain)
+{
+    return QString::number(gain, 'f', 2)+" dB";
+}
+
+QString KNMusicGlobal::tempoToString(const qreal &beatsPerMinute)
+{
+    //The tempo is shown as an integer like the tags, 0 means it's unknown.
+    return beatsPerMinute>0.0?QString::number(qRound(beatsPerMinute)):QString();
+}
+
 bool KNMusicGlobal::isMusicFile(const QString &suffix)
 {
     return (m_suffixs.indexOf(suffix.toLower())!=-1);
@@ -130,6 +147,9 @@ void KNMusicGlobal::retranslate()
     m_treeViewHeaderText[TrackCount]=tr("Track Count");
     m_treeViewHeaderText[TrackNumber]=tr("Track Number");
     m_treeViewHeaderText[Year]=tr("Year");
+    m_treeViewHeaderText[TrackGain]=tr("Track Gain");
+    m_treeViewHeaderText[AlbumGain]=tr("Album Gain");
+    m_treeViewHeaderText[MusicalKey]=tr("Key");
 }
 
 void KNMusicGlobal::onActionLibraryMoved(const QString &originalPath,
@@ -202,10 +222,19 @@ bool KNMusicGlobal::renameMusicFile(const QString &originalPath,
 void KNMusicGlobal::regMetaType()
 {
     qRegisterMetaType<QVector<int>>("QVector<int>");
+    qRegisterMetaType<QVector<float>>("QVector<float>");
     qRegisterMetaType<QItemSelection>("QItemSelection");
     qRegisterMetaType<QList<QStandardItem *>>("QList<QStandardItem *>");
+    qRegisterMetaType<QList<QList<QStandardItem *> >>("QList<QList<QStandardItem *> >");
     qRegisterMetaType<KNMusicDetailInfo>("KNMusicDetailInfo");
     qRegisterMetaType<KNMusicAnalysisItem>("KNMusicAnalysisItem");
+    qRegisterMetaType<QList<KNMusicAnalysisItem>>("QList<KNMusicAnalysisItem>");
+    qRegisterMetaType<QList<KNMusicReanalysisItem>>("QList<KNMusicReanalysisItem>");
+    qRegisterMetaType<QList<KNMusicLoudnessItem>>("QList<KNMusicLoudnessItem>");
+    qRegisterMetaType<KNMusicFingerprintItem>("KNMusicFingerprintItem");
+    qRegisterMetaType<QList<KNMusicFingerprintItem>>("QList<KNMusicFingerprintItem>");
+    qRegisterMetaType<QList<QList<quint32> >>("QList<QList<quint32> >");
+    qRegisterMetaType<KNMusicTempoItem>("KNMusicTempoItem");
 }
 
 void KNMusicGlobal::initialFileType()
@@ -485,6 +514,16 @@ void KNMusicGlobal::setDetailDialog(KNMusicDetailDialogBase *detailDialog)
     m_detailDialog = detailDialog;
 }
 
+KNMusicModel *KNMusicGlobal::libraryModel()
+{
+    return m_libraryModel;
+}
+
+void KNMusicGlobal::setLibraryModel(KNMusicModel *libraryModel)
+{
+    m_libraryModel = libraryModel;
+}
+
 KNMusicDetailTooltipBase *KNMusicGlobal::detailTooltip()
 {
     return m_detailTooltip;
@@ -580,6 +619,56 @@ void KNMusicGlobal::setParser(KNMusicParser *parser)
     m_parser = parser;
 }
 
+KNMusicLoudnessScanner *KNMusicGlobal::loudnessScanner()
+{
+    return m_loudnessScanner;
+}
+
+void KNMusicGlobal::setLoudnessScanner(KNMusicLoudnessScanner *loudnessScanner)
+{
+    m_loudnessScanner = loudnessScanner;
+}
+
+KNMusicWaveformGenerator *KNMusicGlobal::waveformGenerator()
+{
+    return m_waveformGenerator;
+}
+
+void KNMusicGlobal::setWaveformGenerator(KNMusicWaveformGenerator *waveformGenerator)
+{
+    m_waveformGenerator = waveformGenerator;
+}
+
+KNMusicSpectrumFeed *KNMusicGlobal::spectrumFeed()
+{
+    return m_spectrumFeed;
+}
+
+void KNMusicGlobal::setSpectrumFeed(KNMusicSpectrumFeed *spectrumFeed)
+{
+    m_spectrumFeed = spectrumFeed;
+}
+
+KNMusicFingerprinter *KNMusicGlobal::fingerprinter()
+{
+    return m_fingerprinter;
+}
+
+void KNMusicGlobal::setFingerprinter(KNMusicFingerprinter *fingerprinter)
+{
+    m_fingerprinter = fingerprinter;
+}
+
+KNMusicTempoScanner *KNMusicGlobal::tempoScanner()
+{
+    return m_tempoScanner;
+}
+
+void KNMusicGlobal::setTempoScanner(KNMusicTempoScanner *tempoScanner)
+{
+    m_tempoScanner = tempoScanner;
+}
+
 KNConfigure *KNMusicGlobal::musicConfigure()
 {
     return m_musicConfigure;
@@ -49,6 +49,9 @@ enum MusicDatas
     TrackCount,
     TrackNumber,
     Year,
+    TrackGain,
+    AlbumGain,
+    MusicalKey,
     MusicDataCount
 };
 enum MusicDisplayData
@@ -64,7 +67,10 @@ enum KNMusicModelRole
     ArtworkKeyRole,
     TrackFileRole,
     TrackIndexRole,
-    CantPlayFlagRole
+    CantPlayFlagRole,
+    TrackIdRole,
+    FingerprintRole,
+    LoudnessScannedRole
 };
 enum PropertyListIndex
 {
@@ -81,7 +87,14 @@ enum PropertyListIndex
     PropertyLastPlayed,
     PropertyTrackFilePath,
     PropertyTrackIndex,
-    PropertyStartPosition
+    PropertyStartPosition,
+    PropertyTrackId,
+    PropertyTrackGain,
+    PropertyAlbumGain,
+    PropertyFingerprint,
+    PropertyTempo,
+    PropertyMusicalKey,
+    PropertyLoudnessScanned
 };
 enum KNMusicCategoryRole
 {
@@ -146,6 +159,9 @@ struct KNMusicDetailInfo
     qint64 duration=0;
     qint64 bitRate=0;
     qint64 samplingRate=0;
+    //Replay gain, in dB, it's available only when the gain text is not empty.
+    qreal trackGain=0.0;
+    qreal albumGain=0.0;
     //Image hash data.
     QString coverImageHash;
     //Tag datas.
@@ -156,8 +172,56 @@ struct KNMusicAnalysisItem
     KNMusicDetailInfo detailInfo;
     //Album art data.
     QImage coverImage;
+    //The compressed album art, it's only decoded to cover image when needed.
+    QByteArray coverImageData;
     QMap<QString, QList<QByteArray>> imageData;
 };
+struct KNMusicReanalysisItem
+{
+    //The id of the row reference which is kept by the model.
+    quint32 rowId=0;
+    KNMusicAnalysisItem analysisItem;
+    bool available=false;
+};
+struct KNMusicLoudnessItem
+{
+    //The id of the track in the library.
+    quint32 trackId=0;
+    //Track file and time, the whole file is scanned when it's not a track.
+    QString filePath;
+    qint64 startPosition=-1;
+    qint64 duration=-1;
+    //Scan results, in dB. The gains are only available when the track could
+    //be scanned.
+    qreal trackGain=0.0;
+    qreal albumGain=0.0;
+    bool scanned=false;
+};
+struct KNMusicFingerprintItem
+{
+    //The id of the track in the library.
+    quint32 trackId=0;
+    //Track file and time, the beginning of the file is used when it's not a
+    //track.
+    QString filePath;
+    qint64 startPosition=-1;
+    qint64 duration=-1;
+    //The chroma fingerprint, see KNMusicChromaFingerprint.
+    QByteArray fingerprint;
+};
+struct KNMusicTempoItem
+{
+    //The id of the track in the library.
+    quint32 trackId=0;
+    //Track file and time, the whole file is used when it's not a track.
+    QString filePath;
+    qint64 startPosition=-1;
+    qint64 duration=-1;
+    //Scan results, the tempo is 0 when it can't be detected, and the key is in
+    //the format of the ID3v2 TKEY frame, e.g. "Ebm".
+    qreal beatsPerMinute=0.0;
+    QString key;
+};
 }
 
 using namespace KNMusic;
@@ -169,6 +233,11 @@ class KNPreferenceWidgetsPanel;
 class KNConfigure;
 class KNGlobal;
 class KNMusicParser;
+class KNMusicLoudnessScanner;
+class KNMusicWaveformGenerator;
+class KNMusicSpectrumFeed;
+class KNMusicFingerprinter;
+class KNMusicTempoScanner;
 class KNMusicLyricsManager;
 class KNMusicNowPlayingBase;
 class KNMusicDetailTooltipBase;
@@ -177,6 +246,7 @@ class KNMusicSoloMenuBase;
 class KNMusicMultiMenuBase;
 class KNMusicSearchBase;
 class KNMusicProxyModel;
+class KNMusicModel;
 class KNMusicTab;
 class KNMusicGlobal : public QObject
 {
@@ -189,8 +259,20 @@ public:
     static QString dateTimeToDataString(const QDateTime &dateTime);
     static QString musicRowFormat();
     static QDateTime dataStringToDateTime(const QString &text);
+    static QString gainToString(const qreal &gain);
+    static QString tempoToString(const qreal &beatsPerMinute);
     static KNMusicParser *parser();
     static void setParser(KNMusicParser *parser);
+    static KNMusicLoudnessScanner *loudnessScanner();
+    static void setLoudnessScanner(KNMusicLoudnessScanner *loudnessScanner);
+    static KNMusicWaveformGenerator *waveformGenerator();
+    static void setWaveformGenerator(KNMusicWaveformGenerator *waveformGenerator);
+    static KNMusicSpectrumFeed *spectrumFeed();
+    static void setSpectrumFeed(KNMusicSpectrumFeed *spectrumFeed);
+    static KNMusicFingerprinter *fingerprinter();
+    static void setFingerprinter(KNMusicFingerprinter *fingerprinter);
+    static KNMusicTempoScanner *tempoScanner();
+    static void setTempoScanner(KNMusicTempoScanner *tempoScanner);
     KNConfigure *musicConfigure();
     KNPreferenceWidgetsPanel *preferencePanel();
     KNMusicNowPlayingBase *nowPlaying();
@@ -223,6 +305,8 @@ public:
     static void setDetailTooltip(KNMusicDetailTooltipBase *detailTooltip);
     static KNMusicDetailDialogBase *detailDialog();
     static void setDetailDialog(KNMusicDetailDialogBase *detailDialog);
+    static KNMusicModel *libraryModel();
+    static void setLibraryModel(KNMusicModel *libraryModel);
     void updateItemValue(const QString &valueName);
     void insertItemInfoList(const KNPreferenceTitleInfo &listTitle,
                             const QList<KNPreferenceItemInfo> &list);
@@ -256,12 +340,18 @@ private:
     static KNMusicGlobal *m_instance;
     KNMusicLyricsManager *m_lyricsManager;
     static KNMusicParser *m_parser;
+    static KNMusicLoudnessScanner *m_loudnessScanner;
+    static KNMusicWaveformGenerator *m_waveformGenerator;
+    static KNMusicSpectrumFeed *m_spectrumFeed;
+    static KNMusicFingerprinter *m_fingerprinter;
+    static KNMusicTempoScanner *m_tempoScanner;
     static KNMusicNowPlayingBase *m_nowPlaying;
     static KNMusicSoloMenuBase *m_soloMenu;
     static KNMusicMultiMenuBase *m_multiMenu;
     static KNMusicSearchBase *m_musicSearch;
     static KNMusicDetailTooltipBase *m_detailTooltip;
     static KNMusicDetailDialogBase *m_detailDialog;
+    static KNMusicModel *m_libraryModel;
     static QString m_musicLibraryPath;
     static QString m_musicRowFormat;
     static QList<QList<QStandardItem *>> m_dragMusicRow;
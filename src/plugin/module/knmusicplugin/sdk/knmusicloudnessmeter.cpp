@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QtMath>
+
+#include "knmusicloudnessmeter.h"
+
+//All the loudness below are in LUFS.
+#define AbsoluteGate -70.0
+#define RelativeGate -10.0
+//The target loudness of the replay gain 2.0.
+#define ReferenceLoudness -18.0
+
+//The loudness of the mean square energy, BS.1770 says it's offset by -0.691.
+static inline double energyToLoudness(const double &energy)
+{
+    return -0.691+10.0*log10(energy);
+}
+
+static inline double loudnessToEnergy(const double &loudness)
+{
+    return pow(10.0, (loudness+0.691)/10.0);
+}
+
+KNMusicLoudnessMeter::KNMusicLoudnessMeter(const int &sampleRate)
+{
+    //Calculate the K-weighting filters for the sample rate, the parameters are
+    //from the BS.1770 filters at 48kHz.
+    //Stage 1: the high shelf which models the head.
+    double K=tan(M_PI*1681.974450955533/sampleRate),
+           Q=0.7071752369554196,
+           Vh=pow(10.0, 3.999843853973347/20.0),
+           Vb=pow(Vh, 0.4996667741545416),
+           a0=1.0+K/Q+K*K;
+    m_shelfB[0]=(Vh+Vb*K/Q+K*K)/a0;
+    m_shelfB[1]=2.0*(K*K-Vh)/a0;
+    m_shelfB[2]=(Vh-Vb*K/Q+K*K)/a0;
+    m_shelfA[0]=1.0;
+    m_shelfA[1]=2.0*(K*K-1.0)/a0;
+    m_shelfA[2]=(1.0-K/Q+K*K)/a0;
+    //Stage 2: the high pass, the numerator is always 1, -2, 1.
+    K=tan(M_PI*38.13547087602444/sampleRate);
+    Q=0.5003270373238773;
+    a0=1.0+K/Q+K*K;
+    m_passA[0]=1.0;
+    m_passA[1]=2.0*(K*K-1.0)/a0;
+    m_passA[2]=(1.0-K/Q+K*K)/a0;
+    //Reset the states.
+    for(int i=0; i<2; ++i)
+    {
+        m_shelfState[i][0]=0.0;
+        m_shelfState[i][1]=0.0;
+        m_passState[i][0]=0.0;
+        m_passState[i][1]=0.0;
+    }
+    for(int i=0; i<4; ++i)
+    {
+        m_subBlockEnergy[i]=0.0;
+    }
+    //A sub-block is 100ms.
+    m_subBlockFrames=qMax(sampleRate/10, 1);
+    //Reserve about 5 minutes of blocks.
+    m_blockEnergies.reserve(3000);
+}
+
+void KNMusicLoudnessMeter::process(const float *samples, int frameCount)
+{
+    while(frameCount>0)
+    {
+        //Only filter the frames until the end of the current sub-block.
+        int frames=qMin(frameCount, m_subBlockFrames-m_subBlockPosition);
+        m_currentEnergy+=filterFrames(samples, frames);
+        samples+=frames<<1;
+        frameCount-=frames;
+        m_subBlockPosition+=frames;
+        //Check whether the sub-block is finished.
+        if(m_subBlockPosition==m_subBlockFrames)
+        {
+            finishSubBlock();
+        }
+    }
+}
+
+QVector<double> KNMusicLoudnessMeter::blockEnergies() const
+{
+    return m_blockEnergies;
+}
+
+float KNMusicLoudnessMeter::peak() const
+{
+    return m_peak;
+}
+
+qreal KNMusicLoudnessMeter::integratedLoudness(
+        const QVector<double> &blockEnergies)
+{
+    //All the blocks are louder than the absolute gate, calculate the relative
+    //gate from them.
+    if(blockEnergies.isEmpty())
+    {
+        return AbsoluteGate;
+    }
+    double energySum=0.0;
+    for(QVector<double>::const_iterator i=blockEnergies.constBegin();
+        i!=blockEnergies.constEnd();
+        ++i)
+    {
+        energySum+=*i;
+    }
+    double relativeGate=energySum/blockEnergies.size()*
+            pow(10.0, RelativeGate/10.0);
+    //Calculate the mean of the blocks which are louder than the relative gate.
+    int gatedCount=0;
+    energySum=0.0;
+    for(QVector<double>::const_iterator i=blockEnergies.constBegin();
+        i!=blockEnergies.constEnd();
+        ++i)
+    {
+        if(*i>=relativeGate)
+        {
+            energySum+=*i;
+            ++gatedCount;
+        }
+    }
+    return gatedCount==0?AbsoluteGate:energyToLoudness(energySum/gatedCount);
+}
+
+qreal KNMusicLoudnessMeter::replayGain(const qreal &loudness,
+                                       const float &peak)
+{
+    //The silent track doesn't need any gain.
+    if(loudness<=AbsoluteGate)
+    {
+        return 0.0;
+    }
+    qreal gain=ReferenceLoudness-loudness;
+    //Don't let the gain make the peak clipped.
+    if(peak>0.0)
+    {
+        gain=qMin(gain, -20.0*log10((qreal)peak));
+    }
+    return gain;
+}
+
+inline double KNMusicLoudnessMeter::filterFrames(const float *samples,
+                                                 const int &frameCount)
+{
+    //Keep the states and coefficients in the locals, the left and right
+    //channels are filtered in the same way at the same time, so the compiler
+    //could put the two channels into one vector register.
+    const double sb0=m_shelfB[0], sb1=m_shelfB[1], sb2=m_shelfB[2],
+                 sa1=m_shelfA[1], sa2=m_shelfA[2],
+                 pa1=m_passA[1], pa2=m_passA[2];
+    double shelf0[2]={m_shelfState[0][0], m_shelfState[1][0]},
+           shelf1[2]={m_shelfState[0][1], m_shelfState[1][1]},
+           pass0[2]={m_passState[0][0], m_passState[1][0]},
+           pass1[2]={m_passState[0][1], m_passState[1][1]},
+           energy[2]={0.0, 0.0};
+    float peak[2]={m_peak, m_peak};
+    for(int i=0; i<frameCount; ++i)
+    {
+        for(int c=0; c<2; ++c)
+        {
+            float sample=samples[c];
+            peak[c]=qMax(peak[c], qAbs(sample));
+            //High shelf, transposed direct form II.
+            double x=sample,
+                   y=sb0*x+shelf0[c];
+            shelf0[c]=sb1*x-sa1*y+shelf1[c];
+            shelf1[c]=sb2*x-sa2*y;
+            //High pass.
+            double z=y+pass0[c];
+            pass0[c]=-2.0*y-pa1*z+pass1[c];
+            pass1[c]=y-pa2*z;
+            energy[c]+=z*z;
+        }
+        samples+=2;
+    }
+    //Save the states.
+    for(int c=0; c<2; ++c)
+    {
+        m_shelfState[c][0]=shelf0[c];
+        m_shelfState[c][1]=shelf1[c];
+        m_passState[c][0]=pass0[c];
+        m_passState[c][1]=pass1[c];
+    }
+    m_peak=qMax(peak[0], peak[1]);
+    //The channels have the same weight.
+    return energy[0]+energy[1];
+}
+
+inline void KNMusicLoudnessMeter::finishSubBlock()
+{
+    //Save the sub-block energy.
+    m_subBlockEnergy[m_subBlockCount & 3]=m_currentEnergy;
+    ++m_subBlockCount;
+    m_currentEnergy=0.0;
+    m_subBlockPosition=0;
+    //A block needs four sub-blocks.
+    if(m_subBlockCount<4)
+    {
+        return;
+    }
+    double blockEnergy=(m_subBlockEnergy[0]+m_subBlockEnergy[1]+
+                        m_subBlockEnergy[2]+m_subBlockEnergy[3])/
+            (4.0*m_subBlockFrames);
+    //Only keep the blocks which are louder than the absolute gate.
+    if(blockEnergy>loudnessToEnergy(AbsoluteGate))
+    {
+        m_blockEnergies.append(blockEnergy);
+    }
+}
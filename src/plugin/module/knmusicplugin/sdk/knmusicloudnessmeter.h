@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICLOUDNESSMETER_H
+#define KNMUSICLOUDNESSMETER_H
+
+#include <QVector>
+
+/*
+ * The loudness meter measures the loudness of the stereo interleaved float
+ * samples as EBU R128 (ITU-R BS.1770) says: the samples are K-weighted, the
+ * mean square of every 400ms block (75% overlapped) is kept when it's louder
+ * than the absolute gate. The integrated loudness is calculated from the kept
+ * blocks with the relative gate, so the blocks of several tracks could be put
+ * together to calculate the loudness of an album.
+ */
+
+class KNMusicLoudnessMeter
+{
+public:
+    explicit KNMusicLoudnessMeter(const int &sampleRate);
+    void process(const float *samples, int frameCount);
+    QVector<double> blockEnergies() const;
+    float peak() const;
+    static qreal integratedLoudness(const QVector<double> &blockEnergies);
+    static qreal replayGain(const qreal &loudness, const float &peak);
+
+private:
+    inline double filterFrames(const float *samples, const int &frameCount);
+    inline void finishSubBlock();
+    //K-weighting filter coefficients, the high shelf and the high pass.
+    double m_shelfB[3], m_shelfA[3], m_passA[3];
+    //Filter states of the left and right channel.
+    double m_shelfState[2][2], m_passState[2][2];
+    //The energy of the latest four 100ms sub-blocks, one block is made by four
+    //sub-blocks.
+    double m_subBlockEnergy[4];
+    double m_currentEnergy=0.0;
+    int m_subBlockFrames, m_subBlockPosition=0, m_subBlockCount=0;
+    float m_peak=0.0;
+    QVector<double> m_blockEnergies;
+};
+
+#endif // KNMUSICLOUDNESSMETER_H
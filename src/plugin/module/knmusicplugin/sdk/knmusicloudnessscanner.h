@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICLOUDNESSSCANNER_H
+#define KNMUSICLOUDNESSSCANNER_H
+
+#include "knmusicglobal.h"
+
+#include <QObject>
+
+using namespace KNMusic;
+
+class KNMusicLoudnessScanner : public QObject
+{
+    Q_OBJECT
+public:
+    KNMusicLoudnessScanner(QObject *parent = 0):QObject(parent){}
+    //Scan the tracks of an album in the background, albumScanned() will be
+    //emitted with all the tracks, the tracks which can't be decoded are not
+    //marked as scanned.
+    virtual void scanAlbum(const QList<KNMusicLoudnessItem> &tracks)=0;
+
+signals:
+    void albumScanned(QList<KNMusicLoudnessItem> tracks);
+
+public slots:
+
+private:
+};
+
+#endif // KNMUSICLOUDNESSSCANNER_H
@@ -18,22 +18,11 @@
 #ifndef KNMUSICLRCLYRICSPARSER_H
 #define KNMUSICLRCLYRICSPARSER_H
 
-#include <QList>
-#include <QRegularExpression>
+#include <QStringList>
 
 #include <QObject>
 
-namespace KNMusicLRCLyrics
-{
-struct LyricsLine
-{
-    qint64 position;
-    QString text;
-};
-}
-
-using namespace KNMusicLRCLyrics;
-
+class KNMusicLRCParser;
 class KNMusicLRCLyricsParser : public QObject
 {
     Q_OBJECT
@@ -52,13 +41,7 @@ signals:
 public slots:
 
 private:
-    void parseFrames(QString frame,
-                     const QString &text,
-                     QList<LyricsLine> &positionList);
-    static bool frameLessThan(const LyricsLine &frameLeft,
-                              const LyricsLine &frameRight);
-    QRegularExpression m_frameCatchRegExp, m_noneNumberRegExp;
-    QTextCodec *m_utf8Codec, *m_localeCodec;
+    KNMusicLRCParser *m_parser;
 };
 
 #endif // KNMUSICLRCLYRICSPARSER_H
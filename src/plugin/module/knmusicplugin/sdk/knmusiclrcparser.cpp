@@ -16,12 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 #include <QFile>
-#include <QTextStream>
 #include <QTextCodec>
 #include <QStringList>
-#include <QLinkedList>
-#include <QRegularExpressionMatch>
-#include <QRegularExpressionMatchIterator>
 
 #include "knglobal.h"
 
@@ -32,8 +28,6 @@
 KNMusicLRCParser::KNMusicLRCParser(QObject *parent) :
     QObject(parent)
 {
-    //Set frame catch regexp.
-    m_frameCatch.setPattern("\\[[^\\]]*\\]");
     //Set the header text.
     m_headerText.append("ti");
     m_headerText.append("ar");
@@ -44,7 +38,7 @@ KNMusicLRCParser::KNMusicLRCParser(QObject *parent) :
     m_localeCodec=KNGlobal::localeDefaultCodec();
 }
 
-void KNMusicLRCParser::parseFile(const QString &filePath,
+bool KNMusicLRCParser::parseFile(const QString &filePath,
                                  QMap<int, QString> &properties,
                                  QList<qint64> &positions,
                                  QStringList &lyricsText)
@@ -53,15 +47,16 @@ void KNMusicLRCParser::parseFile(const QString &filePath,
     positions.clear();
     lyricsText.clear();
     //-------Read the file---------
-    QStringList lyricsRawData;
     //Open the lyric file.
     QFile lyricsFile(filePath);
     if(!lyricsFile.open(QIODevice::ReadOnly))
     {
-        return;
+        return false;
     }
     //Read all the raw data of the file.
     QByteArray fileRawData=lyricsFile.readAll();
+    //Close the file.
+    lyricsFile.close();
     //Try to parse it using UTF-8.
     QTextCodec::ConverterState convState;
     QString fileTextData=m_utf8Codec->toUnicode(fileRawData.constData(),
@@ -79,103 +74,288 @@ void KNMusicLRCParser::parseFile(const QString &filePath,
             ;
         }
     }
-    lyricsRawData=fileTextData.split(QRegularExpression("\n"),
-                                     QString::SkipEmptyParts);
-    //Close the file.
-    lyricsFile.close();
     //-------Parse the file---------
-    //Clear the same line.
-    lyricsRawData.removeDuplicates();
+    return parseData(fileTextData, properties, positions, lyricsText);
+}
+
+bool KNMusicLRCParser::parseData(const QString &lyricsTextData,
+                                 QMap<int, QString> &properties,
+                                 QList<qint64> &positions,
+                                 QStringList &lyricsText)
+{
     //Clear the data.
+    positions.clear();
+    lyricsText.clear();
+    //The lyrics data is scanned only once. A line could be:
+    //  [ti:Title]                          - Header frame.
+    //  [00:01.00][00:31.00]Text            - Several frames share one text.
+    //  [00:01.00]Text 1[00:03.00]Text 2    - Several frames in one line.
+    //  [00:01.00]<00:01.00>Word <00:01.50>Word   - Enhanced LRC.
+    //The word timestamps are removed from the text, and a line which only has
+    //word timestamps uses the first word timestamp as its position.
     QList<LRCFrame> lyricsData;
-    //Process each line.
-    while(!lyricsRawData.isEmpty())
-    {
-        //Take one line and remove all spaces.
-        QString currentLine=lyricsRawData.takeFirst();
-        //Using a linked list to storage all the frames.
-        QLinkedList<QString> currentFrames;
-        //Catch the frame data.
-        QRegularExpressionMatchIterator matchIterator=
-                m_frameCatch.globalMatch(currentLine);
-        int lastPos=0;
-        while(matchIterator.hasNext())
+    QList<qint64> pendingFrames;
+    QString lineText;
+    qint64 offset=0, position;
+    bool sorted=true;
+    const QChar *current=lyricsTextData.constData(),
+                *dataEnd=current+lyricsTextData.size();
+    while(current<dataEnd)
+    {
+        //Find the end of the line.
+        const QChar *lineEnd=current;
+        while(lineEnd<dataEnd && lineEnd->unicode()!='\n')
         {
-            QRegularExpressionMatch match=matchIterator.next();
-            if(match.capturedStart()!=lastPos)
+            ++lineEnd;
+        }
+        //Prepare for the new line.
+        pendingFrames.clear();
+        lineText.clear();
+        qint64 firstWordPosition=-1;
+        const QChar *textStart=current;
+        while(current<lineEnd)
+        {
+            ushort currentChar=current->unicode();
+            if(currentChar!='[' && currentChar!='<')
+            {
+                ++current;
+                continue;
+            }
+            //Find the end of the tag.
+            ushort closeChar=(currentChar=='[')?']':'>';
+            const QChar *tagEnd=current+1;
+            while(tagEnd<lineEnd && tagEnd->unicode()!=closeChar)
+            {
+                ++tagEnd;
+            }
+            //If the tag is not closed, it's a part of the text.
+            if(tagEnd==lineEnd)
             {
-                //Means it's not in the head of the current line.
+                current=lineEnd;
                 break;
             }
-            currentFrames.append(currentLine.mid(match.capturedStart(),
-                                                 match.capturedLength()));
-            lastPos=match.capturedEnd();
+            if(currentChar=='<')
+            {
+                //Only a time tag is a word timestamp, keep the others like
+                //'<3' in the text.
+                if(!parseTime(current+1, tagEnd, position))
+                {
+                    current=tagEnd+1;
+                    continue;
+                }
+                if(firstWordPosition==-1)
+                {
+                    firstWordPosition=position;
+                }
+                //Skip the word timestamp.
+                lineText.append(textStart, current-textStart);
+                current=tagEnd+1;
+                textStart=current;
+                continue;
+            }
+            //Save the text before the frame.
+            lineText.append(textStart, current-textStart);
+            //If there's any text before this frame, it belongs to the frames
+            //before the text. Like 'Text 1' in the example.
+            if(!lineText.trimmed().isEmpty())
+            {
+                flushFrames(pendingFrames, lineText, lyricsData, sorted);
+            }
+            //Parse the frame.
+            if(parseTime(current+1, tagEnd, position))
+            {
+                pendingFrames.append(position);
+            }
+            else
+            {
+                parseHeader(current+1, tagEnd, properties, offset);
+            }
+            current=tagEnd+1;
+            textStart=current;
         }
-        //Remove all the frames.
-        currentLine.remove(0, lastPos);
-        //-------Prase the line------
-        while(!currentFrames.isEmpty())
+        //Save the rest of the line.
+        lineText.append(textStart, lineEnd-textStart);
+        //A line only has word timestamps starts at the first word.
+        if(pendingFrames.isEmpty() && firstWordPosition!=-1)
         {
-            parseFrame(currentFrames.takeFirst(),
-                       currentLine,
-                       lyricsData,
-                       properties);
+            pendingFrames.append(firstWordPosition);
         }
+        flushFrames(pendingFrames, lineText, lyricsData, sorted);
+        //Move to the next line.
+        current=lineEnd+1;
+    }
+    //Check is the lyrics line list is empty or not, if it's empty, means we
+    //can't parse it.
+    if(lyricsData.isEmpty())
+    {
+        return false;
     }
     //-----------Sort the lyrics line-----------
+    //Most of the lyrics is written in time order, only sort the data when
+    //it's not.
     //- Why stable sort?
     //  Because there might be some frames at the same time. Display them with
     //their exist order.
-    qStableSort(lyricsData.begin(), lyricsData.end(), frameLessThan);
-    //Combine the lyrics.
-    QMap<qint64, QString> lyricsMap;
+    if(!sorted)
+    {
+        qStableSort(lyricsData.begin(), lyricsData.end(), frameLessThan);
+    }
+    //Combine the lyrics at the same position, and apply the offset. A positive
+    //offset shows the lyrics earlier.
+    positions.reserve(lyricsData.size());
+    lyricsText.reserve(lyricsData.size());
+    int groupStart=0;
     for(int i=0; i<lyricsData.size(); i++)
     {
-        lyricsMap[lyricsData[i].position]=
-                (lyricsMap[lyricsData[i].position].isEmpty()?"":lyricsMap[lyricsData[i].position]+'\n')+
-                lyricsData[i].text;
+        const LRCFrame &frame=lyricsData.at(i);
+        position=qMax((qint64)0, frame.position-offset);
+        if(positions.isEmpty() || positions.last()!=position)
+        {
+            //A new position.
+            groupStart=i;
+            positions.append(position);
+            lyricsText.append(frame.text);
+            continue;
+        }
+        //Ignore the same text at the same position.
+        bool duplicated=false;
+        for(int j=groupStart; j<i; j++)
+        {
+            if(lyricsData.at(j).text==frame.text)
+            {
+                duplicated=true;
+                break;
+            }
+        }
+        if(!duplicated)
+        {
+            QString &lastText=lyricsText.last();
+            lastText.append('\n');
+            lastText.append(frame.text);
+        }
     }
-    //Export the position and the text.
-    positions=lyricsMap.keys();
-    lyricsText=lyricsMap.values();
+    return true;
 }
 
-void KNMusicLRCParser::parseFrame(const QString &frame,
-                                  const QString &lineData,
-                                  QList<LRCFrame> &lyricsData,
-                                  QMap<int, QString> &properties)
+void KNMusicLRCParser::parseHeader(const QChar *begin,
+                                   const QChar *end,
+                                   QMap<int, QString> &properties,
+                                   qint64 &offset)
 {
-    //Remove the first '[' and ']'.
-    QString frameData=frame.mid(1, frame.length()-2);
-    //Get the data before the first colon, judge it's number or not.
-    int colonPos=frameData.indexOf(':');
-    if(colonPos==-1)
+    //Find the colon.
+    const QChar *colon=begin;
+    while(colon<end && colon->unicode()!=':')
+    {
+        ++colon;
+    }
+    if(colon==end)
     {
         //Cannot find ':', this is frame is obsolete.
         return;
     }
-    //Get the data before the first colon.
-    QString testData=frameData.left(colonPos).toLower();
-    //Search header text in header, if has find.
-    int frameIndex=m_headerText.indexOf(testData);
-    if(frameIndex!=-1)
+    QString headerName=QString(begin, colon-begin).trimmed().toLower(),
+            headerValue=QString(colon+1, end-colon-1).trimmed();
+    //Check the offset header.
+    if(headerName=="offset")
     {
-        properties[frameIndex]=frameData.mid(colonPos+1);
+        bool translateResult=false;
+        qint64 offsetValue=headerValue.toLongLong(&translateResult);
+        if(translateResult)
+        {
+            offset=offsetValue;
+        }
         return;
     }
-    //Judge the test data is number or not.
-    int secondChar=frameData.indexOf(QRegularExpression("[^0-9]"), colonPos+1);
-    //If it's not a number, means it cannot be a time, obsolete.
-    if(secondChar==-1)
+    //Search header text in header, if has find.
+    int headerIndex=m_headerText.indexOf(headerName);
+    if(headerIndex!=-1)
     {
-        return;
+        properties[headerIndex]=headerValue;
+    }
+}
+
+void KNMusicLRCParser::flushFrames(QList<qint64> &pendingFrames,
+                                   QString &lineText,
+                                   QList<LRCFrame> &lyricsData,
+                                   bool &sorted)
+{
+    if(!pendingFrames.isEmpty())
+    {
+        LRCFrame currentFrame;
+        currentFrame.text=lineText.simplified();
+        for(int i=0; i<pendingFrames.size(); i++)
+        {
+            currentFrame.position=pendingFrames.at(i);
+            //Check whether the data is still in order.
+            if(sorted && !lyricsData.isEmpty() &&
+                    currentFrame.position<lyricsData.last().position)
+            {
+                sorted=false;
+            }
+            lyricsData.append(currentFrame);
+        }
+        pendingFrames.clear();
+    }
+    //The text before the first frame is useless.
+    lineText.clear();
+}
+
+bool KNMusicLRCParser::parseTime(const QChar *begin,
+                                 const QChar *end,
+                                 qint64 &position)
+{
+    //There are several types of LRC frames:
+    // [mm:ss]
+    // [mm:ss.xx] or [mm:ss:xx]
+    // [mm:ss.xxx]
+    //Parse the minute part, a minute part is no more than 6 digits.
+    const QChar *current=begin;
+    qint64 minutePart=0, secondPart=0, millisecondPart=0;
+    while(current<end && current->isDigit())
+    {
+        minutePart=minutePart*10+current->digitValue();
+        ++current;
+    }
+    if(current==begin || current-begin>6 ||
+            current==end || current->unicode()!=':')
+    {
+        return false;
+    }
+    //Parse the second part.
+    const QChar *secondStart=++current;
+    while(current<end && current->isDigit())
+    {
+        secondPart=secondPart*10+current->digitValue();
+        ++current;
+    }
+    //You can never find a second more than 59.
+    if(current==secondStart || current-secondStart>2 || secondPart>59)
+    {
+        return false;
+    }
+    //Parse the fraction part.
+    if(current<end)
+    {
+        if(current->unicode()!='.' && current->unicode()!=':')
+        {
+            return false;
+        }
+        const QChar *fractionStart=++current;
+        int scale=100;
+        while(current<end && current->isDigit())
+        {
+            //Only the first three digits is used.
+            millisecondPart+=current->digitValue()*scale;
+            scale/=10;
+            ++current;
+        }
+        if(current==fractionStart || current!=end)
+        {
+            return false;
+        }
     }
-    LRCFrame currentFrame;
-    currentFrame.position=testData.toLongLong()*60000+
-            frameData.mid(colonPos+1, secondChar-colonPos-1).toLongLong()*1000+
-            frameData.mid(secondChar+1).toLongLong()*10;
-    currentFrame.text=lineData;
-    lyricsData.append(currentFrame);
+    position=minutePart*60000+secondPart*1000+millisecondPart;
+    return true;
 }
 
 bool KNMusicLRCParser::frameLessThan(const LRCFrame &frameLeft,
@@ -18,9 +18,9 @@
 #ifndef KNMUSICLRCPARSER_H
 #define KNMUSICLRCPARSER_H
 
-#include <QRegularExpression>
 #include <QMap>
 #include <QList>
+#include <QStringList>
 
 #include <QObject>
 
@@ -47,24 +47,33 @@ class KNMusicLRCParser : public QObject
     Q_OBJECT
 public:
     explicit KNMusicLRCParser(QObject *parent = 0);
-    QList<qint64> positions() const;
+    bool parseData(const QString &lyricsTextData,
+                   QMap<int, QString> &properties,
+                   QList<qint64> &positions,
+                   QStringList &lyricsText);
 
 signals:
 
 public slots:
-    void parseFile(const QString &filePath,
+    bool parseFile(const QString &filePath,
                    QMap<int, QString> &properties,
                    QList<qint64> &positions,
                    QStringList &lyricsText);
 
 private:
-    void parseFrame(const QString &frame,
-                    const QString &lineData,
-                    QList<LRCFrame> &lyricsData,
-                    QMap<int, QString> &properties);
+    inline void parseHeader(const QChar *begin,
+                            const QChar *end,
+                            QMap<int, QString> &properties,
+                            qint64 &offset);
+    inline void flushFrames(QList<qint64> &pendingFrames,
+                            QString &lineText,
+                            QList<LRCFrame> &lyricsData,
+                            bool &sorted);
+    static bool parseTime(const QChar *begin,
+                          const QChar *end,
+                          qint64 &position);
     static bool frameLessThan(const LRCFrame &frameLeft,
                               const LRCFrame &frameRight);
-    QRegularExpression m_frameCatch;
     QStringList m_headerText;
     QTextCodec *m_utf8Codec, *m_localeCodec;
 };
@@ -17,54 +17,119 @@
  */
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QEventLoop>
 #include <QTimer>
 
-#include "knconnectionhandler.h"
-
 #include "knmusiclyricsdownloader.h"
 
+//Waiting for 5 seconds for each request.
+#define RequestTimeout 5000
+
 KNMusicLyricsDownloader::KNMusicLyricsDownloader(QObject *parent) :
     QObject(parent)
 {
-    //Initial the network access manager.
-    m_networkManager=new QNetworkAccessManager(this);
-    //Initial the timer.
-    m_timeout=new QTimer(this);
-    m_timeout->setSingleShot(true);
-    //Waiting for 5 seconds.
-    m_timeout->setInterval(5000);
+    ;
+}
+
+void KNMusicLyricsDownloader::setNetworkManager(QNetworkAccessManager *networkManager)
+{
+    //Cancel all the requests of the previous manager.
+    cancel();
+    m_networkManager=networkManager;
+}
+
+bool KNMusicLyricsDownloader::isRunning() const
+{
+    return !m_replies.isEmpty();
+}
+
+void KNMusicLyricsDownloader::downloadLyrics(const KNMusicDetailInfo &detailInfo)
+{
+    //Cancel the previous searching.
+    cancel();
+    //Save the detail info, and start to search.
+    m_detailInfo=detailInfo;
+    search(m_detailInfo);
+    //If there's no request sent, it's finished.
+    if(m_replies.isEmpty())
+    {
+        emit finished();
+    }
+}
+
+void KNMusicLyricsDownloader::cancel()
+{
+    //Take all the running replies.
+    QList<QNetworkReply *> replies=m_replies.keys();
+    m_replies.clear();
+    //Abort the replies, the reply shouldn't be processed any more.
+    for(QList<QNetworkReply *>::iterator i=replies.begin();
+        i!=replies.end();
+        ++i)
+    {
+        disconnect(*i, 0, this, 0);
+        (*i)->abort();
+        (*i)->deleteLater();
+    }
 }
 
 void KNMusicLyricsDownloader::get(const QString &url,
-                                  QByteArray &responseData,
+                                  const int &step,
+                                  const QVariant &user,
                                   const QVariant &cookie,
                                   const QString &referer)
 {
-    networkProcess(Get, url, responseData, QByteArray(), cookie, referer);
+    networkProcess(Get, url, QByteArray(), step, user, cookie, referer);
 }
 
 void KNMusicLyricsDownloader::post(const QString &url,
-                                   QByteArray &responseData,
                                    const QByteArray &parameter,
+                                   const int &step,
+                                   const QVariant &user,
                                    const QVariant &cookie,
                                    const QString &referer)
 {
-    networkProcess(Post, url, responseData, parameter, cookie, referer);
+    networkProcess(Post, url, parameter, step, user, cookie, referer);
+}
+
+void KNMusicLyricsDownloader::onActionReplyFinished()
+{
+    //Find the request of the reply.
+    QNetworkReply *currentReply=static_cast<QNetworkReply *>(sender());
+    if(!m_replies.contains(currentReply))
+    {
+        return;
+    }
+    ReplyInfo replyInfo=m_replies.take(currentReply);
+    //Get the data, a timeout or failed request gives an empty response.
+    QByteArray responseData;
+    if(currentReply->error()==QNetworkReply::NoError)
+    {
+        responseData=currentReply->readAll();
+    }
+    //Clear the reply.
+    currentReply->deleteLater();
+    //Process the response data.
+    processReply(replyInfo.step, responseData, replyInfo.user);
+    //Check whether there's still any request running.
+    if(m_replies.isEmpty())
+    {
+        emit finished();
+    }
 }
 
 inline void KNMusicLyricsDownloader::networkProcess(int type,
                                                     const QString &url,
-                                                    QByteArray &responseData,
                                                     const QByteArray &parameter,
+                                                    const int &step,
+                                                    const QVariant &user,
                                                     const QVariant &cookie,
                                                     const QString &referer)
 {
-    //Stop the timer.
-    m_timeout->stop();
-    //Clear the data first.
-    responseData.clear();
-    m_networkManager->clearAccessCache();
+    //Check the network manager.
+    if(m_networkManager==nullptr)
+    {
+        return;
+    }
     //Generate the request.
     QNetworkRequest currentRequest;
     //Set the data to request.
@@ -79,17 +144,8 @@ inline void KNMusicLyricsDownloader::networkProcess(int type,
         currentRequest.setRawHeader("Referer", referer.toStdString().data());
         currentRequest.setRawHeader("Origin", referer.toStdString().data());
     }
-    //Generate the reply and quit handler.
+    //Send the request.
     QNetworkReply *currentReply=nullptr;
-    KNConnectionHandler quiterHandle;
-    //Wait for response, using the event loop, generate the loop.
-    QEventLoop stuckWaitingLoop;
-    //Link the finished and timeout counter to quit loop.
-    quiterHandle+=connect(m_networkManager, SIGNAL(finished(QNetworkReply*)),
-                          &stuckWaitingLoop, SLOT(quit()));
-    quiterHandle+=connect(m_timeout, SIGNAL(timeout()),
-                          &stuckWaitingLoop, SLOT(quit()));
-    //Do GET.
     switch(type)
     {
     case Post:
@@ -107,19 +163,14 @@ inline void KNMusicLyricsDownloader::networkProcess(int type,
         break;
     }
     }
-    //Start counting.
-    m_timeout->start();
-    //Start loop.
-    stuckWaitingLoop.exec();
-    //Disconnect all the links.
-    quiterHandle.disconnectAll();
-    //Check if there's reply.
-    if(currentReply==nullptr)
-    {
-        return;
-    }
-    //Get the data.
-    responseData=currentReply->readAll();
-    //Clear the reply.
-    delete currentReply;
+    //Save the reply info.
+    ReplyInfo replyInfo;
+    replyInfo.step=step;
+    replyInfo.user=user;
+    m_replies.insert(currentReply, replyInfo);
+    connect(currentReply, SIGNAL(finished()),
+            this, SLOT(onActionReplyFinished()));
+    //Abort the reply when it's timeout, the timer will be removed with the
+    //reply.
+    QTimer::singleShot(RequestTimeout, currentReply, SLOT(abort()));
 }
@@ -21,6 +21,8 @@
 #include "knglobal.h"
 #include "knmusicglobal.h"
 
+#include <QHash>
+
 #include <QObject>
 
 namespace KNMusicLyricsData
@@ -38,7 +40,6 @@ struct KNMusicLyricsDetails
 using namespace KNMusic;
 using namespace KNMusicLyricsData;
 
-class QTimer;
 class QNetworkReply;
 class QNetworkAccessManager;
 class KNMusicLyricsDownloader : public QObject
@@ -47,14 +48,30 @@ class KNMusicLyricsDownloader : public QObject
 public:
     explicit KNMusicLyricsDownloader(QObject *parent = 0);
     virtual QString downloaderName()=0;
-    virtual void downloadLyrics(const KNMusicDetailInfo &detailInfo,
-                                QList<KNMusicLyricsDetails> &lyricsList)=0;
+    void setNetworkManager(QNetworkAccessManager *networkManager);
+    bool isRunning() const;
 
 signals:
+    void lyricsDownloaded(const KNMusicLyricsDetails &lyricsDetails);
+    void finished();
 
 public slots:
+    void downloadLyrics(const KNMusicDetailInfo &detailInfo);
+    void cancel();
 
 protected:
+    //Start to search the lyrics. All the requests should be sent via get() and
+    //post(), the response will be given back to processReply() with the step
+    //and the user data of the request. When there's no running request, the
+    //finished() signal will be emitted.
+    virtual void search(const KNMusicDetailInfo &detailInfo)=0;
+    virtual void processReply(const int &step,
+                              const QByteArray &responseData,
+                              const QVariant &user)=0;
+    const KNMusicDetailInfo &detailInfo() const
+    {
+        return m_detailInfo;
+    }
     inline QString processKeywords(QString str)
     {
         //Clear some no used words. I don't know how these regexp works.
@@ -69,12 +86,14 @@ protected:
         return str;
     }
     void get(const QString &url,
-             QByteArray &responseData,
+             const int &step,
+             const QVariant &user=QVariant(),
              const QVariant &cookie=QVariant(),
              const QString &referer=QString());
     void post(const QString &url,
-              QByteArray &responseData,
               const QByteArray &parameter,
+              const int &step,
+              const QVariant &user=QVariant(),
               const QVariant &cookie=QVariant(),
               const QString &referer=QString());
     inline void saveLyrics(const KNMusicDetailInfo &detailInfo,
@@ -88,20 +107,30 @@ protected:
         currentDetails.lyricsData=lyricsContent;
     }
 
+private slots:
+    void onActionReplyFinished();
+
 private:
     enum NetworkProcessType
     {
         Post,
         Get
     };
+    struct ReplyInfo
+    {
+        int step;
+        QVariant user;
+    };
     inline void networkProcess(int type,
                                const QString &url,
-                               QByteArray &responseData,
                                const QByteArray &parameter,
+                               const int &step,
+                               const QVariant &user,
                                const QVariant &cookie,
                                const QString &referer);
-    QNetworkAccessManager *m_networkManager;
-    QTimer *m_timeout;
+    QHash<QNetworkReply *, ReplyInfo> m_replies;
+    KNMusicDetailInfo m_detailInfo;
+    QNetworkAccessManager *m_networkManager=nullptr;
 };
 
 #endif // KNMUSICLYRICSDOWNLOADER_H
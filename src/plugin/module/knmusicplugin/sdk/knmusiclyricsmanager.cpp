@@ -15,7 +15,9 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
+#include <QDateTime>
 #include <QFileInfo>
+#include <QNetworkAccessManager>
 #include <QTextStream>
 #include <QTextCodec>
 
@@ -34,6 +36,10 @@ KNMusicLyricsManager::KNMusicLyricsManager(QObject *parent) :
     //Initial the LRC lyrics parser and utf-8 codec.
     m_parser=new KNMusicLRCLyricsParser(this);
     m_utf8Codec=QTextCodec::codecForName("UTF-8");
+    //Initial the network access manager shared by all the downloaders.
+    m_networkManager=new QNetworkAccessManager(this);
+    //Keep the latest 64 online lyrics result.
+    m_lyricsCache.setMaxCost(64);
     //Set the default lyrics directory path.
     setLyricsDir(KNMusicGlobal::musicLibraryPath()+"/Lyrics");
     //Set the default loading policy.
@@ -61,6 +67,12 @@ void KNMusicLyricsManager::installLyricsDownloader(KNMusicLyricsDownloader *down
 {
     //Move the downloader to manager threads.
     downloader->moveToThread(thread());
+    //All the downloaders send the requests via the same network manager.
+    downloader->setNetworkManager(m_networkManager);
+    connect(downloader, &KNMusicLyricsDownloader::lyricsDownloaded,
+            this, &KNMusicLyricsManager::onActionLyricsDownloaded);
+    connect(downloader, &KNMusicLyricsDownloader::finished,
+            this, &KNMusicLyricsManager::onActionDownloaderFinished);
     //Add to downloader list.
     m_downloaders.append(downloader);
 }
@@ -78,6 +90,8 @@ QList<qint64> KNMusicLyricsManager::positionList() const
 void KNMusicLyricsManager::loadLyrics(const KNMusicAnalysisItem &analysisItem)
 {
     const KNMusicDetailInfo &detailInfo=analysisItem.detailInfo;
+    //Stop downloading the lyrics of the previous song.
+    cancelDownload();
     //Clear the current data of the lyrics.
     clearCurrentData();
     //Find the lyrics at local folder.
@@ -97,44 +111,134 @@ void KNMusicLyricsManager::loadLyrics(const KNMusicAnalysisItem &analysisItem)
 
 void KNMusicLyricsManager::downloadLyrics(const KNMusicDetailInfo &detailInfo)
 {
-    //Using all downloaders to download the lyrics.
-    QList<KNMusicLyricsDetails> lyricsList;
+    //Stop the previous downloading.
+    cancelDownload();
+    m_downloadDetailInfo=detailInfo;
+    //Check the result cache first.
+    LyricsCacheItem *cacheItem=m_lyricsCache.object(lyricsCacheKey(detailInfo));
+    if(cacheItem!=nullptr)
+    {
+        if(!cacheItem->lyricsData.isEmpty())
+        {
+            //Use the cached lyrics.
+            applyDownloadedLyrics(cacheItem->lyricsData);
+            return;
+        }
+        //We know there's no lyrics for this song recently.
+        if(cacheItem->expireTime>QDateTime::currentMSecsSinceEpoch())
+        {
+            return;
+        }
+    }
+    //Using all downloaders to download the lyrics at the same time.
+    m_runningDownloaders=m_downloaders.size();
     for(QLinkedList<KNMusicLyricsDownloader *>::iterator i=m_downloaders.begin();
         i!=m_downloaders.end();
         ++i)
     {
         //Try to download the lyrics from all the remote server.
-        (*i)->downloadLyrics(detailInfo, lyricsList);
+        (*i)->downloadLyrics(detailInfo);
+    }
+}
+
+void KNMusicLyricsManager::onActionLyricsDownloaded(
+        const KNMusicLyricsDetails &lyricsDetails)
+{
+    //Ignore the lyrics downloaded after the downloading is stopped.
+    if(m_runningDownloaders==0)
+    {
+        return;
     }
-    //Check the lyrics list.
-    if(lyricsList.isEmpty())
+    //When the title is exactly the same, use the first lyrics which can be
+    //parsed, and stop the other downloaders.
+    if(lyricsDetails.titleSimilarity==0 &&
+            applyDownloadedLyrics(lyricsDetails.lyricsData))
+    {
+        //Save the current data to a file.
+        saveLyrics(m_downloadDetailInfo, lyricsDetails.lyricsData);
+        cacheLyrics(lyricsDetails.lyricsData);
+        cancelDownload();
+        return;
+    }
+    //Or else keep the lyrics, until all the downloaders are finished.
+    m_downloadedLyrics.append(lyricsDetails);
+}
+
+void KNMusicLyricsManager::onActionDownloaderFinished()
+{
+    //Check whether all the downloaders are finished.
+    if(m_runningDownloaders==0 || --m_runningDownloaders>0)
     {
         return;
     }
     //Sort the list according to the similarity of the lyrics.
-    qSort(lyricsList.begin(), lyricsList.end(), lyricsDetailLessThan);
+    qSort(m_downloadedLyrics.begin(),
+          m_downloadedLyrics.end(),
+          lyricsDetailLessThan);
     //Parse all the data from the top to the bottom, save the first lyrics which
     //can be parsed.
-    QList<qint64> positionList;
-    QStringList textList;
-    for(QList<KNMusicLyricsDetails>::iterator i=lyricsList.begin();
-        i!=lyricsList.end();
+    for(QList<KNMusicLyricsDetails>::iterator i=m_downloadedLyrics.begin();
+        i!=m_downloadedLyrics.end();
         ++i)
     {
-        if(m_parser->parseData((*i).lyricsData, positionList, textList))
+        if(applyDownloadedLyrics((*i).lyricsData))
         {
             //Save the current data to a file.
-            saveLyrics(detailInfo, (*i).lyricsData);
-            //Save the position and text list.
-            m_positionList=positionList;
-            m_textList=textList;
-            //Save the detail info.
-            m_musicDetailInfo=detailInfo;
-            //Ask to update lyrics for datas.
-            emit lyricsUpdate();
+            saveLyrics(m_downloadDetailInfo, (*i).lyricsData);
+            cacheLyrics((*i).lyricsData);
+            m_downloadedLyrics.clear();
             return;
         }
     }
+    //No lyrics can be found.
+    cacheLyrics(QString());
+    m_downloadedLyrics.clear();
+}
+
+inline void KNMusicLyricsManager::cancelDownload()
+{
+    //Reset the running counter first, all the results will be ignored.
+    m_runningDownloaders=0;
+    m_downloadedLyrics.clear();
+    //Abort all the requests.
+    for(QLinkedList<KNMusicLyricsDownloader *>::iterator i=m_downloaders.begin();
+        i!=m_downloaders.end();
+        ++i)
+    {
+        (*i)->cancel();
+    }
+}
+
+inline bool KNMusicLyricsManager::applyDownloadedLyrics(const QString &lyricsData)
+{
+    QList<qint64> positionList;
+    QStringList textList;
+    if(!m_parser->parseData(lyricsData, positionList, textList))
+    {
+        return false;
+    }
+    //Save the position and text list.
+    m_positionList=positionList;
+    m_textList=textList;
+    //Save the detail info.
+    m_musicDetailInfo=m_downloadDetailInfo;
+    //Ask to update lyrics for datas.
+    emit lyricsUpdate();
+    return true;
+}
+
+inline void KNMusicLyricsManager::cacheLyrics(const QString &lyricsData)
+{
+    LyricsCacheItem *cacheItem=new LyricsCacheItem;
+    cacheItem->lyricsData=lyricsData;
+    //Try to search the song again 10 minutes later.
+    cacheItem->expireTime=QDateTime::currentMSecsSinceEpoch()+600000;
+    m_lyricsCache.insert(lyricsCacheKey(m_downloadDetailInfo), cacheItem);
+}
+
+inline QString KNMusicLyricsManager::lyricsCacheKey(const KNMusicDetailInfo &detailInfo)
+{
+    return detailInfo.textLists[Artist]+'\n'+detailInfo.textLists[Name];
 }
 
 inline void KNMusicLyricsManager::clearCurrentData()
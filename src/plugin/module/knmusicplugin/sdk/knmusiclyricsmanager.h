@@ -18,6 +18,7 @@
 #ifndef KNMUSICLYRICSMANAGER_H
 #define KNMUSICLYRICSMANAGER_H
 
+#include <QCache>
 #include <QLinkedList>
 
 #include "knmusicglobal.h"
@@ -27,6 +28,7 @@
 
 using namespace KNMusic;
 
+class QNetworkAccessManager;
 class KNMusicLRCLyricsParser;
 class KNMusicLyricsManager : public QObject
 {
@@ -57,6 +59,10 @@ public slots:
     void loadLyrics(const KNMusicAnalysisItem &analysisItem);
     void downloadLyrics(const KNMusicDetailInfo &detailInfo);
 
+private slots:
+    void onActionLyricsDownloaded(const KNMusicLyricsDetails &lyricsDetails);
+    void onActionDownloaderFinished();
+
 private:
     enum SearchPolicy
     {
@@ -86,6 +92,12 @@ private:
 
     inline void saveLyrics(const KNMusicDetailInfo &detailInfo,
                            const QString &content);
+
+    //Online lyrics downloading.
+    inline void cancelDownload();
+    inline bool applyDownloadedLyrics(const QString &lyricsData);
+    inline void cacheLyrics(const QString &lyricsData);
+    inline QString lyricsCacheKey(const KNMusicDetailInfo &detailInfo);
     static bool lyricsDetailLessThan(const KNMusicLyricsDetails &lyricsDetailLeft,
                                      const KNMusicLyricsDetails &lyricsDetailRight);
 
@@ -102,6 +114,19 @@ private:
 
     //Lyrics downlaoders.
     QLinkedList<KNMusicLyricsDownloader *> m_downloaders;
+    QNetworkAccessManager *m_networkManager;
+    KNMusicDetailInfo m_downloadDetailInfo;
+    QList<KNMusicLyricsDetails> m_downloadedLyrics;
+    int m_runningDownloaders=0;
+
+    //Online lyrics result cache, the empty lyrics data means there's no lyrics
+    //found for the song, it will be expired after a while.
+    struct LyricsCacheItem
+    {
+        QString lyricsData;
+        qint64 expireTime;
+    };
+    QCache<QString, LyricsCacheItem> m_lyricsCache;
 
     //Lyrics directory path.
     QString m_lyricsDir;
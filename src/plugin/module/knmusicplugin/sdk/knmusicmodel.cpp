@@ -5,7 +5,6 @@
  * as published by Sam Hocevar. See the COPYING file for more details.
  */
 #include <QMimeData>
-#include <QLinkedList>
 
 #include "knglobal.h"
 
@@ -14,6 +13,7 @@
 #include "knmusicanalysiscache.h"
 #include "knmusicanalysisextend.h"
 #include "knmusicratingdelegate.h"
+#include "knmusicrowmimedata.h"
 
 #include "knmusicmodel.h"
 
@@ -39,8 +39,12 @@ KNMusicModel::KNMusicModel(QObject *parent) :
     m_analysisCache->moveToThread(m_musicGlobal->analysisThread());
     connect(m_searcher, &KNMusicSearcher::fileFound,
             m_analysisCache, &KNMusicAnalysisCache::appendFilePath);
-    connect(m_analysisCache, &KNMusicAnalysisCache::requireAppendRow,
-            this, &KNMusicModel::appendMusicRow);
+    connect(m_analysisCache, &KNMusicAnalysisCache::requireAppendRows,
+            this, &KNMusicModel::appendMusicRows);
+    connect(this, &KNMusicModel::requireReanalysisRows,
+            m_analysisCache, &KNMusicAnalysisCache::reanalysisRows);
+    connect(m_analysisCache, &KNMusicAnalysisCache::reanalysisComplete,
+            this, &KNMusicModel::onActionReanalysisComplete);
 
     //Initial a default analysis extend.
     setAnalysisExtend(new KNMusicAnalysisExtend);
@@ -94,56 +98,53 @@ bool KNMusicModel::dropMimeData(const QMimeData *data,
     //When mimedata contains url data, and ensure that move&copy action enabled.
     if((action==Qt::MoveAction || action==Qt::CopyAction))
     {
-        //Internal movment.
-        if(data->hasFormat(QLatin1String("application/x-qstandarditemmodeldatalist")) &&
-                data->data("org.kreogist.mu.musicmodel").toLongLong()==(qint64)this)
+        //Check whether the rows are dragged from a model in Mu.
+        const KNMusicRowMimeData *rowMimeData=
+                qobject_cast<const KNMusicRowMimeData *>(data);
+        if(rowMimeData!=nullptr && rowMimeData->musicModel()!=nullptr)
         {
-            QLinkedList<QPersistentModelIndex> originalRowList;
-            //Get how many rows.
-            int movedRowCount=data->data("org.kreogist.mu.musicmodelrowsize").toInt();
-            QByteArray rowListData=data->data("org.kreogist.mu.musicmodelrows");
-            QDataStream rowListStream(&rowListData, QIODevice::ReadOnly);
-            int currentRow;
-            for(int i=0; i<movedRowCount; i++)
+            //Internal movment.
+            if(rowMimeData->musicModel()==this)
             {
-                //Get the current row.
-                rowListStream >> currentRow;
-                //Generate the tracking row.
-                originalRowList.append(QPersistentModelIndex(index(currentRow, Name)));
-            }
-            //Use the default drop
-            bool moveResult=QStandardItemModel::dropMimeData(data, Qt::CopyAction, row, column, parent);
-            //Remove the original row.
-            while(!originalRowList.isEmpty())
-            {
-                removeRow(originalRowList.takeFirst().row());
+                //Track the original rows.
+                QVector<int> rows=rowMimeData->rows();
+                QList<QPersistentModelIndex> originalRowList;
+                originalRowList.reserve(rows.size());
+                for(QVector<int>::iterator i=rows.begin(); i!=rows.end(); ++i)
+                {
+                    originalRowList.append(QPersistentModelIndex(index(*i, Name)));
+                }
+                //Copy the rows to the new position.
+                insertMusicRows(row, rowMimeData->musicRows());
+                //Remove the original rows.
+                QList<int> originalRows;
+                originalRows.reserve(originalRowList.size());
+                for(QList<QPersistentModelIndex>::iterator i=originalRowList.begin();
+                    i!=originalRowList.end();
+                    ++i)
+                {
+                    originalRows.append((*i).row());
+                }
+                removeRowList(originalRows);
+                return true;
             }
-            //Though the rowCount shouldn't change here. But we can use this
-            //signal to save the data.
-            emit rowCountChanged();
-            return moveResult;
+            //Copy the rows from another model.
+            insertMusicRows(row, rowMimeData->musicRows());
+            return true;
         }
+        //The rows from another Mu.
         if(data->hasFormat("org.kreogist.mu.musicrowlist"))
         {
             QJsonArray rowArray=KNMusicModelAssist::byteDataToJsonArray(data->data("org.kreogist.mu.musicrowlist"));
-            if(row==-1)
+            QList<QList<QStandardItem *> > musicRows;
+            musicRows.reserve(rowArray.size());
+            for(QJsonArray::iterator i=rowArray.begin();
+                i!=rowArray.end();
+                ++i)
             {
-                for(QJsonArray::iterator i=rowArray.begin();
-                    i!=rowArray.end();
-                    ++i)
-                {
-                    appendMusicRow(KNMusicModelAssist::generateRow((*i).toArray()));
-                }
-            }
-            else
-            {
-                for(QJsonArray::iterator i=rowArray.end();
-                    i!=rowArray.begin();
-                    --i)
-                {
-                    insertMusicRow(row, KNMusicModelAssist::generateRow((*i).toArray()));
-                }
+                musicRows.append(KNMusicModelAssist::generateRow((*i).toArray()));
             }
+            insertMusicRows(row, musicRows);
             return true;
         }
         if(data->hasUrls())
@@ -172,6 +173,7 @@ KNMusicDetailInfo KNMusicModel::detailInfoFromRow(const int &row)
     detailInfo.fileName=rowProperty(row, FileNameRole).toString();
     detailInfo.filePath=rowProperty(row, FilePathRole).toString();
     detailInfo.trackFilePath=rowProperty(row, TrackFileRole).toString();
+    detailInfo.trackIndex=rowProperty(row, TrackIndexRole).toInt();
     detailInfo.coverImageHash=rowProperty(row, ArtworkKeyRole).toString();
     detailInfo.startPosition=rowProperty(row, StartPositionRole).toLongLong();
     detailInfo.size=roleData(row, Size, Qt::UserRole).toLongLong();
@@ -181,6 +183,8 @@ KNMusicDetailInfo KNMusicModel::detailInfoFromRow(const int &row)
     detailInfo.duration=roleData(row, Time, Qt::UserRole).toLongLong();
     detailInfo.bitRate=roleData(row, BitRate, Qt::UserRole).toLongLong();
     detailInfo.samplingRate=roleData(row, SampleRate, Qt::UserRole).toLongLong();
+    detailInfo.trackGain=roleData(row, TrackGain, Qt::UserRole).toDouble();
+    detailInfo.albumGain=roleData(row, AlbumGain, Qt::UserRole).toDouble();
     detailInfo.rating=roleData(row, Size, Qt::DisplayRole).toInt();
     //Return the detail info.
     return detailInfo;
@@ -206,6 +210,48 @@ int KNMusicModel::playingItemColumn()
     return Name;
 }
 
+int KNMusicModel::rowFromTrackId(const quint32 &trackId)
+{
+    Q_UNUSED(trackId)
+    //Only the library gives out the track id, a normal model can't find it.
+    return -1;
+}
+
+void KNMusicModel::reanalysisRows(const QList<QPersistentModelIndex> &indexes)
+{
+    //Generate the reanalysis items, they will be analysised in the analysis
+    //thread, and the rows will be updated when the results come back.
+    QList<KNMusicReanalysisItem> reanalysisItems;
+    reanalysisItems.reserve(indexes.size());
+    for(QList<QPersistentModelIndex>::const_iterator i=indexes.constBegin();
+        i!=indexes.constEnd();
+        ++i)
+    {
+        if(!(*i).isValid() || (*i).model()!=this)
+        {
+            continue;
+        }
+        int row=(*i).row();
+        //Only the file information is needed to analysis the row.
+        KNMusicReanalysisItem reanalysisItem;
+        KNMusicDetailInfo &detailInfo=reanalysisItem.analysisItem.detailInfo;
+        detailInfo.filePath=rowProperty(row, FilePathRole).toString();
+        detailInfo.trackFilePath=rowProperty(row, TrackFileRole).toString();
+        detailInfo.trackIndex=rowProperty(row, TrackIndexRole).toInt();
+        detailInfo.startPosition=rowProperty(row, StartPositionRole).toLongLong();
+        //Keep the row reference in the model, the analysis thread only use the
+        //id of the reference.
+        reanalysisItem.rowId=++m_reanalysisId;
+        m_reanalysisIndexes.insert(reanalysisItem.rowId,
+                                   QPersistentModelIndex(index(row, Name)));
+        reanalysisItems.append(reanalysisItem);
+    }
+    if(!reanalysisItems.isEmpty())
+    {
+        emit requireReanalysisRows(reanalysisItems);
+    }
+}
+
 void KNMusicModel::addFiles(const QStringList &fileList)
 {
     emit requireAnalysisFiles(fileList);
@@ -233,6 +279,51 @@ void KNMusicModel::insertMusicRow(const int &row, const QList<QStandardItem *> &
     emit rowCountChanged();
 }
 
+void KNMusicModel::appendMusicRows(const QList<QList<QStandardItem *> > &musicRows)
+{
+    insertMusicRows(rowCount(), musicRows);
+}
+
+void KNMusicModel::insertMusicRows(int row,
+                                   const QList<QList<QStandardItem *> > &musicRows)
+{
+    if(musicRows.isEmpty())
+    {
+        return;
+    }
+    //Check the row, -1 means append the rows.
+    if(row<0 || row>rowCount())
+    {
+        row=rowCount();
+    }
+    if(columnCount()<MusicDataCount)
+    {
+        setColumnCount(MusicDataCount);
+    }
+    //Insert all the blank rows at once, the views will only be told once.
+    insertRows(row, musicRows.size());
+    //Fill the blank rows. Block the item changed signals of every single item,
+    //and tell the views the whole range has been changed at last.
+    bool signalBlocked=blockSignals(true);
+    for(int i=0; i<musicRows.size(); i++)
+    {
+        const QList<QStandardItem *> &musicRow=musicRows.at(i);
+        //Clear all the icons.
+        musicRow.at(Name)->setData(QPixmap(), Qt::DecorationRole);
+        //Calculate new total duration.
+        m_totalDuration+=musicRow.at(Time)->data(Qt::UserRole).toInt();
+        //Set the items.
+        for(int j=0; j<musicRow.size(); j++)
+        {
+            setItem(row+i, j, musicRow.at(j));
+        }
+    }
+    blockSignals(signalBlocked);
+    emit dataChanged(index(row, 0),
+                     index(row+musicRows.size()-1, columnCount()-1));
+    emit rowCountChanged();
+}
+
 void KNMusicModel::updateMusicRow(const int &row,
                                   const KNMusicAnalysisItem &analysisItem)
 {
@@ -246,6 +337,21 @@ void KNMusicModel::updateMusicRow(const int &row,
         case AlbumRating:
         case DateAdded:
         case Plays:
+        //The gains are scanned from the audio data, not the tags.
+        case TrackGain:
+        case AlbumGain:
+            break;
+        //The tempo and the key are detected from the audio data when the tags
+        //don't have them.
+        case BeatsPerMinuate:
+            updateItemText(row, i, detailInfo.textLists[i].isEmpty()?
+                               KNMusicGlobal::tempoToString(roleData(row, i, Qt::UserRole).toDouble()):
+                               detailInfo.textLists[i]);
+            break;
+        case MusicalKey:
+            updateItemText(row, i, detailInfo.textLists[i].isEmpty()?
+                               roleData(row, i, Qt::UserRole).toString():
+                               detailInfo.textLists[i]);
             break;
         default:
             updateItemText(row, i, detailInfo.textLists[i]);
@@ -286,6 +392,27 @@ void KNMusicModel::clearMusicRow()
     emit rowCountChanged();
 }
 
+inline void KNMusicModel::removeRowList(QList<int> rows)
+{
+    //Remove the rows from the bottom to the top, the continuous rows will be
+    //removed together.
+    qSort(rows.begin(), rows.end(), qGreater<int>());
+    int i=0;
+    while(i<rows.size())
+    {
+        int lastRow=rows.at(i), firstRow=lastRow;
+        m_totalDuration-=data(index(firstRow, Time), Qt::UserRole).toInt();
+        while(++i<rows.size() && rows.at(i)==firstRow-1)
+        {
+            firstRow=rows.at(i);
+            m_totalDuration-=data(index(firstRow, Time), Qt::UserRole).toInt();
+        }
+        removeRows(firstRow, lastRow-firstRow+1);
+    }
+    //Tell other's to update.
+    emit rowCountChanged();
+}
+
 void KNMusicModel::blockAddFile(const QString &filePath)
 {
     //WARNING: This function is working in a block way to adding file, may cause
@@ -303,8 +430,11 @@ void KNMusicModel::setHeaderSortFlag()
     setHeaderData(DiscCount, Qt::Horizontal, SortByInt, Qt::UserRole);
     setHeaderData(TrackNumber, Qt::Horizontal, SortByInt, Qt::UserRole);
     setHeaderData(TrackCount, Qt::Horizontal, SortByInt, Qt::UserRole);
+    setHeaderData(BeatsPerMinuate, Qt::Horizontal, SortByInt, Qt::UserRole);
     setHeaderData(Size, Qt::Horizontal, SortUserByInt, Qt::UserRole);
     setHeaderData(BitRate, Qt::Horizontal, SortUserByFloat, Qt::UserRole);
+    setHeaderData(TrackGain, Qt::Horizontal, SortUserByFloat, Qt::UserRole);
+    setHeaderData(AlbumGain, Qt::Horizontal, SortUserByFloat, Qt::UserRole);
     setHeaderData(DateAdded, Qt::Horizontal, SortUserByDate, Qt::UserRole);
     setHeaderData(DateModified, Qt::Horizontal, SortUserByDate, Qt::UserRole);
     setHeaderData(LastPlayed, Qt::Horizontal, SortUserByDate, Qt::UserRole);
@@ -320,8 +450,8 @@ void KNMusicModel::setAnalysisExtend(KNMusicAnalysisExtend *analysisExtend)
     if(m_analysisExtend!=nullptr)
     {
         //Disconnect the extended.
-        disconnect(m_analysisExtend, &KNMusicAnalysisExtend::requireAppendRow,
-                   this, &KNMusicModel::appendMusicRow);
+        disconnect(m_analysisExtend, &KNMusicAnalysisExtend::requireAppendRows,
+                   this, &KNMusicModel::appendMusicRows);
         //Clear the extend in analysis cache.
         m_analysisCache->setExtend(nullptr);
         //Recover the memory.
@@ -336,8 +466,8 @@ void KNMusicModel::setAnalysisExtend(KNMusicAnalysisExtend *analysisExtend)
     //Establish connections.
     if(m_analysisExtend!=nullptr)
     {
-        connect(m_analysisExtend, &KNMusicAnalysisExtend::requireAppendRow,
-                this, &KNMusicModel::appendMusicRow);
+        connect(m_analysisExtend, &KNMusicAnalysisExtend::requireAppendRows,
+                this, &KNMusicModel::appendMusicRows);
     }
 }
 
@@ -361,3 +491,24 @@ void KNMusicModel::onActionFileNameChanged(const QString &originalPath,
         setRowProperty(currentRow, FileNameRole, currentFileName);
     }
 }
+
+void KNMusicModel::onActionReanalysisComplete(const QList<KNMusicReanalysisItem> &reanalysisItems)
+{
+    for(QList<KNMusicReanalysisItem>::const_iterator i=reanalysisItems.constBegin();
+        i!=reanalysisItems.constEnd();
+        ++i)
+    {
+        //Take the row reference, the row may be removed while analysising.
+        QPersistentModelIndex rowIndex=m_reanalysisIndexes.take((*i).rowId);
+        if(!rowIndex.isValid())
+        {
+            continue;
+        }
+        if((*i).available)
+        {
+            updateMusicRow(rowIndex.row(), (*i).analysisItem);
+        }
+        //Give out the result, the cover image is only in the result.
+        emit rowReanalysised(rowIndex, *i);
+    }
+}
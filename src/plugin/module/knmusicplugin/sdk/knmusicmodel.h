@@ -7,6 +7,8 @@
 #ifndef KNMUSICMODEL_H
 #define KNMUSICMODEL_H
 
+#include <QHash>
+#include <QPersistentModelIndex>
 #include <QPixmap>
 #include <QStringList>
 
@@ -130,16 +132,24 @@ public:
     virtual QPixmap songAlbumArt(const int &row);
     qint64 songDuration(const int &row);
     virtual int playingItemColumn();
+    virtual int rowFromTrackId(const quint32 &trackId);
+    void reanalysisRows(const QList<QPersistentModelIndex> &indexes);
 
 signals:
     void rowCountChanged();
     void requireAnalysisFiles(QStringList urls);
+    void requireReanalysisRows(QList<KNMusicReanalysisItem> reanalysisItems);
+    void rowReanalysised(QPersistentModelIndex index,
+                         KNMusicReanalysisItem reanalysisItem);
 
 public slots:
     virtual void addFiles(const QStringList &fileList);
     virtual void appendMusicRow(const QList<QStandardItem *> &musicRow);
     virtual void insertMusicRow(const int &row,
                                 const QList<QStandardItem *> &musicRow);
+    virtual void appendMusicRows(const QList<QList<QStandardItem *> > &musicRows);
+    virtual void insertMusicRows(int row,
+                                 const QList<QList<QStandardItem *> > &musicRows);
     virtual void updateMusicRow(const int &row,
                                 const KNMusicAnalysisItem &analysisItem);
     virtual void removeMusicRow(const int &row);
@@ -155,12 +165,16 @@ private slots:
     void onActionFileNameChanged(const QString &originalPath,
                                  const QString &currentPath,
                                  const QString &currentFileName);
+    void onActionReanalysisComplete(const QList<KNMusicReanalysisItem> &reanalysisItems);
 
 private:
+    inline void removeRowList(QList<int> rows);
     KNMusicSearcher *m_searcher;
     KNMusicAnalysisCache *m_analysisCache;
     KNMusicAnalysisExtend *m_analysisExtend=nullptr;
     KNMusicGlobal *m_musicGlobal;
+    QHash<quint32, QPersistentModelIndex> m_reanalysisIndexes;
+    quint32 m_reanalysisId=0;
     qint64 m_totalDuration=0;
 };
 
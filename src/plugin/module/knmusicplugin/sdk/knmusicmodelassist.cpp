@@ -6,7 +6,6 @@
  */
 #include <QJsonDocument>
 
-#include "knmusicparser.h"
 #include "knmusicmodel.h"
 
 #include "knmusicmodelassist.h"
@@ -63,6 +62,18 @@ QList<QStandardItem *> KNMusicModelAssist::generateRow(const KNMusicDetailInfo &
     item->setEditable(true);
     item=musicRow.at(AlbumRating);
     item->setEditable(true);
+    item=musicRow.at(TrackGain);
+    item->setData(QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+    if(!detailInfo.textLists[TrackGain].isEmpty())
+    {
+        item->setData(detailInfo.trackGain, Qt::UserRole);
+    }
+    item=musicRow.at(AlbumGain);
+    item->setData(QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+    if(!detailInfo.textLists[AlbumGain].isEmpty())
+    {
+        item->setData(detailInfo.albumGain, Qt::UserRole);
+    }
     return musicRow;
 }
 
@@ -88,6 +99,18 @@ QList<QStandardItem *> KNMusicModelAssist::generateRow(const QJsonArray &itemDat
     item->setData(propertyArray.at(PropertyTrackIndex).toInt(), TrackIndexRole);
     item->setData(propertyArray.at(PropertyCoverImageHash).toString(), ArtworkKeyRole);
     item->setData(propertyArray.at(PropertyStartPosition).toString().toLongLong(), StartPositionRole);
+    item->setData(propertyArray.at(PropertyTrackId).toString().toUInt(), TrackIdRole);
+    //The rows from the old database don't have the fingerprint.
+    QString fingerprint=propertyArray.at(PropertyFingerprint).toString();
+    if(!fingerprint.isEmpty())
+    {
+        item->setData(QByteArray::fromBase64(fingerprint.toLatin1()),
+                      FingerprintRole);
+    }
+    //The row which has been scanned without a result shouldn't be scanned
+    //again.
+    item->setData(propertyArray.at(PropertyLoudnessScanned).toBool(),
+                  LoudnessScannedRole);
     item=musicRow.at(Size);
     item->setData(propertyArray.at(PropertySize).toString().toLongLong(), Qt::UserRole);
     item->setData(QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
@@ -112,6 +135,21 @@ QList<QStandardItem *> KNMusicModelAssist::generateRow(const QJsonArray &itemDat
     item->setEditable(true);
     item=musicRow.at(AlbumRating);
     item->setEditable(true);
+    item=musicRow.at(TrackGain);
+    item->setData(QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+    item->setData(KNMusicModelAssist::dataStringToGain(propertyArray.at(PropertyTrackGain).toString()),
+                  Qt::UserRole);
+    item=musicRow.at(AlbumGain);
+    item->setData(QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+    item->setData(KNMusicModelAssist::dataStringToGain(propertyArray.at(PropertyAlbumGain).toString()),
+                  Qt::UserRole);
+    //The detected tempo is saved in the same way as the gains, the key is
+    //only available when the tempo is.
+    item=musicRow.at(BeatsPerMinuate);
+    item->setData(KNMusicModelAssist::dataStringToGain(propertyArray.at(PropertyTempo).toString()),
+                  Qt::UserRole);
+    item=musicRow.at(MusicalKey);
+    item->setData(propertyArray.at(PropertyMusicalKey).toString(), Qt::UserRole);
     return musicRow;
 }
 
@@ -137,6 +175,13 @@ QJsonArray KNMusicModelAssist::rowToJsonArray(KNMusicModel *musicModel,
     propertyArray.append(musicModel->rowProperty(row, TrackFileRole).toString()); //PropertyTrackFilePath
     propertyArray.append(musicModel->rowProperty(row, TrackIndexRole).toInt()); //PropertyTrackIndex
     propertyArray.append(QString::number(musicModel->rowProperty(row, StartPositionRole).toLongLong())); //PropertyStartPosition
+    propertyArray.append(QString::number(musicModel->rowProperty(row, TrackIdRole).toUInt())); //PropertyTrackId
+    propertyArray.append(KNMusicModelAssist::gainToDataString(musicModel->roleData(row, TrackGain, Qt::UserRole))); //PropertyTrackGain
+    propertyArray.append(KNMusicModelAssist::gainToDataString(musicModel->roleData(row, AlbumGain, Qt::UserRole))); //PropertyAlbumGain
+    propertyArray.append(QString(musicModel->rowProperty(row, FingerprintRole).toByteArray().toBase64())); //PropertyFingerprint
+    propertyArray.append(KNMusicModelAssist::gainToDataString(musicModel->roleData(row, BeatsPerMinuate, Qt::UserRole))); //PropertyTempo
+    propertyArray.append(musicModel->roleData(row, MusicalKey, Qt::UserRole).toString()); //PropertyMusicalKey
+    propertyArray.append(musicModel->rowProperty(row, LoudnessScannedRole).toBool()); //PropertyLoudnessScanned
     itemDataArray.append(textInformationArray);
     itemDataArray.append(propertyArray);
     return itemDataArray;
@@ -147,58 +192,28 @@ QJsonArray KNMusicModelAssist::byteDataToJsonArray(const QByteArray &rowData)
     return QJsonDocument::fromBinaryData(rowData).array();
 }
 
-bool KNMusicModelAssist::reanalysisRow(KNMusicModel *musicModel,
-                                       const QPersistentModelIndex &index,
-                                       KNMusicAnalysisItem &analysisItem)
+int KNMusicModelAssist::trackListPosition(const QList<KNMusicAnalysisItem> &trackList,
+                                          int trackIndex)
 {
-    //Get the parser.
-    KNMusicParser *parser=KNMusicGlobal::parser();
-    //Get the file path.
-    QString musicFilePath=musicModel->rowProperty(index.row(),
-                                                  FilePathRole).toString();
-    //Check the start position role, if it is not -1, means it's a music file.
-    if(musicModel->rowProperty(index.row(),StartPositionRole).toLongLong()==-1)
-    {
-        //Parse the info.
-        parser->parseFile(musicFilePath, analysisItem);
-        parser->parseAlbumArt(analysisItem);
-        return true;
-    }
-    QList<KNMusicAnalysisItem> currentTrackInfo;
-    //Get the track number.
-    int currentTrackNumber=musicModel->rowProperty(index.row(),
-                                                   TrackIndexRole).toInt();
-    //Parse the list first.
-    parser->parseTrackList(musicModel->rowProperty(index.row(),
-                                                   TrackFileRole).toString(),
-                           currentTrackInfo);
     //No list parsed.
-    if(currentTrackInfo.isEmpty())
+    if(trackList.isEmpty())
     {
-        return false;
+        return -1;
     }
     //Check the beginning of the track list, if it's 0, means the track is indexed at:
     // 0 1 2 3 ...
     //Or else, it is start at 1, we need to reduce the track number.
-    if(currentTrackInfo.first().detailInfo.trackIndex!=0)
+    if(trackList.first().detailInfo.trackIndex!=0)
     {
-        currentTrackNumber--;
+        trackIndex--;
         //Still need to check the tracknumber.
-        if(currentTrackNumber<0)
+        if(trackIndex<0)
         {
-            currentTrackNumber=0;
+            trackIndex=0;
         }
     }
     //Check the size of the new track we get.
-    if(currentTrackInfo.size()>currentTrackNumber)
-    {
-        //Get the track number's current info.
-        analysisItem=currentTrackInfo.at(currentTrackNumber);
-        //Parse the album art.
-        parser->parseAlbumArt(analysisItem);
-        return true;
-    }
-    return false;
+    return trackList.size()>trackIndex?trackIndex:-1;
 }
 
 QString KNMusicModelAssist::dateTimeToString(const QDateTime &dateTime)
@@ -220,3 +235,14 @@ QDateTime KNMusicModelAssist::dataStringToDateTime(const QString &text)
 {
     return QDateTime::fromString(text, "yyyyMMddHHmmss");
 }
+
+QString KNMusicModelAssist::gainToDataString(const QVariant &gain)
+{
+    //The gain which hasn't been scanned is saved as an empty string.
+    return gain.isValid()?QString::number(gain.toDouble()):QString();
+}
+
+QVariant KNMusicModelAssist::dataStringToGain(const QString &text)
+{
+    return text.isEmpty()?QVariant():QVariant(text.toDouble());
+}
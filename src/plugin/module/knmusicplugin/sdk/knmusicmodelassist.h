@@ -28,13 +28,14 @@ public:
     static QString dateTimeToDataString(const QDateTime &dateTime);
     static QString dateTimeToDataString(const QVariant &dateTime);
     static QDateTime dataStringToDateTime(const QString &text);
+    static QString gainToDataString(const QVariant &gain);
+    static QVariant dataStringToGain(const QString &text);
     static QList<QStandardItem *> generateRow(const KNMusicDetailInfo &detailInfo);
     static QList<QStandardItem *> generateRow(const QJsonArray &itemDataArray);
     static QJsonArray rowToJsonArray(KNMusicModel *musicModel, const int &row);
     static QJsonArray byteDataToJsonArray(const QByteArray &rowData);
-    static bool reanalysisRow(KNMusicModel *musicModel,
-                              const QPersistentModelIndex &index,
-                              KNMusicAnalysisItem &analysisItem);
+    static int trackListPosition(const QList<KNMusicAnalysisItem> &trackList,
+                                 int trackIndex);
 
 signals:
 
@@ -4,20 +4,27 @@
  * terms of the Do What The Fuck You Want To Public License, Version 2,
  * as published by Sam Hocevar. See the COPYING file for more details.
  */
+#include <QDir>
 #include <QFile>
 #include <QDataStream>
 
 #include "knglobal.h"
+#include "kntrace.h"
 
 #include "knmusicparser.h"
 
 #include <QDebug>
 
+//The folders are listed one by one in a scan, only keep the recent folders.
+#define MaxCoverFolderCount 8
+
 KNMusicParser::KNMusicParser(QObject *parent) :
     QObject(parent)
 {
     m_global=KNGlobal::instance();
     m_musicGlobal=KNMusicGlobal::instance();
+    //The external image suffixes, ordered by the priority.
+    m_imageSuffixes<<"jpg"<<"png"<<"jpeg"<<"bmp";
 }
 
 KNMusicParser::~KNMusicParser()
@@ -36,6 +43,7 @@ KNMusicParser::~KNMusicParser()
 void KNMusicParser::parseFile(QString filePath,
                               KNMusicAnalysisItem &analysisItem)
 {
+    KNTraceScope("import", "KNMusicParser::parseFile");
     //Get the detail info.
     KNMusicDetailInfo &detailInfo=analysisItem.detailInfo;
     //Set the added date.
@@ -101,33 +109,14 @@ QString KNMusicParser::sampleRateText(const qint64 &sampleRateNumber)
 
 void KNMusicParser::parseAlbumArt(KNMusicAnalysisItem &analysisItem)
 {
-    //Using all the tag parser try to parse the album art.
-    for(auto i=m_tagParsers.begin();
-        i!=m_tagParsers.end();
-        ++i)
-    {
-        (*i)->parseAlbumArt(analysisItem);
-    }
-    if(analysisItem.coverImage.isNull())
-    {
-        //Try to find external images, here is the policy.
-        //  1. Find the same file name in the same folder.
-        QFileInfo musicFileInfo(analysisItem.detailInfo.filePath);
-        if(findImageFile(musicFileInfo.absolutePath()+"/"+
-                         musicFileInfo.completeBaseName(),
-                         analysisItem))
-        {
-            return;
-        }
-        //  2. Find the "cover" named image in the same folder.
-        if(findImageFile(musicFileInfo.absolutePath()+"/cover",
-                         analysisItem))
-        {
-            return;
-        }
-        //  3. Find the name contains "cover" in the same folder.
-        //!FIXME: add code here.
-    }
+    KNTraceScope("artwork", "KNMusicParser::parseAlbumArt");
+    parseAlbumArtImage(analysisItem, true);
+}
+
+void KNMusicParser::parseAlbumArtData(KNMusicAnalysisItem &analysisItem)
+{
+    //Only get the compressed album art data.
+    parseAlbumArtImage(analysisItem, false);
 }
 
 void KNMusicParser::parseTag(const QString &filePath,
@@ -144,6 +133,7 @@ void KNMusicParser::parseTag(const QString &filePath,
             i!=m_tagParsers.end();
             ++i)
         {
+            KNTraceScope("import", (*i)->metaObject()->className());
             musicFile.reset();
             (*i)->praseTag(musicFile, musicDataStream, analysisItem);
         }
@@ -240,6 +230,7 @@ void KNMusicParser::analysis(const QString &filePath,
         i!=m_analysisers.end();
         ++i)
     {
+        KNTraceScope("import", (*i)->metaObject()->className());
         if((*i)->analysis(filePath, detailInfo))
         {
             return;
@@ -247,23 +238,157 @@ void KNMusicParser::analysis(const QString &filePath,
     }
 }
 
-bool KNMusicParser::findImageFile(const QString &imageBaseFileName,
-                                  KNMusicAnalysisItem &analysisItem)
+void KNMusicParser::parseAlbumArtImage(KNMusicAnalysisItem &analysisItem,
+                                       bool decode)
+{
+    //Using all the tag parser try to parse the album art.
+    for(auto i=m_tagParsers.begin();
+        i!=m_tagParsers.end();
+        ++i)
+    {
+        (*i)->parseAlbumArt(analysisItem);
+    }
+    //Try to find external images.
+    if(analysisItem.coverImageData.isEmpty())
+    {
+        findImageFile(analysisItem, decode);
+        return;
+    }
+    //Decode the album art.
+    if(decode)
+    {
+        analysisItem.coverImage.loadFromData(analysisItem.coverImageData);
+    }
+}
+
+bool KNMusicParser::findImageFile(KNMusicAnalysisItem &analysisItem,
+                                  bool decode)
 {
-    return  checkImageFile(imageBaseFileName+".jpg", analysisItem) ||
-            checkImageFile(imageBaseFileName+".png", analysisItem) ||
-            checkImageFile(imageBaseFileName+".jpeg", analysisItem) ||
-            checkImageFile(imageBaseFileName+".bmp", analysisItem);
+    QFileInfo musicFileInfo(analysisItem.detailInfo.filePath);
+    QString folderPath=musicFileInfo.absolutePath();
+    QSharedPointer<KNMusicCoverFolder> folder=coverFolder(folderPath);
+    //Here is the policy.
+    //  1. Find the same file name in the same folder.
+    QString imageFileName=
+            folder->imageFiles.value(musicFileInfo.completeBaseName().toLower());
+    if(!imageFileName.isEmpty())
+    {
+        QFile imageFile(folderPath+"/"+imageFileName);
+        if(imageFile.open(QIODevice::ReadOnly))
+        {
+            analysisItem.coverImageData=imageFile.readAll();
+            imageFile.close();
+            if(decode)
+            {
+                analysisItem.coverImage.loadFromData(
+                            analysisItem.coverImageData);
+            }
+            return true;
+        }
+    }
+    //  2. Use the cover image of the folder, it's only loaded and decoded once
+    //for all the tracks in the folder. The other tracks of the folder wait for
+    //it, the tracks of the other folders don't.
+    if(folder->coverFileName.isEmpty())
+    {
+        return false;
+    }
+    QMutexLocker coverLocker(&folder->coverLock);
+    if(!folder->coverLoaded)
+    {
+        QFile imageFile(folderPath+"/"+folder->coverFileName);
+        if(imageFile.open(QIODevice::ReadOnly))
+        {
+            folder->coverImageData=imageFile.readAll();
+            imageFile.close();
+        }
+        folder->coverLoaded=true;
+    }
+    if(decode && folder->coverImage.isNull() &&
+            !folder->coverImageData.isEmpty())
+    {
+        folder->coverImage.loadFromData(folder->coverImageData);
+    }
+    analysisItem.coverImageData=folder->coverImageData;
+    if(decode)
+    {
+        analysisItem.coverImage=folder->coverImage;
+    }
+    return !analysisItem.coverImageData.isEmpty();
 }
 
-bool KNMusicParser::checkImageFile(const QString &imageFilePath,
-                                   KNMusicAnalysisItem &analysisItem)
+QSharedPointer<KNMusicCoverFolder> KNMusicParser::coverFolder(
+        const QString &folderPath)
 {
-    QFileInfo imageFileInfo(imageFilePath);
-    if(imageFileInfo.exists())
+    //Check whether the folder is cached and not changed. The folder cache is
+    //shared by all the threads, only the lookup and the insert are locked.
+    QDateTime lastModified=QFileInfo(folderPath).lastModified();
     {
-        analysisItem.coverImage=QImage(imageFileInfo.absoluteFilePath());
-        return true;
+        QMutexLocker folderLocker(&m_coverFolderLock);
+        QSharedPointer<KNMusicCoverFolder> cachedFolder=
+                m_coverFolders.value(folderPath);
+        if(!cachedFolder.isNull() && cachedFolder->lastModified==lastModified)
+        {
+            return cachedFolder;
+        }
+    }
+    //List the folder.
+    QSharedPointer<KNMusicCoverFolder> folder(new KNMusicCoverFolder);
+    folder->lastModified=lastModified;
+    QStringList fileNames=QDir(folderPath).entryList(QDir::Files);
+    //The rank of the cover image, the smaller the better:
+    //  cover.*, folder.*, front.*, then the name contains "cover".
+    int coverRank=4, coverSuffixRank=m_imageSuffixes.size();
+    for(QStringList::iterator i=fileNames.begin(); i!=fileNames.end(); ++i)
+    {
+        //Check the suffix.
+        int suffixRank=imageSuffixRank(*i);
+        if(suffixRank==-1)
+        {
+            continue;
+        }
+        //Save the image file, the same name prefer the former suffix.
+        QString baseName=(*i).left((*i).lastIndexOf('.')).toLower();
+        QString &sameNameFile=folder->imageFiles[baseName];
+        if(sameNameFile.isEmpty() || imageSuffixRank(sameNameFile)>suffixRank)
+        {
+            sameNameFile=*i;
+        }
+        //Check the cover rank.
+        int currentRank=baseName=="cover"?0:
+                        baseName=="folder"?1:
+                        baseName=="front"?2:
+                        baseName.contains("cover")?3:4;
+        if(currentRank<coverRank ||
+                (currentRank==coverRank && currentRank<4 &&
+                 suffixRank<coverSuffixRank))
+        {
+            coverRank=currentRank;
+            coverSuffixRank=suffixRank;
+            folder->coverFileName=*i;
+        }
+    }
+    QMutexLocker folderLocker(&m_coverFolderLock);
+    //Use the folder which is listed by another thread at the same time, so the
+    //cover is still loaded once.
+    QSharedPointer<KNMusicCoverFolder> cachedFolder=
+            m_coverFolders.value(folderPath);
+    if(!cachedFolder.isNull() && cachedFolder->lastModified==lastModified)
+    {
+        return cachedFolder;
+    }
+    //Clear the cache when it's full, the folders in use are kept by the
+    //threads.
+    if(m_coverFolders.size()>=MaxCoverFolderCount)
+    {
+        m_coverFolders.clear();
     }
-    return false;
+    m_coverFolders.insert(folderPath, folder);
+    return folder;
+}
+
+int KNMusicParser::imageSuffixRank(const QString &fileName)
+{
+    return m_imageSuffixes.indexOf(
+                fileName.mid(fileName.lastIndexOf('.')+1).toLower());
 }
@@ -9,6 +9,9 @@
 
 #include <QDateTime>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
 #include <QStringList>
 #include <QList>
 
@@ -22,6 +25,20 @@
 
 using namespace KNMusic;
 
+struct KNMusicCoverFolder
+{
+    QDateTime lastModified;
+    //The image files in the folder, the key is the lower case base name.
+    QHash<QString, QString> imageFiles;
+    //The cover image of the whole folder, it's loaded and decoded once under
+    //the lock of the folder.
+    QString coverFileName;
+    QMutex coverLock;
+    QByteArray coverImageData;
+    QImage coverImage;
+    bool coverLoaded=false;
+};
+
 class KNGlobal;
 class KNMusicParser : public QObject
 {
@@ -43,16 +60,23 @@ signals:
 
 public slots:
     void parseAlbumArt(KNMusicAnalysisItem &analysisItem);
+    void parseAlbumArtData(KNMusicAnalysisItem &analysisItem);
 
 private:
     inline void parseTag(const QString &filePath,
                          KNMusicAnalysisItem &analysisItem);
     inline void analysis(const QString &filePath,
                          KNMusicDetailInfo &detailInfo);
-    inline bool findImageFile(const QString &imageBaseFileName,
-                              KNMusicAnalysisItem &analysisItem);
-    inline bool checkImageFile(const QString &imageFileInfo,
-                               KNMusicAnalysisItem &analysisItem);
+    inline void parseAlbumArtImage(KNMusicAnalysisItem &analysisItem,
+                                   bool decode);
+    inline bool findImageFile(KNMusicAnalysisItem &analysisItem,
+                              bool decode);
+    inline QSharedPointer<KNMusicCoverFolder> coverFolder(
+            const QString &folderPath);
+    inline int imageSuffixRank(const QString &fileName);
+    QHash<QString, QSharedPointer<KNMusicCoverFolder> > m_coverFolders;
+    QMutex m_coverFolderLock;
+    QStringList m_imageSuffixes;
     KNGlobal *m_global;
     KNMusicGlobal *m_musicGlobal;
     QList<KNMusicAnalysiser *> m_analysisers;
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStringList>
+#include <QUrl>
+
+#include "knmusicglobal.h"
+#include "knmusicmodel.h"
+#include "knmusicmodelassist.h"
+
+#include "knmusicrowmimedata.h"
+
+KNMusicRowMimeData::KNMusicRowMimeData(KNMusicModel *musicModel,
+                                       const QVector<int> &rows) :
+    QMimeData(),
+    m_musicModel(musicModel)
+{
+    //The rows may be moved or removed before they are dropped, keep the
+    //persistent indexes of the rows.
+    m_indexes.reserve(rows.size());
+    for(QVector<int>::const_iterator i=rows.constBegin();
+        i!=rows.constEnd();
+        ++i)
+    {
+        m_indexes.append(QPersistentModelIndex(musicModel->index(*i, Name)));
+    }
+}
+
+KNMusicModel *KNMusicRowMimeData::musicModel() const
+{
+    return m_musicModel;
+}
+
+QVector<int> KNMusicRowMimeData::rows() const
+{
+    QVector<int> rows;
+    //Check the model is still alive.
+    if(m_musicModel.isNull())
+    {
+        return rows;
+    }
+    //Get the current rows, skip the removed rows.
+    rows.reserve(m_indexes.size());
+    for(QList<QPersistentModelIndex>::const_iterator i=m_indexes.constBegin();
+        i!=m_indexes.constEnd();
+        ++i)
+    {
+        if((*i).isValid() && (*i).model()==m_musicModel)
+        {
+            rows.append((*i).row());
+        }
+    }
+    return rows;
+}
+
+QList<QList<QStandardItem *> > KNMusicRowMimeData::musicRows() const
+{
+    QList<QList<QStandardItem *> > musicRows;
+    //Copy the rows which are still in the source model.
+    QVector<int> sourceRows=rows();
+    musicRows.reserve(sourceRows.size());
+    for(QVector<int>::const_iterator i=sourceRows.constBegin();
+        i!=sourceRows.constEnd();
+        ++i)
+    {
+        musicRows.append(m_musicModel->songRow(*i));
+    }
+    return musicRows;
+}
+
+QStringList KNMusicRowMimeData::formats() const
+{
+    //When the model is removed, nothing could be provided.
+    if(m_musicModel.isNull())
+    {
+        return QStringList();
+    }
+    return QStringList() << "text/uri-list"
+                         << "org.kreogist.mu.musicrowlist";
+}
+
+bool KNMusicRowMimeData::hasFormat(const QString &mimeType) const
+{
+    return formats().contains(mimeType);
+}
+
+QVariant KNMusicRowMimeData::retrieveData(const QString &mimeType,
+                                          QVariant::Type type) const
+{
+    //The data is only generated when someone asks for it. The drop targets in
+    //Mu use the rows directly, only the other processes will ask for these.
+    if(m_musicModel.isNull())
+    {
+        return QVariant();
+    }
+    QVector<int> sourceRows=rows();
+    if(mimeType=="text/uri-list")
+    {
+        QList<QVariant> fileUrlList;
+        QByteArray fileUrlData;
+        for(QVector<int>::const_iterator i=sourceRows.constBegin();
+            i!=sourceRows.constEnd();
+            ++i)
+        {
+            QUrl fileUrl=QUrl::fromLocalFile(m_musicModel->filePathFromRow(*i));
+            if(type==QVariant::ByteArray)
+            {
+                fileUrlData.append(fileUrl.toEncoded());
+                fileUrlData.append("\r\n");
+            }
+            else
+            {
+                fileUrlList.append(fileUrl);
+            }
+        }
+        return type==QVariant::ByteArray?
+                    QVariant(fileUrlData):QVariant(fileUrlList);
+    }
+    if(mimeType=="org.kreogist.mu.musicrowlist")
+    {
+        //Serialize the full rows.
+        QJsonArray musicRowList;
+        for(QVector<int>::const_iterator i=sourceRows.constBegin();
+            i!=sourceRows.constEnd();
+            ++i)
+        {
+            musicRowList.append(KNMusicModelAssist::rowToJsonArray(m_musicModel,
+                                                                   *i));
+        }
+        QJsonDocument musicRowDocument;
+        musicRowDocument.setArray(musicRowList);
+        return musicRowDocument.toBinaryData();
+    }
+    return QMimeData::retrieveData(mimeType, type);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICROWMIMEDATA_H
+#define KNMUSICROWMIMEDATA_H
+
+#include <QMimeData>
+#include <QPersistentModelIndex>
+#include <QPointer>
+#include <QVector>
+
+class QStandardItem;
+class KNMusicModel;
+class KNMusicRowMimeData : public QMimeData
+{
+    Q_OBJECT
+public:
+    explicit KNMusicRowMimeData(KNMusicModel *musicModel,
+                                const QVector<int> &rows);
+    KNMusicModel *musicModel() const;
+    QVector<int> rows() const;
+    QList<QList<QStandardItem *> > musicRows() const;
+    QStringList formats() const;
+    bool hasFormat(const QString &mimeType) const;
+
+signals:
+
+public slots:
+
+protected:
+    QVariant retrieveData(const QString &mimeType,
+                          QVariant::Type type) const;
+
+private:
+    QPointer<KNMusicModel> m_musicModel;
+    QList<QPersistentModelIndex> m_indexes;
+};
+
+#endif // KNMUSICROWMIMEDATA_H
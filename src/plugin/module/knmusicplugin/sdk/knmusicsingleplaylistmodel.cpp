@@ -67,6 +67,8 @@ void KNMusicSinglePlaylistModel::initialHeader()
     setHeaderData(Time, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
     setHeaderData(Size, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
     setHeaderData(TrackNumber, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
+    setHeaderData(TrackGain, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
+    setHeaderData(AlbumGain, Qt::Horizontal, QVariant(Qt::AlignVCenter|Qt::AlignRight), Qt::TextAlignmentRole);
     setHeaderData(Time, Qt::Horizontal, 2, Qt::UserRole);
     setHeaderData(DiscNumber, Qt::Horizontal, 1, Qt::UserRole);
     setHeaderData(DiscCount, Qt::Horizontal, 1, Qt::UserRole);
@@ -74,6 +76,8 @@ void KNMusicSinglePlaylistModel::initialHeader()
     setHeaderData(TrackCount, Qt::Horizontal, 1, Qt::UserRole);
     setHeaderData(Size, Qt::Horizontal, 2, Qt::UserRole);
     setHeaderData(BitRate, Qt::Horizontal, 3, Qt::UserRole);
+    setHeaderData(TrackGain, Qt::Horizontal, 3, Qt::UserRole);
+    setHeaderData(AlbumGain, Qt::Horizontal, 3, Qt::UserRole);
     setHeaderData(DateAdded, Qt::Horizontal, 4, Qt::UserRole);
     setHeaderData(DateModified, Qt::Horizontal, 4, Qt::UserRole);
     setHeaderData(LastPlayed, Qt::Horizontal, 4, Qt::UserRole);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QElapsedTimer>
+
+#include "knmusicbackend.h"
+
+#include "knmusicspectrumfeed.h"
+
+//About 30 updates per second.
+#define SpectrumInterval 33
+
+KNMusicSpectrumFeed::KNMusicSpectrumFeed(QObject *parent) :
+    QThread(parent),
+    m_fft(SpectrumFFTSize),
+    m_bins(SpectrumBinCount)
+{
+}
+
+KNMusicSpectrumFeed::~KNMusicSpectrumFeed()
+{
+    //Stop the feed thread.
+    m_stateLock.lock();
+    m_quit=true;
+    m_stateChanged.wakeAll();
+    m_stateLock.unlock();
+    wait();
+}
+
+void KNMusicSpectrumFeed::setBackend(KNMusicBackend *backend)
+{
+    QMutexLocker stateLocker(&m_stateLock);
+    m_backend=backend;
+}
+
+void KNMusicSpectrumFeed::addListener()
+{
+    QMutexLocker stateLocker(&m_stateLock);
+    ++m_listenerCount;
+    //Start the thread when it's needed at the first time.
+    if(!isRunning())
+    {
+        start(QThread::LowPriority);
+    }
+    m_stateChanged.wakeAll();
+}
+
+void KNMusicSpectrumFeed::removeListener()
+{
+    QMutexLocker stateLocker(&m_stateLock);
+    if(m_listenerCount>0)
+    {
+        --m_listenerCount;
+    }
+}
+
+void KNMusicSpectrumFeed::run()
+{
+    QElapsedTimer updateTimer;
+    forever
+    {
+        //Sleep until there's a listener.
+        m_stateLock.lock();
+        while(m_listenerCount==0 && !m_quit)
+        {
+            m_stateChanged.wait(&m_stateLock);
+        }
+        if(m_quit)
+        {
+            m_stateLock.unlock();
+            return;
+        }
+        m_stateLock.unlock();
+        updateTimer.start();
+        updateSpectrum();
+        //Keep the fixed rate.
+        qint64 remainTime=SpectrumInterval-updateTimer.elapsed();
+        if(remainTime>0)
+        {
+            msleep(remainTime);
+        }
+    }
+}
+
+inline void KNMusicSpectrumFeed::updateSpectrum()
+{
+    //The backend won't be changed while the samples are being copied.
+    m_stateLock.lock();
+    int frameCount=m_backend==nullptr?
+                0:m_backend->spectrumSamples(m_samples, SpectrumFFTSize);
+    m_stateLock.unlock();
+    //Nothing is playing, leave the last spectrum there.
+    if(frameCount==0)
+    {
+        return;
+    }
+    //Put the samples at the end of the window, the head is silent.
+    if(frameCount<SpectrumFFTSize)
+    {
+        int silentCount=SpectrumFFTSize-frameCount;
+        memmove(m_samples+silentCount, m_samples, frameCount*sizeof(float));
+        memset(m_samples, 0, silentCount*sizeof(float));
+    }
+    m_fft.amplitudes(m_samples, m_bins.data());
+    emit spectrumUpdated(m_bins);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICSPECTRUMFEED_H
+#define KNMUSICSPECTRUMFEED_H
+
+#include <QMutex>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "knmusicfft.h"
+
+#include <QThread>
+
+/*
+ * The spectrum feed reads the latest samples from the backend at a fixed rate,
+ * and gives out the Hann windowed FFT amplitudes of them. All the work is done
+ * in the feed thread, it only runs when there's a listener, e.g. a visible
+ * visualizer. The backend only copies the samples it has already played, so
+ * nothing is added to the audio path.
+ */
+
+#define SpectrumFFTSize 2048
+#define SpectrumBinCount (SpectrumFFTSize/2)
+
+class KNMusicBackend;
+class KNMusicSpectrumFeed : public QThread
+{
+    Q_OBJECT
+public:
+    explicit KNMusicSpectrumFeed(QObject *parent = 0);
+    ~KNMusicSpectrumFeed();
+    void setBackend(KNMusicBackend *backend);
+    void addListener();
+    void removeListener();
+
+signals:
+    //The amplitudes of the bins, from 0Hz to the half of the sample rate.
+    void spectrumUpdated(QVector<float> bins);
+
+public slots:
+
+protected:
+    void run();
+
+private:
+    inline void updateSpectrum();
+    KNMusicBackend *m_backend=nullptr;
+    QMutex m_stateLock;
+    QWaitCondition m_stateChanged;
+    int m_listenerCount=0;
+    bool m_quit=false;
+    //The buffers are allocated once.
+    float m_samples[SpectrumFFTSize];
+    KNMusicFFT m_fft;
+    QVector<float> m_bins;
+};
+
+#endif // KNMUSICSPECTRUMFEED_H
@@ -4,6 +4,8 @@
  * terms of the Do What The Fuck You Want To Public License, Version 2,
  * as published by Sam Hocevar. See the COPYING file for more details.
  */
+#include <QtMath>
+
 #include "knmusicbackendthread.h"
 
 #include "knmusicstandardbackend.h"
@@ -50,6 +52,18 @@ void KNMusicStandardBackend::play()
     m_main->play();
 }
 
+void KNMusicStandardBackend::setReplayGain(const qreal &gain)
+{
+    //Change the dB to the linear scale.
+    m_main->setGain(qPow(10.0, gain/20.0));
+}
+
+int KNMusicStandardBackend::spectrumSamples(float *samples,
+                                            const int &frameCount)
+{
+    return m_main->recentSamples(samples, frameCount);
+}
+
 void KNMusicStandardBackend::pause()
 {
     m_main->pause();
@@ -67,7 +81,30 @@ void KNMusicStandardBackend::resetMainPlayer()
 
 void KNMusicStandardBackend::loadPreview(const QString &filePath)
 {
+    //Find the thread which has opened the file.
+    bool cacheHit;
+    KNMusicBackendThread *thread=takePreviewCache(filePath, cacheHit);
+    //Make it the latest used one.
+    PreviewCacheItem currentItem;
+    currentItem.filePath=filePath;
+    currentItem.thread=thread;
+    m_previewCache.prepend(currentItem);
+    //Switch the preview thread.
+    if(thread!=m_preview)
+    {
+        //Stop the previous one, and link the new one.
+        m_preview->stop();
+        unlinkPreviewThread(m_preview);
+        m_preview=thread;
+        linkPreviewThread(m_preview);
+    }
+    //Load the file, if the file has been opened, it only reset the state.
     m_preview->loadFromFile(filePath);
+    if(cacheHit)
+    {
+        //The duration won't be emitted when loading an opened file.
+        emit previewDurationChanged(m_preview->duration());
+    }
 }
 
 qint64 KNMusicStandardBackend::previewDuration() const
@@ -129,10 +166,43 @@ void KNMusicStandardBackend::resetPreviewPlayer()
 {
     //Set the smart volume off first.
     smartVolumeOff();
+    //When the preview cache is enabled, only stop the thread to keep the file
+    //opened, it might be previewed again soon.
+    if(m_previewCacheSize>1)
+    {
+        m_preview->stop();
+        return;
+    }
     //Clear the thread.
     m_preview->clear();
 }
 
+void KNMusicStandardBackend::prefetchPreview(const QString &filePath)
+{
+    //Check the cache is enabled.
+    if(m_previewCacheSize<2)
+    {
+        return;
+    }
+    //Check whether the file has been opened.
+    for(auto i=m_previewCache.constBegin(); i!=m_previewCache.constEnd(); ++i)
+    {
+        if((*i).filePath==filePath)
+        {
+            return;
+        }
+    }
+    //Open the file in a thread which is not previewing.
+    bool cacheHit;
+    KNMusicBackendThread *thread=takePreviewCache(filePath, cacheHit);
+    PreviewCacheItem currentItem;
+    currentItem.filePath=filePath;
+    currentItem.thread=thread;
+    m_previewCache.prepend(currentItem);
+    //The thread is not linked, so no signal will be sent out.
+    thread->loadFromFile(filePath);
+}
+
 void KNMusicStandardBackend::changeMuteState()
 {
     setMute(!m_mute);
@@ -210,21 +280,97 @@ void KNMusicStandardBackend::setPreviewThread(KNMusicBackendThread *thread)
     if(m_preview==nullptr)
     {
         m_preview=thread;
-        connect(m_preview, &KNMusicBackendThread::positionChanged,
-                this, &KNMusicStandardBackend::previewPositionChanged);
-        connect(m_preview, &KNMusicBackendThread::durationChanged,
-                this, &KNMusicStandardBackend::previewDurationChanged);
-        connect(m_preview, &KNMusicBackendThread::finished,
-                this, &KNMusicStandardBackend::previewFinished);
-        connect(m_preview, &KNMusicBackendThread::stopped,
-                this, &KNMusicStandardBackend::previewStopped);
-        connect(m_preview, &KNMusicBackendThread::stateChanged,
-                this, &KNMusicStandardBackend::previewPlayingStateChanged);
-        connect(m_preview, &KNMusicBackendThread::loaded,
-                this, &KNMusicStandardBackend::previewLoaded);
-        connect(m_preview, &KNMusicBackendThread::cannotLoadFile,
-                this, &KNMusicStandardBackend::previewCannotLoad);
+        linkPreviewThread(m_preview);
+        //Add the thread to the preview cache.
+        PreviewCacheItem currentItem;
+        currentItem.thread=m_preview;
+        m_previewCache.append(currentItem);
+    }
+}
+
+KNMusicBackendThread *KNMusicStandardBackend::generatePreviewThread()
+{
+    //The backend should give out a new thread for the preview cache.
+    return nullptr;
+}
+
+void KNMusicStandardBackend::setPreviewCacheSize(const int &previewCacheSize)
+{
+    m_previewCacheSize=qMax(previewCacheSize, 1);
+}
+
+KNMusicBackendThread *KNMusicStandardBackend::activePreviewThread() const
+{
+    return m_preview;
+}
+
+void KNMusicStandardBackend::clearPreviewThreads()
+{
+    //The active thread is always in the cache.
+    for(auto i=m_previewCache.constBegin(); i!=m_previewCache.constEnd(); ++i)
+    {
+        (*i).thread->clear();
+    }
+}
+
+inline void KNMusicStandardBackend::linkPreviewThread(
+        KNMusicBackendThread *thread)
+{
+    connect(thread, &KNMusicBackendThread::positionChanged,
+            this, &KNMusicStandardBackend::previewPositionChanged);
+    connect(thread, &KNMusicBackendThread::durationChanged,
+            this, &KNMusicStandardBackend::previewDurationChanged);
+    connect(thread, &KNMusicBackendThread::finished,
+            this, &KNMusicStandardBackend::previewFinished);
+    connect(thread, &KNMusicBackendThread::stopped,
+            this, &KNMusicStandardBackend::previewStopped);
+    connect(thread, &KNMusicBackendThread::stateChanged,
+            this, &KNMusicStandardBackend::previewPlayingStateChanged);
+    connect(thread, &KNMusicBackendThread::loaded,
+            this, &KNMusicStandardBackend::previewLoaded);
+    connect(thread, &KNMusicBackendThread::cannotLoadFile,
+            this, &KNMusicStandardBackend::previewCannotLoad);
+}
+
+inline void KNMusicStandardBackend::unlinkPreviewThread(
+        KNMusicBackendThread *thread)
+{
+    //Disconnect all the signals from the thread to the backend.
+    disconnect(thread, 0, this, 0);
+}
+
+KNMusicBackendThread *KNMusicStandardBackend::takePreviewCache(
+        const QString &filePath,
+        bool &cacheHit)
+{
+    //Check whether the file has been opened by one of the thread.
+    for(int i=0; i<m_previewCache.size(); i++)
+    {
+        if(m_previewCache.at(i).filePath==filePath)
+        {
+            cacheHit=true;
+            return m_previewCache.takeAt(i).thread;
+        }
+    }
+    cacheHit=false;
+    //If the cache is not full, generate a new thread.
+    if(m_previewCache.size()<m_previewCacheSize)
+    {
+        KNMusicBackendThread *thread=generatePreviewThread();
+        if(thread!=nullptr)
+        {
+            return thread;
+        }
+    }
+    //Reuse the least used thread, try not to use the previewing one.
+    for(int i=m_previewCache.size()-1; i>-1; i--)
+    {
+        if(m_previewCache.at(i).thread!=m_preview)
+        {
+            return m_previewCache.takeAt(i).thread;
+        }
     }
+    return m_previewCache.takeLast().thread;
 }
 
 void KNMusicStandardBackend::smartVolumeOn()
@@ -25,6 +25,8 @@ public:
     void pause();
     void stop();
     void resetMainPlayer();
+    void setReplayGain(const qreal &gain);
+    int spectrumSamples(float *samples, const int &frameCount);
 
     void loadPreview(const QString &filePath);
     qint64 previewDuration() const;
@@ -39,6 +41,7 @@ public:
     void stopPreview();
     void pausePreview();
     void resetPreviewPlayer();
+    void prefetchPreview(const QString &filePath);
 
 signals:
 
@@ -53,12 +56,30 @@ public slots:
 protected:
     void setMainThread(KNMusicBackendThread *thread);
     void setPreviewThread(KNMusicBackendThread *thread);
+    virtual KNMusicBackendThread *generatePreviewThread();
+    void setPreviewCacheSize(const int &previewCacheSize);
+    //The preview thread which is linked to the backend now, it's changed when
+    //a cached thread is used.
+    KNMusicBackendThread *activePreviewThread() const;
+    //Clear all the preview threads in the cache, including the active one.
+    void clearPreviewThreads();
     virtual void changeVolume(const int &volumeSize)=0;
     virtual qreal smartVolumeScale() const=0;
 
 private:
+    struct PreviewCacheItem
+    {
+        QString filePath;
+        KNMusicBackendThread *thread;
+    };
+    inline void linkPreviewThread(KNMusicBackendThread *thread);
+    inline void unlinkPreviewThread(KNMusicBackendThread *thread);
+    KNMusicBackendThread *takePreviewCache(const QString &filePath,
+                                           bool &cacheHit);
     void smartVolumeOn();
     void smartVolumeOff();
+    QList<PreviewCacheItem> m_previewCache;
+    int m_previewCacheSize=1;
     int m_originalVolume=-1,
         m_volumeBeforeMute=0.0;
     qint64 m_backupPosition=-1;
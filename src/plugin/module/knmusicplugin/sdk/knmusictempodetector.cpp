@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QtMath>
+
+#include "knmusictempodetector.h"
+
+//The tempo range, in BPM.
+#define MinimumTempo 60.0
+#define MaximumTempo 200.0
+#define TempoStep 0.25
+//The beat period and its multiples are scored by the comb.
+#define CombHarmonics 4
+//The log-Gaussian prior of the tempo, the width is in octaves.
+#define TempoPriorCenter 120.0
+#define TempoPriorWidth 1.0
+//The amplitudes are compressed by log(1+C*x) before calculating the flux.
+#define OnsetCompression 1000.0
+//The local mean of the onset envelope is calculated in this radius, in second.
+#define OnsetMeanRadius 0.5
+//The chroma is calculated from A1 to A7.
+#define KeyMinimumFrequency 55.0
+#define KeyMaximumFrequency 3520.0
+//The chroma which doesn't correlate with any key profile better than this
+//doesn't have a key.
+#define KeyMinimumCorrelation 0.4
+
+//The Krumhansl-Kessler key profiles, starting from the tonic.
+static const double majorProfile[12]={6.35, 2.23, 3.48, 2.33, 4.38, 4.09,
+                                      2.52, 5.19, 2.39, 3.66, 2.29, 2.88};
+static const double minorProfile[12]={6.33, 2.68, 3.52, 5.38, 2.60, 3.53,
+                                      2.54, 4.75, 3.98, 2.69, 3.34, 3.17};
+//The names of the tonics, starting from C, as the ID3v2 TKEY frame uses.
+static const char *tonicNames[12]={"C", "C#", "D", "Eb", "E", "F",
+                                   "F#", "G", "Ab", "A", "Bb", "B"};
+
+//The Pearson correlation of the chroma from the tonic and the key profile.
+static inline double profileCorrelation(const double *chroma,
+                                        const int &tonic,
+                                        const double *profile)
+{
+    double chromaMean=0.0, profileMean=0.0;
+    for(int i=0; i<12; ++i)
+    {
+        chromaMean+=chroma[i];
+        profileMean+=profile[i];
+    }
+    chromaMean/=12.0;
+    profileMean/=12.0;
+    double covariance=0.0, chromaVariance=0.0, profileVariance=0.0;
+    for(int i=0; i<12; ++i)
+    {
+        double chromaDiff=chroma[(tonic+i)%12]-chromaMean,
+               profileDiff=profile[i]-profileMean;
+        covariance+=chromaDiff*profileDiff;
+        chromaVariance+=chromaDiff*chromaDiff;
+        profileVariance+=profileDiff*profileDiff;
+    }
+    //The flat chroma doesn't correlate with anything.
+    if(chromaVariance<=0.0)
+    {
+        return 0.0;
+    }
+    return covariance/qSqrt(chromaVariance*profileVariance);
+}
+
+KNMusicTempoDetector::KNMusicTempoDetector() :
+    m_onsetFFT(OnsetFrameSize),
+    m_chromaFFT(ChromaFrameSize),
+    m_buffer(TempoBufferSize),
+    m_amplitudes(ChromaFrameSize>>1),
+    m_spectrum(OnsetFrameSize>>1),
+    m_binPitch(ChromaFrameSize>>1),
+    m_frameEnd(OnsetFrameSize)
+{
+    //Map the chroma bins to the pitch classes, pitch class 0 is A.
+    const qreal binFrequency=(qreal)TempoSampleRate/ChromaFrameSize;
+    m_firstBin=qCeil(KeyMinimumFrequency/binFrequency);
+    m_lastBin=qMin(qFloor(KeyMaximumFrequency/binFrequency),
+                   (ChromaFrameSize>>1)-1);
+    for(int i=0; i<m_binPitch.size(); ++i)
+    {
+        if(i<m_firstBin || i>m_lastBin)
+        {
+            m_binPitch[i]=-1;
+            continue;
+        }
+        int semitone=qRound(12.0*log2(i*binFrequency/440.0));
+        m_binPitch[i]=((semitone%12)+12)%12;
+    }
+    for(int i=0; i<12; ++i)
+    {
+        m_chroma[i]=0.0;
+    }
+    //Reserve the onsets of the whole duration.
+    m_onsets.reserve(TempoDuration*TempoSampleRate/OnsetHopSize+1);
+}
+
+void KNMusicTempoDetector::process(const float *samples, int frameCount)
+{
+    float *buffer=m_buffer.data();
+    while(frameCount>0)
+    {
+        //Fill the buffer.
+        int copyCount=qMin(frameCount, TempoBufferSize-m_bufferPosition);
+        memcpy(buffer+m_bufferPosition, samples, copyCount*sizeof(float));
+        m_bufferPosition+=copyCount;
+        samples+=copyCount;
+        frameCount-=copyCount;
+        //Analysis all the hops which are in the buffer.
+        while(m_frameEnd<=m_bufferPosition)
+        {
+            analysisHop(m_frameEnd);
+            m_frameEnd+=OnsetHopSize;
+        }
+        //Keep the last chroma frame for the next hops when the buffer is full.
+        if(m_bufferPosition==TempoBufferSize)
+        {
+            memmove(buffer,
+                    buffer+TempoBufferSize-ChromaFrameSize,
+                    ChromaFrameSize*sizeof(float));
+            m_frameEnd-=TempoBufferSize-ChromaFrameSize;
+            m_bufferPosition=ChromaFrameSize;
+        }
+    }
+}
+
+qreal KNMusicTempoDetector::beatsPerMinute() const
+{
+    const qreal onsetRate=(qreal)TempoSampleRate/OnsetHopSize;
+    //The comb needs the multiples of the slowest beat period.
+    const int maxLag=qCeil(onsetRate*60.0/MinimumTempo)*CombHarmonics,
+              onsetCount=m_onsets.size();
+    //Several bars are needed at least.
+    if(onsetCount<(maxLag<<1))
+    {
+        return 0.0;
+    }
+    //Remove the local mean of the envelope, only the onsets which are stronger
+    //than their neighbours are kept.
+    const int meanRadius=qRound(onsetRate*OnsetMeanRadius);
+    QVector<double> prefixSum(onsetCount+1);
+    for(int i=0; i<onsetCount; ++i)
+    {
+        prefixSum[i+1]=prefixSum.at(i)+m_onsets.at(i);
+    }
+    QVector<float> envelope(onsetCount);
+    for(int i=0; i<onsetCount; ++i)
+    {
+        int first=qMax(i-meanRadius, 0),
+            last=qMin(i+meanRadius+1, onsetCount);
+        float mean=(prefixSum.at(last)-prefixSum.at(first))/(last-first);
+        envelope[i]=qMax(m_onsets.at(i)-mean, 0.0f);
+    }
+    //Calculate the autocorrelation of the envelope. The products are summed
+    //in independent lanes, so the compiler could vectorize the loop.
+    QVector<float> correlation(maxLag+2);
+    const float *data=envelope.constData();
+    for(int lag=0; lag<correlation.size(); ++lag)
+    {
+        const float *shifted=data+lag;
+        const int count=onsetCount-lag;
+        float lanes[8]={0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        int i=0;
+        for(; i+8<=count; i+=8)
+        {
+            for(int j=0; j<8; ++j)
+            {
+                lanes[j]+=data[i+j]*shifted[i+j];
+            }
+        }
+        float sum=0.0;
+        for(int j=0; j<8; ++j)
+        {
+            sum+=lanes[j];
+        }
+        for(; i<count; ++i)
+        {
+            sum+=data[i]*shifted[i];
+        }
+        //The longer lag has fewer products.
+        correlation[lag]=sum/count;
+    }
+    //The silent track doesn't have a tempo.
+    if(correlation.at(0)<=0.0)
+    {
+        return 0.0;
+    }
+    //Score the tempos with the comb of the beat period, the prior prefers the
+    //tempo most music uses, so the half and the double tempo could hardly win.
+    qreal bestTempo=0.0, bestScore=0.0;
+    for(qreal tempo=MinimumTempo; tempo<=MaximumTempo; tempo+=TempoStep)
+    {
+        qreal period=onsetRate*60.0/tempo, score=0.0;
+        for(int i=1; i<=CombHarmonics; ++i)
+        {
+            //Interpolate the autocorrelation at the fractional lag.
+            qreal lag=period*i;
+            int lowerLag=(int)lag;
+            qreal fraction=lag-lowerLag;
+            score+=correlation.at(lowerLag)*(1.0-fraction)+
+                    correlation.at(lowerLag+1)*fraction;
+        }
+        qreal octave=log2(tempo/TempoPriorCenter);
+        score*=qExp(-0.5*octave*octave/(TempoPriorWidth*TempoPriorWidth));
+        if(score>bestScore)
+        {
+            bestScore=score;
+            bestTempo=tempo;
+        }
+    }
+    return bestTempo;
+}
+
+QString KNMusicTempoDetector::key() const
+{
+    //Rotate the chroma to start from C.
+    double chroma[12];
+    for(int i=0; i<12; ++i)
+    {
+        chroma[i]=m_chroma[(i+3)%12];
+    }
+    //Find the key profile which correlates best.
+    int bestTonic=-1;
+    bool bestMinor=false;
+    double bestCorrelation=KeyMinimumCorrelation;
+    for(int tonic=0; tonic<12; ++tonic)
+    {
+        double majorCorrelation=profileCorrelation(chroma,
+                                                   tonic,
+                                                   majorProfile),
+               minorCorrelation=profileCorrelation(chroma,
+                                                   tonic,
+                                                   minorProfile);
+        if(majorCorrelation>bestCorrelation)
+        {
+            bestCorrelation=majorCorrelation;
+            bestTonic=tonic;
+            bestMinor=false;
+        }
+        if(minorCorrelation>bestCorrelation)
+        {
+            bestCorrelation=minorCorrelation;
+            bestTonic=tonic;
+            bestMinor=true;
+        }
+    }
+    if(bestTonic==-1)
+    {
+        return QString();
+    }
+    return bestMinor?QString(tonicNames[bestTonic])+"m":
+                     QString(tonicNames[bestTonic]);
+}
+
+inline void KNMusicTempoDetector::analysisHop(const int &frameEnd)
+{
+    const float *buffer=m_buffer.constData();
+    m_onsetFFT.amplitudes(buffer+frameEnd-OnsetFrameSize, m_amplitudes.data());
+    //The flux sums how much the compressed amplitudes rise, the DC is skipped.
+    const float *amplitudes=m_amplitudes.constData();
+    float *spectrum=m_spectrum.data(), flux=0.0;
+    for(int i=1; i<(OnsetFrameSize>>1); ++i)
+    {
+        float magnitude=log1p(OnsetCompression*amplitudes[i]);
+        flux+=qMax(magnitude-spectrum[i], 0.0f);
+        spectrum[i]=magnitude;
+    }
+    //The first frame rises from nothing, it's not an onset.
+    m_onsets.append(m_hopCount==0?0.0:flux);
+    //Calculate the chroma when there's a whole chroma frame.
+    if(m_hopCount%ChromaHopInterval==0 && frameEnd>=ChromaFrameSize)
+    {
+        analysisChroma(buffer+frameEnd-ChromaFrameSize);
+    }
+    ++m_hopCount;
+}
+
+inline void KNMusicTempoDetector::analysisChroma(const float *frame)
+{
+    m_chromaFFT.amplitudes(frame, m_amplitudes.data());
+    //Fold the energy of the bins into the pitch classes.
+    double chroma[12], energy=0.0;
+    for(int i=0; i<12; ++i)
+    {
+        chroma[i]=0.0;
+    }
+    const float *amplitudes=m_amplitudes.constData();
+    const int *binPitch=m_binPitch.constData();
+    for(int i=m_firstBin; i<=m_lastBin; ++i)
+    {
+        double binEnergy=amplitudes[i]*amplitudes[i];
+        chroma[binPitch[i]]+=binEnergy;
+        energy+=binEnergy;
+    }
+    //Skip the silent frame, and normalize the others so the loud parts don't
+    //decide the key alone.
+    if(energy<=0.0)
+    {
+        return;
+    }
+    for(int i=0; i<12; ++i)
+    {
+        m_chroma[i]+=chroma[i]/energy;
+    }
+}
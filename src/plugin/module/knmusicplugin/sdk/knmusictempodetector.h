@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICTEMPODETECTOR_H
+#define KNMUSICTEMPODETECTOR_H
+
+#include <QString>
+#include <QVector>
+
+#include "knmusicfft.h"
+
+/*
+ * The tempo detector estimates the tempo and the key of the mono samples at
+ * TempoSampleRate. The onset envelope is the spectral flux of the short
+ * frames, its autocorrelation is scored by a comb of the beat period and its
+ * multiples, the best scored tempo wins. The chroma of the long frames is
+ * accumulated at the same time, and the key is the Krumhansl-Kessler key
+ * profile which correlates best with it.
+ */
+
+#define TempoSampleRate 11025
+//Only two minutes in the middle of the track are used.
+#define TempoDuration 120
+#define OnsetFrameSize 1024
+#define OnsetHopSize 128
+#define ChromaFrameSize 4096
+//The chroma is calculated every ChromaHopInterval onset hops.
+#define ChromaHopInterval 8
+//The samples are saved in the buffer, the analysised part is dropped only
+//when the buffer is full.
+#define TempoBufferSize 16384
+
+class KNMusicTempoDetector
+{
+public:
+    KNMusicTempoDetector();
+    void process(const float *samples, int frameCount);
+    qreal beatsPerMinute() const;
+    QString key() const;
+
+private:
+    inline void analysisHop(const int &frameEnd);
+    inline void analysisChroma(const float *frame);
+    KNMusicFFT m_onsetFFT, m_chromaFFT;
+    QVector<float> m_buffer, m_amplitudes, m_spectrum, m_onsets;
+    //The pitch class of the chroma bins, the bins out of the range are not used.
+    QVector<int> m_binPitch;
+    int m_firstBin, m_lastBin, m_bufferPosition=0, m_frameEnd, m_hopCount=0;
+    //The accumulated chroma, pitch class 0 is A.
+    double m_chroma[12];
+};
+
+#endif // KNMUSICTEMPODETECTOR_H
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICTEMPOSCANNER_H
+#define KNMUSICTEMPOSCANNER_H
+
+#include "knmusicglobal.h"
+
+#include <QObject>
+
+using namespace KNMusic;
+
+class KNMusicTempoScanner : public QObject
+{
+    Q_OBJECT
+public:
+    KNMusicTempoScanner(QObject *parent = 0):QObject(parent){}
+    //Detect the tempo and the key of the tracks in the background,
+    //trackScanned() will be emitted for every track which could be decoded.
+    virtual void scan(const QList<KNMusicTempoItem> &tracks)=0;
+
+signals:
+    void trackScanned(KNMusicTempoItem track);
+
+public slots:
+
+private:
+};
+
+#endif // KNMUSICTEMPOSCANNER_H
@@ -5,21 +5,17 @@
  * as published by Sam Hocevar. See the COPYING file for more details.
  */
 #include <QScopedPointer>
-#include <QMimeData>
 #include <QPainter>
 #include <QList>
 #include <QKeyEvent>
-#include <QDataStream>
 #include <QDrag>
 #include <QScrollBar>
 #include <QTimeLine>
 #include <QMouseEvent>
-#include <QJsonDocument>
 
 #include "knconnectionhandler.h"
 #include "knmusicdetailtooltipbase.h"
 #include "knmusicmodel.h"
-#include "knmusicmodelassist.h"
 #include "knmusicsearchbase.h"
 #include "knmusicsolomenubase.h"
 #include "knmusicmultimenubase.h"
@@ -27,6 +23,7 @@
 #include "knmusictreeviewheader.h"
 #include "knmusicproxymodel.h"
 #include "knmusicratingdelegate.h"
+#include "knmusicrowmimedata.h"
 
 #include "knmusictreeviewbase.h"
 
@@ -160,6 +157,26 @@ void KNMusicTreeViewBase::scrollToSourceSongRow(const int &row)
     }
 }
 
+void KNMusicTreeViewBase::selectSourceSongRows(const QList<int> &rows)
+{
+    if(rows.isEmpty() || m_proxyModel->musicModel()==nullptr)
+    {
+        return;
+    }
+    //Scroll to the first row, it will be the current row.
+    scrollToSourceSongRow(rows.first());
+    //Select the other rows.
+    for(QList<int>::const_iterator i=rows.constBegin()+1;
+        i!=rows.constEnd();
+        ++i)
+    {
+        selectionModel()->select(
+                    m_proxyModel->mapFromSource(
+                        m_proxyModel->musicModel()->index(*i, Name)),
+                    QItemSelectionModel::Select | QItemSelectionModel::Rows);
+    }
+}
+
 void KNMusicTreeViewBase::scrollToSongRow(const int &row)
 {
     //Get the target index.
@@ -335,34 +352,20 @@ void KNMusicTreeViewBase::startDrag(Qt::DropActions supportedActions)
     {
         return;
     }
-    //Clear the mimedata.
+    //Only the source model and the source rows are saved in the mime data,
+    //the rows will be serialized when it's dropped to other applications.
     QScopedPointer<QDrag> drag(new QDrag(this));
-    QMimeData *mimeData=m_proxyModel->mimeData(selectionModel()->selectedIndexes());
-    //Get the file path and music row of all the selected rows.
-    QList<QUrl> fileUrlList;
-    QJsonArray musicRowList;
-    KNMusicModel *musicModel=m_proxyModel->musicModel();
-    QByteArray sourceRowList;
-    QDataStream sourceRowStream(&sourceRowList, QIODevice::WriteOnly);
+    QVector<int> sourceRows;
+    sourceRows.reserve(indexes.size());
     for(auto i=indexes.begin();
              i!=indexes.end();
              ++i)
     {
         //Get the original row of the specific row.
-        int currentRow=m_proxyModel->mapToSource(*i).row();
-        //Add the file path, row index and music row to list.
-        fileUrlList.append(QUrl::fromLocalFile(musicModel->filePathFromRow(currentRow)));
-        musicRowList.append(KNMusicModelAssist::rowToJsonArray(musicModel, currentRow));
-        sourceRowStream << currentRow;
+        sourceRows.append(m_proxyModel->mapToSource(*i).row());
     }
-    QJsonDocument musicRowDocument;
-    musicRowDocument.setArray(musicRowList);
-    //Set the data to mimedata.
-    mimeData->setUrls(fileUrlList);
-    mimeData->setData("org.kreogist.mu.musicrowlist", musicRowDocument.toBinaryData());
-    mimeData->setData("org.kreogist.mu.musicmodel", QByteArray::number((qint64)musicModel));
-    mimeData->setData("org.kreogist.mu.musicmodelrows", sourceRowList);
-    mimeData->setData("org.kreogist.mu.musicmodelrowsize", QByteArray::number(indexes.size()));
+    KNMusicRowMimeData *mimeData=
+            new KNMusicRowMimeData(m_proxyModel->musicModel(), sourceRows);
     //Set the mime data to the drag action.
     drag->setMimeData(mimeData);
     //Do the drag.
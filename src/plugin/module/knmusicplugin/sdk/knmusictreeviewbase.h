@@ -31,6 +31,7 @@ public:
     void scrollToSongRow(const int &row);
     inline void scrollToSongIndex(const QModelIndex &songIndex);
     void scrollToSourceSongRow(const int &row);
+    void selectSourceSongRows(const QList<int> &rows);
     KNMusicProxyModel *proxyModel();
     KNMusicTab *musicTab() const;
     void setMusicTab(KNMusicTab *musicTab);
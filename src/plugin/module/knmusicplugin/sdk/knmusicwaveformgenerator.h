@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNMUSICWAVEFORMGENERATOR_H
+#define KNMUSICWAVEFORMGENERATOR_H
+
+#include <QObject>
+
+/*
+ * The waveform is the overview of a track for the progress slider. It's
+ * WaveformBucketCount buckets, every bucket is three bytes: the minimum and
+ * the maximum sample as qint8, and the RMS as quint8.
+ */
+
+#define WaveformBucketCount 1024
+
+class KNMusicWaveformGenerator : public QObject
+{
+    Q_OBJECT
+public:
+    KNMusicWaveformGenerator(QObject *parent = 0):QObject(parent){}
+    //Generate the waveform in the background, the previous generating will be
+    //dropped. The start position and the duration are in ms, -1 start position
+    //means the whole file. waveformGenerated() will be emitted when it's done.
+    virtual void generate(const QString &filePath,
+                          const qint64 &startPosition=-1,
+                          const qint64 &duration=-1)=0;
+
+signals:
+    void waveformGenerated(QString filePath,
+                           qint64 startPosition,
+                           QByteArray waveform);
+
+public slots:
+
+private:
+};
+
+#endif // KNMUSICWAVEFORMGENERATOR_H
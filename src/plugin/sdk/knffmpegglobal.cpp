@@ -4,10 +4,36 @@
  * terms of the Do What The Fuck You Want To Public License, Version 2,
  * as published by Sam Hocevar. See the COPYING file for more details.
  */
+#include <QMutex>
+
 #include "knffmpegglobal.h"
 
 KNFFMpegGlobal *KNFFMpegGlobal::m_instance=nullptr;
 
+//The lock manager of FFMpeg. Opening and closing the codecs are not thread
+//safe without it, and the analysis jobs, the analysiser and the playback
+//decoder are opening the codecs in different threads at the same time.
+static int lockManager(void **mutex, enum AVLockOp operation)
+{
+    switch(operation)
+    {
+    case AV_LOCK_CREATE:
+        *mutex=new QMutex;
+        return 0;
+    case AV_LOCK_OBTAIN:
+        static_cast<QMutex *>(*mutex)->lock();
+        return 0;
+    case AV_LOCK_RELEASE:
+        static_cast<QMutex *>(*mutex)->unlock();
+        return 0;
+    case AV_LOCK_DESTROY:
+        delete static_cast<QMutex *>(*mutex);
+        *mutex=nullptr;
+        return 0;
+    }
+    return 1;
+}
+
 KNFFMpegGlobal *KNFFMpegGlobal::instance()
 {
     return m_instance==nullptr?m_instance=new KNFFMpegGlobal:m_instance;
@@ -19,4 +45,6 @@ KNFFMpegGlobal::KNFFMpegGlobal(QObject *parent) :
     //Initial the FFMpeg.
     //Initialize all the muxers, demuxers and protocols of FFMpeg.
     av_register_all();
+    //Register the lock manager before any codec is opened.
+    av_lockmgr_register(lockManager);
 }
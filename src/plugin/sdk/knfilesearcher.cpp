@@ -7,6 +7,8 @@
 #include <QDir>
 #include <QFileInfo>
 
+#include "kntrace.h"
+
 #include "knfilesearcher.h"
 
 #include <QDebug>
@@ -51,6 +53,7 @@ void KNFileSearcher::analysisFile(const QString &suffix,
 
 void KNFileSearcher::analysisFolder(const QString &folderPath)
 {
+    KNTraceScope("import", "KNFileSearcher::analysisFolder");
     QDir folderInfo(folderPath);
     //Get the entry file info under the folder.
     QFileInfoList contents=folderInfo.entryInfoList();
@@ -17,6 +17,8 @@
  */
 #include <QCryptographicHash>
 
+#include "kntrace.h"
+
 #include "knhashpixmaplist.h"
 
 KNHashPixmapList::KNHashPixmapList(QObject *parent) :
@@ -26,6 +28,7 @@ KNHashPixmapList::KNHashPixmapList(QObject *parent) :
 
 QString KNHashPixmapList::appendImage(const QImage &image)
 {
+    KNTraceScope("artwork", "KNHashPixmapList::appendImage");
     //Calculate the hash data of the image.
     QByteArray hashResult=QCryptographicHash::hash(QByteArray((char *)image.bits(), image.byteCount()),
                                                    QCryptographicHash::Md5);
@@ -43,12 +46,56 @@ QString KNHashPixmapList::appendImage(const QImage &image)
         //Insert the image in to the hash list.
         m_imageList.insert(imageKey, image);
         //Ask to save the image.
-        emit requireSaveImage(imageKey);
+        emit requireSaveImage(imageKey, QByteArray());
     }
     //Return the image key.
     return imageKey;
 }
 
+QString KNHashPixmapList::appendImageData(const QByteArray &imageData,
+                                          const QImage &image)
+{
+    KNTraceScope("artwork", "KNHashPixmapList::appendImageData");
+    if(imageData.isEmpty())
+    {
+        return QString();
+    }
+    //Get the image key from the compressed data.
+    QString imageKey=imageDataKey(imageData);
+    //If the image has been added, don't decode it again.
+    if(m_imageList.contains(imageKey))
+    {
+        return imageKey;
+    }
+    //Decode the image if the caller hasn't decoded it.
+    QImage decodedImage=image.isNull()?QImage::fromData(imageData):image;
+    if(decodedImage.isNull())
+    {
+        return QString();
+    }
+    //Insert the image in to the hash list.
+    m_imageList.insert(imageKey, decodedImage);
+    //Ask to save the compressed data.
+    emit requireSaveImage(imageKey, imageData);
+    //Return the image key.
+    return imageKey;
+}
+
+QString KNHashPixmapList::imageDataKey(const QByteArray &imageData)
+{
+    //Use 64-bit FNV-1a, it's much faster than the MD5, the size of the data is
+    //also a part of the key to reduce collisions.
+    quint64 hashResult=Q_UINT64_C(14695981039346656037);
+    const uchar *data=reinterpret_cast<const uchar *>(imageData.constData());
+    for(int i=0, dataSize=imageData.size(); i<dataSize; ++i)
+    {
+        hashResult^=data[i];
+        hashResult*=Q_UINT64_C(1099511628211);
+    }
+    return QString("%1%2").arg(hashResult, 16, 16, QChar('0'))
+                          .arg(imageData.size(), 8, 16, QChar('0'));
+}
+
 QPixmap KNHashPixmapList::pixmap(const QString &key)
 {
     return QPixmap::fromImage(m_imageList.value(key));
@@ -30,13 +30,16 @@ class KNHashPixmapList : public QObject
 public:
     explicit KNHashPixmapList(QObject *parent = 0);
     QString appendImage(const QImage &image);
+    QString appendImageData(const QByteArray &imageData,
+                            const QImage &image=QImage());
+    static QString imageDataKey(const QByteArray &imageData);
     QPixmap pixmap(const QString &key);
     QImage image(const QString &key);
     void setImage(const QString &key, const QImage &image);
     void removeImage(const QString &key);
 
 signals:
-    void requireSaveImage(QString hashKey);
+    void requireSaveImage(QString hashKey, QByteArray imageData);
 
 public slots:
 
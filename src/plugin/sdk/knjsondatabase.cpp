@@ -8,6 +8,8 @@
 #include <QDir>
 #include <QJsonParseError>
 
+#include "kntrace.h"
+
 #include "knjsondatabase.h"
 
 #include <QDebug>
@@ -34,6 +36,7 @@ void KNJSONDatabase::setDatabaseFile(const QString &filePath)
 
 void KNJSONDatabase::read()
 {
+    KNTraceScope("database", "KNJSONDatabase::read");
     //Check the file existance.
     if(!m_databaseFile->exists())
     {
@@ -84,6 +87,7 @@ void KNJSONDatabase::read()
 
 void KNJSONDatabase::write()
 {
+    KNTraceScope("database", "KNJSONDatabase::write");
     //Check if we need to write.
     if(m_batchCount==0)
     {
@@ -108,6 +112,11 @@ void KNJSONDatabase::write()
     m_batchCount=0;
 }
 
+void KNJSONDatabase::setAutoWrite(const bool &autoWrite)
+{
+    m_autoWrite=autoWrite;
+}
+
 void KNJSONDatabase::append(const QJsonValue &value)
 {
     m_dataField.append(value);
@@ -140,6 +149,11 @@ QJsonValue KNJSONDatabase::at(int i)
     return m_dataField.at(i);
 }
 
+QJsonArray KNJSONDatabase::data() const
+{
+    return m_dataField;
+}
+
 QJsonArray::iterator KNJSONDatabase::begin()
 {
     return m_dataField.begin();
@@ -154,8 +168,9 @@ inline void KNJSONDatabase::addBatchCount()
 {
     //Count the operate.
     m_batchCount++;
-    //Check the count.
-    if(m_batchCount==MAX_BATCH)
+    //Check the count, the count could be larger than the batch when the auto
+    //write is enabled again.
+    if(m_autoWrite && m_batchCount>=MAX_BATCH)
     {
         //Write to disk.
         write();
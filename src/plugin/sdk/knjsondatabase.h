@@ -23,12 +23,16 @@ public:
     void setDatabaseFile(const QString &filePath);
     void read();
     void write();
+    //The database writes itself after every MAX_BATCH operations by default,
+    //disable it to write the database only when write() is called.
+    void setAutoWrite(const bool &autoWrite);
     QJsonArray::iterator begin();
     QJsonArray::iterator end();
     void append(const QJsonValue &value);
     void replace(int i, const QJsonValue &value);
     void removeAt(int i);
     QJsonValue at(int i);
+    QJsonArray data() const;
 
 signals:
 
@@ -47,6 +51,7 @@ private:
     static int m_majorVersion;
     static int m_minorVersion;
     int m_batchCount=0;
+    bool m_autoWrite=true;
 };
 
 #endif // KNJSONDATABASE_H
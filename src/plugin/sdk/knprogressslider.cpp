@@ -36,6 +36,13 @@ KNProgressSlider::KNProgressSlider(QWidget *parent) :
     updateButtonSize();
 }
 
+void KNProgressSlider::setWaveform(const QByteArray &waveform)
+{
+    m_waveform=waveform;
+    updateWaveformLines();
+    update();
+}
+
 void KNProgressSlider::enterEvent(QEvent *event)
 {
     //Stop all the animation.
@@ -76,12 +83,24 @@ void KNProgressSlider::paintEvent(QPaintEvent *event)
     //Set no pen
     painter.setPen(Qt::NoPen);
 
-    //Draw central rects.
-    painter.fillRect(QRect(m_glowWidth,
-                           m_glowWidth+m_spacing,
-                           width()-(m_glowWidth<<1),
-                           m_sliderHeight),
-                     m_rectColor);
+    //Draw the waveform instead of the central rects when we have one.
+    if(m_peakLines.isEmpty())
+    {
+        //Draw central rects.
+        painter.fillRect(QRect(m_glowWidth,
+                               m_glowWidth+m_spacing,
+                               width()-(m_glowWidth<<1),
+                               m_sliderHeight),
+                         m_rectColor);
+    }
+    else
+    {
+        painter.setPen(m_rectColor);
+        painter.drawLines(m_peakLines);
+        painter.setPen(m_backgroundColor);
+        painter.drawLines(m_rmsLines);
+        painter.setPen(Qt::NoPen);
+    }
 
     //Calculat the position left.
     int positionLeft;
@@ -100,12 +119,24 @@ void KNProgressSlider::paintEvent(QPaintEvent *event)
     }
     //Restore the opacity.
     painter.setOpacity(1.0);
-    //Paint the rect.
-    painter.fillRect(QRect(m_glowWidth,
-                           m_glowWidth+m_spacing,
-                           positionLeft+2,
-                           m_sliderHeight),
-                     m_buttonColor);
+    if(m_peakLines.isEmpty())
+    {
+        //Paint the rect.
+        painter.fillRect(QRect(m_glowWidth,
+                               m_glowWidth+m_spacing,
+                               positionLeft+2,
+                               m_sliderHeight),
+                         m_buttonColor);
+    }
+    else
+    {
+        //Paint the played part of the waveform.
+        painter.save();
+        painter.setClipRect(QRect(0, 0, m_glowWidth+positionLeft+2, height()));
+        painter.setPen(m_buttonColor);
+        painter.drawLines(m_peakLines);
+        painter.restore();
+    }
 
     //Draw the circle button.
     //Calculate position.
@@ -127,6 +158,13 @@ void KNProgressSlider::paintEvent(QPaintEvent *event)
                                m_sliderHeight+2));
 }
 
+void KNProgressSlider::resizeEvent(QResizeEvent *event)
+{
+    KNAbstractSlider::resizeEvent(event);
+    //The columns of the waveform are changed.
+    updateWaveformLines();
+}
+
 void KNProgressSlider::mousePressEvent(QMouseEvent *event)
 {
     //Set pressed flag.
@@ -196,3 +234,43 @@ qint64 KNProgressSlider::posToValue(int position)
     return minimal()+
             (qreal)range()/(qreal)(width()-(m_glowWidth<<1))*(qreal)position;
 }
+
+void KNProgressSlider::updateWaveformLines()
+{
+    m_peakLines.clear();
+    m_rmsLines.clear();
+    int bucketCount=m_waveform.size()/3,
+        columnCount=width()-(m_glowWidth<<1);
+    if(bucketCount==0 || columnCount<=0)
+    {
+        return;
+    }
+    //The waveform is drawn around the center of the bar, it could use the
+    //whole height of the widget.
+    qreal center=m_glowWidth+m_spacing+(m_sliderHeight>>1),
+          halfHeight=center-1.0;
+    const char *buckets=m_waveform.constData();
+    m_peakLines.reserve(columnCount);
+    m_rmsLines.reserve(columnCount);
+    for(int i=0; i<columnCount; i++)
+    {
+        //Merge all the buckets of the column.
+        int firstBucket=i*bucketCount/columnCount,
+            lastBucket=qMax((i+1)*bucketCount/columnCount, firstBucket+1);
+        qint8 minimum=0, maximum=0;
+        quint8 rms=0;
+        for(int j=firstBucket; j<lastBucket; j++)
+        {
+            const char *bucket=buckets+j*3;
+            minimum=qMin(minimum, (qint8)bucket[0]);
+            maximum=qMax(maximum, (qint8)bucket[1]);
+            rms=qMax(rms, (quint8)bucket[2]);
+        }
+        qreal x=m_glowWidth+i+0.5,
+              rmsHeight=halfHeight*rms/255.0;
+        m_peakLines.append(QLineF(x, center-halfHeight*maximum/127.0,
+                                  x, center-halfHeight*minimum/127.0));
+        m_rmsLines.append(QLineF(x, center-rmsHeight,
+                                 x, center+rmsHeight));
+    }
+}
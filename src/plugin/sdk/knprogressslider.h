@@ -7,6 +7,9 @@
 #ifndef KNPROGRESSSLIDER_H
 #define KNPROGRESSSLIDER_H
 
+#include <QLine>
+#include <QVector>
+
 #include "knabstractslider.h"
 
 class QTimeLine;
@@ -15,6 +18,10 @@ class KNProgressSlider : public KNAbstractSlider
     Q_OBJECT
 public:
     explicit KNProgressSlider(QWidget *parent = 0);
+    //The waveform is the overview of the value range, every bucket is three
+    //bytes: the minimum and maximum as qint8, and the RMS as quint8. An empty
+    //waveform shows the plain bar.
+    void setWaveform(const QByteArray &waveform);
 
 signals:
 
@@ -24,6 +31,7 @@ protected:
     void enterEvent(QEvent *event);
     void leaveEvent(QEvent *event);
     void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
     void mousePressEvent(QMouseEvent *event);
     void mouseMoveEvent(QMouseEvent *event);
     void mouseReleaseEvent(QMouseEvent *event);
@@ -35,6 +43,7 @@ private:
     void configureTimeLine(QTimeLine *timeLine);
     void updateButtonSize();
     qint64 posToValue(int position);
+    void updateWaveformLines();
     int m_sliderHeight=4, m_glowWidth=5, m_buttonSize=14,
         m_spacing=2;
     bool m_pressed=false;
@@ -42,6 +51,10 @@ private:
            m_backgroundColor=QColor(255,255,255,80),
            m_buttonColor=QColor(255,255,255,110);
     QRadialGradient m_buttonGradient;
+    QByteArray m_waveform;
+    //The lines of the peak and the RMS of every column, they're only updated
+    //when the waveform or the width is changed.
+    QVector<QLineF> m_peakLines, m_rmsLines;
     QTimeLine *m_mouseIn, *m_mouseOut;
     qreal m_mouseOutOpacity=0.65,
           m_backOpacity=m_mouseOutOpacity;
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+
+#include "kntrace.h"
+
+#include <QDebug>
+
+//The events are saved in the chunks, a new chunk is linked when the current
+//one is full, so the recorded events are never moved.
+#define TraceChunkSize 4096
+
+struct KNTraceEvent
+{
+    const char *category;
+    const char *name;
+    qint64 start;
+    qint64 end;
+};
+
+struct KNTraceChunk
+{
+    KNTraceEvent events[TraceChunkSize];
+    //The count is published after the event is written, the dumper only reads
+    //the events before it.
+    QAtomicInt count;
+    QAtomicPointer<KNTraceChunk> next;
+};
+
+struct KNTraceBuffer
+{
+    KNTraceChunk *first;
+    KNTraceChunk *current;
+    int threadId;
+    QString threadName;
+};
+
+//The buffers are owned by the list, the events of the finished threads could
+//still be dumped.
+static QMutex traceBufferLock;
+static QList<KNTraceBuffer *> traceBuffers;
+static QElapsedTimer traceTimer;
+static bool traceTimerStarted=(traceTimer.start(), true);
+static thread_local KNTraceBuffer *threadBuffer=nullptr;
+
+static KNTraceBuffer *registerThreadBuffer()
+{
+    KNTraceBuffer *buffer=new KNTraceBuffer;
+    buffer->first=new KNTraceChunk;
+    buffer->current=buffer->first;
+    //Most of the threads are not named, use the class name of the thread.
+    QThread *thread=QThread::currentThread();
+    if(!thread->objectName().isEmpty())
+    {
+        buffer->threadName=thread->objectName();
+    }
+    else if(QCoreApplication::instance()!=nullptr &&
+            thread==QCoreApplication::instance()->thread())
+    {
+        buffer->threadName="Main Thread";
+    }
+    else
+    {
+        buffer->threadName=thread->metaObject()->className();
+    }
+    traceBufferLock.lock();
+    buffer->threadId=traceBuffers.size();
+    traceBuffers.append(buffer);
+    traceBufferLock.unlock();
+    return buffer;
+}
+
+//Escape the string for the JSON string.
+static inline void appendJsonString(QByteArray &json, const QByteArray &text)
+{
+    json.append('"');
+    for(auto i=text.constBegin(); i!=text.constEnd(); ++i)
+    {
+        if(*i=='"' || *i=='\\')
+        {
+            json.append('\\');
+        }
+        //The control characters are not allowed in the JSON string.
+        json.append((uchar)*i<0x20?' ':*i);
+    }
+    json.append('"');
+}
+
+qint64 KNTrace::timestamp()
+{
+    Q_UNUSED(traceTimerStarted)
+    return traceTimer.nsecsElapsed();
+}
+
+void KNTrace::addEvent(const char *category,
+                       const char *name,
+                       const qint64 &start,
+                       const qint64 &end)
+{
+    KNTraceBuffer *buffer=threadBuffer;
+    if(buffer==nullptr)
+    {
+        buffer=registerThreadBuffer();
+        threadBuffer=buffer;
+    }
+    //Only this thread writes the chunk, so the count could be loaded relaxed.
+    KNTraceChunk *chunk=buffer->current;
+    int index=chunk->count.load();
+    if(index==TraceChunkSize)
+    {
+        KNTraceChunk *nextChunk=new KNTraceChunk;
+        chunk->next.storeRelease(nextChunk);
+        buffer->current=nextChunk;
+        chunk=nextChunk;
+        index=0;
+    }
+    KNTraceEvent &event=chunk->events[index];
+    event.category=category;
+    event.name=name;
+    event.start=start;
+    event.end=end;
+    chunk->count.storeRelease(index+1);
+}
+
+bool KNTrace::dump(const QString &filePath)
+{
+    //Copy the buffer list, the buffers are never removed.
+    traceBufferLock.lock();
+    QList<KNTraceBuffer *> buffers=traceBuffers;
+    traceBufferLock.unlock();
+    QFile traceFile(filePath);
+    if(!traceFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    const QByteArray processId=
+            QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray json="{\"traceEvents\":[";
+    bool firstEvent=true;
+    for(auto i=buffers.constBegin(); i!=buffers.constEnd(); ++i)
+    {
+        const QByteArray threadId=QByteArray::number((*i)->threadId);
+        //The metadata event names the thread.
+        if(!firstEvent)
+        {
+            json.append(',');
+        }
+        firstEvent=false;
+        json.append("\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":");
+        json.append(processId);
+        json.append(",\"tid\":");
+        json.append(threadId);
+        json.append(",\"args\":{\"name\":");
+        appendJsonString(json, (*i)->threadName.toUtf8());
+        json.append("}}");
+        //The complete events, the time is in microseconds.
+        for(KNTraceChunk *chunk=(*i)->first;
+            chunk!=nullptr;
+            chunk=chunk->next.loadAcquire())
+        {
+            int count=chunk->count.loadAcquire();
+            for(int j=0; j<count; ++j)
+            {
+                const KNTraceEvent &event=chunk->events[j];
+                json.append(",\n{\"name\":");
+                appendJsonString(json, event.name);
+                json.append(",\"cat\":");
+                appendJsonString(json, event.category);
+                json.append(",\"ph\":\"X\",\"pid\":");
+                json.append(processId);
+                json.append(",\"tid\":");
+                json.append(threadId);
+                json.append(",\"ts\":");
+                json.append(QByteArray::number(event.start/1000.0, 'f', 3));
+                json.append(",\"dur\":");
+                json.append(QByteArray::number((event.end-event.start)/1000.0,
+                                               'f',
+                                               3));
+                json.append('}');
+            }
+            //Write the events chunk by chunk, the trace could be large.
+            traceFile.write(json);
+            json.clear();
+        }
+    }
+    json.append("\n],\"displayTimeUnit\":\"ms\"}\n");
+    traceFile.write(json);
+    traceFile.close();
+    return true;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) Kreogist Dev Team <kreogistdevteam@126.com>
+ * This work is free. You can redistribute it and/or modify it under the
+ * terms of the Do What The Fuck You Want To Public License, Version 2,
+ * as published by Sam Hocevar. See the COPYING file for more details.
+ */
+#ifndef KNTRACE_H
+#define KNTRACE_H
+
+#include <QString>
+
+/*
+ * The trace records how long the scopes take, and dumps them as the Chrome
+ * trace event JSON, which could be opened in chrome://tracing. Every thread
+ * appends the events to its own buffer without any lock, the mutex is only
+ * used once when a thread records its first event.
+ * The trace is only built with CONFIG+=trace, otherwise KNTraceScope() is
+ * expanded to nothing.
+ * The category and the name must be the static strings, only the pointers are
+ * saved.
+ */
+
+#ifdef ENABLE_TRACE
+
+class KNTrace
+{
+public:
+    //The nanoseconds since the application started.
+    static qint64 timestamp();
+    static void addEvent(const char *category,
+                         const char *name,
+                         const qint64 &start,
+                         const qint64 &end);
+    //Dump all the recorded events, it could be called from any thread while
+    //the others are still recording.
+    static bool dump(const QString &filePath);
+};
+
+class KNTraceScopeRecorder
+{
+public:
+    inline KNTraceScopeRecorder(const char *category, const char *name) :
+        m_category(category),
+        m_name(name),
+        m_start(KNTrace::timestamp())
+    {
+    }
+    inline ~KNTraceScopeRecorder()
+    {
+        KNTrace::addEvent(m_category, m_name, m_start, KNTrace::timestamp());
+    }
+
+private:
+    const char *m_category, *m_name;
+    qint64 m_start;
+};
+
+#define KNTraceJoin(a, b) a##b
+#define KNTraceVariable(line) KNTraceJoin(knTraceScope, line)
+#define KNTraceScope(category, name) \
+    KNTraceScopeRecorder KNTraceVariable(__LINE__)(category, name)
+
+#else
+
+#define KNTraceScope(category, name)
+
+#endif
+
+#endif // KNTRACE_H
@@ -0,0 +1,579 @@
+# Copyright (C) Kreogist Dev Team
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+# Add modules
+QT += core \
+      gui \
+      widgets \
+      xml \
+      network
+
+# Enable c++11
+CONFIG += c++11
+
+# Enable processor instruction sets when using release mode.
+release: {
+    CONFIG += mmx sse sse2 sse3
+    QMAKE_CXXFLAGS += -mmmx -msse -msse2 -msse3 -finline-functions
+}
+
+# Windows configure
+win32: {
+    CONFIG += libbass FFMpeg
+    QMAKE_CXXFLAGS += -fforce-addr
+    # Windows special extras.
+    QT += winextras
+    SOURCES += $$PWD/plugin/module/knwindowsextras/knwindowsextras.cpp
+    HEADERS += $$PWD/plugin/module/knwindowsextras/knwindowsextras.h
+}
+
+# UNIX common configure
+unix: {
+    LIBS += -ldl
+}
+
+# Mac OS X configure
+macx: {
+    # Brew configure. Use brew to install all your libs.
+    INCLUDEPATH += /usr/local/include/
+    LIBS += -L/usr/local/lib/
+    LIBS += -framework CoreFoundation
+
+    CONFIG += libbass
+    QMAKE_LFLAGS += -framework CoreFoundation
+}
+
+# Linux configure
+linux: {
+    CONFIG += libPhonon FFMpeg
+    QMAKE_CXXFLAGS += -fforce-addr
+}
+
+FFMpeg{
+    macx: {
+        LIBS += -lswscale
+    }
+    LIBS += -lavformat -lavcodec -lavutil -lswresample
+    DEFINES += ENABLE_FFMPEG
+    SOURCES += $$PWD/plugin/sdk/knffmpegglobal.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysiser.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysisjob.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysispool.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegaudioreader.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegfingerprinter.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegfingerprintconsumer.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegtemposcanner.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegtempoconsumer.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegloudnessconsumer.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegloudnessscanner.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegwaveformgenerator.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegwaveformjob.cpp
+    HEADERS += $$PWD/plugin/sdk/knffmpegglobal.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysiser.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysisconsumer.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysisjob.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpeganalysispool.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegaudioreader.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegfingerprinter.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegfingerprintconsumer.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegtemposcanner.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegtempoconsumer.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegloudnessconsumer.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegloudnessscanner.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegwaveformgenerator.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicffmpeganalysiser/knmusicffmpegwaveformjob.h
+}
+
+libPhonon{
+    contains(DEFINES, BACKEND_ENABLED){
+        error("You can't enable more than one backend at the same time.")
+    }
+    DEFINES += ENABLE_PHONON BACKEND_ENABLED
+    LIBS += -lphonon4qt5
+    SOURCES += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendphonon/knmusicbackendphonon.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendphonon/knmusicbackendphononthread.cpp
+    HEADERS += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendphonon/knmusicbackendphonon.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendphonon/knmusicbackendphononthread.h
+}
+
+libVLC{
+    contains(DEFINES, BACKEND_ENABLED){
+        error("You can't enable more than one backend at the same time.")
+    }
+    DEFINES += ENABLE_LIBVLC BACKEND_ENABLED
+    SOURCES += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendvlc/knmusicbackendvlc.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendvlc/knmusicvlcglobal.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendvlc/knmusicbackendvlcthread.cpp
+    HEADERS += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendvlc/knmusicbackendvlc.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendvlc/knmusicvlcglobal.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendvlc/knmusicbackendvlcthread.h
+}
+
+libFFMpegBackend{
+    contains(DEFINES, BACKEND_ENABLED){
+        error("You can't enable more than one backend at the same time.")
+    }
+    !FFMpeg{
+        error("FFMpeg backend needs FFMpeg to be enabled.")
+    }
+    QT += multimedia
+    DEFINES += ENABLE_FFMPEG_BACKEND BACKEND_ENABLED
+    SOURCES += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpeg.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpegthread.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegdecoder.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegringbuffer.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegsink.cpp
+    HEADERS += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpeg.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpegthread.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegdecoder.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegringbuffer.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegsink.h
+}
+
+libbass{
+    contains(DEFINES, BACKEND_ENABLED){
+        error("You can't enable more than one backend at the same time.")
+    }
+    LIBS += -lbass
+    DEFINES += ENABLE_LIBBASS BACKEND_ENABLED
+    SOURCES += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbassglobal.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbackendbass.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbassanalysiser.cpp \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbackendbassthread.cpp
+    HEADERS += $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbassglobal.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbackendbass.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbassanalysiser.h \
+               $$PWD/plugin/module/knmusicplugin/plugin/knmusicbackendbass/knmusicbackendbassthread.h
+}
+
+# Trace the import and playback pipelines, use CONFIG+=trace to enable it.
+trace{
+    DEFINES += ENABLE_TRACE
+    SOURCES += $$PWD/plugin/sdk/kntrace.cpp
+}
+
+# Add public path
+INCLUDEPATH += $$PWD/public
+# Add plugin and sdk path
+INCLUDEPATH += $$PWD/plugin \
+               $$PWD/plugin/sdk \
+               $$PWD/plugin/module/knmusicplugin/sdk
+
+SOURCES += \
+    $$PWD/core/knsingleapplication.cpp \
+    $$PWD/core/knpluginmanager.cpp \
+    $$PWD/public/knglobal.cpp \
+    $$PWD/plugin/base/knmainwindow/knmainwindow.cpp \
+    $$PWD/plugin/base/knmainwindow/knmainwindowcontainer.cpp \
+    $$PWD/plugin/base/knmainwindowheader/knmainwindowheader.cpp \
+    $$PWD/plugin/base/knmainwindowheader/knheadercontainer.cpp \
+    $$PWD/plugin/base/knmainwindowheader/knheaderbutton.cpp \
+    $$PWD/plugin/base/knmainwindowheader/knheaderswitcher.cpp \
+    $$PWD/plugin/sdk/knanimecheckedbutton.cpp \
+    $$PWD/plugin/sdk/knwidgetswitcher.cpp \
+    $$PWD/plugin/base/knmainwindowcategorystack/knmainwindowcategorystack.cpp \
+    $$PWD/plugin/sdk/knhwidgetswitcher.cpp \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/knmainwindowcategoryswitcher.cpp \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/kncategoryswitcherwidget.cpp \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/knabstractcategorybutton.cpp \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/kncategorysettingbutton.cpp \
+    $$PWD/plugin/base/knpreference/knpreference.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencecategory.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencecontents.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencepanel.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencetitle.cpp \
+    $$PWD/plugin/module/knmusicplugin/knmusicplugin.cpp \
+    $$PWD/plugin/sdk/kncategorybutton.cpp \
+    $$PWD/plugin/sdk/kncategorytabbar.cpp \
+    $$PWD/plugin/sdk/kncategorytabwidget.cpp \
+    $$PWD/plugin/base/knpreference/knpreferenceheaderbutton.cpp \
+    $$PWD/public/knfontmanager.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicglobal.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicstandardbackend.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicloudnessmeter.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicspectrumfeed.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicfft.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicchromafingerprint.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicduplicatefinder.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictempodetector.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicheaderplayer/knmusicheaderplayer.cpp \
+    $$PWD/plugin/sdk/knhighlightlabel.cpp \
+    $$PWD/plugin/sdk/knscrolllabel.cpp \
+    $$PWD/plugin/sdk/kngraphicsgloweffect.cpp \
+    $$PWD/plugin/sdk/knprogressslider.cpp \
+    $$PWD/plugin/sdk/knabstractslider.cpp \
+    $$PWD/plugin/sdk/kneditablelabel.cpp \
+    $$PWD/plugin/sdk/knopacityanimebutton.cpp \
+    $$PWD/plugin/sdk/knopacitybutton.cpp \
+    $$PWD/plugin/sdk/knvolumeslider.cpp \
+    $$PWD/plugin/sdk/kncancellineedit.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencecategorylist.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencecategoryitem.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicproxymodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicmodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicheaderlyrics/knmusicheaderlyrics.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/knmusicplaylistmanager.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylisttab.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistdisplay.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiccategorylistviewbase.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistview.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistvieweditor.cpp \
+    $$PWD/plugin/sdk/knanimationmenu.cpp \
+    $$PWD/plugin/sdk/knlinearsensewidget.cpp \
+    $$PWD/plugin/sdk/kndropproxycontainer.cpp \
+    $$PWD/plugin/sdk/knmousesensewidget.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictreeviewbase.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictreeviewheader.cpp \
+    $$PWD/plugin/sdk/knmousesenseheader.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictreeviewheadermenu.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylisttreeview.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistindex.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicsearcher.cpp \
+    $$PWD/plugin/sdk/knfilesearcher.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicmodelassist.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicrowmimedata.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicanalysiscache.cpp \
+    $$PWD/plugin/sdk/knpreferencewidgetspanel.cpp \
+    $$PWD/plugin/sdk/knvwidgetswitcher.cpp \
+    $$PWD/plugin/sdk/preference/knpreferenceitembase.cpp \
+    $$PWD/plugin/sdk/preference/knpreferenceitemswitcher.cpp \
+    $$PWD/plugin/sdk/knsideshadowwidget.cpp \
+    $$PWD/plugin/sdk/knanimeroundswitcher.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicsingleplaylistmodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistmodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistitem.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlist.cpp \
+    $$PWD/plugin/sdk/knconnectionhandler.cpp \
+    $$PWD/plugin/sdk/knanimecolorswitcher.cpp \
+    $$PWD/plugin/sdk/preference/knpreferenceitemlineedit.cpp \
+    $$PWD/plugin/sdk/preference/knpreferenceitemglobal.cpp \
+    $$PWD/plugin/sdk/preference/knpreferenceitempathbrowser.cpp \
+    $$PWD/plugin/sdk/knpathlineedit.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistdelegate.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicratingeditor.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicratingdelegate.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicsolomenu/knmusicsolomenu.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicmultimenu/knmusicmultimenu.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiccueparser/knmusiccueparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistassistant.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistloader.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistpathresolver.cpp \
+    $$PWD/plugin/sdk/knmessagebox.cpp \
+    $$PWD/plugin/sdk/messagebox/knmessageboxconfigure.cpp \
+    $$PWD/plugin/sdk/messagebox/knmessagecontent.cpp \
+    $$PWD/plugin/sdk/messagebox/knmessageblock.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetaildialog/knmusicdetaildialog.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetaildialog/knmusicdetailpanel.cpp \
+    $$PWD/core/knexpandmainwindow.cpp \
+    $$PWD/plugin/sdk/knemptystatewidget.cpp \
+    $$PWD/public/knlocalemanager.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencelanguageitem.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencelanguagepanel.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencelanguagepanelitem.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistemptyhint.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagid3v1/knmusictagid3v1.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagflac/knmusictagflac.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagid3v2/knmusictagid3v2.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetaildialog/knmusicdetailoverview.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagm4a/knmusictagm4a.cpp \
+    $$PWD/plugin/sdk/knfilepathlabel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagwma/knmusictagwma.cpp \
+    $$PWD/plugin/sdk/knsearchbox.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicsearch/knmusicsearch.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetailtooltip/knmusicdetailtooltip.cpp \
+    $$PWD/plugin/sdk/knmousedetectheader.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagapev2/knmusictagapev2.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagid3v2/knmusictagwav.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/knmusiclibrary.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarysongtab.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryartisttab.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryalbumtab.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarygenretab.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarytreeview.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarymodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarytab.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiccategorymodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiccategoryproxymodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarycategorytab.cpp \
+    $$PWD/plugin/sdk/knhashpixmaplist.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiccategorydisplay.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicanalysisextend.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryanalysisextend.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicgenremodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumview.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbummodel.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicxspfparser/knmusicxspfparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicttplparser/knmusicttplparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicm3uparser/knmusicm3uparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumdetail.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumtreeview.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumindexdelegate.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumtitle.cpp \
+    $$PWD/plugin/sdk/knjsondatabase.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryimagemanager.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryimagewriter.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryrecover.cpp \
+    $$PWD/plugin/sdk/knngnlbutton.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryemptyhint.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicwplparser/knmusicwplparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetailtooltip/knmusicdetailtooltipartwork.cpp \
+    $$PWD/plugin/sdk/preference/knpreferenceitemnumber.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicitunesxmlparser/knmusicitunesxmlparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicmainplayer/knmusicmainplayer.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicmainplayer/knmusicspectrumvisualizer.cpp \
+    $$PWD/plugin/sdk/sao/knsaostyle.cpp \
+    $$PWD/plugin/sdk/sao/knsaosubmenu.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicheaderplayer/knmusicheaderplayerappendmenu.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiccategorytabwidget.cpp \
+    $$PWD/plugin/sdk/preference/knpreferenceitemfont.cpp \
+    $$PWD/plugin/sdk/knfontdialog.cpp \
+    $$PWD/plugin/sdk/knmousedetectlabel.cpp \
+    $$PWD/plugin/base/knpreference/knpreferencegeneralpanel.cpp \
+    $$PWD/plugin/sdk/knlabelbutton.cpp \
+    $$PWD/public/knconfiguremanager.cpp \
+    $$PWD/plugin/sdk/knconfigure.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicnowplaying2/knmusicnowplaying2.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclrcparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclyricsdownloader.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicxiamilyrics/knmusicxiamilyrics.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicttpodlyrics/knmusicttpodlyrics.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicttplayerlyrics/knmusicttplayerlyrics.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicqqlyrics/knmusicqqlyrics.cpp \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicneteaselyrics/knmusicneteaselyrics.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclrclyricsparser.cpp \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclyricsmanager.cpp
+
+HEADERS += \
+    $$PWD/core/knsingleapplication.h \
+    $$PWD/core/knpluginmanager.h \
+    $$PWD/public/knglobal.h \
+    $$PWD/plugin/sdk/knmainwindowplugin.h \
+    $$PWD/plugin/base/knmainwindow/knmainwindow.h \
+    $$PWD/plugin/base/knmainwindow/knmainwindowcontainer.h \
+    $$PWD/plugin/sdk/knmainwindowheaderplugin.h \
+    $$PWD/plugin/base/knmainwindowheader/knmainwindowheader.h \
+    $$PWD/plugin/base/knmainwindowheader/knheadercontainer.h \
+    $$PWD/plugin/base/knmainwindowheader/knheaderbutton.h \
+    $$PWD/plugin/sdk/knabstractbutton.h \
+    $$PWD/plugin/sdk/knanimecheckedbutton.h \
+    $$PWD/plugin/base/knmainwindowheader/knheaderswitcher.h \
+    $$PWD/plugin/sdk/knwidgetswitcher.h \
+    $$PWD/plugin/sdk/knmainwindowcategorystackplugin.h \
+    $$PWD/plugin/base/knmainwindowcategorystack/knmainwindowcategorystack.h \
+    $$PWD/plugin/sdk/knhwidgetswitcher.h \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/knmainwindowcategoryswitcher.h \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/kncategoryswitcherwidget.h \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/knabstractcategorybutton.h \
+    $$PWD/plugin/base/knmainwindowcategoryswitcher/kncategorysettingbutton.h \
+    $$PWD/plugin/sdk/knmainwindowcategoryswitcherplugin.h \
+    $$PWD/plugin/sdk/knpreferenceplugin.h \
+    $$PWD/plugin/base/knpreference/knpreference.h \
+    $$PWD/plugin/base/knpreference/knpreferencecategory.h \
+    $$PWD/plugin/base/knpreference/knpreferencecontents.h \
+    $$PWD/plugin/base/knpreference/knpreferencepanel.h \
+    $$PWD/plugin/base/knpreference/knpreferencetitle.h \
+    $$PWD/plugin/sdk/kncategoryplugin.h \
+    $$PWD/plugin/module/knmusicplugin/knmusicplugin.h \
+    $$PWD/plugin/sdk/kncategorybutton.h \
+    $$PWD/plugin/sdk/kncategorytabbar.h \
+    $$PWD/plugin/sdk/kncategorytabwidget.h \
+    $$PWD/plugin/sdk/knabstractmusicplugin.h \
+    $$PWD/plugin/base/knpreference/knpreferenceheaderbutton.h \
+    $$PWD/public/knfontmanager.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicbackend.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicglobal.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicbackendthread.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicstandardbackend.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicparser.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicanalysiser.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicloudnessmeter.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicloudnessscanner.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicwaveformgenerator.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicspectrumfeed.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicfft.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicchromafingerprint.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicduplicatefinder.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicfingerprinter.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictempodetector.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictemposcanner.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictagpraser.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclistparser.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicheaderplayerbase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicheaderplayer/knmusicheaderplayer.h \
+    $$PWD/plugin/sdk/knhighlightlabel.h \
+    $$PWD/plugin/sdk/knscrolllabel.h \
+    $$PWD/plugin/sdk/kngraphicsgloweffect.h \
+    $$PWD/plugin/sdk/knprogressslider.h \
+    $$PWD/plugin/sdk/knabstractslider.h \
+    $$PWD/plugin/sdk/kneditablelabel.h \
+    $$PWD/plugin/sdk/knopacityanimebutton.h \
+    $$PWD/plugin/sdk/knopacitybutton.h \
+    $$PWD/plugin/sdk/knvolumeslider.h \
+    $$PWD/plugin/sdk/kncancellineedit.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicnowplayingbase.h \
+    $$PWD/plugin/base/knpreference/knpreferencecategorylist.h \
+    $$PWD/plugin/base/knpreference/knpreferencecategoryitem.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicproxymodel.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicmodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicheaderlyrics/knmusicheaderlyrics.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictab.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicplaylistmanagerbase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/knmusicplaylistmanager.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylisttab.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistdisplay.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiccategorylistviewbase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistview.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistvieweditor.h \
+    $$PWD/plugin/sdk/knanimationmenu.h \
+    $$PWD/plugin/sdk/knlinearsensewidget.h \
+    $$PWD/plugin/sdk/kndropproxycontainer.h \
+    $$PWD/plugin/sdk/knmousesensewidget.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictreeviewbase.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictreeviewheader.h \
+    $$PWD/plugin/sdk/knmousesenseheader.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusictreeviewheadermenu.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylisttreeview.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistindex.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicsearcher.h \
+    $$PWD/plugin/sdk/knfilesearcher.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicmodelassist.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicrowmimedata.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicanalysiscache.h \
+    $$PWD/plugin/sdk/preference/knpreferenceitembase.h \
+    $$PWD/plugin/sdk/knpreferencewidgetspanel.h \
+    $$PWD/plugin/sdk/knvwidgetswitcher.h \
+    $$PWD/plugin/sdk/preference/knpreferenceitemswitcher.h \
+    $$PWD/plugin/sdk/knsideshadowwidget.h \
+    $$PWD/plugin/sdk/knanimeroundswitcher.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicsingleplaylistmodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistmodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistitem.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlist.h \
+    $$PWD/plugin/sdk/knconnectionhandler.h \
+    $$PWD/plugin/sdk/knanimecolorswitcher.h \
+    $$PWD/plugin/sdk/preference/knpreferenceitemlineedit.h \
+    $$PWD/plugin/sdk/preference/knpreferenceitemglobal.h \
+    $$PWD/plugin/sdk/preference/knpreferenceitempathbrowser.h \
+    $$PWD/plugin/sdk/knpathlineedit.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistdelegate.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicratingeditor.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicratingdelegate.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicsolomenubase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicsolomenu/knmusicsolomenu.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicmultimenubase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicmultimenu/knmusicmultimenu.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiccueparser/knmusiccueparser.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistlistassistant.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistparser.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistloader.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistpathresolver.h \
+    $$PWD/plugin/sdk/knmessagebox.h \
+    $$PWD/plugin/sdk/messagebox/knmessageboxconfigure.h \
+    $$PWD/plugin/sdk/messagebox/knmessagecontent.h \
+    $$PWD/plugin/sdk/messagebox/knmessageblock.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetaildialog/knmusicdetaildialog.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicdetaildialogbase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetaildialog/knmusicdetailpanel.h \
+    $$PWD/core/knexpandmainwindow.h \
+    $$PWD/plugin/sdk/knemptystatewidget.h \
+    $$PWD/public/knlocalemanager.h \
+    $$PWD/plugin/base/knpreference/knpreferencelanguageitem.h \
+    $$PWD/plugin/base/knpreference/knpreferencelanguagepanel.h \
+    $$PWD/plugin/base/knpreference/knpreferencelanguagepanelitem.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/sdk/knmusicplaylistemptyhint.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagid3v1/knmusictagid3v1.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagflac/knmusictagflac.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagid3v2/knmusictagid3v2.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetaildialog/knmusicdetailoverview.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagm4a/knmusictagm4a.h \
+    $$PWD/plugin/sdk/knfilepathlabel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagwma/knmusictagwma.h \
+    $$PWD/plugin/sdk/knsearchbox.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicsearch/knmusicsearch.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicsearchbase.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicdetailtooltipbase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetailtooltip/knmusicdetailtooltip.h \
+    $$PWD/plugin/sdk/knplatformextras.h \
+    $$PWD/plugin/sdk/knmousedetectheader.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagapev2/knmusictagapev2.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusictagid3v2/knmusictagwav.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclibrarybase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/knmusiclibrary.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarysongtab.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryartisttab.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryalbumtab.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarygenretab.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarytreeview.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarymodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarytab.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiccategorymodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiccategoryproxymodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibrarycategorytab.h \
+    $$PWD/plugin/sdk/knhashpixmaplist.h \
+    $$PWD/plugin/sdk/kntrace.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiccategorydisplay.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicanalysisextend.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryanalysisextend.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicgenremodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumview.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbummodel.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicxspfparser/knmusicxspfparser.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicttplparser/knmusicttplparser.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicm3uparser/knmusicm3uparser.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumdetail.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumtreeview.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumindexdelegate.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusicalbumtitle.h \
+    $$PWD/plugin/sdk/knjsondatabase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryimagemanager.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryimagewriter.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryrecover.h \
+    $$PWD/plugin/sdk/knngnlbutton.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusiclibrary/sdk/knmusiclibraryemptyhint.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicwplparser/knmusicwplparser.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicdetailtooltip/knmusicdetailtooltipartwork.h \
+    $$PWD/plugin/sdk/preference/knpreferenceitemnumber.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicplaylistmanager/plugin/knmusicitunesxmlparser/knmusicitunesxmlparser.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusicmainplayerbase.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicmainplayer/knmusicmainplayer.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicmainplayer/knmusicspectrumvisualizer.h \
+    $$PWD/plugin/sdk/sao/knsaostyle.h \
+    $$PWD/plugin/sdk/sao/knsaosubmenu.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicheaderplayer/knmusicheaderplayerappendmenu.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiccategorytabwidget.h \
+    $$PWD/plugin/sdk/preference/knpreferenceitemfont.h \
+    $$PWD/plugin/sdk/knfontdialog.h \
+    $$PWD/plugin/sdk/knmousedetectlabel.h \
+    $$PWD/plugin/base/knpreference/knpreferencegeneralpanel.h \
+    $$PWD/core/knversion.h \
+    $$PWD/plugin/sdk/knlabelbutton.h \
+    $$PWD/public/knconfiguremanager.h \
+    $$PWD/plugin/sdk/knconfigure.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicnowplaying2/knmusicnowplaying2.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclrcparser.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclyricsdownloader.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicxiamilyrics/knmusicxiamilyrics.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicttpodlyrics/knmusicttpodlyrics.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicttplayerlyrics/knmusicttplayerlyrics.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicqqlyrics/knmusicqqlyrics.h \
+    $$PWD/plugin/module/knmusicplugin/plugin/knmusicneteaselyrics/knmusicneteaselyrics.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclrclyricsparser.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclyricsmanager.h \
+    $$PWD/plugin/module/knmusicplugin/sdk/knmusiclyricsbase.h
+
+RESOURCES += \
+    $$PWD/resource/res.qrc
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QDataStream>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTest>
+#include <QtMath>
+
+#include "module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpeg.h"
+#include "module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicbackendffmpegthread.h"
+#include "module/knmusicplugin/plugin/knmusicbackendffmpeg/knmusicffmpegdecoder.h"
+
+#include "knbackendffmpegtest.h"
+
+//The test files are 16-bit stereo at 44.1kHz, a second and a half second.
+#define TestSampleRate 44100
+#define MainFrames 44100
+#define PreviewFrames 22050
+//The files are played faster than real time, but give the slow machines some
+//time.
+#define PlayTimeout 10000
+
+KNBackendFFMpegTest::KNBackendFFMpegTest(QObject *parent) :
+    QObject(parent),
+    m_backend(nullptr)
+{
+}
+
+void KNBackendFFMpegTest::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+    QVERIFY(writeWave(m_tempDir.path()+"/main.source.wav", MainFrames));
+    QVERIFY(writeWave(m_tempDir.path()+"/previewA.source.wav", PreviewFrames));
+    QVERIFY(writeWave(m_tempDir.path()+"/previewB.source.wav", PreviewFrames));
+    //The sinks write the decoded samples to the temporary folder.
+    m_backend=new KNMusicBackendFFMpeg(this,
+                                       KNMusicBackendFFMpeg::FileSink,
+                                       m_tempDir.path());
+}
+
+void KNBackendFFMpegTest::cleanupTestCase()
+{
+    //The sinks finish their files when they are stopped.
+    delete m_backend;
+    m_backend=nullptr;
+}
+
+void KNBackendFFMpegTest::playMain()
+{
+    QSignalSpy finishedSpy(m_backend, SIGNAL(finished()));
+    KNMusicFFMpegDecoder *decoder=m_backend->mainThread()->decoder();
+    qint64 startFrames=decoder->decodedFrames();
+    QVERIFY(m_backend->loadMusic(m_tempDir.path()+"/main.source.wav"));
+    m_backend->play();
+    QVERIFY(finishedSpy.wait(PlayTimeout));
+    //All the frames are decoded and written as the stereo float samples.
+    QCOMPARE(decoder->decodedFrames()-startFrames, (qint64)MainFrames);
+    QVERIFY(decoder->decodeNanoseconds()>0);
+    m_backend->resetMainPlayer();
+    QCOMPARE(waveDataSize(m_tempDir.path()+"/main.wav"),
+             (qint64)MainFrames*2*sizeof(float));
+}
+
+void KNBackendFFMpegTest::previewThreadsWriteOwnFiles()
+{
+    QSignalSpy finishedSpy(m_backend, SIGNAL(previewFinished()));
+    m_backend->playPreviewFile(m_tempDir.path()+"/previewA.source.wav");
+    KNMusicBackendFFMpegThread *firstThread=m_backend->previewThread();
+    QVERIFY(finishedSpy.wait(PlayTimeout));
+    //The second file is opened in another new thread, the cache isn't full.
+    m_backend->playPreviewFile(m_tempDir.path()+"/previewB.source.wav");
+    KNMusicBackendFFMpegThread *secondThread=m_backend->previewThread();
+    QVERIFY(secondThread!=firstThread);
+    QVERIFY(finishedSpy.wait(PlayTimeout));
+    m_backend->stopPreview();
+    //Both of the threads have finished their own files.
+    QCOMPARE(waveDataSize(m_tempDir.path()+"/preview-1.wav"),
+             (qint64)PreviewFrames*2*sizeof(float));
+    QCOMPARE(waveDataSize(m_tempDir.path()+"/preview-2.wav"),
+             (qint64)PreviewFrames*2*sizeof(float));
+}
+
+inline bool KNBackendFFMpegTest::writeWave(const QString &filePath,
+                                           const int &frameCount)
+{
+    QFile waveFile(filePath);
+    if(!waveFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    QDataStream waveStream(&waveFile);
+    waveStream.setByteOrder(QDataStream::LittleEndian);
+    quint32 dataSize=frameCount*4;
+    //RIFF chunk and format chunk, 1 is the integer PCM.
+    waveStream.writeRawData("RIFF", 4);
+    waveStream<<(quint32)(36+dataSize);
+    waveStream.writeRawData("WAVEfmt ", 8);
+    waveStream<<(quint32)16
+              <<(quint16)1
+              <<(quint16)2
+              <<(quint32)TestSampleRate
+              <<(quint32)(TestSampleRate*4)
+              <<(quint16)4
+              <<(quint16)16;
+    //A 440Hz sine in both channels.
+    waveStream.writeRawData("data", 4);
+    waveStream<<dataSize;
+    for(int i=0; i<frameCount; ++i)
+    {
+        qint16 sample=(qint16)(qSin(2.0*M_PI*440.0*i/TestSampleRate)*8192.0);
+        waveStream<<sample<<sample;
+    }
+    return waveStream.status()==QDataStream::Ok;
+}
+
+inline qint64 KNBackendFFMpegTest::waveDataSize(const QString &filePath)
+{
+    //The file sink writes a 44 bytes header before the samples.
+    QFile waveFile(filePath);
+    return waveFile.exists()?waveFile.size()-44:-1;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNBACKENDFFMPEGTEST_H
+#define KNBACKENDFFMPEGTEST_H
+
+#include <QTemporaryDir>
+
+#include <QObject>
+
+/*
+ * The FFMpeg backend plays the generated wave files with the file sinks, the
+ * decoded samples are checked in the wave files written by the sinks.
+ */
+
+class KNMusicBackendFFMpeg;
+class KNBackendFFMpegTest : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KNBackendFFMpegTest(QObject *parent = 0);
+
+signals:
+
+public slots:
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void playMain();
+    void previewThreadsWriteOwnFiles();
+
+private:
+    inline bool writeWave(const QString &filePath, const int &frameCount);
+    inline qint64 waveDataSize(const QString &filePath);
+    QTemporaryDir m_tempDir;
+    KNMusicBackendFFMpeg *m_backend;
+};
+
+#endif // KNBACKENDFFMPEGTEST_H
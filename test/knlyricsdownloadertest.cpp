@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QSignalSpy>
+#include <QTest>
+
+#include "knmusiclyricsmanager.h"
+
+#include "knlyricstestdownloader.h"
+#include "knlyricstestserver.h"
+
+#include "knlyricsdownloadertest.h"
+
+#define TestArtist "Artist"
+#define TestLyrics "[00:01.00]First line\n[00:05.00]Second line\n"
+
+KNLyricsDownloaderTest::KNLyricsDownloaderTest(QObject *parent) :
+    QObject(parent),
+    m_server(nullptr),
+    m_fastDownloader(nullptr),
+    m_slowDownloader(nullptr),
+    m_lyricsManager(nullptr)
+{
+}
+
+void KNLyricsDownloaderTest::initTestCase()
+{
+    m_server=new KNLyricsTestServer(this);
+    QVERIFY(m_server->listen(QHostAddress::LocalHost));
+    m_lyricsManager=new KNMusicLyricsManager(this);
+    //The manager owns the downloaders.
+    m_fastDownloader=new KNLyricsTestDownloader("fast", m_server->baseUrl());
+    m_slowDownloader=new KNLyricsTestDownloader("slow", m_server->baseUrl());
+    m_lyricsManager->installLyricsDownloader(m_fastDownloader);
+    m_lyricsManager->installLyricsDownloader(m_slowDownloader);
+}
+
+void KNLyricsDownloaderTest::exactResultCancelsOthers()
+{
+    //Both servers are waiting, the slow one never answers.
+    m_server->setHanging(searchTarget("fast", "SongA"));
+    m_server->setHanging(searchTarget("slow", "SongA"));
+    m_server->setResponse("/fast/lyrics/SongA", TestLyrics);
+    QSignalSpy receivedSpy(m_server, SIGNAL(requestReceived(QString)));
+    QSignalSpy abortedSpy(m_server, SIGNAL(requestAborted(QString)));
+    QSignalSpy updateSpy(m_lyricsManager, SIGNAL(lyricsUpdate()));
+    m_lyricsManager->downloadLyrics(songInfo("SongA"));
+    QTRY_COMPARE(receivedSpy.count(), 2);
+    //The exact title of the fast server is used at once.
+    m_server->setResponse(searchTarget("fast", "SongA"), "/fast/lyrics/SongA");
+    QTRY_COMPARE(updateSpy.count(), 1);
+    QCOMPARE(m_lyricsManager->textList().size(), 2);
+    QCOMPARE(m_lyricsManager->musicDetailInfo().textLists[Name],
+             QString("SongA"));
+    //The request of the slow server is aborted.
+    QVERIFY(!m_slowDownloader->isRunning());
+    QTRY_COMPARE(abortedSpy.count(), 1);
+    QCOMPARE(abortedSpy.first().first().toString(),
+             searchTarget("slow", "SongA"));
+}
+
+void KNLyricsDownloaderTest::cachedLyrics()
+{
+    m_server->setResponse(searchTarget("fast", "SongB"), "/fast/lyrics/SongB");
+    m_server->setResponse("/fast/lyrics/SongB", TestLyrics);
+    QSignalSpy updateSpy(m_lyricsManager, SIGNAL(lyricsUpdate()));
+    m_lyricsManager->downloadLyrics(songInfo("SongB"));
+    QTRY_COMPARE(updateSpy.count(), 1);
+    //The slow server has no lyrics, wait for it to be finished or cancelled.
+    QTRY_VERIFY(!m_slowDownloader->isRunning());
+    int requestCount=m_server->requestCount("/fast/lyrics/SongB");
+    QCOMPARE(requestCount, 1);
+    //The lyrics is applied from the cache without any request.
+    m_lyricsManager->downloadLyrics(songInfo("SongB"));
+    QCOMPARE(updateSpy.count(), 2);
+    QVERIFY(!m_fastDownloader->isRunning());
+    QVERIFY(!m_slowDownloader->isRunning());
+    QCOMPARE(m_server->requestCount(searchTarget("fast", "SongB")), 1);
+    QCOMPARE(m_server->requestCount("/fast/lyrics/SongB"), requestCount);
+}
+
+void KNLyricsDownloaderTest::cachedMiss()
+{
+    //No server knows the song.
+    QSignalSpy updateSpy(m_lyricsManager, SIGNAL(lyricsUpdate()));
+    QSignalSpy fastFinishedSpy(m_fastDownloader, SIGNAL(finished()));
+    QSignalSpy slowFinishedSpy(m_slowDownloader, SIGNAL(finished()));
+    m_lyricsManager->downloadLyrics(songInfo("SongC"));
+    QTRY_COMPARE(fastFinishedSpy.count(), 1);
+    QTRY_COMPARE(slowFinishedSpy.count(), 1);
+    QCOMPARE(updateSpy.count(), 0);
+    QCOMPARE(m_server->requestCount(searchTarget("fast", "SongC")), 1);
+    QCOMPARE(m_server->requestCount(searchTarget("slow", "SongC")), 1);
+    //The miss is cached, the servers won't be asked again.
+    m_lyricsManager->downloadLyrics(songInfo("SongC"));
+    QVERIFY(!m_fastDownloader->isRunning());
+    QVERIFY(!m_slowDownloader->isRunning());
+    QTest::qWait(100);
+    QCOMPARE(updateSpy.count(), 0);
+    QCOMPARE(m_server->requestCount(searchTarget("fast", "SongC")), 1);
+    QCOMPARE(m_server->requestCount(searchTarget("slow", "SongC")), 1);
+}
+
+void KNLyricsDownloaderTest::songChangeCancelsRequests()
+{
+    m_server->setHanging(searchTarget("fast", "SongD"));
+    m_server->setHanging(searchTarget("slow", "SongD"));
+    m_server->setResponse(searchTarget("fast", "SongE"), "/fast/lyrics/SongE");
+    m_server->setResponse("/fast/lyrics/SongE", TestLyrics);
+    QSignalSpy receivedSpy(m_server, SIGNAL(requestReceived(QString)));
+    QSignalSpy abortedSpy(m_server, SIGNAL(requestAborted(QString)));
+    QSignalSpy updateSpy(m_lyricsManager, SIGNAL(lyricsUpdate()));
+    m_lyricsManager->downloadLyrics(songInfo("SongD"));
+    QTRY_COMPARE(receivedSpy.count(), 2);
+    //Downloading the next song aborts the requests of the previous one.
+    m_lyricsManager->downloadLyrics(songInfo("SongE"));
+    QTRY_COMPARE(abortedSpy.count(), 2);
+    QStringList abortedTargets;
+    for(QList<QList<QVariant> >::iterator i=abortedSpy.begin();
+        i!=abortedSpy.end();
+        ++i)
+    {
+        abortedTargets.append((*i).first().toString());
+    }
+    QVERIFY(abortedTargets.contains(searchTarget("fast", "SongD")));
+    QVERIFY(abortedTargets.contains(searchTarget("slow", "SongD")));
+    QTRY_COMPARE(updateSpy.count(), 1);
+    QCOMPARE(m_lyricsManager->musicDetailInfo().textLists[Name],
+             QString("SongE"));
+}
+
+inline KNMusicDetailInfo KNLyricsDownloaderTest::songInfo(const QString &title)
+{
+    KNMusicDetailInfo detailInfo;
+    detailInfo.textLists[Name]=title;
+    detailInfo.textLists[Artist]=TestArtist;
+    return detailInfo;
+}
+
+inline QString KNLyricsDownloaderTest::searchTarget(const QString &downloader,
+                                                    const QString &title)
+{
+    return KNLyricsTestDownloader::searchTarget(downloader, TestArtist, title);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNLYRICSDOWNLOADERTEST_H
+#define KNLYRICSDOWNLOADERTEST_H
+
+#include "knmusicglobal.h"
+
+#include <QObject>
+
+using namespace KNMusic;
+
+/*
+ * The lyrics manager runs two test downloaders, "fast" and "slow", against
+ * the test server. The tests share the manager, so the result cache is kept
+ * between them, every test uses its own songs.
+ */
+
+class KNLyricsTestServer;
+class KNLyricsTestDownloader;
+class KNMusicLyricsManager;
+class KNLyricsDownloaderTest : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KNLyricsDownloaderTest(QObject *parent = 0);
+
+signals:
+
+public slots:
+
+private slots:
+    void initTestCase();
+    void exactResultCancelsOthers();
+    void cachedLyrics();
+    void cachedMiss();
+    void songChangeCancelsRequests();
+
+private:
+    inline KNMusicDetailInfo songInfo(const QString &title);
+    inline QString searchTarget(const QString &downloader,
+                                const QString &title);
+    KNLyricsTestServer *m_server;
+    KNLyricsTestDownloader *m_fastDownloader, *m_slowDownloader;
+    KNMusicLyricsManager *m_lyricsManager;
+};
+
+#endif // KNLYRICSDOWNLOADERTEST_H
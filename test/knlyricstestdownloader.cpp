@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QUrl>
+
+#include "knlyricstestdownloader.h"
+
+KNLyricsTestDownloader::KNLyricsTestDownloader(const QString &name,
+                                               const QString &baseUrl,
+                                               QObject *parent) :
+    KNMusicLyricsDownloader(parent),
+    m_name(name),
+    m_baseUrl(baseUrl)
+{
+}
+
+QString KNLyricsTestDownloader::downloaderName()
+{
+    return m_name;
+}
+
+QString KNLyricsTestDownloader::searchTarget(const QString &name,
+                                             const QString &artist,
+                                             const QString &title)
+{
+    return "/"+name+"/search?artist="+
+            QString::fromLatin1(QUrl::toPercentEncoding(artist))+
+            "&title="+
+            QString::fromLatin1(QUrl::toPercentEncoding(title));
+}
+
+void KNLyricsTestDownloader::search(const KNMusicDetailInfo &detailInfo)
+{
+    get(m_baseUrl+searchTarget(m_name,
+                               detailInfo.textLists[Artist],
+                               detailInfo.textLists[Name]),
+        SearchStep);
+}
+
+void KNLyricsTestDownloader::processReply(const int &step,
+                                          const QByteArray &responseData,
+                                          const QVariant &user)
+{
+    Q_UNUSED(user)
+    //A failed or an empty response means no lyrics.
+    if(responseData.isEmpty())
+    {
+        return;
+    }
+    switch(step)
+    {
+    case SearchStep:
+        get(m_baseUrl+QString::fromUtf8(responseData.trimmed()), LyricsStep);
+        break;
+    case LyricsStep:
+    {
+        //The server only keeps the lyrics of the songs it's asked for.
+        KNMusicLyricsDetails currentDetails;
+        currentDetails.title=detailInfo().textLists[Name];
+        currentDetails.artist=detailInfo().textLists[Artist];
+        saveLyrics(detailInfo(),
+                   QString::fromUtf8(responseData),
+                   currentDetails);
+        emit lyricsDownloaded(currentDetails);
+        break;
+    }
+    }
+}
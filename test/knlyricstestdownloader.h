@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNLYRICSTESTDOWNLOADER_H
+#define KNLYRICSTESTDOWNLOADER_H
+
+#include "knmusiclyricsdownloader.h"
+
+/*
+ * The test downloader searches the lyrics on the test server. It asks
+ * "<base>/<name>/search?artist=<artist>&title=<title>" first, a non-empty
+ * response is the path of the lyrics on the server, which is fetched at the
+ * second step.
+ */
+
+class KNLyricsTestDownloader : public KNMusicLyricsDownloader
+{
+    Q_OBJECT
+public:
+    explicit KNLyricsTestDownloader(const QString &name,
+                                    const QString &baseUrl,
+                                    QObject *parent = 0);
+    QString downloaderName();
+    static QString searchTarget(const QString &name,
+                                const QString &artist,
+                                const QString &title);
+
+signals:
+
+public slots:
+
+protected:
+    void search(const KNMusicDetailInfo &detailInfo);
+    void processReply(const int &step,
+                      const QByteArray &responseData,
+                      const QVariant &user);
+
+private:
+    enum DownloadSteps
+    {
+        SearchStep,
+        LyricsStep
+    };
+    QString m_name, m_baseUrl;
+};
+
+#endif // KNLYRICSTESTDOWNLOADER_H
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QTcpSocket>
+
+#include "knlyricstestserver.h"
+
+#include <QDebug>
+
+KNLyricsTestServer::KNLyricsTestServer(QObject *parent) :
+    QTcpServer(parent)
+{
+    connect(this, &KNLyricsTestServer::newConnection,
+            this, &KNLyricsTestServer::onActionNewConnection);
+}
+
+QString KNLyricsTestServer::baseUrl() const
+{
+    return "http://127.0.0.1:"+QString::number(serverPort());
+}
+
+void KNLyricsTestServer::setResponse(const QString &target,
+                                     const QByteArray &response)
+{
+    m_responses.insert(target, response);
+    //Answer the requests which are waiting for the response.
+    m_hangingTargets.remove(target);
+    for(QHash<QTcpSocket *, ConnectionInfo>::iterator i=m_connections.begin();
+        i!=m_connections.end();
+        ++i)
+    {
+        if(i.value().target==target && !i.value().answered)
+        {
+            answer(i.key(), i.value());
+        }
+    }
+}
+
+void KNLyricsTestServer::setHanging(const QString &target)
+{
+    m_hangingTargets.insert(target);
+}
+
+int KNLyricsTestServer::requestCount(const QString &target) const
+{
+    return m_requestCounts.value(target);
+}
+
+void KNLyricsTestServer::onActionNewConnection()
+{
+    while(hasPendingConnections())
+    {
+        QTcpSocket *socket=nextPendingConnection();
+        m_connections.insert(socket, ConnectionInfo());
+        connect(socket, &QTcpSocket::readyRead,
+                this, &KNLyricsTestServer::onActionReadyRead);
+        connect(socket, &QTcpSocket::disconnected,
+                this, &KNLyricsTestServer::onActionDisconnected);
+    }
+}
+
+void KNLyricsTestServer::onActionReadyRead()
+{
+    QTcpSocket *socket=static_cast<QTcpSocket *>(sender());
+    ConnectionInfo &connection=m_connections[socket];
+    connection.data.append(socket->readAll());
+    //Wait for the whole header and the body of the request.
+    int headerEnd=connection.data.indexOf("\r\n\r\n");
+    if(!connection.target.isEmpty() || headerEnd==-1)
+    {
+        return;
+    }
+    QList<QByteArray> headerLines=connection.data.left(headerEnd).split('\n');
+    int contentLength=0;
+    for(QList<QByteArray>::iterator i=headerLines.begin()+1;
+        i!=headerLines.end();
+        ++i)
+    {
+        if((*i).toLower().startsWith("content-length:"))
+        {
+            contentLength=(*i).mid(15).trimmed().toInt();
+        }
+    }
+    if(connection.data.size()<headerEnd+4+contentLength)
+    {
+        return;
+    }
+    //The request line is "METHOD target HTTP/1.1".
+    QList<QByteArray> requestLine=headerLines.first().trimmed().split(' ');
+    if(requestLine.size()<2)
+    {
+        socket->disconnectFromHost();
+        return;
+    }
+    connection.target=QString::fromLatin1(requestLine.at(1));
+    ++m_requestCounts[connection.target];
+    emit requestReceived(connection.target);
+    if(!m_hangingTargets.contains(connection.target))
+    {
+        answer(socket, connection);
+    }
+}
+
+void KNLyricsTestServer::onActionDisconnected()
+{
+    QTcpSocket *socket=static_cast<QTcpSocket *>(sender());
+    ConnectionInfo connection=m_connections.take(socket);
+    socket->deleteLater();
+    if(!connection.target.isEmpty() && !connection.answered)
+    {
+        emit requestAborted(connection.target);
+    }
+}
+
+inline void KNLyricsTestServer::answer(QTcpSocket *socket,
+                                       ConnectionInfo &connection)
+{
+    QByteArray response;
+    if(m_responses.contains(connection.target))
+    {
+        QByteArray body=m_responses.value(connection.target);
+        response="HTTP/1.1 200 OK\r\n"
+                 "Content-Type: text/plain; charset=utf-8\r\n"
+                 "Content-Length: "+QByteArray::number(body.size())+"\r\n"
+                 "Connection: close\r\n\r\n"+body;
+    }
+    else
+    {
+        response="HTTP/1.1 404 Not Found\r\n"
+                 "Content-Length: 0\r\n"
+                 "Connection: close\r\n\r\n";
+    }
+    connection.answered=true;
+    socket->write(response);
+    socket->disconnectFromHost();
+}
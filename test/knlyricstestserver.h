@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KNLYRICSTESTSERVER_H
+#define KNLYRICSTESTSERVER_H
+
+#include <QHash>
+#include <QSet>
+
+#include <QTcpServer>
+
+/*
+ * The test server is a stand-in of the lyrics servers. It answers the HTTP
+ * requests with the canned responses of the request targets, e.g.
+ * "/fast/search?artist=A&title=T". A target without a response gets a 404,
+ * and a hanging target is not answered until its response is set, so the
+ * client could abort it.
+ */
+
+class QTcpSocket;
+class KNLyricsTestServer : public QTcpServer
+{
+    Q_OBJECT
+public:
+    explicit KNLyricsTestServer(QObject *parent = 0);
+    QString baseUrl() const;
+    void setResponse(const QString &target, const QByteArray &response);
+    void setHanging(const QString &target);
+    int requestCount(const QString &target) const;
+
+signals:
+    void requestReceived(const QString &target);
+    //The client closed the connection before it's answered.
+    void requestAborted(const QString &target);
+
+public slots:
+
+private slots:
+    void onActionNewConnection();
+    void onActionReadyRead();
+    void onActionDisconnected();
+
+private:
+    struct ConnectionInfo
+    {
+        QByteArray data;
+        QString target;
+        bool answered=false;
+    };
+    inline void answer(QTcpSocket *socket, ConnectionInfo &connection);
+    QHash<QTcpSocket *, ConnectionInfo> m_connections;
+    QHash<QString, QByteArray> m_responses;
+    QHash<QString, int> m_requestCounts;
+    QSet<QString> m_hangingTargets;
+};
+
+#endif // KNLYRICSTESTSERVER_H
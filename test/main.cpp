@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) Kreogist Dev Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include <QApplication>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "knmusicglobal.h"
+
+#ifdef ENABLE_FFMPEG_BACKEND
+#include "knbackendffmpegtest.h"
+#endif
+#include "knlyricsdownloadertest.h"
+
+int main(int argc, char *argv[])
+{
+    //The music global needs the widgets, run the tests without a display if
+    //no platform is specified.
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("mu-test");
+    //Never touch the library of the user, the downloaded lyrics are saved in a
+    //temporary folder.
+    QTemporaryDir libraryDir;
+    if(!libraryDir.isValid())
+    {
+        return EXIT_FAILURE;
+    }
+    KNMusicGlobal::instance();
+    KNMusicGlobal::setMusicLibraryPath(libraryDir.path()+"/Music");
+    //Run all the tests, any failed test fails the run.
+    int result=0;
+    KNLyricsDownloaderTest lyricsDownloaderTest;
+    result|=QTest::qExec(&lyricsDownloaderTest, argc, argv);
+#ifdef ENABLE_FFMPEG_BACKEND
+    KNBackendFFMpegTest backendFFMpegTest;
+    result|=QTest::qExec(&backendFFMpegTest, argc, argv);
+#endif
+    return result;
+}